@@ -35,6 +35,7 @@ endmacro()
 set(COMPAT_CACHE_BOOL_VARS
     "VERBOSE"
     "ENABLE_CONCURRENT_EXEC"
+    "ENABLE_DYNAMIC_SCHEDULING"
     "ENABLE_PRIMITIVE_CACHE"
     "USE_RT_OBJECTS_IN_PRIMITIVE_CACHE"
     "ENABLE_MAX_CPU_ISA"
@@ -37,6 +37,12 @@ option(DNNL_ENABLE_CONCURRENT_EXEC
     CAUTION: enabling this option increases memory consumption."
     OFF) # disabled by default
 
+option(DNNL_ENABLE_DYNAMIC_SCHEDULING
+    "enables dynamic scheduling of the work between the threads in CPU
+    primitives by default. The default can be changed at run-time with
+    ONEDNN_DYNAMIC_SCHEDULING environment variable."
+    OFF) # disabled by default
+
 option(DNNL_ENABLE_PRIMITIVE_CACHE "enables primitive cache." ON)
     # enabled by default
 
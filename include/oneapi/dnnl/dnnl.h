@@ -238,6 +238,22 @@ dnnl_status_t DNNL_API dnnl_primitive_create_from_cache_blob(
         dnnl_primitive_t *primitive, const_dnnl_primitive_desc_t primitive_desc,
         size_t size, const uint8_t *cache_blob);
 
+/// Creates a number of primitives.
+///
+/// The primitives are created concurrently using the library threading
+/// runtime. Identical primitives are created only once through the primitive
+/// cache.
+///
+/// @param primitives Array of @p n output primitives. On failure, all the
+///     elements are set to NULL.
+/// @param n Number of primitives to create.
+/// @param primitive_descs Array of @p n primitive descriptors used to create
+///     the primitives.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_primitives_create(dnnl_primitive_t *primitives,
+        size_t n, const const_dnnl_primitive_desc_t *primitive_descs);
+
 /// Executes a primitive.
 ///
 /// @param primitive Primitive to execute.
@@ -369,6 +385,81 @@ dnnl_status_t DNNL_API dnnl_primitive_attr_get_scratchpad_mode(
 dnnl_status_t DNNL_API dnnl_primitive_attr_set_scratchpad_mode(
         dnnl_primitive_attr_t attr, dnnl_scratchpad_mode_t mode);
 
+/// Returns the maximum number of threads a primitive can use.
+///
+/// @param attr Primitive attributes.
+/// @param max_threads Output maximum number of threads. The value of 0 means
+///     the number of threads is defined by the threading runtime.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_primitive_attr_get_max_threads(
+        const_dnnl_primitive_attr_t attr, int *max_threads);
+
+/// Sets the maximum number of threads a primitive can use.
+///
+/// The limit is applied both when the primitive descriptor and the primitive
+/// are created and when the primitive is executed. It only affects CPU
+/// primitives.
+///
+/// @param attr Primitive attributes.
+/// @param max_threads Maximum number of threads. The value of 0 (default)
+///     means the number of threads is defined by the threading runtime.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_primitive_attr_set_max_threads(
+        dnnl_primitive_attr_t attr, int max_threads);
+
+/// Returns the weights group size.
+///
+/// @param attr Primitive attributes.
+/// @param group_size Output number of consecutive elements along the weights
+///     reduction dimension that share a scaling factor and a zero point.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_primitive_attr_get_weights_group_size(
+        const_dnnl_primitive_attr_t attr, dnnl_dim_t *group_size);
+
+/// Sets the weights group size.
+///
+/// When the weights scaling factors or zero points mask includes the weights
+/// reduction dimension (K for matmul), a single scaling factor and zero point
+/// is shared by @p group_size consecutive elements along that dimension. The
+/// scaling factors and zero points tensors then have K / @p group_size
+/// elements along the reduction dimension.
+///
+/// @param attr Primitive attributes.
+/// @param group_size Weights group size. Must be positive. The default value
+///     is 1.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_primitive_attr_set_weights_group_size(
+        dnnl_primitive_attr_t attr, dnnl_dim_t group_size);
+
+/// Returns whether the source may be quantized at runtime.
+///
+/// @param attr Primitive attributes.
+/// @param enable Output value: non-zero if the source may be quantized.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_primitive_attr_get_src_dynamic_quantization(
+        const_dnnl_primitive_attr_t attr, int *enable);
+
+/// Allows or disallows the source quantization at runtime.
+///
+/// When allowed, a primitive with f32 or bf16 source and s8 weights may
+/// quantize the source to s8 during execution using a scaling factor
+/// computed for each row of the source, and then compute the result using
+/// the int8 arithmetic. This trades accuracy for performance. Primitives that
+/// do not support it compute the result as if the attribute is not set.
+///
+/// @param attr Primitive attributes.
+/// @param enable Non-zero to allow the source quantization. The default
+///     value is 0.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_primitive_attr_set_src_dynamic_quantization(
+        dnnl_primitive_attr_t attr, int enable);
+
 /// Returns primitive attributes output scaling factors correspondence mask
 /// and values.
 ///
@@ -2341,6 +2432,36 @@ dnnl_status_t DNNL_API dnnl_layer_normalization_forward_desc_init(
         const dnnl_memory_desc_t *data_desc,
         const dnnl_memory_desc_t *stat_desc, float epsilon, unsigned flags);
 
+/// Initializes a descriptor for layer normalization forward propagation
+/// primitive with the source and destination of different data types.
+///
+/// The normalization is computed in f32 and then the output scales and the
+/// post-ops of the primitive attributes are applied before the conversion to
+/// the destination data type.
+///
+/// @note
+///     In-place operation is supported: the dst can refer to the same memory
+///     as the src if both have the same data type.
+///
+/// @param lnrm_desc Output descriptor for layer normalization primitive.
+/// @param prop_kind Propagation kind. Possible values are
+///     #dnnl_forward_training and #dnnl_forward_inference.
+/// @param src_desc Source memory descriptor.
+/// @param dst_desc Destination memory descriptor.
+/// @param stat_desc Memory descriptor for mean and variance. If this
+///     parameter is NULL, a zero memory descriptor, or a memory descriptor
+///     with format_kind set to #dnnl_format_kind_undef, then the memory
+///     descriptor for stats is derived from @p src_desc by removing the last
+///     dimension.
+/// @param epsilon Layer normalization epsilon parameter.
+/// @param flags Layer normalization flags (@ref dnnl_normalization_flags_t).
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_layer_normalization_forward_desc_init_v2(
+        dnnl_layer_normalization_desc_t *lnrm_desc, dnnl_prop_kind_t prop_kind,
+        const dnnl_memory_desc_t *src_desc, const dnnl_memory_desc_t *dst_desc,
+        const dnnl_memory_desc_t *stat_desc, float epsilon, unsigned flags);
+
 /// Initializes a descriptor for a layer normalization backward propagation
 /// primitive.
 ///
@@ -3714,6 +3835,31 @@ size_t DNNL_API dnnl_engine_get_count(dnnl_engine_kind_t kind);
 dnnl_status_t DNNL_API dnnl_engine_create(
         dnnl_engine_t *engine, dnnl_engine_kind_t kind, size_t index);
 
+/// Returns the number of NUMA nodes engines of a particular kind can be bound
+/// to.
+///
+/// @param kind Kind of engines. Only #dnnl_cpu is supported.
+/// @returns Count of the NUMA nodes or 0 if binding to a NUMA node is not
+///     supported.
+size_t DNNL_API dnnl_engine_get_numa_node_count(dnnl_engine_kind_t kind);
+
+/// Creates an engine bound to a NUMA node.
+///
+/// The memory allocated by the engine, including the memory of the memory
+/// objects and the scratchpads of the primitives, is placed on the NUMA node.
+/// With OpenMP threading runtime the threads executing primitives on the
+/// engine are bound to the CPUs of the node, and their number is limited to
+/// the number of the CPUs, for the time of the execution.
+///
+/// @param engine Output engine.
+/// @param kind Engine kind. Only #dnnl_cpu is supported.
+/// @param numa_node NUMA node that should be between 0 and the count of
+///     NUMA nodes returned by dnnl_engine_get_numa_node_count().
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_engine_create_on_numa_node(
+        dnnl_engine_t *engine, dnnl_engine_kind_t kind, int numa_node);
+
 /// Returns the kind of an engine.
 ///
 /// @param engine Engine to query.
@@ -3723,6 +3869,16 @@ dnnl_status_t DNNL_API dnnl_engine_create(
 dnnl_status_t DNNL_API dnnl_engine_get_kind(
         dnnl_engine_t engine, dnnl_engine_kind_t *kind);
 
+/// Returns the NUMA node an engine is bound to.
+///
+/// @param engine Engine to query.
+/// @param numa_node Output NUMA node or -1 if the engine is not bound to a
+///     NUMA node.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_engine_get_numa_node(
+        dnnl_engine_t engine, int *numa_node);
+
 /// Destroys an engine.
 ///
 /// @param engine Engine to destroy.
@@ -3761,6 +3917,22 @@ dnnl_status_t DNNL_API dnnl_stream_get_engine(
 ///     otherwise.
 dnnl_status_t DNNL_API dnnl_stream_wait(dnnl_stream_t stream);
 
+/// Returns the statistics of the scratchpad arena of an execution stream.
+///
+/// The primitives created with #dnnl_scratchpad_mode_user and executed on a
+/// CPU stream without #DNNL_ARG_SCRATCHPAD argument take the scratchpad from
+/// the arena owned by the stream. The arena grows to the largest scratchpad
+/// requested and is reused by the subsequent executions. Streams with an
+/// asynchronous threadpool have no arena and report zeros.
+///
+/// @param stream Execution stream.
+/// @param size Output size of the arena in bytes.
+/// @param num_allocations Output number of allocations the arena made.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_stream_get_scratchpad_arena_stats(
+        dnnl_stream_t stream, size_t *size, size_t *num_allocations);
+
 /// Destroys an execution stream.
 ///
 /// @param stream Execution stream to destroy.
@@ -3796,6 +3968,43 @@ dnnl_status_t DNNL_API dnnl_get_primitive_cache_capacity(int *capacity);
 ///     success.
 dnnl_status_t DNNL_API dnnl_set_primitive_cache_capacity(int capacity);
 
+/// Returns the limit on the total footprint of the primitives held in the
+/// primitive cache in bytes.
+///
+/// @param limit Primitive cache footprint limit to query. The value of 0
+///     means that the footprint is not limited. Concurrently accessing
+///     @p limit is safe.
+/// @returns #dnnl_invalid_arguments/#dnnl::status::invalid_arguments if the
+///     @p limit value is invalid, and #dnnl_success/#dnnl::status::success on
+///     success.
+dnnl_status_t DNNL_API dnnl_get_primitive_cache_footprint_limit(size_t *limit);
+
+/// Sets a limit on the total footprint of the primitives held in the
+/// primitive cache in bytes.
+///
+/// The footprint of a primitive is an estimate of the memory it occupies,
+/// including the primitive descriptor and the generated kernels. The limit
+/// applies in addition to the primitive cache capacity. A primitive with
+/// a footprint exceeding the limit is not stored in the primitive cache.
+///
+/// @param limit Primitive cache footprint limit to set. If the footprint of
+///     the primitives that the primitive cache already has exceeds the new
+///     @p limit then the least recently used entries will be evicted. Setting
+///     the @p limit to 0 removes the limit. Concurrently modifying @p limit
+///     is safe.
+/// @returns #dnnl_success/#dnnl::status::success on success.
+dnnl_status_t DNNL_API dnnl_set_primitive_cache_footprint_limit(size_t limit);
+
+/// Returns the total footprint of the primitives held in the primitive cache
+/// in bytes.
+///
+/// @param footprint Primitive cache footprint to query. Concurrently
+///     accessing @p footprint is safe.
+/// @returns #dnnl_invalid_arguments/#dnnl::status::invalid_arguments if the
+///     @p footprint value is invalid, and #dnnl_success/#dnnl::status::success
+///     on success.
+dnnl_status_t DNNL_API dnnl_get_primitive_cache_footprint(size_t *footprint);
+
 /// @} dnnl_api_primitive_cache
 
 /// @addtogroup dnnl_api_mathmode Floating-point Math Mode
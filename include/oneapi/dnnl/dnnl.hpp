@@ -732,6 +732,12 @@ enum class normalization_flags : unsigned {
     /// input on forward propagation. On backward propagation of type
     /// #dnnl::prop_kind::backward, the library computes its derivative.
     use_shift = dnnl_use_shift,
+
+    /// Use Root Mean Square (RMS) normalization. If specified, the mean is
+    /// considered to be zero on forward propagation and only the variance,
+    /// which is the mean of the squared source values, is an input or an
+    /// output of the primitive. Supported by the layer normalization only.
+    rms_norm = dnnl_rms_norm,
 };
 
 /// Converts normalization flags enum value from C++ API to C API type.
@@ -749,7 +755,10 @@ inline dnnl_normalization_flags_t convert_to_c(normalization_flags flags) {
 /// RNN cell flags.
 enum class rnn_flags : unsigned {
     /// Undefined RNN flags
-    undef = dnnl_rnn_flags_undef
+    undef = dnnl_rnn_flags_undef,
+    /// The sequences of the batch have different lengths, passed at the
+    /// execution as the #DNNL_ARG_SEQ_LENGTHS argument.
+    seq_lengths = dnnl_rnn_flags_seq_lengths,
 };
 
 /// Converts RNN cell flags enum value from C++ API to C API type.
@@ -1005,6 +1014,37 @@ struct engine : public handle<dnnl_engine_t> {
         reset(engine);
     }
 
+    /// Returns the number of NUMA nodes engines of a certain kind can be bound
+    /// to.
+    ///
+    /// @param akind The kind of engines. Only #dnnl::engine::kind::cpu is
+    ///     supported.
+    /// @returns The number of NUMA nodes or 0 if binding to a NUMA node is
+    ///     not supported.
+    static size_t get_numa_node_count(kind akind) {
+        return dnnl_engine_get_numa_node_count(convert_to_c(akind));
+    }
+
+    /// Constructs an engine bound to a NUMA node.
+    ///
+    /// The memory allocated by the engine is placed on the NUMA node. With
+    /// OpenMP threading runtime the threads executing primitives on the
+    /// engine are bound to the CPUs of the node, and their number is limited
+    /// to the number of the CPUs, for the time of the execution.
+    ///
+    /// @param akind The kind of engine to construct. Only
+    ///     #dnnl::engine::kind::cpu is supported.
+    /// @param numa_node The NUMA node. Must be less than the value returned
+    ///     by #get_numa_node_count() for this particular kind of engine.
+    /// @returns The engine bound to the NUMA node.
+    static engine create_on_numa_node(kind akind, int numa_node) {
+        dnnl_engine_t c_engine;
+        error::wrap_c_api(dnnl_engine_create_on_numa_node(
+                                  &c_engine, convert_to_c(akind), numa_node),
+                "could not create an engine on a NUMA node");
+        return engine(c_engine);
+    }
+
     /// Constructs an engine based on a primitive from the primitive
     /// descriptor @p pd by querying its engine.
     ///
@@ -1027,6 +1067,16 @@ struct engine : public handle<dnnl_engine_t> {
         return static_cast<engine::kind>(kind);
     }
 
+    /// Returns the NUMA node the engine is bound to.
+    /// @returns The NUMA node or -1 if the engine is not bound to a NUMA
+    ///     node.
+    int get_numa_node() const {
+        int numa_node;
+        error::wrap_c_api(dnnl_engine_get_numa_node(get(), &numa_node),
+                "could not get NUMA node of an engine");
+        return numa_node;
+    }
+
     /// Returns the engine of a primitive descriptor.
     ///
     /// @param pd The primitive descriptor to query.
@@ -1089,6 +1139,9 @@ struct stream : public handle<dnnl_stream_t> {
         in_order = dnnl_stream_in_order,
         /// Out-of-order execution.
         out_of_order = dnnl_stream_out_of_order,
+        /// Dynamic scheduling of the work between the threads. Only affects
+        /// CPU primitives.
+        dynamic_scheduling = dnnl_stream_dynamic_scheduling,
         /// Default stream configuration.
         default_flags = dnnl_stream_default_flags,
     };
@@ -1125,6 +1178,29 @@ struct stream : public handle<dnnl_stream_t> {
                 dnnl_stream_wait(get()), "could not wait on a stream");
         return *this;
     }
+
+    /// Returns the size of the scratchpad arena of the stream in bytes.
+    ///
+    /// The primitives created with #dnnl::scratchpad_mode::user and executed
+    /// on a CPU stream without #DNNL_ARG_SCRATCHPAD argument take the
+    /// scratchpad from the arena owned by the stream.
+    size_t get_scratchpad_arena_size() const {
+        size_t size, num_allocations;
+        error::wrap_c_api(dnnl_stream_get_scratchpad_arena_stats(
+                                  get(), &size, &num_allocations),
+                "could not get scratchpad arena statistics of a stream");
+        return size;
+    }
+
+    /// Returns the number of allocations the scratchpad arena of the stream
+    /// made.
+    size_t get_scratchpad_arena_num_allocations() const {
+        size_t size, num_allocations;
+        error::wrap_c_api(dnnl_stream_get_scratchpad_arena_stats(
+                                  get(), &size, &num_allocations),
+                "could not get scratchpad arena statistics of a stream");
+        return num_allocations;
+    }
 };
 
 DNNL_DEFINE_BITMASK_OPS(stream::flags)
@@ -3426,6 +3502,79 @@ struct primitive_attr : public handle<dnnl_primitive_attr_t> {
                 "could not set scratchpad mode primitive attribute");
     }
 
+    /// Returns the maximum number of threads a primitive can use. The value
+    /// of 0 means the number of threads is defined by the threading runtime.
+    int get_max_threads() const {
+        int result;
+        error::wrap_c_api(dnnl_primitive_attr_get_max_threads(get(), &result),
+                "could not get max threads primitive attribute");
+        return result;
+    }
+
+    /// Sets the maximum number of threads a primitive can use.
+    ///
+    /// The limit is applied both when the primitive descriptor and the
+    /// primitive are created and when the primitive is executed. It only
+    /// affects CPU primitives.
+    ///
+    /// @param max_threads Maximum number of threads. The value of 0 (default)
+    ///     means the number of threads is defined by the threading runtime.
+    void set_max_threads(int max_threads) {
+        error::wrap_c_api(
+                dnnl_primitive_attr_set_max_threads(get(), max_threads),
+                "could not set max threads primitive attribute");
+    }
+
+    /// Returns the number of consecutive elements along the weights
+    /// reduction dimension that share a scaling factor and a zero point.
+    memory::dim get_weights_group_size() const {
+        dnnl_dim_t result;
+        error::wrap_c_api(
+                dnnl_primitive_attr_get_weights_group_size(get(), &result),
+                "could not get weights group size primitive attribute");
+        return result;
+    }
+
+    /// Sets the weights group size.
+    ///
+    /// When the weights scaling factors or zero points mask includes the
+    /// weights reduction dimension, a single scaling factor and zero point is
+    /// shared by @p group_size consecutive elements along that dimension.
+    ///
+    /// @param group_size Weights group size. Must be positive. The default
+    ///     value is 1.
+    void set_weights_group_size(memory::dim group_size) {
+        error::wrap_c_api(
+                dnnl_primitive_attr_set_weights_group_size(get(), group_size),
+                "could not set weights group size primitive attribute");
+    }
+
+    /// Returns whether the source may be quantized at runtime.
+    bool get_src_dynamic_quantization() const {
+        int result;
+        error::wrap_c_api(
+                dnnl_primitive_attr_get_src_dynamic_quantization(
+                        get(), &result),
+                "could not get src dynamic quantization primitive attribute");
+        return result != 0;
+    }
+
+    /// Allows or disallows the source quantization at runtime.
+    ///
+    /// When allowed, a primitive with f32 or bf16 source and s8 weights may
+    /// quantize the source to s8 during execution using a scaling factor
+    /// computed for each row of the source, and then compute the result
+    /// using the int8 arithmetic. Primitives that do not support it compute
+    /// the result as if the attribute is not set.
+    ///
+    /// @param enable Whether the source quantization is allowed. The default
+    ///     value is false.
+    void set_src_dynamic_quantization(bool enable) {
+        error::wrap_c_api(dnnl_primitive_attr_set_src_dynamic_quantization(
+                                  get(), enable ? 1 : 0),
+                "could not set src dynamic quantization primitive attribute");
+    }
+
     /// Returns output scaling factors correspondence mask and values.
     ///
     /// @param mask Scaling factors correspondence mask that defines the
@@ -4588,6 +4737,31 @@ private:
     }
 };
 
+/// Creates primitives for a number of primitive descriptors.
+///
+/// @sa dnnl_primitives_create
+///
+/// @param pds Primitive descriptors used to create the primitives.
+/// @returns Primitives in the order of the primitive descriptors.
+inline std::vector<primitive> create_primitives(
+        const std::vector<primitive_desc_base> &pds) {
+    std::vector<const_dnnl_primitive_desc_t> c_pds;
+    c_pds.reserve(pds.size());
+    for (const auto &pd : pds)
+        c_pds.push_back(pd.get());
+
+    std::vector<dnnl_primitive_t> c_primitives(pds.size());
+    error::wrap_c_api(dnnl_primitives_create(c_primitives.data(),
+                              c_pds.size(), c_pds.data()),
+            "could not create primitives");
+
+    std::vector<primitive> result;
+    result.reserve(c_primitives.size());
+    for (auto c_primitive : c_primitives)
+        result.emplace_back(c_primitive);
+    return result;
+}
+
 /// @} dnnl_api_primitives_common
 
 /// @addtogroup dnnl_api_convolution Convolution
@@ -7822,6 +7996,33 @@ struct layer_normalization_forward : public primitive {
                     "could not create a descriptor for a layer normalization "
                     "forward propagation primitive");
         }
+
+        /// Constructs a descriptor for layer normalization forward
+        /// propagation primitive with the source and destination of
+        /// different data types.
+        ///
+        /// @param aprop_kind Propagation kind. Possible values are
+        ///     #dnnl::prop_kind::forward_training, and
+        ///     #dnnl::prop_kind::forward_inference.
+        /// @param src_desc Source memory descriptor.
+        /// @param dst_desc Destination memory descriptor.
+        /// @param stat_desc Statistics memory descriptors. If it is a zero
+        ///     memory descriptor, the statistics memory descriptor is derived
+        ///     from the @p src_desc.
+        /// @param epsilon Layer normalization epsilon parameter.
+        /// @param flags Layer normalization flags (@ref
+        ///     dnnl::normalization_flags).
+        desc(prop_kind aprop_kind, const memory::desc &src_desc,
+                const memory::desc &dst_desc, const memory::desc &stat_desc,
+                float epsilon, normalization_flags flags) {
+            error::wrap_c_api(
+                    dnnl_layer_normalization_forward_desc_init_v2(&data,
+                            dnnl::convert_to_c(aprop_kind), &src_desc.data,
+                            &dst_desc.data, &stat_desc.data, epsilon,
+                            convert_to_c(flags)),
+                    "could not create a descriptor for a layer normalization "
+                    "forward propagation primitive");
+        }
     };
 
     /// Primitive descriptor for a layer normalization forward propagation
@@ -12971,6 +13172,28 @@ inline void set_primitive_cache_capacity(int capacity) {
             "could not set primitive cache capacity");
 }
 
+/// @copydoc dnnl_get_primitive_cache_footprint_limit(size_t *limit)
+inline size_t get_primitive_cache_footprint_limit() {
+    size_t result = 0;
+    error::wrap_c_api(dnnl_get_primitive_cache_footprint_limit(&result),
+            "could not get primitive cache footprint limit");
+    return result;
+}
+
+/// @copydoc dnnl_set_primitive_cache_footprint_limit(size_t limit)
+inline void set_primitive_cache_footprint_limit(size_t limit) {
+    error::wrap_c_api(dnnl_set_primitive_cache_footprint_limit(limit),
+            "could not set primitive cache footprint limit");
+}
+
+/// @copydoc dnnl_get_primitive_cache_footprint(size_t *footprint)
+inline size_t get_primitive_cache_footprint() {
+    size_t result = 0;
+    error::wrap_c_api(dnnl_get_primitive_cache_footprint(&result),
+            "could not get primitive cache footprint");
+    return result;
+}
+
 /// @} dnnl_api_primitive_cache
 
 /// @addtogroup dnnl_api_blas BLAS functions
@@ -1645,6 +1645,18 @@ typedef enum {
     ///  - on backward propagation (for prop_kind == #dnnl_backward) compute
     ///    diff wrt shift (hence one extra output used)
     dnnl_use_shift = 0x10U,
+
+    /// Use Root Mean Square (RMS) normalization
+    ///
+    /// If specified:
+    ///  - on forward propagation the mean is considered to be zero and is
+    ///    neither computed nor used, the variance is the mean of the squared
+    ///    source values
+    ///  - only the variance is an input (with #dnnl_use_global_stats) or an
+    ///    output (on training) of the primitive
+    ///
+    /// The flag is supported by the layer normalization primitive only.
+    dnnl_rms_norm = 0x20U,
 } dnnl_normalization_flags_t;
 
 /// @} dnnl_api_primitives_common
@@ -2277,6 +2289,9 @@ typedef struct {
     /// Layer normalization epsilon parameter.
     float layer_norm_epsilon;
     unsigned flags;
+    /// Destination memory descriptor for forward propagation. Has the same
+    /// dimensions as the data_desc and may have a different data type.
+    dnnl_memory_desc_t dst_desc;
 } dnnl_layer_normalization_desc_t;
 
 /// @} dnnl_api_layer_normalization
@@ -2321,7 +2336,10 @@ typedef struct {
 /// Flags for RNN cell.
 typedef enum {
     /// Undefined RNN flags
-    dnnl_rnn_flags_undef = 0x0
+    dnnl_rnn_flags_undef = 0x0,
+    /// The sequences of the batch have different lengths, passed at the
+    /// execution as the #DNNL_ARG_SEQ_LENGTHS argument.
+    dnnl_rnn_flags_seq_lengths = 0x1U,
 } dnnl_rnn_flags_t;
 
 /// A direction of RNN primitive execution.
@@ -2775,6 +2793,10 @@ typedef const struct dnnl_primitive *const_dnnl_primitive_t;
 /// A special mnemonic for shift argument of normalization primitives.
 #define DNNL_ARG_SHIFT 52
 
+/// Sequence lengths tensor argument of the RNN primitive: the number of
+/// valid time steps for every sequence of the batch.
+#define DNNL_ARG_SEQ_LENGTHS 53
+
 /// Workspace tensor argument. Workspace is used to pass information
 /// from forward propagation to backward propagation computations.
 #define DNNL_ARG_WORKSPACE 64
@@ -3017,6 +3039,9 @@ typedef enum {
     dnnl_stream_in_order = 0x1U,
     /// Out-of-order execution.
     dnnl_stream_out_of_order = 0x2U,
+    /// Dynamic scheduling of the work between the threads. Only affects CPU
+    /// primitives.
+    dnnl_stream_dynamic_scheduling = 0x4U,
     /// Default stream configuration.
     dnnl_stream_default_flags = dnnl_stream_in_order,
 } dnnl_stream_flags_t;
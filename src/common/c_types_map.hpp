@@ -1445,6 +1445,7 @@ using stream_flags_t = dnnl_stream_flags_t;
 namespace stream_flags {
 const stream_flags_t in_order = dnnl_stream_in_order;
 const stream_flags_t out_of_order = dnnl_stream_out_of_order;
+const stream_flags_t dynamic_scheduling = dnnl_stream_dynamic_scheduling;
 const stream_flags_t default_flags = dnnl_stream_default_flags;
 } // namespace stream_flags
 using stream_t = dnnl_stream;
@@ -25,6 +25,20 @@
 namespace dnnl {
 namespace impl {
 
+bool is_cache_blob_supported(
+        const engine_t *engine, const primitive_desc_t *pd) {
+    const auto engine_kind = engine->kind();
+    const auto runtime_kind = engine->runtime_kind();
+
+    // CPU primitives keep JIT code in the blob, which is only meaningful for
+    // the native CPU runtimes. Only the JIT eltwise implementation stores its
+    // code so far. GPU primitives keep OpenCL binaries.
+    if (engine_kind == engine_kind::cpu)
+        return runtime_kind != runtime_kind::sycl
+                && pd->kind() == primitive_kind::eltwise;
+    return engine_kind == engine_kind::gpu && runtime_kind == runtime_kind::ocl;
+}
+
 const std::vector<uint8_t> &cache_blob_id_t::get(
         const engine_t *engine, const primitive_desc_t *pd) {
     if (is_initialized_) return sstream_.get_data();
@@ -32,19 +46,12 @@ const std::vector<uint8_t> &cache_blob_id_t::get(
     auto engine_kind = engine->kind();
     auto runtime_kind = engine->runtime_kind();
 
-    if (engine_kind != engine_kind::gpu
-            || (engine_kind == engine_kind::gpu
-                    && runtime_kind != runtime_kind::ocl)) {
-        return sstream_.get_data();
-    }
+    if (!is_cache_blob_supported(engine, pd)) return sstream_.get_data();
 
     if (pd->op_desc()->kind == primitive_kind::zero_pad) {
         return sstream_.get_data();
     }
 
-    assert(engine->kind() == engine_kind::gpu
-            && engine->runtime_kind() == runtime_kind::ocl);
-
     const auto init_id = [&]() {
         serialization::serialize_desc(sstream_, pd->op_desc());
         serialization::serialize_attr(sstream_, *pd->attr());
@@ -19,6 +19,7 @@
 #include "oneapi/dnnl/dnnl.h"
 
 #include "c_types_map.hpp"
+#include "dnnl_thread.hpp"
 #include "concat_pd.hpp"
 #include "engine.hpp"
 #include "impl_list_item.hpp"
@@ -43,6 +44,7 @@ status_t concat_primitive_desc_create(primitive_desc_iface_t **concat_pd_iface,
     if (!args_ok) return invalid_arguments;
 
     if (attr == nullptr) attr = &default_attr();
+    max_threads_guard_t max_threads_guard(attr->max_threads_);
 
     const int ndims = src_mds[0].ndims;
     const dims_t &dims = src_mds[0].dims;
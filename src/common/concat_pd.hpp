@@ -114,7 +114,9 @@ protected:
      *
      * @warning The call may fail. */
     status_t init(const memory_desc_t *force_dst_md = nullptr) {
-        bool ok = attr()->has_default_values();
+        bool ok = attr()->has_default_values(
+                          primitive_attr_t::skip_mask_t::scales)
+                && attr_scales_ok();
         if (force_dst_md == nullptr)
             ok = ok && set_default_params() == status::success;
         if (!ok) return status::unimplemented;
@@ -151,6 +153,25 @@ protected:
         return status::success;
     }
 
+    /* the inputs may be scaled by a common factor each */
+    bool attr_scales_ok() const {
+        const auto &scales = attr()->scales_;
+        for (const auto &s : scales.scales_) {
+            if (s.second.has_default_values()) continue;
+            const int src_index = s.first - DNNL_ARG_MULTIPLE_SRC;
+            if (src_index < 0 || src_index >= n_ || s.second.mask_ != 0
+                    || !s.second.defined())
+                return false;
+        }
+        return true;
+    }
+
+    /* the common scale of the input, 1.f if not set */
+    float src_scale(int index) const {
+        const auto &s = attr()->scales_.get(DNNL_ARG_MULTIPLE_SRC + index);
+        return s.has_default_values() ? 1.f : s.scales_[0];
+    }
+
     status_t set_default_params() {
         if (dst_md_.format_kind != format_kind::any) return status::success;
 
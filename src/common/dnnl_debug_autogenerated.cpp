@@ -1187,6 +1187,7 @@ const char *dnnl_alg_kind2str(dnnl_alg_kind_t v) {
 
 const char *dnnl_rnn_flags2str(dnnl_rnn_flags_t v) {
     if (v == dnnl_rnn_flags_undef) return "undef";
+    if (v == dnnl_rnn_flags_seq_lengths) return "seq_lengths";
     assert(!"unknown rnn_flags");
     return "unknown rnn_flags";
 }
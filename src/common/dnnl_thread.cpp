@@ -362,57 +362,209 @@ void parallel_nd_ext(int nthr, dim_t D0, dim_t D1, dim_t D2, dim_t D3, dim_t D4,
         });
 }
 
+/* scheduling section */
+
+namespace {
+
+// The scheduling mode set for the calling thread: -1 means the default mode.
+thread_local int thread_dynamic_scheduling = -1;
+
+// The limit of the number of threads for the calling thread: 0 means no limit.
+thread_local int thread_max_threads = 0;
+
+// The number of threads assumed for the calling thread instead of the one
+// reported by the runtime: 0 means no override.
+thread_local int thread_default_max_threads = 0;
+
+bool get_default_dynamic_scheduling() {
+#ifdef DNNL_ENABLE_DYNAMIC_SCHEDULING
+    static const bool dynamic
+            = getenv_int_user("DYNAMIC_SCHEDULING", 1) != 0;
+#else
+    static const bool dynamic
+            = getenv_int_user("DYNAMIC_SCHEDULING", 0) != 0;
+#endif
+    return dynamic;
+}
+
+} // namespace
+
+bool get_dynamic_scheduling() {
+    if (thread_dynamic_scheduling != -1) return thread_dynamic_scheduling;
+    return get_default_dynamic_scheduling();
+}
+
+dynamic_scheduling_guard_t::dynamic_scheduling_guard_t(bool enable)
+    : prev_(thread_dynamic_scheduling) {
+    thread_dynamic_scheduling = enable;
+}
+
+dynamic_scheduling_guard_t::~dynamic_scheduling_guard_t() {
+    thread_dynamic_scheduling = prev_;
+}
+
+int apply_max_threads_limit(int nthr) {
+    if (thread_default_max_threads > 0) nthr = thread_default_max_threads;
+    return thread_max_threads > 0 ? nstl::min(nthr, thread_max_threads) : nthr;
+}
+
+max_threads_guard_t::max_threads_guard_t(int max_threads)
+    : prev_(thread_max_threads) {
+    if (max_threads > 0)
+        thread_max_threads = apply_max_threads_limit(max_threads);
+}
+
+max_threads_guard_t::~max_threads_guard_t() {
+    thread_max_threads = prev_;
+}
+
+default_max_threads_guard_t::default_max_threads_guard_t(int max_threads)
+    : prev_(thread_default_max_threads) {
+    thread_default_max_threads = max_threads;
+}
+
+default_max_threads_guard_t::~default_max_threads_guard_t() {
+    thread_default_max_threads = prev_;
+}
+
+work_scheduler_t::work_scheduler_t(dim_t work_amount, int nthr, bool dynamic)
+    : work_amount_(work_amount), nthr_(nthr), dynamic_(dynamic && nthr > 1) {
+    if (!dynamic_) return;
+    ranges_.reset(new range_t[nthr]);
+    for (int ithr = 0; ithr < nthr; ithr++) {
+        dim_t start {0}, end {0};
+        balance211(work_amount, nthr, ithr, start, end);
+        ranges_[ithr].next.store(start, std::memory_order_relaxed);
+        ranges_[ithr].end = end;
+    }
+}
+
+bool work_scheduler_t::take(range_t &range, dim_t &start, dim_t &end) const {
+    const dim_t range_end = range.end;
+    // Guided self-scheduling: large chunks first to keep the overhead low,
+    // then small ones to balance the tail of the work.
+    const dim_t remaining
+            = range_end - range.next.load(std::memory_order_relaxed);
+    if (remaining <= 0) return false;
+    const dim_t chunk = nstl::max((dim_t)1, remaining / 4);
+    start = range.next.fetch_add(chunk, std::memory_order_relaxed);
+    if (start >= range_end) return false;
+    end = nstl::min(start + chunk, range_end);
+    return true;
+}
+
+bool work_scheduler_t::next(int ithr, dim_t &start, dim_t &end) {
+    if (!dynamic_) {
+        // The only range of the thread is returned by the first call, which
+        // is recognized by `end` being 0: a non-empty range ends above 0.
+        if (end != 0) return false;
+        balance211(work_amount_, nthr_, ithr, start, end);
+        return start < end;
+    }
+    if (take(ranges_[ithr], start, end)) return true;
+    // Take the work remaining in the ranges of the other threads.
+    for (int i = 1; i < nthr_; i++)
+        if (take(ranges_[(ithr + i) % nthr_], start, end)) return true;
+    return false;
+}
+
 /* parallel_nd section */
 
+namespace {
+
+template <typename F>
+void parallel_nd_impl(dim_t work_amount, const F &f_range) {
+    int nthr = adjust_num_threads(dnnl_get_current_num_threads(), work_amount);
+    if (!nthr) return;
+    if (!get_dynamic_scheduling()) {
+        parallel(nthr, [&](int ithr, int nthr) {
+            dim_t start {0}, end {0};
+            balance211(work_amount, nthr, ithr, start, end);
+            f_range(start, end);
+        });
+        return;
+    }
+    work_scheduler_t scheduler(work_amount, nthr);
+    parallel(nthr, [&](int ithr, int nthr_) {
+        dim_t start {0}, end {0};
+        // The runtime may provide less threads than requested.
+        if (nthr_ != nthr) {
+            balance211(work_amount, nthr_, ithr, start, end);
+            f_range(start, end);
+            return;
+        }
+        while (scheduler.next(ithr, start, end))
+            f_range(start, end);
+    });
+}
+
+} // namespace
+
 void parallel_nd(dim_t D0, const F_1D_t &f) {
-    int nthr = adjust_num_threads(dnnl_get_current_num_threads(), D0);
-    if (nthr)
-        parallel(nthr, [&](int ithr, int nthr) { for_nd(ithr, nthr, D0, f); });
+    parallel_nd_impl(D0, [&](dim_t start, dim_t end) {
+        for (dim_t d0 = start; d0 < end; ++d0)
+            f(d0);
+    });
 }
 
 void parallel_nd(dim_t D0, dim_t D1, const F_2D_t &f) {
-    const dim_t work_amount = D0 * D1;
-    int nthr = adjust_num_threads(dnnl_get_current_num_threads(), work_amount);
-    if (nthr)
-        parallel(nthr,
-                [&](int ithr, int nthr) { for_nd(ithr, nthr, D0, D1, f); });
+    parallel_nd_impl(D0 * D1, [&](dim_t start, dim_t end) {
+        dim_t d0 {0}, d1 {0};
+        utils::nd_iterator_init(start, d0, D0, d1, D1);
+        for (dim_t iwork = start; iwork < end; ++iwork) {
+            f(d0, d1);
+            utils::nd_iterator_step(d0, D0, d1, D1);
+        }
+    });
 }
 
 void parallel_nd(dim_t D0, dim_t D1, dim_t D2, const F_3D_t &f) {
-    const dim_t work_amount = D0 * D1 * D2;
-    int nthr = adjust_num_threads(dnnl_get_current_num_threads(), work_amount);
-    if (nthr)
-        parallel(nthr,
-                [&](int ithr, int nthr) { for_nd(ithr, nthr, D0, D1, D2, f); });
+    parallel_nd_impl(D0 * D1 * D2, [&](dim_t start, dim_t end) {
+        dim_t d0 {0}, d1 {0}, d2 {0};
+        utils::nd_iterator_init(start, d0, D0, d1, D1, d2, D2);
+        for (dim_t iwork = start; iwork < end; ++iwork) {
+            f(d0, d1, d2);
+            utils::nd_iterator_step(d0, D0, d1, D1, d2, D2);
+        }
+    });
 }
 
 void parallel_nd(dim_t D0, dim_t D1, dim_t D2, dim_t D3, const F_4D_t &f) {
-    const dim_t work_amount = D0 * D1 * D2 * D3;
-    int nthr = adjust_num_threads(dnnl_get_current_num_threads(), work_amount);
-    if (nthr)
-        parallel(nthr, [&](int ithr, int nthr) {
-            for_nd(ithr, nthr, D0, D1, D2, D3, f);
-        });
+    parallel_nd_impl(D0 * D1 * D2 * D3, [&](dim_t start, dim_t end) {
+        dim_t d0 {0}, d1 {0}, d2 {0}, d3 {0};
+        utils::nd_iterator_init(start, d0, D0, d1, D1, d2, D2, d3, D3);
+        for (dim_t iwork = start; iwork < end; ++iwork) {
+            f(d0, d1, d2, d3);
+            utils::nd_iterator_step(d0, D0, d1, D1, d2, D2, d3, D3);
+        }
+    });
 }
 
 void parallel_nd(
         dim_t D0, dim_t D1, dim_t D2, dim_t D3, dim_t D4, const F_5D_t &f) {
-    const dim_t work_amount = D0 * D1 * D2 * D3 * D4;
-    int nthr = adjust_num_threads(dnnl_get_current_num_threads(), work_amount);
-    if (nthr)
-        parallel(nthr, [&](int ithr, int nthr) {
-            for_nd(ithr, nthr, D0, D1, D2, D3, D4, f);
-        });
+    parallel_nd_impl(D0 * D1 * D2 * D3 * D4, [&](dim_t start, dim_t end) {
+        dim_t d0 {0}, d1 {0}, d2 {0}, d3 {0}, d4 {0};
+        utils::nd_iterator_init(
+                start, d0, D0, d1, D1, d2, D2, d3, D3, d4, D4);
+        for (dim_t iwork = start; iwork < end; ++iwork) {
+            f(d0, d1, d2, d3, d4);
+            utils::nd_iterator_step(d0, D0, d1, D1, d2, D2, d3, D3, d4, D4);
+        }
+    });
 }
 
 void parallel_nd(dim_t D0, dim_t D1, dim_t D2, dim_t D3, dim_t D4, dim_t D5,
         const F_6D_t &f) {
-    const dim_t work_amount = D0 * D1 * D2 * D3 * D4 * D5;
-    int nthr = adjust_num_threads(dnnl_get_current_num_threads(), work_amount);
-    if (nthr)
-        parallel(nthr, [&](int ithr, int nthr) {
-            for_nd(ithr, nthr, D0, D1, D2, D3, D4, D5, f);
-        });
+    parallel_nd_impl(D0 * D1 * D2 * D3 * D4 * D5, [&](dim_t start, dim_t end) {
+        dim_t d0 {0}, d1 {0}, d2 {0}, d3 {0}, d4 {0}, d5 {0};
+        utils::nd_iterator_init(
+                start, d0, D0, d1, D1, d2, D2, d3, D3, d4, D4, d5, D5);
+        for (dim_t iwork = start; iwork < end; ++iwork) {
+            f(d0, d1, d2, d3, d4, d5);
+            utils::nd_iterator_step(
+                    d0, D0, d1, D1, d2, D2, d3, D3, d4, D4, d5, D5);
+        }
+    });
 }
 
 } // namespace impl
@@ -18,12 +18,25 @@
 #define COMMON_DNNL_THREAD_HPP
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
+#include <memory>
 #include <mutex>
 
 #include "utils.hpp"
 #include "z_magic.hpp"
 
+namespace dnnl {
+namespace impl {
+
+// Returns `nthr`, or the number set for the calling thread using
+// default_max_threads_guard_t, bounded by the limit set for the calling thread
+// using max_threads_guard_t.
+int DNNL_API apply_max_threads_limit(int nthr);
+
+} // namespace impl
+} // namespace dnnl
+
 #if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_SEQ
 #define DNNL_THR_SYNC 1
 inline int dnnl_get_max_threads() {
@@ -38,7 +51,7 @@ inline void dnnl_thr_barrier() {}
 #include "omp.h"
 #define DNNL_THR_SYNC 1
 inline int dnnl_get_max_threads() {
-    return omp_get_max_threads();
+    return dnnl::impl::apply_max_threads_limit(omp_get_max_threads());
 }
 inline int dnnl_in_parallel() {
     return omp_in_parallel();
@@ -52,7 +65,8 @@ inline void dnnl_thr_barrier() {
 #include "tbb/task_arena.h"
 #define DNNL_THR_SYNC 0
 inline int dnnl_get_max_threads() {
-    return tbb::this_task_arena::max_concurrency();
+    return dnnl::impl::apply_max_threads_limit(
+            tbb::this_task_arena::max_concurrency());
 }
 inline int dnnl_in_parallel() {
     return 0;
@@ -112,7 +126,8 @@ inline int dnnl_get_max_threads() {
     // Make user responsible for number of threads provided at execution time.
     // This relates to the fact that the library may identify `def_max_threads`
     // incorrectly for a platform.
-    return tp ? std::max(1, tp->get_num_threads()) : def_max_threads;
+    return dnnl::impl::apply_max_threads_limit(
+            tp ? std::max(1, tp->get_num_threads()) : def_max_threads);
 }
 inline int dnnl_in_parallel() {
     using namespace dnnl::impl::threadpool_utils;
@@ -140,9 +155,9 @@ inline void dnnl_thr_barrier() {
 inline int dnnl_get_current_num_threads() {
     if (dnnl_in_parallel()) return 1;
 #if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
-    return omp_get_max_threads();
+    return dnnl_get_max_threads();
 #elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_TBB
-    return tbb::this_task_arena::max_concurrency();
+    return dnnl_get_max_threads();
 #elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
     using namespace dnnl::impl::threadpool_utils;
     dnnl::threadpool_interop::threadpool_iface *tp = get_active_threadpool();
@@ -251,6 +266,20 @@ void balance2D(U nthr, U ithr, T ny, T &ny_start, T &ny_end, T nx, T &nx_start,
  *  - parallel_nd_in_omp(dims..., f)     - queries current nthr and ithr and
  *                                         then calls for_nd (mostly for
  *                                         convenience)
+ *
+ * Scheduling:
+ *  parallel_nd() splits the work between the threads statically using
+ *  balance211() by default. With dynamic scheduling the threads start with
+ *  the same ranges, but a thread that is done with its range takes chunks of
+ *  the work remaining in the ranges of the other threads. The chunk size
+ *  decreases with the amount of the remaining work. This helps when threads
+ *  progress at different speed, e.g. on hybrid CPUs or on shared hosts.
+ *
+ *  Dynamic scheduling is the default if the library is built with
+ *  DNNL_ENABLE_DYNAMIC_SCHEDULING, which can be changed with
+ *  ONEDNN_DYNAMIC_SCHEDULING environment variable. It is also enabled for the
+ *  primitives executed on a stream created with
+ *  dnnl_stream_dynamic_scheduling flag.
  */
 
 /* general parallelization */
@@ -318,6 +347,84 @@ void DNNL_API parallel_nd(dim_t D0, dim_t D1, dim_t D2, dim_t D3, dim_t D4,
 void DNNL_API parallel_nd(dim_t D0, dim_t D1, dim_t D2, dim_t D3, dim_t D4,
         dim_t D5,
         const std::function<void(dim_t, dim_t, dim_t, dim_t, dim_t, dim_t)> &f);
+
+/* scheduling section */
+
+// Returns whether dynamic scheduling is enabled for the calling thread.
+bool DNNL_API get_dynamic_scheduling();
+
+// Enables or disables dynamic scheduling for the calling thread during the
+// lifetime of the object.
+struct DNNL_API dynamic_scheduling_guard_t {
+    dynamic_scheduling_guard_t(bool enable);
+    ~dynamic_scheduling_guard_t();
+
+private:
+    int prev_;
+
+    DNNL_DISALLOW_COPY_AND_ASSIGN(dynamic_scheduling_guard_t);
+};
+
+// Limits the number of threads the library uses on the calling thread during
+// the lifetime of the object. The limits of nested guards are combined. The
+// limit of 0 means that the guard doesn't add a limit.
+struct DNNL_API max_threads_guard_t {
+    max_threads_guard_t(int max_threads);
+    ~max_threads_guard_t();
+
+private:
+    int prev_;
+
+    DNNL_DISALLOW_COPY_AND_ASSIGN(max_threads_guard_t);
+};
+
+// Makes the library assume `max_threads` threads on the calling thread instead
+// of the number reported by the threading runtime during the lifetime of the
+// object. Used to do the work of a user thread on a worker thread, where the
+// runtime may report a different number.
+struct DNNL_API default_max_threads_guard_t {
+    default_max_threads_guard_t(int max_threads);
+    ~default_max_threads_guard_t();
+
+private:
+    int prev_;
+
+    DNNL_DISALLOW_COPY_AND_ASSIGN(default_max_threads_guard_t);
+};
+
+// Distributes `work_amount` items between `nthr` threads. The object is shared
+// by the threads of a parallel region, which call next() until it returns
+// false. With static scheduling a thread gets its balance211() range at once.
+//
+// The scheduler relies on all `nthr` threads to run. A caller which may get
+// less threads from the runtime has to fall back to balance211().
+struct DNNL_API work_scheduler_t {
+    work_scheduler_t(dim_t work_amount, int nthr,
+            bool dynamic = get_dynamic_scheduling());
+
+    // Returns the next range of items [start, end) for the thread `ithr`.
+    // `start` and `end` must be 0 before the first call.
+    bool next(int ithr, dim_t &start, dim_t &end);
+
+private:
+    // Ranges are accessed by all threads hence are aligned to avoid false
+    // sharing.
+    struct alignas(64) range_t : public c_compatible {
+        std::atomic<dim_t> next;
+        dim_t end;
+    };
+
+    bool take(range_t &range, dim_t &start, dim_t &end) const;
+
+    dim_t work_amount_;
+    int nthr_;
+    bool dynamic_;
+    // Allocated with dynamic scheduling only.
+    std::unique_ptr<range_t[]> ranges_;
+
+    DNNL_DISALLOW_COPY_AND_ASSIGN(work_scheduler_t);
+};
+
 /* parallel_nd_in_omp section */
 
 template <typename... Args>
@@ -85,12 +85,39 @@ status_t dnnl_engine_create(
     return ef->engine_create(engine, index);
 }
 
+size_t dnnl_engine_get_numa_node_count(engine_kind_t kind) {
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE
+    if (kind == engine_kind::cpu
+            && is_native_runtime(get_default_runtime(kind)))
+        return (size_t)cpu::numa::get_node_count();
+#endif
+    return 0;
+}
+
+status_t dnnl_engine_create_on_numa_node(
+        engine_t **engine, engine_kind_t kind, int numa_node) {
+    if (engine == nullptr) return invalid_arguments;
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE
+    if (kind == engine_kind::cpu
+            && is_native_runtime(get_default_runtime(kind)))
+        return cpu::cpu_engine_factory_t().engine_create_on_numa_node(
+                engine, numa_node);
+#endif
+    return unimplemented;
+}
+
 status_t dnnl_engine_get_kind(engine_t *engine, engine_kind_t *kind) {
     if (engine == nullptr) return invalid_arguments;
     *kind = engine->kind();
     return success;
 }
 
+status_t dnnl_engine_get_numa_node(engine_t *engine, int *numa_node) {
+    if (any_null(engine, numa_node)) return invalid_arguments;
+    *numa_node = engine->numa_node();
+    return success;
+}
+
 status_t dnnl_engine_destroy(engine_t *engine) {
 #ifdef DNNL_USE_RT_OBJECTS_IN_PRIMITIVE_CACHE
     if (engine != nullptr) engine->release();
@@ -62,6 +62,9 @@ struct dnnl_engine : public dnnl::impl::c_compatible {
 
     virtual dnnl::impl::device_id_t device_id() const = 0;
 
+    /** get the NUMA node the engine is bound to or -1 if it is not bound */
+    virtual int numa_node() const { return -1; }
+
 #ifdef DNNL_USE_RT_OBJECTS_IN_PRIMITIVE_CACHE
     virtual dnnl::impl::engine_id_t engine_id() const = 0;
 #endif
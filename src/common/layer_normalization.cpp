@@ -30,16 +30,18 @@ using namespace dnnl::impl::types;
 namespace {
 status_t lnorm_desc_init(layer_normalization_desc_t *lnorm_desc,
         prop_kind_t prop_kind, const memory_desc_t *data_desc,
-        const memory_desc_t *stat_desc, const memory_desc_t *diff_data_desc,
-        float epsilon, unsigned flags) {
+        const memory_desc_t *dst_desc, const memory_desc_t *stat_desc,
+        const memory_desc_t *diff_data_desc, float epsilon, unsigned flags) {
     bool args_ok = !any_null(lnorm_desc, data_desc)
             && one_of(prop_kind, forward_training, forward_inference,
                     backward_data, backward)
             && 2 <= data_desc->ndims && data_desc->ndims <= 5
             && IMPLICATION(prop_kind & backward, diff_data_desc != nullptr)
+            && IMPLICATION(!(prop_kind & backward), dst_desc != nullptr)
             && (flags
                        & ~(dnnl_use_global_stats | dnnl_use_scaleshift
-                               | dnnl_use_scale | dnnl_use_shift))
+                               | dnnl_use_scale | dnnl_use_shift
+                               | dnnl_rms_norm))
                     == 0
             && IMPLICATION(
                     one_of(prop_kind, forward_training, forward_inference),
@@ -59,15 +61,21 @@ status_t lnorm_desc_init(layer_normalization_desc_t *lnorm_desc,
         runtime_dims_or_strides = runtime_dims_or_strides
                 || memory_desc_wrapper(diff_data_desc)
                            .has_runtime_dims_or_strides();
+    else
+        runtime_dims_or_strides = runtime_dims_or_strides
+                || memory_desc_wrapper(dst_desc).has_runtime_dims_or_strides();
     if (runtime_dims_or_strides) return unimplemented;
 
     ld.data_desc = *data_desc;
     ld.stat_desc = zero_md();
     ld.diff_data_desc = zero_md();
+    ld.dst_desc = zero_md();
     if (one_of(ld.prop_kind, backward_data, backward))
         ld.diff_data_desc = *diff_data_desc;
+    else
+        ld.dst_desc = *dst_desc;
 
-    if (stat_desc)
+    if (stat_desc && !memory_desc_wrapper(stat_desc).is_zero())
         ld.stat_desc = *stat_desc;
     else
         CHECK(dnnl_memory_desc_init_by_tag(&ld.stat_desc,
@@ -99,6 +107,13 @@ status_t lnorm_desc_init(layer_normalization_desc_t *lnorm_desc,
 
     ld.flags = flags;
 
+    if (one_of(ld.prop_kind, forward_training, forward_inference)) {
+        bool consistency = ld.dst_desc.ndims == ld.data_desc.ndims
+                && array_cmp(
+                        ld.dst_desc.dims, ld.data_desc.dims, ld.dst_desc.ndims);
+        if (!consistency) return invalid_arguments;
+    }
+
     if (ld.prop_kind == backward_data) {
         bool consistency = ld.diff_data_desc.ndims == ld.data_desc.ndims
                 && array_cmp(ld.diff_data_desc.dims, ld.data_desc.dims,
@@ -120,8 +135,18 @@ status_t dnnl_layer_normalization_forward_desc_init(
         float epsilon, unsigned flags) {
     if (!one_of(prop_kind, forward_training, forward_inference))
         return invalid_arguments;
-    return lnorm_desc_init(lnorm_desc, prop_kind, data_desc, stat_desc, nullptr,
-            epsilon, flags);
+    return lnorm_desc_init(lnorm_desc, prop_kind, data_desc, data_desc,
+            stat_desc, nullptr, epsilon, flags);
+}
+
+status_t dnnl_layer_normalization_forward_desc_init_v2(
+        layer_normalization_desc_t *lnorm_desc, prop_kind_t prop_kind,
+        const memory_desc_t *src_desc, const memory_desc_t *dst_desc,
+        const memory_desc_t *stat_desc, float epsilon, unsigned flags) {
+    if (!one_of(prop_kind, forward_training, forward_inference))
+        return invalid_arguments;
+    return lnorm_desc_init(lnorm_desc, prop_kind, src_desc, dst_desc,
+            stat_desc, nullptr, epsilon, flags);
 }
 
 status_t dnnl_layer_normalization_backward_desc_init(
@@ -129,8 +154,8 @@ status_t dnnl_layer_normalization_backward_desc_init(
         const memory_desc_t *diff_data_desc, const memory_desc_t *data_desc,
         const memory_desc_t *stat_desc, float epsilon, unsigned flags) {
     if (!one_of(prop_kind, backward, backward_data)) return invalid_arguments;
-    return lnorm_desc_init(lnorm_desc, prop_kind, data_desc, stat_desc,
-            diff_data_desc, epsilon, flags);
+    return lnorm_desc_init(lnorm_desc, prop_kind, data_desc, nullptr,
+            stat_desc, diff_data_desc, epsilon, flags);
 }
 
 // vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -65,6 +65,8 @@ struct layer_normalization_pd_t : public primitive_desc_t {
     bool use_global_stats() const {
         return desc_.flags & dnnl_use_global_stats;
     }
+    // the mean is not computed and is not an argument of the primitive
+    bool use_rms_norm() const { return desc_.flags & dnnl_rms_norm; }
 
     bool is_fwd() const {
         return utils::one_of(desc_.prop_kind, prop_kind::forward_training,
@@ -134,7 +136,8 @@ struct layer_normalization_fwd_pd_t : public layer_normalization_pd_t {
         if (arg == DNNL_ARG_SRC) return arg_usage_t::input;
         if (arg == DNNL_ARG_DST) return arg_usage_t::output;
 
-        if (utils::one_of(arg, DNNL_ARG_MEAN, DNNL_ARG_VARIANCE)) {
+        if (utils::one_of(arg, DNNL_ARG_MEAN, DNNL_ARG_VARIANCE)
+                && IMPLICATION(use_rms_norm(), arg == DNNL_ARG_VARIANCE)) {
             if (stats_are_src()) return arg_usage_t::input;
             if (!stats_are_src() && is_training()) return arg_usage_t::output;
             return arg_usage_t::unused;
@@ -165,13 +168,13 @@ struct layer_normalization_fwd_pd_t : public layer_normalization_pd_t {
 
     const memory_desc_t *src_md(int index = 0) const override {
         if (index == 0) return &data_md_;
-        if (stats_are_src() && (index == 1 || index == 2)) return &stat_md_;
+        if (stats_are_src() && is_stat_index(index)) return &stat_md_;
         return &glob_zero_md;
     }
 
     const memory_desc_t *dst_md(int index = 0) const override {
-        if (index == 0) return &data_md_;
-        if (!stats_are_src() && is_training() && (index == 1 || index == 2))
+        if (index == 0) return &dst_md_;
+        if (!stats_are_src() && is_training() && is_stat_index(index))
             return &stat_md_;
         return &glob_zero_md;
     }
@@ -181,20 +184,35 @@ struct layer_normalization_fwd_pd_t : public layer_normalization_pd_t {
     }
 
     int n_inputs() const override {
-        return 1 + 2 * stats_are_src() + use_scaleshift() + use_scale()
+        return 1 + n_stats() * stats_are_src() + use_scaleshift() + use_scale()
                 + use_shift();
     }
     int n_outputs() const override {
-        return 1 + 2 * (!stats_are_src()) * is_training();
+        return 1 + n_stats() * (!stats_are_src()) * is_training();
     }
 
 protected:
+    memory_desc_t dst_md_;
+
+    // the mean (index 1) is not used by the RMS normalization
+    int n_stats() const { return use_rms_norm() ? 1 : 2; }
+    bool is_stat_index(int index) const {
+        return (index == 1 && !use_rms_norm()) || index == 2;
+    }
+
     layer_normalization_fwd_pd_t(const layer_normalization_desc_t *adesc,
             const primitive_attr_t *attr,
             const layer_normalization_fwd_pd_t *hint_fwd_pd)
-        : layer_normalization_pd_t(adesc, attr, hint_fwd_pd) {}
+        : layer_normalization_pd_t(adesc, attr, hint_fwd_pd)
+        , dst_md_(desc_.dst_desc) {}
 
     bool set_default_formats_common() {
+        // the destination follows the layout of the source by default
+        if (dst_md_.format_kind == format_kind::any
+                && memory_desc_init_by_blocking_desc(
+                           dst_md_, data_md_.format_desc.blocking)
+                        != status::success)
+            return false;
         return set_default_stat_md_format(data_md_);
     }
 
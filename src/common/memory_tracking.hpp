@@ -166,6 +166,7 @@ enum {
     key_brgemm_primitive_buffer_comp,
     key_brgemm_primitive_zp_comp_a,
     key_brgemm_primitive_zp_comp_b,
+    key_brgemm_primitive_src_quant_scales,
     key_concat_iptrs,
     key_concat_istrides,
     key_concat_nelems,
@@ -262,6 +263,9 @@ enum {
     key_rnn_ptrs_wei_layer,
     key_rnn_ptrs_wei_iter,
     key_rnn_ptrs_wei_projection,
+    key_rnn_packed_wei_layer,
+    key_rnn_packed_wei_iter,
+    key_rnn_packed_wei_projection,
     key_softmax_reduction,
     key_softmax_interim_store,
     key_sum_reduction,
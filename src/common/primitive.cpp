@@ -14,11 +14,16 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <atomic>
+#include <mutex>
 #include <string>
+#include <unordered_set>
+#include <vector>
 
 #include <assert.h>
 
 #include "c_types_map.hpp"
+#include "dnnl_thread.hpp"
 #include "engine.hpp"
 
 #if defined(DNNL_ENABLE_ITT_TASKS)
@@ -58,6 +63,18 @@ void unpoison_outputs(const exec_args_t &args) {
 namespace dnnl {
 namespace impl {
 
+void primitive_t::init_footprint(
+        engine_t *engine, size_t object_size, size_t code_size) {
+    // GPU kernels are not accounted as generated code, the size of their
+    // binaries is used instead.
+    size_t binary_size = 0;
+    if (engine->kind() == engine_kind::gpu
+            && get_cache_blob_size(&binary_size) != status::success)
+        binary_size = 0;
+    footprint_ = object_size + code_size + binary_size
+            + get_owned_memory_size();
+}
+
 nested_scratchpad_t::nested_scratchpad_t(const exec_ctx_t &master_ctx, int key,
         const std::shared_ptr<primitive_t> &nested_p) {
     auto scratchpad = master_ctx.get_scratchpad_grantor();
@@ -111,6 +128,79 @@ status_t primitive_create(primitive_iface_t **primitive_iface,
     return safe_ptr_assign((*primitive_iface), p_iface.first);
 }
 
+status_t primitives_create(primitive_iface_t **primitive_ifaces, size_t n,
+        const primitive_desc_iface_t *const *primitive_desc_ifaces) {
+    // The implementations are created concurrently and put into the primitive
+    // cache. The primitives are then created sequentially from the cache
+    // since a global scratchpad can't be shared between threads. The batch is
+    // split into chunks that fit the cache to avoid evicting the
+    // implementations before they are used.
+    const size_t capacity = (size_t)primitive_cache().get_capacity();
+    const size_t chunk = capacity > 0 ? capacity : n;
+    const int max_nthr = dnnl_get_max_threads();
+
+    status_t status = success;
+    for (size_t start = 0; start < n && status == success; start += chunk) {
+        const size_t end = nstl::min(start + chunk, n);
+
+        // The cache keys depend on the number of threads, hence they are
+        // computed on the calling thread. Identical keys are created once:
+        // a worker never waits for an implementation created by another one,
+        // which could be suspended on the same stack by the runtime.
+        std::vector<size_t> unique;
+        std::unordered_set<primitive_hashing::key_t> keys;
+        for (size_t i = start; i < end; i++) {
+            const auto *pd_iface = primitive_desc_ifaces[i];
+            max_threads_guard_t max_threads_guard(
+                    pd_iface->impl()->attr()->max_threads_);
+            if (keys.emplace(pd_iface->impl().get(), pd_iface->engine())
+                            .second)
+                unique.push_back(i);
+        }
+
+        std::vector<std::shared_ptr<primitive_t>> impls(unique.size());
+        const size_t nthr = nstl::min((size_t)max_nthr, unique.size());
+        if (capacity > 0 && nthr > 1) {
+            // Creation time varies a lot between the implementations hence
+            // the work is distributed dynamically.
+            std::atomic<size_t> next(0);
+            parallel((int)nthr, [&](int, int) {
+                // Create the implementations as the calling thread would.
+                default_max_threads_guard_t max_threads_guard(max_nthr);
+                for (size_t u = next++; u < unique.size(); u = next++) {
+                    const auto *pd_iface = primitive_desc_ifaces[unique[u]];
+                    std::pair<std::shared_ptr<primitive_t>, bool> p;
+                    auto create = [&]() {
+                        return pd_iface->impl()->create_primitive(
+                                p, pd_iface->engine(), cache_blob_t());
+                    };
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_TBB
+                    // Don't let nested parallel regions of the creation take
+                    // the other creations on the same stack.
+                    const status_t st = tbb::this_task_arena::isolate(create);
+#else
+                    const status_t st = create();
+#endif
+                    // An error is reported by the primitive creation below.
+                    if (st == success) impls[u] = p.first;
+                }
+            });
+        }
+
+        for (size_t i = start; i < end && status == success; i++)
+            status = primitive_create(
+                    &primitive_ifaces[i], primitive_desc_ifaces[i]);
+    }
+
+    if (status != success) {
+        for (size_t i = 0; i < n; i++) {
+            if (primitive_ifaces[i]) primitive_ifaces[i]->release();
+            primitive_ifaces[i] = nullptr;
+        }
+    }
+    return status;
+}
+
 status_t primitive_execute(
         const primitive_iface_t *primitive_iface, exec_ctx_t &ctx) {
     auto stream = ctx.stream();
@@ -118,6 +208,15 @@ status_t primitive_execute(
 
     stream->before_exec_hook();
 
+    // CPU primitives executed on the stream use dynamic scheduling if the
+    // stream requests it.
+    const bool dynamic_scheduling = get_dynamic_scheduling()
+            || (stream->engine()->kind() == engine_kind::cpu
+                    && (stream->flags() & stream_flags::dynamic_scheduling));
+    dynamic_scheduling_guard_t scheduling_guard(dynamic_scheduling);
+    max_threads_guard_t max_threads_guard(
+            primitive_iface->pd()->attr()->max_threads_);
+
 #if defined(DNNL_ENABLE_ITT_TASKS)
     const bool enable_itt = itt::get_itt(itt::__itt_task_level_low);
     if (enable_itt)
@@ -180,6 +279,19 @@ status_t dnnl_primitive_create(primitive_iface_t **primitive_iface,
     return dnnl::impl::primitive_create(primitive_iface, primitive_desc_iface);
 }
 
+status_t dnnl_primitives_create(primitive_iface_t **primitive_ifaces, size_t n,
+        const primitive_desc_iface_t *const *primitive_desc_ifaces) {
+    if (n == 0) return success;
+    if (utils::any_null(primitive_ifaces, primitive_desc_ifaces))
+        return invalid_arguments;
+    for (size_t i = 0; i < n; i++) {
+        if (primitive_desc_ifaces[i] == nullptr) return invalid_arguments;
+        primitive_ifaces[i] = nullptr;
+    }
+    return dnnl::impl::primitives_create(
+            primitive_ifaces, n, primitive_desc_ifaces);
+}
+
 status_t dnnl_primitive_create_from_cache_blob(
         primitive_iface_t **primitive_iface,
         const primitive_desc_iface_t *primitive_desc_iface, size_t size,
@@ -188,13 +300,9 @@ status_t dnnl_primitive_create_from_cache_blob(
             || size == 0) {
         return invalid_arguments;
     }
-    const auto ekind = primitive_desc_iface->engine()->kind();
-    const auto runtime_kind = primitive_desc_iface->engine()->runtime_kind();
-    if (ekind != engine_kind::gpu
-            || (ekind == engine_kind::gpu
-                    && runtime_kind != runtime_kind::ocl)) {
+    if (!is_cache_blob_supported(primitive_desc_iface->engine(),
+                primitive_desc_iface->impl().get()))
         return status::unimplemented;
-    }
 
     cache_blob_t cb(const_cast<uint8_t *>(cache_blob), size);
     return dnnl::impl::primitive_create(
@@ -241,13 +349,9 @@ status_t dnnl_primitive_get_cache_blob(const primitive_iface_t *primitive_iface,
         return status::invalid_arguments;
     }
 
-    const auto ekind = primitive_iface->engine()->kind();
-    const auto runtime_kind = primitive_iface->engine()->runtime_kind();
-    if (ekind != engine_kind::gpu
-            || (ekind == engine_kind::gpu
-                    && runtime_kind != runtime_kind::ocl)) {
+    if (!is_cache_blob_supported(
+                primitive_iface->engine(), primitive_iface->pd()->impl().get()))
         return status::unimplemented;
-    }
 
     if (!cache_blob) {
         size_t sz = 0;
@@ -331,14 +435,30 @@ status_t dnnl_primitive::execute(exec_ctx_t &ctx) const {
     const memory_storage_t *mem_storage = nullptr;
     if (primitive_->pd()->attr()->scratchpad_mode_ == scratchpad_mode::user) {
         memory_t *scratchpad_memory = ctx.output(DNNL_ARG_SCRATCHPAD);
+        const size_t scratchpad_size
+                = primitive_->pd()->scratchpad_size(scratchpad_mode::user);
+        scratchpad_arena_t *arena = ctx.stream()
+                ? ctx.stream()->scratchpad_arena()
+                : nullptr;
+        if (!scratchpad_memory && scratchpad_size > 0 && arena) {
+            // The scratchpad is not passed, take it from the stream arena.
+            std::lock_guard<std::mutex> lock(arena->mutex());
+            CHECK(arena->get_memory_storage(scratchpad_size, &mem_storage));
+            return execute(ctx, mem_storage);
+        }
         mem_storage = scratchpad_memory ? scratchpad_memory->memory_storage()
                                         : nullptr;
     } else if (scratchpad_) {
         mem_storage = scratchpad_->get_memory_storage();
     }
 
-    auto scratchpad_grantor
-            = primitive_->pd()->scratchpad_registry().grantor(mem_storage, ctx);
+    return execute(ctx, mem_storage);
+}
+
+status_t dnnl_primitive::execute(
+        exec_ctx_t &ctx, const memory_storage_t *scratchpad_storage) const {
+    auto scratchpad_grantor = primitive_->pd()->scratchpad_registry().grantor(
+            scratchpad_storage, ctx);
     ctx.set_scratchpad_grantor(&scratchpad_grantor);
     ctx.set_resource_mapper(&resource_mapper_);
 
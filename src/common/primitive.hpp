@@ -24,9 +24,11 @@
 
 #include "c_types_map.hpp"
 #include "cache_blob.hpp"
+#include "dnnl_thread.hpp"
 #include "memory_storage.hpp"
 #include "memory_tracking.hpp"
 #include "primitive_desc.hpp"
+#include "primitive_disk_cache.hpp"
 #include "primitive_exec_types.hpp"
 #include "rw_mutex.hpp"
 #include "scratchpad.hpp"
@@ -62,15 +64,15 @@ struct primitive_t : public c_compatible {
     primitive_kind_t kind() const { return pd_->kind(); }
     virtual status_t execute(const exec_ctx_t &ctx) const = 0;
 
+    // Not every CPU implementation can be stored in a cache blob, those that
+    // can't report `unimplemented`.
     virtual status_t get_cache_blob(
             engine_t *engine, cache_blob_t &cache_blob) const {
-        assert(!"unexpected");
-        return status::runtime_error;
+        return status::unimplemented;
     }
 
     virtual status_t get_cache_blob_size(size_t *size) const {
-        assert(!"unexpected");
-        return status::runtime_error;
+        return status::unimplemented;
     }
 
     virtual status_t create_resource(
@@ -95,9 +97,19 @@ struct primitive_t : public c_compatible {
         return status::success;
     }
 
+    // Returns the size of the memory owned by the primitive implementation,
+    // e.g. pre-packed data, that is not accounted as part of the kernels.
+    virtual size_t get_owned_memory_size() const { return 0; }
+
     bool use_global_scratchpad() const { return use_global_scratchpad_; }
     cache_blob_t cache_blob() const { return cache_blob_; }
 
+    // Returns an estimate of the memory occupied by the primitive in bytes:
+    // the primitive and its descriptor, the kernels created along with the
+    // primitive and the memory the primitive owns. The primitive cache uses
+    // it to bound the memory consumed by the cached primitives.
+    size_t get_footprint() const { return footprint_; }
+
 protected:
     template <typename impl_type, typename pd_t>
     static status_t create_primitive_common(
@@ -105,6 +117,7 @@ protected:
             const pd_t *pd, engine_t *engine, bool use_global_scratchpad,
             const cache_blob_t &cache_blob) {
 
+        max_threads_guard_t max_threads_guard(pd->attr()->max_threads_);
         auto &global_primitive_cache = primitive_cache();
         primitive_hashing::key_t key(pd, engine);
 
@@ -131,7 +144,15 @@ protected:
             // we have to create it and notify the waiting threads
             // once the creation is done.
             p = std::make_shared<impl_type>(pd);
-            status = p->init(engine, use_global_scratchpad, cache_blob);
+            const size_t code_size_before = get_thread_code_size();
+            // Fall back to the on-disk tier of the cache if it's enabled and
+            // the user didn't provide a cache blob.
+            const auto &disk_cache = primitive_disk_cache();
+            if (!cache_blob && disk_cache.is_enabled())
+                status = disk_cache.init_primitive(
+                        p.get(), engine, use_global_scratchpad);
+            else
+                status = p->init(engine, use_global_scratchpad, cache_blob);
             if (status != status::success) {
                 // Communicate an error.
                 p_promise.set_value({nullptr, status});
@@ -141,6 +162,9 @@ protected:
                 global_primitive_cache.remove_if_invalidated(key);
                 return status;
             } else {
+                p->init_footprint(engine, sizeof(impl_type) + sizeof(pd_t),
+                        get_thread_code_size() - code_size_before);
+
                 // Store the created primitive in the shared future and notify
                 // the waiting threads.
                 p_promise.set_value({p, status});
@@ -166,6 +190,11 @@ protected:
     cache_blob_t cache_blob_;
 
 private:
+    void init_footprint(
+            engine_t *engine, size_t object_size, size_t code_size);
+
+    size_t footprint_ = 0;
+
     primitive_t() = delete;
     DNNL_DISALLOW_COPY_AND_ASSIGN(primitive_t);
 };
@@ -315,6 +344,10 @@ private:
     std::unique_ptr<primitive_desc_iface_t> pd_;
     dnnl::impl::resource_mapper_t resource_mapper_;
 
+    // Executes the primitive using the given scratchpad memory storage.
+    dnnl::impl::status_t execute(dnnl::impl::exec_ctx_t &ctx,
+            const dnnl::impl::memory_storage_t *scratchpad_storage) const;
+
     dnnl_primitive() = delete;
     DNNL_DISALLOW_COPY_AND_ASSIGN(dnnl_primitive);
 };
@@ -89,9 +89,7 @@ status_t zero_points_t::set(
     const bool supported_arg
             = utils::one_of(arg, DNNL_ARG_SRC, DNNL_ARG_WEIGHTS, DNNL_ARG_DST);
     const bool ok = count == 1
-            && IMPLICATION(mask != 0,
-                    utils::one_of(arg, DNNL_ARG_SRC, DNNL_ARG_DST)
-                            && zero_points[0] == DNNL_RUNTIME_S32_VAL)
+            && IMPLICATION(mask != 0, zero_points[0] == DNNL_RUNTIME_S32_VAL)
             && IMPLICATION(!supported_arg, *zero_points == 0);
     if (!ok) return status::unimplemented;
 
@@ -370,6 +368,20 @@ status_t primitive_attr_t::set_scratchpad_mode(
     return success;
 }
 
+status_t primitive_attr_t::set_max_threads(int max_threads) {
+    if (max_threads < 0) return invalid_arguments;
+
+    max_threads_ = max_threads;
+    return success;
+}
+
+status_t primitive_attr_t::set_weights_group_size(dim_t group_size) {
+    if (group_size <= 0) return invalid_arguments;
+
+    weights_group_size_ = group_size;
+    return success;
+}
+
 status_t primitive_attr_t::set_post_ops(const post_ops_t &post_ops) {
     return post_ops_.copy_from(post_ops);
 }
@@ -431,6 +443,55 @@ status_t dnnl_primitive_attr_set_scratchpad_mode(
     return attr->set_scratchpad_mode(scratchpad_mode);
 }
 
+status_t dnnl_primitive_attr_get_max_threads(
+        const primitive_attr_t *attr, int *max_threads) {
+    if (any_null(attr, max_threads)) return invalid_arguments;
+
+    *max_threads = attr->max_threads_;
+
+    return success;
+}
+
+status_t dnnl_primitive_attr_set_max_threads(
+        primitive_attr_t *attr, int max_threads) {
+    if (any_null(attr)) return invalid_arguments;
+
+    return attr->set_max_threads(max_threads);
+}
+
+status_t dnnl_primitive_attr_get_weights_group_size(
+        const primitive_attr_t *attr, dim_t *group_size) {
+    if (any_null(attr, group_size)) return invalid_arguments;
+
+    *group_size = attr->weights_group_size_;
+
+    return success;
+}
+
+status_t dnnl_primitive_attr_set_weights_group_size(
+        primitive_attr_t *attr, dim_t group_size) {
+    if (any_null(attr)) return invalid_arguments;
+
+    return attr->set_weights_group_size(group_size);
+}
+
+status_t dnnl_primitive_attr_get_src_dynamic_quantization(
+        const primitive_attr_t *attr, int *enable) {
+    if (any_null(attr, enable)) return invalid_arguments;
+
+    *enable = attr->src_dynamic_quantization_;
+
+    return success;
+}
+
+status_t dnnl_primitive_attr_set_src_dynamic_quantization(
+        primitive_attr_t *attr, int enable) {
+    if (any_null(attr)) return invalid_arguments;
+
+    attr->src_dynamic_quantization_ = enable != 0;
+    return success;
+}
+
 status_t dnnl_primitive_attr_get_output_scales(const primitive_attr_t *attr,
         dim_t *count, int *mask, const float **scales) {
     if (any_null(attr, count, mask, scales)) return invalid_arguments;
@@ -241,7 +241,10 @@ struct arg_scales_t : public c_compatible {
         switch (arg) {
             case DNNL_ARG_SRC_0: return 0;
             case DNNL_ARG_SRC_1: return 1;
-            default: assert(!"unsupported arg");
+            default:
+                if (is_multiple_src_arg(arg))
+                    return arg - DNNL_ARG_MULTIPLE_SRC;
+                assert(!"unsupported arg");
         }
         return -1;
     }
@@ -250,10 +253,16 @@ struct arg_scales_t : public c_compatible {
 
 private:
     bool check_arg(int arg) const {
-        for (const auto &sa : {DNNL_ARG_SRC_0, DNNL_ARG_SRC_1}) {
+        for (const auto &sa :
+                {DNNL_ARG_SRC_0, DNNL_ARG_SRC_1, DNNL_ARG_WEIGHTS}) {
             if (arg == sa) return true;
         }
-        return false;
+        // concat
+        return is_multiple_src_arg(arg);
+    }
+
+    static bool is_multiple_src_arg(int arg) {
+        return arg >= DNNL_ARG_MULTIPLE_SRC && arg < DNNL_ARG_MULTIPLE_DST;
     }
 };
 
@@ -596,7 +605,10 @@ struct dnnl_post_ops : public dnnl::impl::c_compatible {
 struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
     dnnl_primitive_attr()
         : scratchpad_mode_(dnnl::impl::scratchpad_mode::library)
-        , fpmath_mode_(dnnl::impl::get_fpmath_mode()) {}
+        , fpmath_mode_(dnnl::impl::get_fpmath_mode())
+        , max_threads_(0)
+        , weights_group_size_(1)
+        , src_dynamic_quantization_(false) {}
 
     dnnl_primitive_attr *clone() const {
         return new dnnl_primitive_attr(*this);
@@ -615,6 +627,9 @@ struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
         zero_points_ = other.zero_points_;
         scratchpad_mode_ = other.scratchpad_mode_;
         fpmath_mode_ = other.fpmath_mode_;
+        max_threads_ = other.max_threads_;
+        weights_group_size_ = other.weights_group_size_;
+        src_dynamic_quantization_ = other.src_dynamic_quantization_;
         CHECK(post_ops_.copy_from(other.post_ops_));
         rnn_data_qparams_ = other.rnn_data_qparams_;
         CHECK(rnn_weights_qparams_.copy_from(other.rnn_weights_qparams_));
@@ -645,7 +660,8 @@ struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
 
     /** Returns true if the attributes have default values.
      *
-     * @note The scratchpad_mode_ is not take into account */
+     * @note The scratchpad_mode_, max_threads_, weights_group_size_ and
+     * src_dynamic_quantization_ are not take into account */
     bool has_default_values(skip_mask_t mask = skip_mask_t::none,
             dnnl::impl::data_type_t dst_dt = dnnl_data_type_undef) const;
 
@@ -655,6 +671,9 @@ struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
     bool operator==(const dnnl_primitive_attr &rhs) const {
         bool ret = scratchpad_mode_ == rhs.scratchpad_mode_
                 && fpmath_mode_ == rhs.fpmath_mode_
+                && max_threads_ == rhs.max_threads_
+                && weights_group_size_ == rhs.weights_group_size_
+                && src_dynamic_quantization_ == rhs.src_dynamic_quantization_
                 && output_scales_ == rhs.output_scales_
                 && scales_ == rhs.scales_ && zero_points_ == rhs.zero_points_
                 && post_ops_ == rhs.post_ops_
@@ -669,6 +688,8 @@ struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
     dnnl::impl::status_t set_fpmath_mode(dnnl::impl::fpmath_mode_t fpmath_mode);
     dnnl::impl::status_t set_scratchpad_mode(
             dnnl::impl::scratchpad_mode_t scratchpad_mode);
+    dnnl::impl::status_t set_max_threads(int max_threads);
+    dnnl::impl::status_t set_weights_group_size(dnnl::impl::dim_t group_size);
     dnnl::impl::status_t set_post_ops(const dnnl::impl::post_ops_t &post_ops);
     dnnl::impl::status_t set_default_formats(
             const dnnl::impl::memory_desc_t *dst_md);
@@ -699,6 +720,14 @@ struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
     dnnl::impl::zero_points_t zero_points_;
     dnnl::impl::scratchpad_mode_t scratchpad_mode_;
     dnnl::impl::fpmath_mode_t fpmath_mode_;
+    // The maximum number of threads, 0 means the number of threads is
+    // defined by the threading runtime.
+    int max_threads_;
+    // The number of consecutive elements along the weights reduction
+    // dimension sharing a single scale and zero point.
+    dnnl::impl::dim_t weights_group_size_;
+    // Whether the f32 / bf16 source may be quantized to s8 at runtime.
+    bool src_dynamic_quantization_;
     dnnl::impl::post_ops_t post_ops_;
     dnnl::impl::rnn_data_qparams_t rnn_data_qparams_;
     dnnl::impl::scales_t rnn_weights_qparams_;
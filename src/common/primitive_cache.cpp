@@ -28,6 +28,7 @@
 #endif
 
 #include <algorithm>
+#include <cstdlib>
 #include <unordered_map>
 
 #ifdef _WIN32
@@ -47,16 +48,49 @@ size_t get_timestamp() {
 #endif
 }
 
+size_t get_footprint_limit_from_env() {
+    // # of digits in the longest 64-bit unsigned int + terminating null
+    const int len = 21;
+    char value_str[len];
+    for (const auto &prefix : {"ONEDNN_", "DNNL_"}) {
+        std::string name_str
+                = std::string(prefix) + "PRIMITIVE_CACHE_FOOTPRINT_LIMIT";
+        if (getenv(name_str.c_str(), value_str, len) > 0)
+            return (size_t)std::strtoull(value_str, nullptr, 10);
+    }
+    return 0;
+}
+
+thread_local size_t thread_code_size = 0;
+
 } // namespace
 
+void add_thread_code_size(size_t size) {
+    thread_code_size += size;
+}
+
+size_t get_thread_code_size() {
+    return thread_code_size;
+}
+
 primitive_cache_t &primitive_cache() {
 #ifndef DNNL_DISABLE_PRIMITIVE_CACHE
     static const int capacity
             = getenv_int_user("PRIMITIVE_CACHE_CAPACITY", 1024);
+    static const size_t footprint_limit = get_footprint_limit_from_env();
 #else
     static const int capacity = 0;
+    static const size_t footprint_limit = 0;
+#endif
+#ifndef DNNL_DISABLE_PRIMITIVE_CACHE
+    static const int nshards = getenv_int_user("PRIMITIVE_CACHE_SHARDS", 1);
+    if (nshards > 1) {
+        static sharded_primitive_cache_t cache(
+                capacity, nshards, footprint_limit);
+        return cache;
+    }
 #endif
-    static lru_primitive_cache_t cache(capacity);
+    static lru_primitive_cache_t cache(capacity, footprint_limit);
     return cache;
 }
 
@@ -82,9 +116,12 @@ bool is_primitive_in_cache(const primitive_iface_t *p_iface) {
 }
 
 size_t set_primitive_cache_capacity_without_clearing(size_t capacity) {
-    size_t old_capacity = primitive_cache().get_capacity();
-    static_cast<lru_primitive_cache_t &>((primitive_cache())).capacity_
-            = capacity;
+    return primitive_cache().set_capacity_without_clearing(capacity);
+}
+
+size_t lru_primitive_cache_t::set_capacity_without_clearing(size_t capacity) {
+    size_t old_capacity = get_capacity();
+    capacity_ = capacity;
     return old_capacity;
 }
 
@@ -111,6 +148,23 @@ int lru_primitive_cache_t::get_size() const {
     return (int)cache_mapper().size();
 }
 
+status_t lru_primitive_cache_t::set_footprint_limit(size_t limit) {
+    utils::lock_write_t lock_w(rw_mutex());
+    footprint_limit_ = limit;
+    evict_to_footprint_limit();
+    return status::success;
+}
+
+size_t lru_primitive_cache_t::get_footprint_limit() const {
+    utils::lock_read_t lock_r(rw_mutex());
+    return footprint_limit_;
+}
+
+size_t lru_primitive_cache_t::get_footprint() const {
+    utils::lock_read_t lock_r(rw_mutex());
+    return footprint_;
+}
+
 lru_primitive_cache_t::value_t lru_primitive_cache_t::get_or_add(
         const key_t &key, const value_t &value) {
     // 1. Section with shared access (read lock)
@@ -248,6 +302,20 @@ void lru_primitive_cache_t::update_entry(
     // Update key in cache_mapper()
     it->first.op_desc_ = op_desc;
     it->first.attr_ = attr;
+
+    // The entry is updated once the primitive is created, hence its footprint
+    // is known at this point.
+    auto &entry = it->second;
+    footprint_ -= entry.footprint_;
+    entry.footprint_ = entry.value_.get().primitive->get_footprint();
+    if (footprint_limit_ != 0 && entry.footprint_ > footprint_limit_) {
+        // The primitive doesn't fit the cache even when it's empty, keeping
+        // it would only evict all the other entries.
+        cache_mapper().erase(it);
+    } else {
+        footprint_ += entry.footprint_;
+        evict_to_footprint_limit();
+    }
     unlock_write();
 }
 
@@ -257,6 +325,7 @@ void lru_primitive_cache_t::evict(size_t n) {
 
     if (n == capacity_) {
         cache_mapper().clear();
+        footprint_ = 0;
         return;
     }
 
@@ -280,12 +349,36 @@ void lru_primitive_cache_t::evict(size_t n) {
                             < right.second.timestamp_.load(
                                     std::memory_order_relaxed);
                 });
+        footprint_ -= it->second.footprint_;
         auto res = cache_mapper().erase(it->first);
         MAYBE_UNUSED(res);
         assert(res);
     }
 }
 
+// Evicts the least recently used entries until the footprint of the cache fits
+// the limit
+void lru_primitive_cache_t::evict_to_footprint_limit() {
+    while (footprint_limit_ != 0 && footprint_ > footprint_limit_) {
+        // The entries of the primitives being created have no footprint yet,
+        // evicting them frees nothing.
+        auto lru = cache_mapper().end();
+        for (auto it = cache_mapper().begin(); it != cache_mapper().end();
+                ++it) {
+            if (it->second.footprint_ == 0) continue;
+            if (lru == cache_mapper().end()
+                    || it->second.timestamp_.load(std::memory_order_relaxed)
+                            < lru->second.timestamp_.load(
+                                    std::memory_order_relaxed))
+                lru = it;
+        }
+        if (lru == cache_mapper().end()) break;
+
+        footprint_ -= lru->second.footprint_;
+        cache_mapper().erase(lru);
+    }
+}
+
 lru_primitive_cache_t::~lru_primitive_cache_t() {
     if (cache_mapper().empty()) return;
 
@@ -360,6 +453,121 @@ lru_primitive_cache_t::~lru_primitive_cache_t() {
 #endif /* DNNL_USE_RT_OBJECTS_IN_PRIMITIVE_CACHE */
 }
 
+sharded_primitive_cache_t::sharded_primitive_cache_t(
+        int capacity, int nshards, size_t footprint_limit)
+    : nshards_active_(1), footprint_limit_(footprint_limit) {
+    shards_.resize(nshards);
+    nshards_active_ = get_nshards_active(capacity);
+    for (int i = 0; i < nshards; i++)
+        shards_[i] = utils::make_unique<lru_primitive_cache_t>(
+                get_shard_capacity(capacity, i),
+                get_shard_footprint_limit(footprint_limit, i));
+}
+
+lru_primitive_cache_t &sharded_primitive_cache_t::shard(
+        const key_t &key) const {
+    const size_t hash = std::hash<key_t>()(key);
+    // Mix the upper bits in since the lower ones are used by the shard's
+    // hash table.
+    return *shards_[(hash ^ (hash >> 32)) % (size_t)nshards_active_.load()];
+}
+
+int sharded_primitive_cache_t::get_nshards_active(int capacity) const {
+    return nstl::max(1, nstl::min((int)shards_.size(), capacity));
+}
+
+int sharded_primitive_cache_t::get_shard_capacity(
+        int capacity, int ishard) const {
+    const int nshards = get_nshards_active(capacity);
+    if (ishard >= nshards) return 0;
+    return capacity / nshards + (ishard < capacity % nshards);
+}
+
+size_t sharded_primitive_cache_t::get_shard_footprint_limit(
+        size_t limit, int ishard) const {
+    if (limit == 0) return 0;
+    const size_t nshards = (size_t)nshards_active_.load();
+    // Unused shards hold no entries.
+    if ((size_t)ishard >= nshards) return 0;
+    // A shard limit must not become 0 as it means no limit.
+    return nstl::max(
+            (size_t)1, limit / nshards + ((size_t)ishard < limit % nshards));
+}
+
+status_t sharded_primitive_cache_t::set_capacity(int capacity) {
+    // Entries of the shards that become unused are evicted along with the
+    // shrunk ones, and the footprint limit is split between the used shards.
+    nshards_active_ = get_nshards_active(capacity);
+    for (size_t i = 0; i < shards_.size(); i++) {
+        CHECK(shards_[i]->set_capacity(get_shard_capacity(capacity, (int)i)));
+        CHECK(shards_[i]->set_footprint_limit(
+                get_shard_footprint_limit(footprint_limit_, (int)i)));
+    }
+    return status::success;
+}
+
+int sharded_primitive_cache_t::get_capacity() const {
+    int capacity = 0;
+    for (const auto &s : shards_)
+        capacity += s->get_capacity();
+    return capacity;
+}
+
+int sharded_primitive_cache_t::get_size() const {
+    int size = 0;
+    for (const auto &s : shards_)
+        size += s->get_size();
+    return size;
+}
+
+status_t sharded_primitive_cache_t::set_footprint_limit(size_t limit) {
+    footprint_limit_ = limit;
+    for (size_t i = 0; i < shards_.size(); i++)
+        CHECK(shards_[i]->set_footprint_limit(
+                get_shard_footprint_limit(limit, (int)i)));
+    return status::success;
+}
+
+size_t sharded_primitive_cache_t::get_footprint_limit() const {
+    return footprint_limit_;
+}
+
+size_t sharded_primitive_cache_t::get_footprint() const {
+    size_t footprint = 0;
+    for (const auto &s : shards_)
+        footprint += s->get_footprint();
+    return footprint;
+}
+
+sharded_primitive_cache_t::value_t sharded_primitive_cache_t::get_or_add(
+        const key_t &key, const value_t &value) {
+    return shard(key).get_or_add(key, value);
+}
+
+void sharded_primitive_cache_t::remove_if_invalidated(const key_t &key) {
+    shard(key).remove_if_invalidated(key);
+}
+
+void sharded_primitive_cache_t::update_entry(
+        const key_t &key, const primitive_desc_t *pd) {
+    shard(key).update_entry(key, pd);
+}
+
+std::shared_ptr<primitive_desc_t> sharded_primitive_cache_t::get_pd(
+        const key_t &key) {
+    return shard(key).get_pd(key);
+}
+
+size_t sharded_primitive_cache_t::set_capacity_without_clearing(
+        size_t capacity) {
+    size_t old_capacity = get_capacity();
+    nshards_active_ = get_nshards_active((int)capacity);
+    for (size_t i = 0; i < shards_.size(); i++)
+        shards_[i]->set_capacity_without_clearing(
+                get_shard_capacity((int)capacity, (int)i));
+    return old_capacity;
+}
+
 } // namespace impl
 } // namespace dnnl
 
@@ -380,3 +588,29 @@ dnnl::impl::status_t dnnl_set_primitive_cache_capacity(int capacity) {
 #endif
     return dnnl::impl::status::success;
 }
+
+dnnl::impl::status_t dnnl_get_primitive_cache_footprint_limit(size_t *limit) {
+    if (limit == nullptr) return dnnl::impl::status::invalid_arguments;
+    *limit = 0;
+#ifndef DNNL_DISABLE_PRIMITIVE_CACHE
+    *limit = dnnl::impl::primitive_cache().get_footprint_limit();
+#endif
+    return dnnl::impl::status::success;
+}
+
+dnnl::impl::status_t dnnl_set_primitive_cache_footprint_limit(size_t limit) {
+#ifndef DNNL_DISABLE_PRIMITIVE_CACHE
+    return dnnl::impl::primitive_cache().set_footprint_limit(limit);
+#else
+    return dnnl::impl::status::success;
+#endif
+}
+
+dnnl::impl::status_t dnnl_get_primitive_cache_footprint(size_t *footprint) {
+    if (footprint == nullptr) return dnnl::impl::status::invalid_arguments;
+    *footprint = 0;
+#ifndef DNNL_DISABLE_PRIMITIVE_CACHE
+    *footprint = dnnl::impl::primitive_cache().get_footprint();
+#endif
+    return dnnl::impl::status::success;
+}
@@ -17,10 +17,12 @@
 #ifndef COMMON_PRIMITIVE_CACHE_HPP
 #define COMMON_PRIMITIVE_CACHE_HPP
 
+#include <atomic>
 #include <future>
 #include <memory>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "c_types_map.hpp"
 #include "oneapi/dnnl/dnnl.h"
@@ -51,23 +53,37 @@ struct primitive_cache_t : public c_compatible {
 
     virtual int get_size() const = 0;
 
+    // The footprint limit bounds the total footprint of the cached
+    // primitives in bytes in addition to the capacity. 0 means no limit.
+    virtual status_t set_footprint_limit(size_t limit) = 0;
+    virtual size_t get_footprint_limit() const = 0;
+    virtual size_t get_footprint() const = 0;
+
     virtual std::shared_ptr<primitive_desc_t> get_pd(const key_t &key) = 0;
 
 protected:
-    static utils::rw_mutex_t &rw_mutex() {
-        static utils::rw_mutex_t mutex;
-        return mutex;
-    }
+    utils::rw_mutex_t &rw_mutex() const { return rw_mutex_; }
 
     void lock_read() { rw_mutex().lock_read(); }
     void lock_write() { rw_mutex().lock_write(); }
     void unlock_read() { rw_mutex().unlock_read(); }
     void unlock_write() { rw_mutex().unlock_write(); }
+
+private:
+    // Used for testing.
+    virtual size_t set_capacity_without_clearing(size_t capacity) = 0;
+    friend size_t DNNL_API set_primitive_cache_capacity_without_clearing(
+            size_t capacity);
+
+    mutable utils::rw_mutex_t rw_mutex_;
 };
 
 // The cache uses LRU replacement policy
 struct lru_primitive_cache_t : public primitive_cache_t {
-    lru_primitive_cache_t(int capacity) : capacity_(capacity) {
+    lru_primitive_cache_t(int capacity, size_t footprint_limit = 0)
+        : capacity_(capacity)
+        , footprint_limit_(footprint_limit)
+        , footprint_(0) {
         cache_mapper_ = utils::make_unique<
                 std::unordered_map<key_t, timed_entry_t>>();
     }
@@ -83,19 +99,30 @@ struct lru_primitive_cache_t : public primitive_cache_t {
 
     int get_size() const override;
 
+    status_t set_footprint_limit(size_t limit) override;
+    size_t get_footprint_limit() const override;
+    size_t get_footprint() const override;
+
     std::shared_ptr<primitive_desc_t> get_pd(const key_t &key) override;
 
 private:
     void evict(size_t n);
+    void evict_to_footprint_limit();
     void add(const key_t &key, const value_t &value);
     value_t get(const key_t &key);
 
+    size_t set_capacity_without_clearing(size_t capacity) override;
+
     size_t capacity_;
+    size_t footprint_limit_;
+    size_t footprint_;
     struct timed_entry_t {
         value_t value_;
         std::atomic<size_t> timestamp_;
+        // The footprint is known only once the primitive is created.
+        size_t footprint_;
         timed_entry_t(const value_t &value, size_t timestamp)
-            : value_(value), timestamp_(timestamp) {}
+            : value_(value), timestamp_(timestamp), footprint_(0) {}
     };
 
     std::unordered_map<key_t, timed_entry_t> &cache_mapper() {
@@ -112,13 +139,60 @@ private:
     // is deleted.
     std::unique_ptr<std::unordered_map<key_t, timed_entry_t>> cache_mapper_;
 
-    // Used for testing.
-    friend size_t DNNL_API set_primitive_cache_capacity_without_clearing(
-            size_t capacity);
+    friend struct sharded_primitive_cache_t;
+};
+
+// The cache consists of a number of independent LRU caches (shards), each with
+// its own lock. An entry is placed into the shard chosen by the hash of its
+// key. Threads that create or look up different primitives most likely
+// access different shards and hence do not contend for the same lock.
+//
+// The capacity is split evenly between the shards, and the least recently
+// used entries are evicted within a shard. Hence the replacement policy is
+// an approximation of LRU for the whole cache. When the capacity is lower than
+// the number of shards, only `capacity` shards are used so that every entry
+// gets a slot.
+struct sharded_primitive_cache_t : public primitive_cache_t {
+    sharded_primitive_cache_t(
+            int capacity, int nshards, size_t footprint_limit = 0);
+
+    status_t set_capacity(int capacity) override;
+    int get_capacity() const override;
+
+    value_t get_or_add(const key_t &key, const value_t &value) override;
+    void remove_if_invalidated(const key_t &key) override;
+    void update_entry(const key_t &key, const primitive_desc_t *pd) override;
+
+    int get_size() const override;
+
+    status_t set_footprint_limit(size_t limit) override;
+    size_t get_footprint_limit() const override;
+    size_t get_footprint() const override;
+
+    std::shared_ptr<primitive_desc_t> get_pd(const key_t &key) override;
+
+private:
+    lru_primitive_cache_t &shard(const key_t &key) const;
+    // Returns the number of shards used for the `capacity`.
+    int get_nshards_active(int capacity) const;
+    int get_shard_capacity(int capacity, int ishard) const;
+    size_t get_shard_footprint_limit(size_t limit, int ishard) const;
+
+    size_t set_capacity_without_clearing(size_t capacity) override;
+
+    std::vector<std::unique_ptr<lru_primitive_cache_t>> shards_;
+    std::atomic<int> nshards_active_;
+    size_t footprint_limit_;
 };
 
 primitive_cache_t &primitive_cache();
 
+// Accounts the code of a kernel generated by the calling thread. The code
+// generated while a primitive is being created is a part of the primitive
+// footprint.
+void add_thread_code_size(size_t size);
+size_t get_thread_code_size();
+
 // Undocumented API for testing.
 status_t DNNL_API get_primitive_cache_size(int *size);
 bool DNNL_API is_primitive_in_cache(const primitive_iface_t *p_iface);
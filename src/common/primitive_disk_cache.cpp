@@ -0,0 +1,267 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+#ifdef _WIN32
+#include <process.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "common/cache_blob.hpp"
+#include "common/cache_blob_id.hpp"
+#include "common/primitive.hpp"
+#include "common/primitive_desc.hpp"
+#include "common/primitive_disk_cache.hpp"
+#include "common/utils.hpp"
+
+namespace dnnl {
+namespace impl {
+
+namespace {
+
+// An entry file layout: header_t | cache blob ID | cache blob.
+struct header_t {
+    char magic[8];
+    uint32_t format_version;
+    uint32_t reserved;
+    uint64_t id_size;
+    uint64_t blob_size;
+    // The checksum of the ID and the cache blob, protects against truncated
+    // or otherwise corrupted files.
+    uint64_t checksum;
+};
+
+constexpr char entry_magic[8] = {'O', 'N', 'E', 'D', 'N', 'N', 'P', 'C'};
+constexpr uint32_t entry_format_version = 2;
+
+// FNV-1a hash.
+constexpr uint64_t fnv1a_seed = 0xcbf29ce484222325ull;
+
+uint64_t fnv1a(const uint8_t *data, size_t size, uint64_t hash = fnv1a_seed) {
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+uint64_t get_checksum(const uint8_t *id, size_t id_size, const uint8_t *blob,
+        size_t blob_size) {
+    return fnv1a(blob, blob_size, fnv1a(id, id_size));
+}
+
+// A read-only view of an entry file. The file is memory mapped when possible
+// to avoid copying the cache blob.
+struct entry_view_t {
+    entry_view_t(const std::string &path) {
+#ifdef _WIN32
+        FILE *fp = fopen(path.c_str(), "rb");
+        if (!fp) return;
+        if (fseek(fp, 0, SEEK_END) == 0) {
+            const long size = ftell(fp);
+            if (size > 0 && fseek(fp, 0, SEEK_SET) == 0) {
+                buffer_.resize((size_t)size);
+                if (fread(buffer_.data(), 1, buffer_.size(), fp)
+                        != buffer_.size())
+                    buffer_.clear();
+            }
+        }
+        fclose(fp);
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+#else
+        const int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void *addr = mmap(nullptr, (size_t)st.st_size, PROT_READ,
+                    MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED) {
+                data_ = static_cast<const uint8_t *>(addr);
+                size_ = (size_t)st.st_size;
+            }
+        }
+        close(fd);
+#endif
+    }
+
+    ~entry_view_t() {
+#ifndef _WIN32
+        if (data_) munmap(const_cast<uint8_t *>(data_), size_);
+#endif
+    }
+
+    // Returns the cache blob if the entry is valid and corresponds to `id`.
+    bool get_blob(const std::vector<uint8_t> &id, const uint8_t **blob,
+            size_t *blob_size) const {
+        if (!data_ || size_ < sizeof(header_t)) return false;
+
+        header_t header;
+        std::memcpy(&header, data_, sizeof(header));
+        const bool ok = std::memcmp(header.magic, entry_magic,
+                                sizeof(entry_magic))
+                        == 0
+                && header.format_version == entry_format_version
+                && header.id_size == id.size() && header.blob_size > 0
+                && sizeof(header) + header.id_size + header.blob_size == size_
+                && std::memcmp(data_ + sizeof(header), id.data(), id.size())
+                        == 0;
+        if (!ok) return false;
+
+        const uint8_t *b = data_ + sizeof(header) + header.id_size;
+        if (get_checksum(id.data(), id.size(), b, header.blob_size)
+                != header.checksum)
+            return false;
+
+        *blob = b;
+        *blob_size = header.blob_size;
+        return true;
+    }
+
+    DNNL_DISALLOW_COPY_AND_ASSIGN(entry_view_t);
+
+private:
+    const uint8_t *data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    std::vector<uint8_t> buffer_;
+#endif
+};
+
+std::string get_cache_dir() {
+    // Enough to fit a path on all supported OSes.
+    const int len = 4096;
+    char value_str[len];
+    for (const auto &prefix : {"ONEDNN_", "DNNL_"}) {
+        std::string name_str = std::string(prefix) + "PRIMITIVE_CACHE_DIR";
+        if (getenv(name_str.c_str(), value_str, len) > 0) return value_str;
+    }
+    return std::string();
+}
+
+} // namespace
+
+primitive_disk_cache_t::primitive_disk_cache_t() {
+#ifndef DNNL_DISABLE_PRIMITIVE_CACHE
+    dir_ = get_cache_dir();
+#endif
+}
+
+std::string primitive_disk_cache_t::get_entry_path(
+        const std::vector<uint8_t> &id) const {
+    const uint64_t hash = fnv1a(id.data(), id.size());
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.onednn", (unsigned long long)hash);
+
+#ifdef _WIN32
+    const char sep = '\\';
+#else
+    const char sep = '/';
+#endif
+    std::string path = dir_;
+    if (path.back() != sep && path.back() != '/') path += sep;
+    return path + name;
+}
+
+status_t primitive_disk_cache_t::store(const std::string &path,
+        const std::vector<uint8_t> &id, const primitive_t *p,
+        engine_t *engine) const {
+    size_t blob_size = 0;
+    CHECK(p->get_cache_blob_size(&blob_size));
+    if (blob_size == 0) return status::unimplemented;
+
+    std::vector<uint8_t> blob(blob_size);
+    cache_blob_t cb(blob.data(), blob.size());
+    CHECK(p->get_cache_blob(engine, cb));
+
+    header_t header;
+    std::memcpy(header.magic, entry_magic, sizeof(entry_magic));
+    header.format_version = entry_format_version;
+    header.reserved = 0;
+    header.id_size = id.size();
+    header.blob_size = blob.size();
+    header.checksum
+            = get_checksum(id.data(), id.size(), blob.data(), blob.size());
+
+    // Write to a temporary file first and then rename it to make the entry
+    // appear atomically for other processes sharing the directory. The name
+    // of the temporary file is unique across the processes and the threads.
+#ifdef _WIN32
+    const int pid = _getpid();
+#else
+    const int pid = (int)getpid();
+#endif
+    const size_t tid = std::hash<std::thread::id>()(std::this_thread::get_id());
+    const std::string tmp_path = path + ".tmp." + std::to_string(pid) + "."
+            + std::to_string(tid);
+    FILE *fp = fopen(tmp_path.c_str(), "wb");
+    if (!fp) return status::runtime_error;
+
+    const bool ok = fwrite(&header, sizeof(header), 1, fp) == 1
+            && fwrite(id.data(), 1, id.size(), fp) == id.size()
+            && fwrite(blob.data(), 1, blob.size(), fp) == blob.size();
+    if (fclose(fp) != 0 || !ok || std::rename(tmp_path.c_str(), path.c_str())) {
+        std::remove(tmp_path.c_str());
+        return status::runtime_error;
+    }
+    return status::success;
+}
+
+status_t primitive_disk_cache_t::init_primitive(
+        primitive_t *p, engine_t *engine, bool use_global_scratchpad) const {
+    // Don't compute the cache blob ID and don't touch the disk for the
+    // primitives that can't be created from a cache blob.
+    if (!is_enabled() || !is_cache_blob_supported(engine, p->pd().get()))
+        return p->init(engine, use_global_scratchpad, cache_blob_t());
+
+    const auto &id = p->pd()->get_cache_blob_id(engine);
+    if (id.empty())
+        return p->init(engine, use_global_scratchpad, cache_blob_t());
+
+    const std::string path = get_entry_path(id);
+    {
+        entry_view_t entry(path);
+        const uint8_t *blob = nullptr;
+        size_t blob_size = 0;
+        if (entry.get_blob(id, &blob, &blob_size)) {
+            cache_blob_t cb(const_cast<uint8_t *>(blob), blob_size);
+            return p->init(engine, use_global_scratchpad, cb);
+        }
+    }
+
+    CHECK(p->init(engine, use_global_scratchpad, cache_blob_t()));
+    // Failing to store the entry (e.g. the primitive doesn't support cache
+    // blobs or the directory is read-only) is not an error.
+    store(path, id, p, engine);
+    return status::success;
+}
+
+const primitive_disk_cache_t &primitive_disk_cache() {
+    static const primitive_disk_cache_t cache;
+    return cache;
+}
+
+} // namespace impl
+} // namespace dnnl
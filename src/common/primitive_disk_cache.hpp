@@ -0,0 +1,71 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef COMMON_PRIMITIVE_DISK_CACHE_HPP
+#define COMMON_PRIMITIVE_DISK_CACHE_HPP
+
+#include <string>
+#include <vector>
+
+#include "c_types_map.hpp"
+
+namespace dnnl {
+namespace impl {
+
+struct primitive_t;
+
+// The on-disk tier of the primitive cache.
+//
+// The tier is enabled by setting ONEDNN_PRIMITIVE_CACHE_DIR (or
+// DNNL_PRIMITIVE_CACHE_DIR) environment variable to a directory. When the
+// in-memory primitive cache misses, the cache blob of the primitive is looked
+// up in the directory and, if found, is used to create the primitive.
+// Otherwise, the primitive is created from scratch and its cache blob is
+// stored in the directory for the subsequent runs.
+//
+// The entries are keyed by the cache blob ID, which includes the serialized
+// primitive descriptor, the library version and git hash, the number of
+// threads and the device (e.g. the effective ISA for CPU). The file name is
+// derived from the hash of the ID and the full ID is stored in the file and
+// compared on lookup.
+//
+// The directory may be read-only. In this case the entries are only looked
+// up and never stored.
+struct primitive_disk_cache_t {
+    primitive_disk_cache_t();
+
+    bool is_enabled() const { return !dir_.empty(); }
+
+    // Initializes the primitive using the cache blob from the disk if it is
+    // available and stores the cache blob of the primitive on the disk
+    // otherwise.
+    status_t init_primitive(
+            primitive_t *p, engine_t *engine, bool use_global_scratchpad) const;
+
+private:
+    std::string get_entry_path(const std::vector<uint8_t> &id) const;
+    status_t store(const std::string &path, const std::vector<uint8_t> &id,
+            const primitive_t *p, engine_t *engine) const;
+
+    std::string dir_;
+};
+
+const primitive_disk_cache_t &primitive_disk_cache();
+
+} // namespace impl
+} // namespace dnnl
+
+#endif
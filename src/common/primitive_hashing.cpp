@@ -208,6 +208,12 @@ size_t get_attr_hash(const primitive_attr_t &attr) {
     seed = hash_combine(seed, static_cast<size_t>(attr.scratchpad_mode_));
     // fpmath_mode
     seed = hash_combine(seed, static_cast<size_t>(attr.fpmath_mode_));
+    // max_threads
+    seed = hash_combine(seed, attr.max_threads_);
+    // weights_group_size
+    seed = hash_combine(seed, attr.weights_group_size_);
+    // src_dynamic_quantization
+    seed = hash_combine(seed, attr.src_dynamic_quantization_);
 
     if (!attr.output_scales_.has_default_values()) {
         // output_scales: mask
@@ -438,6 +444,7 @@ size_t get_desc_hash(const layer_normalization_desc_t &desc) {
     seed = hash_combine(seed, get_md_hash(desc.data_scaleshift_desc));
     seed = hash_combine(seed, get_md_hash(desc.diff_data_scaleshift_desc));
     seed = hash_combine(seed, get_md_hash(desc.stat_desc));
+    seed = hash_combine(seed, get_md_hash(desc.dst_desc));
     // Epsilon
     seed = hash_combine(seed, desc.layer_norm_epsilon);
     // Flags
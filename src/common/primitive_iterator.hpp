@@ -20,6 +20,7 @@
 #include "oneapi/dnnl/dnnl.h"
 
 #include "c_types_map.hpp"
+#include "dnnl_thread.hpp"
 #include "engine.hpp"
 #include "impl_list_item.hpp"
 #include "primitive_attr.hpp"
@@ -76,6 +77,10 @@ struct dnnl_primitive_desc_iterator : public dnnl::impl::c_compatible {
         // The state is equal to the state of the iterator that end() returns.
         if (idx_ == last_idx_) return *this;
 
+        // The key depends on the number of threads, so the limit is applied
+        // before the key is created.
+        dnnl::impl::max_threads_guard_t max_threads_guard(attr_.max_threads_);
+
         offset_++;
         pd_.reset();
 
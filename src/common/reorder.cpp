@@ -18,6 +18,7 @@
 #include "oneapi/dnnl/dnnl.h"
 
 #include "c_types_map.hpp"
+#include "dnnl_thread.hpp"
 #include "engine.hpp"
 #include "impl_list_item.hpp"
 #include "primitive_cache.hpp"
@@ -76,6 +77,7 @@ status_t reorder_primitive_desc_create(std::shared_ptr<primitive_desc_t> &pd,
     if (!s_mdw.consistent_with(d_mdw)) return invalid_arguments;
 
     if (attr == nullptr) attr = &default_attr();
+    max_threads_guard_t max_threads_guard(attr->max_threads_);
 
     bool is_cross_engine = src_engine != dst_engine
             && utils::one_of(
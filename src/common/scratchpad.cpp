@@ -16,6 +16,10 @@
 
 #include <memory>
 
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
 #include "engine.hpp"
 #include "utils.hpp"
 
@@ -74,6 +78,21 @@ memory_storage_t *create_scratchpad_memory_storage(
     return mem_storage;
 }
 
+// Asks the OS to back the huge page aligned part of [ptr, ptr + size) with
+// transparent huge pages.
+void advise_huge_pages(void *ptr, size_t size, size_t huge_page_size) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    const size_t begin = utils::rnd_up((size_t)ptr, huge_page_size);
+    const size_t end = utils::rnd_dn((size_t)ptr + size, huge_page_size);
+    // The advice is an optimization, so a failure is not an error.
+    if (begin < end) madvise((void *)begin, end - begin, MADV_HUGEPAGE);
+#else
+    UNUSED(ptr);
+    UNUSED(size);
+    UNUSED(huge_page_size);
+#endif
+}
+
 } // namespace
 
 /*
@@ -165,7 +184,10 @@ scratchpad_t *create_scratchpad(
      * from different engines.
      * lock global scratchpad to work with CPU engine only.
      */
-    if (use_global_scratchpad && engine->kind() == engine_kind_t::dnnl_cpu)
+    // The global scratchpad is shared between the engines, hence it can't be
+    // used to place the memory on the NUMA node of the engine.
+    if (use_global_scratchpad && engine->kind() == engine_kind_t::dnnl_cpu
+            && engine->numa_node() == -1)
         return new global_scratchpad_t(engine, size);
     else
         return new concurrent_scratchpad_t(engine, size);
@@ -175,5 +197,29 @@ scratchpad_t *create_scratchpad(
 #endif
 }
 
+status_t scratchpad_arena_t::get_memory_storage(
+        size_t size, const memory_storage_t **mem_storage) {
+    if (size > size_) {
+        // Grow in huge page granularity to limit the number of allocations
+        // and to let the arena be backed by transparent huge pages.
+        const size_t huge_page_size = 2 * 1024 * 1024;
+        const size_t new_size = utils::rnd_up(size, huge_page_size);
+
+        mem_storage_.reset();
+        size_ = 0;
+        memory_storage_t *new_mem_storage = nullptr;
+        CHECK(engine_->create_memory_storage(&new_mem_storage, new_size));
+        mem_storage_.reset(new_mem_storage);
+        size_ = new_size;
+        num_allocations_++;
+
+        void *ptr = nullptr;
+        CHECK(mem_storage_->get_data_handle(&ptr));
+        advise_huge_pages(ptr, new_size, huge_page_size);
+    }
+    *mem_storage = mem_storage_.get();
+    return status::success;
+}
+
 } // namespace impl
 } // namespace dnnl
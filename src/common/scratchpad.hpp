@@ -17,6 +17,9 @@
 #ifndef COMMON_SCRATCHPAD_HPP
 #define COMMON_SCRATCHPAD_HPP
 
+#include <memory>
+#include <mutex>
+
 #include "c_types_map.hpp"
 #include "memory_storage.hpp"
 #include "utils.hpp"
@@ -33,6 +36,40 @@ struct scratchpad_t {
 scratchpad_t *create_scratchpad(
         engine_t *engine, size_t size, bool use_global_scratchpad);
 
+/*
+  A scratchpad arena owned by a stream. The primitives with the user
+  scratchpad mode executed without DNNL_ARG_SCRATCHPAD argument take the
+  scratchpad from the arena of the stream. The arena grows to the largest
+  scratchpad requested so far and is reused by all the executions on the
+  stream, so no memory is allocated once the arena reaches its high-water
+  mark. The arena is only available for native CPU streams whose execution
+  is synchronous.
+*/
+struct scratchpad_arena_t {
+    scratchpad_arena_t(engine_t *engine) : engine_(engine) {}
+
+    // Returns a memory storage of at least `size` bytes. The storage is valid
+    // until the next call. The caller is expected to hold the lock returned
+    // by mutex() while the storage is in use.
+    status_t get_memory_storage(
+            size_t size, const memory_storage_t **mem_storage);
+
+    std::mutex &mutex() { return mutex_; }
+
+    // Statistics: the size of the arena and the number of allocations made.
+    size_t size() const { return size_; }
+    size_t num_allocations() const { return num_allocations_; }
+
+private:
+    engine_t *engine_;
+    std::unique_ptr<memory_storage_t> mem_storage_;
+    size_t size_ = 0;
+    size_t num_allocations_ = 0;
+    std::mutex mutex_;
+
+    DNNL_DISALLOW_COPY_AND_ASSIGN(scratchpad_arena_t);
+};
+
 } // namespace impl
 } // namespace dnnl
 #endif
@@ -136,6 +136,12 @@ void serialize_attr(
     sstream.write(&attr.scratchpad_mode_);
     // fpmath_mode
     sstream.write(&attr.fpmath_mode_);
+    // max_threads
+    sstream.write(&attr.max_threads_);
+    // weights_group_size
+    sstream.write(&attr.weights_group_size_);
+    // src_dynamic_quantization
+    sstream.write(&attr.src_dynamic_quantization_);
 
     if (!attr.output_scales_.has_default_values()) {
         // output_scales: mask
@@ -338,6 +344,7 @@ void serialize_desc(serialization_stream_t &sstream,
     serialize_md(sstream, desc.data_scaleshift_desc);
     serialize_md(sstream, desc.diff_data_scaleshift_desc);
     serialize_md(sstream, desc.stat_desc);
+    serialize_md(sstream, desc.dst_desc);
     // Epsilon
     sstream.write(&desc.layer_norm_epsilon);
     // Flags
@@ -56,6 +56,21 @@ status_t dnnl_stream_wait(stream_t *stream) {
     return stream->wait();
 }
 
+status_t dnnl_stream_get_scratchpad_arena_stats(
+        stream_t *stream, size_t *size, size_t *num_allocations) {
+    if (any_null(stream, size, num_allocations)) return invalid_arguments;
+
+    *size = 0;
+    *num_allocations = 0;
+    scratchpad_arena_t *arena = stream->scratchpad_arena();
+    if (arena) {
+        std::lock_guard<std::mutex> lock(arena->mutex());
+        *size = arena->size();
+        *num_allocations = arena->num_allocations();
+    }
+    return success;
+}
+
 status_t dnnl_stream_destroy(stream_t *stream) {
     delete stream;
     return success;
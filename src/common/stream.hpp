@@ -18,11 +18,15 @@
 #define COMMON_STREAM_HPP
 
 #include <assert.h>
+#include <memory>
+#include <mutex>
+
 #include "oneapi/dnnl/dnnl.h"
 #include "oneapi/dnnl/dnnl_threadpool_iface.hpp"
 
 #include "c_types_map.hpp"
 #include "engine.hpp"
+#include "scratchpad.hpp"
 #include "utils.hpp"
 
 struct dnnl_stream : public dnnl::impl::c_compatible {
@@ -53,6 +57,28 @@ struct dnnl_stream : public dnnl::impl::c_compatible {
     virtual dnnl::impl::status_t zero_pad(const dnnl::impl::memory_t *memory,
             const dnnl::impl::exec_ctx_t &ctx);
 
+    /** returns the scratchpad arena of the stream or nullptr if the stream
+     * doesn't support it, e.g. when its execution is asynchronous */
+    dnnl::impl::scratchpad_arena_t *scratchpad_arena() {
+        using namespace dnnl::impl;
+        if (engine_->kind() != engine_kind::cpu
+                || !is_native_runtime(engine_->runtime_kind()))
+            return nullptr;
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
+        // The kernels may still run on an asynchronous threadpool when the
+        // execution returns, so the next execution can't reuse the arena.
+        if (threadpool_
+                && (threadpool_->get_flags()
+                        & dnnl::threadpool_interop::threadpool_iface::
+                                ASYNCHRONOUS))
+            return nullptr;
+#endif
+        std::call_once(scratchpad_arena_once_, [&] {
+            scratchpad_arena_.reset(new scratchpad_arena_t(engine_));
+        });
+        return scratchpad_arena_.get();
+    }
+
 #if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
     dnnl_stream(dnnl::impl::engine_t *engine,
             dnnl::threadpool_interop::threadpool_iface *threadpool)
@@ -74,6 +100,8 @@ struct dnnl_stream : public dnnl::impl::c_compatible {
 protected:
     dnnl::impl::engine_t *engine_;
     unsigned flags_;
+    std::unique_ptr<dnnl::impl::scratchpad_arena_t> scratchpad_arena_;
+    std::once_flag scratchpad_arena_once_;
 #if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
     dnnl::threadpool_interop::threadpool_iface *threadpool_ = nullptr;
 #endif
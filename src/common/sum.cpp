@@ -19,6 +19,7 @@
 #include "oneapi/dnnl/dnnl.h"
 
 #include "c_types_map.hpp"
+#include "dnnl_thread.hpp"
 #include "engine.hpp"
 #include "impl_list_item.hpp"
 #include "primitive_cache.hpp"
@@ -45,6 +46,7 @@ status_t sum_primitive_desc_create(primitive_desc_iface_t **sum_pd_iface,
     if (!args_ok) return invalid_arguments;
 
     if (attr == nullptr) attr = &default_attr();
+    max_threads_guard_t max_threads_guard(attr->max_threads_);
 
     const int ndims = src_mds[0].ndims;
     const dims_t &dims = src_mds[0].dims;
@@ -259,6 +259,9 @@ inline data_type_t default_accum_data_type(data_type_t src_dt,
 
     if (one_of(prop_kind, forward_training, forward_inference)) {
         if ((src_dt == u8 || src_dt == s8) && wei_dt == s8) return s32;
+        // weights decompression: integer weights are converted to the
+        // floating point activations type before the computations
+        if (src_dt == f32 && one_of(wei_dt, s8, u8)) return f32;
     } else if (prop_kind == backward_data) {
         if (one_of(src_dt, f32, s32, s8, u8) && wei_dt == s8
                 && one_of(dst_dt, s8, u8, s32))
@@ -419,7 +422,8 @@ inline bool operator==(const layer_normalization_desc_t &lhs,
             && COMPARE_DESC_MEMBERS(diff_data_scaleshift_desc)
             && COMPARE_DESC_MEMBERS(stat_desc)
             && COMPARE_FLOAT_DESC_MEMBERS(layer_norm_epsilon)
-            && COMPARE_DESC_MEMBERS(flags);
+            && COMPARE_DESC_MEMBERS(flags)
+            && COMPARE_DESC_MEMBERS(dst_desc);
     return ret;
 }
 
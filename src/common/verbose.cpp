@@ -208,6 +208,7 @@ std::string flags2str(unsigned flags) {
     if (flags & dnnl_use_scale) s += "C";
     if (flags & dnnl_use_shift) s += "H";
     if (flags & dnnl_fuse_norm_relu) s += "R";
+    if (flags & dnnl_rms_norm) s += "M";
     return s;
 }
 
@@ -360,8 +361,9 @@ std::ostream &operator<<(std::ostream &ss, const scales_t &oscale) {
 }
 
 std::ostream &operator<<(std::ostream &ss, const primitive_attr_t *attr) {
-    // scratchpad and fpmath mode are not a part of
-    // has_default_values(). Check them first.
+    // scratchpad mode, fpmath mode, max threads, weights group size and src
+    // dynamic quantization are not a part of has_default_values(). Check them
+    // first.
     const scratchpad_mode_t &spm = attr->scratchpad_mode_;
     if (spm != scratchpad_mode_t::dnnl_scratchpad_mode_library) {
         ss << "attr-scratchpad:" << dnnl_scratchpad_mode2str(spm) << " ";
@@ -370,6 +372,13 @@ std::ostream &operator<<(std::ostream &ss, const primitive_attr_t *attr) {
     if (fpm != fpmath_mode_t::dnnl_fpmath_mode_strict) {
         ss << "attr-fpmath:" << dnnl_fpmath_mode2str(fpm) << " ";
     }
+    if (attr->max_threads_ > 0) {
+        ss << "attr-max-threads:" << attr->max_threads_ << " ";
+    }
+    if (attr->weights_group_size_ != 1) {
+        ss << "attr-weights-group:" << attr->weights_group_size_ << " ";
+    }
+    if (attr->src_dynamic_quantization_) ss << "attr-src-dyn-quant:1 ";
 
     if (attr->has_default_values()) return ss;
 
@@ -386,8 +395,12 @@ std::ostream &operator<<(std::ostream &ss, const primitive_attr_t *attr) {
             const auto &val = map_entry.second;
             if (val.has_default_values()) continue;
 
-            int idx = as.get_index_val(map_entry.first);
-            ss << delim << "src" << idx << ":" << val;
+            if (map_entry.first == DNNL_ARG_WEIGHTS) {
+                ss << delim << "wei:" << val;
+            } else {
+                int idx = as.get_index_val(map_entry.first);
+                ss << delim << "src" << idx << ":" << val;
+            }
             delim = attr_delim;
         }
         ss << " ";
@@ -653,6 +666,9 @@ static std::string init_info_layer_normalization(
                                                          : pd->src_md(1);
     auto diff_src_md = pd->diff_src_md();
     ss << "data_" << src_md;
+    // the destination is printed only if it differs from the source
+    if (pd->is_fwd() && *pd->dst_md(0) != *src_md)
+        ss << " dst_" << pd->dst_md(0);
     if (stats_md) ss << " stats_" << stats_md;
     if (diff_src_md) ss << " diff_" << diff_src_md;
     ss << ",";
@@ -862,6 +878,7 @@ static std::string init_info_rnn(const engine_t *e, const pd_t *pd) {
     print_tensor(pd->with_bias(), DNNL_ARG_BIAS, "bias");
     print_tensor(true, DNNL_ARG_DST_LAYER, "dst_layer");
     print_tensor(pd->with_dst_iter(), DNNL_ARG_DST_ITER, "dst_iter");
+    print_tensor(pd->with_seq_lengths(), DNNL_ARG_SEQ_LENGTHS, "seq_lengths");
 
     if (!pd->is_fwd()) {
         print_tensor(true, DNNL_ARG_DIFF_SRC_LAYER, "diff_src_layer");
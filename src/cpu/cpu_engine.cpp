@@ -17,6 +17,7 @@
 #include <assert.h>
 
 #include "common/memory.hpp"
+#include "common/serialization_stream.hpp"
 #include "common/type_helpers.hpp"
 
 #include "cpu/cpu_engine.hpp"
@@ -52,6 +53,16 @@ status_t cpu_engine_t::create_stream(stream_t **stream,
 }
 #endif
 
+status_t cpu_engine_t::serialize_device(serialization_stream_t &sstream) const {
+    // JIT code depends on the instruction set it was generated for, hence a
+    // cache blob is only valid for the same effective ISA and hints.
+    const auto isa = platform::get_effective_cpu_isa();
+    const auto isa_hints = platform::get_cpu_isa_hints();
+    sstream.write(&isa);
+    sstream.write(&isa_hints);
+    return status::success;
+}
+
 } // namespace cpu
 } // namespace impl
 } // namespace dnnl
@@ -27,6 +27,7 @@
 #include "common/engine_id.hpp"
 #include "common/impl_list_item.hpp"
 
+#include "cpu/cpu_numa.hpp"
 #include "cpu/platform.hpp"
 
 #define CPU_INSTANCE(...) \
@@ -112,7 +113,9 @@ public:
 
 class cpu_engine_t : public engine_t {
 public:
-    cpu_engine_t() : engine_t(engine_kind::cpu, get_cpu_native_runtime(), 0) {}
+    cpu_engine_t(int numa_node = -1)
+        : engine_t(engine_kind::cpu, get_cpu_native_runtime(), 0)
+        , numa_node_(numa_node) {}
 
     /* implementation part */
 
@@ -144,7 +147,15 @@ public:
         return cpu_engine_impl_list_t::get_implementation_list(desc);
     }
 
-    device_id_t device_id() const override { return std::make_tuple(0, 0, 0); }
+    // Engines bound to different NUMA nodes allocate memory on the different
+    // nodes, hence they are distinguished by the device ID.
+    device_id_t device_id() const override {
+        return std::make_tuple(0, (uint64_t)(numa_node_ + 1), 0);
+    }
+
+    int numa_node() const override { return numa_node_; }
+
+    status_t serialize_device(serialization_stream_t &sstream) const override;
 
 #ifdef DNNL_USE_RT_OBJECTS_IN_PRIMITIVE_CACHE
     engine_id_t engine_id() const override {
@@ -155,6 +166,9 @@ public:
 protected:
     ~cpu_engine_t() override = default;
 #endif
+
+private:
+    int numa_node_;
 };
 
 class cpu_engine_factory_t : public engine_factory_t {
@@ -165,6 +179,13 @@ public:
         *engine = new cpu_engine_t();
         return status::success;
     };
+
+    status_t engine_create_on_numa_node(engine_t **engine, int node) const {
+        if (node < 0 || node >= numa::get_node_count())
+            return status::invalid_arguments;
+        *engine = new cpu_engine_t(node);
+        return status::success;
+    }
 };
 
 } // namespace cpu
@@ -31,8 +31,7 @@ using namespace dnnl::impl::prop_kind;
 const std::map<pk_impl_key_t, std::vector<impl_list_item_t>> &impl_list_map() {
     static const std::map<pk_impl_key_t, std::vector<impl_list_item_t>> the_map = REG_LNORM_P({
         {{forward}, {
-            CPU_INSTANCE(simple_layer_normalization_fwd_t<f32>)
-            CPU_INSTANCE(simple_layer_normalization_fwd_t<bf16>)
+            CPU_INSTANCE(simple_layer_normalization_fwd_t)
             CPU_INSTANCE(ref_layer_normalization_fwd_t<f32>)
             CPU_INSTANCE(ref_layer_normalization_fwd_t<bf16>)
             nullptr,
@@ -25,6 +25,7 @@
 #include "common/stream.hpp"
 #include "common/utils.hpp"
 
+#include "cpu/cpu_numa.hpp"
 #include "cpu/platform.hpp"
 
 namespace dnnl {
@@ -86,6 +87,19 @@ public:
 
 protected:
     status_t init_allocate(size_t size) override {
+        const int numa_node = engine()->numa_node();
+        if (numa_node != -1) {
+            // Allocate whole pages to not move the neighbouring allocations
+            // to the node.
+            const size_t page_size = 4096;
+            size = utils::rnd_up(size, page_size);
+            void *ptr = malloc(size, page_size);
+            if (!ptr) return status::out_of_memory;
+            numa::bind_memory(ptr, size, numa_node);
+            data_ = decltype(data_)(ptr, destroy);
+            return status::success;
+        }
+
         void *ptr = malloc(size, platform::get_cache_line_size());
         if (!ptr) return status::out_of_memory;
         data_ = decltype(data_)(ptr, destroy);
@@ -0,0 +1,197 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cstdio>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
+#include "common/dnnl_thread.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/cpu_numa.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace numa {
+
+#if defined(__linux__) && defined(__GLIBC__)
+
+namespace {
+
+// Parses a list in the sysfs format, e.g. "0-3,8-11".
+std::vector<int> read_list(const char *path) {
+    std::vector<int> list;
+    FILE *fp = fopen(path, "r");
+    if (!fp) return list;
+    int first = 0;
+    while (fscanf(fp, "%d", &first) == 1) {
+        int last = first;
+        int c = fgetc(fp);
+        if (c == '-') {
+            if (fscanf(fp, "%d", &last) != 1) break;
+            c = fgetc(fp);
+        }
+        for (int i = first; i <= last; i++)
+            list.push_back(i);
+        if (c != ',') break;
+    }
+    fclose(fp);
+    return list;
+}
+
+struct topology_t {
+    topology_t() {
+        const auto nodes = read_list("/sys/devices/system/node/online");
+        // Node IDs are expected to be contiguous.
+        for (size_t i = 0; i < nodes.size(); i++)
+            if (nodes[i] != (int)i) return;
+
+        cpu_set_t process_cpus;
+        if (sched_getaffinity(0, sizeof(process_cpus), &process_cpus) != 0)
+            return;
+
+        node_cpus.resize(nodes.size());
+        for (size_t node = 0; node < nodes.size(); node++) {
+            char path[64];
+            snprintf(path, sizeof(path),
+                    "/sys/devices/system/node/node%d/cpulist", (int)node);
+            CPU_ZERO(&node_cpus[node]);
+            for (int cpu : read_list(path))
+                if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &process_cpus))
+                    CPU_SET(cpu, &node_cpus[node]);
+        }
+    }
+
+    std::vector<cpu_set_t> node_cpus;
+};
+
+const topology_t &topology() {
+    static const topology_t topology;
+    return topology;
+}
+
+// The node the thread is bound to and the affinity it had before the binding.
+// CAVEAT: both are trivially constructed on purpose, see scratchpad.cpp.
+thread_local int thread_node = -1;
+thread_local cpu_set_t thread_orig_cpus;
+
+// The number of threads bound by bind_threads() called on the thread and the
+// limit set for them. The number is 0 when no threads are bound.
+thread_local int team_nthr = 0;
+thread_local max_threads_guard_t *team_max_threads_guard = nullptr;
+
+void bind_calling_thread(int node) {
+    if (thread_node == node) return;
+    if (thread_node == -1) {
+        if (sched_getaffinity(0, sizeof(cpu_set_t), &thread_orig_cpus) != 0)
+            return;
+    }
+    const cpu_set_t &cpus = node == -1 ? thread_orig_cpus
+                                       : topology().node_cpus[node];
+    if (sched_setaffinity(0, sizeof(cpu_set_t), &cpus) == 0) thread_node = node;
+}
+
+} // namespace
+
+int get_node_count() {
+    return (int)topology().node_cpus.size();
+}
+
+int get_node_num_cpus(int node) {
+    if (node < 0 || node >= get_node_count()) return 0;
+    return CPU_COUNT(&topology().node_cpus[node]);
+}
+
+void bind_memory(void *ptr, size_t size, int node) {
+#if defined(SYS_mbind)
+    if (node < 0 || node >= get_node_count() || size == 0) return;
+    // Values from linux/mempolicy.h.
+    const int mpol_preferred = 1;
+    const unsigned mpol_mf_move = 1 << 1;
+    const unsigned long bits_per_mask = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> mask(node / bits_per_mask + 1, 0);
+    mask[node / bits_per_mask] |= 1ul << (node % bits_per_mask);
+    // The placement is an optimization, so a failure is not an error.
+    syscall(SYS_mbind, ptr, size, mpol_preferred, mask.data(),
+            mask.size() * bits_per_mask + 1, mpol_mf_move);
+#else
+    UNUSED(ptr);
+    UNUSED(size);
+    UNUSED(node);
+#endif
+}
+
+void bind_threads(int node) {
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+    if (node < 0 || node >= get_node_count() || team_nthr > 0) return;
+    const int node_nthr = get_node_num_cpus(node);
+    if (node_nthr == 0) return;
+    // More threads than the node has CPUs would share the CPUs.
+    team_max_threads_guard = new max_threads_guard_t(node_nthr);
+    team_nthr = dnnl_get_max_threads();
+    parallel(team_nthr, [&](int, int) { bind_calling_thread(node); });
+#else
+    UNUSED(node);
+#endif
+}
+
+void unbind_threads() {
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+    if (team_nthr == 0) return;
+    parallel(team_nthr, [&](int, int) {
+        if (thread_node != -1) bind_calling_thread(-1);
+    });
+    team_nthr = 0;
+    delete team_max_threads_guard;
+    team_max_threads_guard = nullptr;
+#endif
+}
+
+#else
+
+int get_node_count() {
+    return 0;
+}
+
+int get_node_num_cpus(int node) {
+    UNUSED(node);
+    return 0;
+}
+
+void bind_memory(void *ptr, size_t size, int node) {
+    UNUSED(ptr);
+    UNUSED(size);
+    UNUSED(node);
+}
+
+void bind_threads(int node) {
+    UNUSED(node);
+}
+
+void unbind_threads() {}
+
+#endif
+
+} // namespace numa
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
@@ -0,0 +1,59 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_CPU_NUMA_HPP
+#define CPU_CPU_NUMA_HPP
+
+#include <stddef.h>
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace numa {
+
+// NUMA support for CPU engines bound to a node.
+//
+// The topology is read from sysfs, hence the support is limited to Linux.
+// The memory allocated by an engine bound to a node is placed on the node
+// with the preferred memory policy. With OpenMP threading runtime the threads
+// executing primitives are also bound to the CPUs of the node for the time of
+// the execution, and their number is limited to the number of the CPUs.
+
+// Returns the number of NUMA nodes or 0 if the topology is unknown.
+int get_node_count();
+
+// Returns the number of CPUs of the node available to the process.
+int get_node_num_cpus(int node);
+
+// Makes the pages of [ptr, ptr + size) be allocated on the node. The range
+// is expected to be page aligned and not touched yet.
+void bind_memory(void *ptr, size_t size, int node);
+
+// Binds the threads executing primitives on the calling thread to the node
+// and limits their number to the number of CPUs of the node until
+// unbind_threads() is called. Does nothing if the node is -1.
+void bind_threads(int node);
+
+// Restores the affinity of the threads bound by bind_threads() and removes
+// the limit. Does nothing if no threads are bound.
+void unbind_threads();
+
+} // namespace numa
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
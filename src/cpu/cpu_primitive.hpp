@@ -46,6 +46,13 @@
     } \
     MAYBE_UNUSED(scales);
 
+#define DEFINE_ARG_SCALES_BUFFER(scales, mem_arg) \
+    const float *scales = pd()->attr()->scales_.get(mem_arg).defined() \
+            ? pd()->attr()->scales_.get(mem_arg).scales_ \
+            : CTX_IN_MEM(const float *, DNNL_ARG_ATTR_INPUT_SCALES | mem_arg); \
+    if (scales == nullptr) return status::invalid_arguments; \
+    MAYBE_UNUSED(scales);
+
 #define DEFINE_ZERO_POINTS_BUFFER(zero_points_ptr, mem_arg) \
     const int32_t *zero_points_ptr \
             = pd()->attr()->zero_points_.defined(mem_arg) \
@@ -27,6 +27,8 @@
 #include "common/dnnl_thread.hpp"
 #include "common/stream.hpp"
 
+#include "cpu/cpu_numa.hpp"
+
 namespace dnnl {
 namespace impl {
 namespace cpu {
@@ -40,6 +42,16 @@ struct cpu_stream_t : public stream_t {
         return dnnl::impl::status::success;
     }
 
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_THREADPOOL
+    // The threads executing primitives are bound to the NUMA node of the
+    // engine and get their original affinity back once the execution is done.
+    void before_exec_hook() override {
+        numa::bind_threads(engine()->numa_node());
+    }
+
+    void after_exec_hook() override { numa::unbind_threads(); }
+#endif
+
 #if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
     cpu_stream_t(engine_t *engine,
             dnnl::threadpool_interop::threadpool_iface *threadpool)
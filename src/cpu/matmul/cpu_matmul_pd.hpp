@@ -28,6 +28,41 @@ namespace matmul {
 
 struct cpu_matmul_pd_t : public matmul_pd_t {
     using matmul_pd_t::matmul_pd_t;
+
+protected:
+    // Weights decompression: s8 / u8 weights are converted to the f32 / bf16
+    // source data type on the fly as `(wei - zero_point) * scale`.
+    bool is_wei_decompression() const {
+        using namespace data_type;
+        return utils::one_of(src_md_.data_type, f32, bf16)
+                && utils::one_of(weights_md_.data_type, s8, u8);
+    }
+
+    // The weights scales and zero points can be common, per N, per group of K
+    // rows, or per group of K rows and N. No other quantization parameters
+    // are allowed.
+    bool attr_wei_decompression_ok() const {
+        const int k_mask = 1 << (ndims() - 2);
+        const int n_mask = 1 << (ndims() - 1);
+        const dim_t group = attr()->weights_group_size_;
+        auto mask_ok = [&](int mask) {
+            return utils::one_of(mask, 0, k_mask, n_mask, k_mask | n_mask)
+                    && IMPLICATION(mask & k_mask,
+                            !is_runtime_value(K()) && K() % group == 0);
+        };
+
+        const auto &zp = attr()->zero_points_;
+        int zp_mask = 0;
+        zp.get(DNNL_ARG_WEIGHTS, nullptr, &zp_mask, nullptr);
+        bool ok = mask_ok(attr()->scales_.get(DNNL_ARG_WEIGHTS).mask_)
+                && mask_ok(zp_mask) && zp.has_default_values(DNNL_ARG_SRC)
+                && zp.has_default_values(DNNL_ARG_DST);
+        for (const auto &s : attr()->scales_.scales_) {
+            if (s.first == DNNL_ARG_WEIGHTS) continue;
+            ok = ok && s.second.has_default_values();
+        }
+        return ok;
+    }
 };
 
 } // namespace matmul
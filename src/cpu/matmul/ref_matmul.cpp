@@ -43,6 +43,8 @@ status_t ref_matmul_t::execute_ref(const exec_ctx_t &ctx) const {
     CHECK(status);
 
     DEFINE_SCALES_BUFFER(scales);
+    DEFINE_ARG_SCALES_BUFFER(wei_scales, DNNL_ARG_WEIGHTS);
+    DEFINE_ZERO_POINTS_BUFFER(wei_zero_points, DNNL_ARG_WEIGHTS);
 
     const auto src_d = ctx.memory_mdw(DNNL_ARG_SRC, pd()->src_md());
     const auto weights_d = ctx.memory_mdw(DNNL_ARG_WEIGHTS, pd()->weights_md());
@@ -50,6 +52,8 @@ status_t ref_matmul_t::execute_ref(const exec_ctx_t &ctx) const {
     const auto bia_d = ctx.memory_mdw(DNNL_ARG_BIAS, pd()->weights_md(1));
 
     const bool non_default_attrs = !pd()->attr()->has_default_values();
+    const bool with_wei_decomp = utils::one_of(
+            weights_d.data_type(), data_type::s8, data_type::u8);
 
     matmul_helper_t helper(src_d, weights_d, dst_d);
     const int ndims = pd()->ndims();
@@ -66,6 +70,21 @@ status_t ref_matmul_t::execute_ref(const exec_ctx_t &ctx) const {
     const int bia_mask
             = utils::get_dims_mask(dst_d.dims(), bia_d.dims(), ndims);
 
+    // weights decompression section: the scales and zero points are indexed
+    // by the group of K rows and by N according to their masks
+    const dim_t wei_group = pd()->attr()->weights_group_size_;
+    auto get_wei_decomp_off = [&](int mask, dim_t k, dim_t n) {
+        const bool per_k = mask & (1 << (ndims - 2));
+        const bool per_n = mask & (1 << (ndims - 1));
+        return (per_k ? (k / wei_group) * (per_n ? N : 1) : 0)
+                + (per_n ? n : 0);
+    };
+    const int wei_scales_mask
+            = pd()->attr()->scales_.get(DNNL_ARG_WEIGHTS).mask_;
+    int wei_zp_mask = 0;
+    pd()->attr()->zero_points_.get(
+            DNNL_ARG_WEIGHTS, nullptr, &wei_zp_mask, nullptr);
+
     // mm kernel
     auto ker = [&](const dims_t dst_dims_idx, dim_t m, dim_t n) {
         float acc = 0;
@@ -84,8 +103,12 @@ status_t ref_matmul_t::execute_ref(const exec_ctx_t &ctx) const {
             const auto weights_off = weights_d.off_v(weights_dims_idx);
             const float s
                     = io::load_float_value(src_d.data_type(), src, src_off);
-            const float w = io::load_float_value(
+            float w = io::load_float_value(
                     weights_d.data_type(), weights, weights_off);
+            if (with_wei_decomp) {
+                w -= wei_zero_points[get_wei_decomp_off(wei_zp_mask, k, n)];
+                w *= wei_scales[get_wei_decomp_off(wei_scales_mask, k, n)];
+            }
             acc += s * w;
         }
         return acc;
@@ -49,21 +49,28 @@ struct ref_matmul_t : public primitive_t {
             const auto bia_type = weights_md(1)->data_type;
             const auto dst_type = dst_md(0)->data_type;
 
+            const bool is_wei_decomp = is_wei_decompression();
+            auto skip_mask = smask_t::oscale_runtime | smask_t::post_ops
+                    | smask_t::sum_dt;
+            if (is_wei_decomp)
+                skip_mask |= smask_t::scales_runtime
+                        | smask_t::zero_points_runtime;
+
             bool ok = utils::one_of(src_type, f32, bf16)
-                    && utils::one_of(wei_type, f32, bf16)
+                    && utils::one_of(wei_type, f32, bf16, s8, u8)
                     && utils::one_of(dst_type, f32, bf16)
-                    && src_type == wei_type
+                    && (src_type == wei_type || is_wei_decomp)
                     && IMPLICATION(src_type == f32, dst_type == f32)
                     && IMPLICATION(with_bias(),
                             utils::one_of(bia_type, f32, bf16)
                                     && IMPLICATION(
                                             src_type == f32, bia_type == f32))
                     && platform::has_data_type_support(src_type)
-                    && attr()->has_default_values(smask_t::oscale_runtime
-                                    | smask_t::post_ops | smask_t::sum_dt,
-                            dst_type)
+                    && attr()->has_default_values(skip_mask, dst_type)
                     && attr_.post_ops_.check_sum_consistent_dt(dst_type)
-                    && attr_oscale_ok() && set_default_formats()
+                    && attr_oscale_ok()
+                    && IMPLICATION(is_wei_decomp, attr_wei_decompression_ok())
+                    && set_default_formats()
                     && attr_.set_default_formats(dst_md(0)) == status::success;
             return ok ? status::success : status::unimplemented;
         }
@@ -55,8 +55,12 @@ struct ref_concat_t : public primitive_t {
 
             reorder_pds_.resize(n_ + use_tent_dst());
             for (int i = 0; i < n_; ++i) {
-                CHECK(reorder_primitive_desc_create(
-                        reorder_pds_[i], engine, src_md(i), src_image_md(i)));
+                // the input scale is applied by the reorder into the image
+                primitive_attr_t r_attr;
+                const float scale = src_scale(i);
+                if (scale != 1.f) CHECK(r_attr.output_scales_.set(scale));
+                CHECK(reorder_primitive_desc_create(reorder_pds_[i], engine,
+                        src_md(i), src_image_md(i), &r_attr));
             }
 
             if (use_tent_dst()) {
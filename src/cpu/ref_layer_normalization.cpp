@@ -48,6 +48,7 @@ status_t ref_layer_normalization_fwd_t<d_type>::execute_forward(
     const auto use_ss = pd()->use_scaleshift();
     const auto use_scale = pd()->use_scale();
     const auto use_shift = pd()->use_shift();
+    const auto use_rms_norm = pd()->use_rms_norm();
 
     const memory_desc_wrapper src_d(pd()->src_md());
     const memory_desc_wrapper dst_d(pd()->dst_md());
@@ -63,7 +64,9 @@ status_t ref_layer_normalization_fwd_t<d_type>::execute_forward(
     auto shift = use_shift ? CTX_IN_MEM(const float *, DNNL_ARG_SHIFT)
                            : use_ss ? &scale[shift_off] : nullptr;
 
-    auto mean = pd()->stats_are_src()
+    // the RMS normalization does not take the mean
+    auto mean = use_rms_norm ? nullptr
+            : pd()->stats_are_src()
             ? const_cast<float *>(CTX_IN_MEM(const float *, DNNL_ARG_MEAN))
             : CTX_OUT_MEM(float *, DNNL_ARG_MEAN);
     auto variance = pd()->stats_are_src()
@@ -91,7 +94,7 @@ status_t ref_layer_normalization_fwd_t<d_type>::execute_forward(
     if (this->pd()->has_zero_dim_memory()) {
         if (calculate_stats && save_stats) {
             for (dim_t n = 0; n < N; n++) {
-                mean[n] = 0;
+                if (!use_rms_norm) mean[n] = 0;
                 variance[n] = 0;
             }
         }
@@ -100,13 +103,15 @@ status_t ref_layer_normalization_fwd_t<d_type>::execute_forward(
 
     parallel_nd(N, [&](dim_t n) {
         const size_t s_off = stat_d.off_l(n);
-        auto v_mean = calculate_stats ? 0 : mean[s_off];
+        auto v_mean = calculate_stats || use_rms_norm ? 0 : mean[s_off];
         auto v_variance = calculate_stats ? 0 : variance[s_off];
 
         if (calculate_stats) {
-            for (dim_t c = 0; c < C; ++c)
-                v_mean += maybe_up_convert(src[src_d.off_l(n * C + c)]);
-            v_mean /= C;
+            if (!use_rms_norm) {
+                for (dim_t c = 0; c < C; ++c)
+                    v_mean += maybe_up_convert(src[src_d.off_l(n * C + c)]);
+                v_mean /= C;
+            }
 
             for (dim_t c = 0; c < C; ++c) {
                 float m = src[src_d.off_l(n * C + c)] - v_mean;
@@ -128,7 +133,7 @@ status_t ref_layer_normalization_fwd_t<d_type>::execute_forward(
 
         if (calculate_stats) {
             if (save_stats) {
-                mean[s_off] = v_mean;
+                if (!use_rms_norm) mean[s_off] = v_mean;
                 variance[s_off] = v_variance;
             }
         }
@@ -45,7 +45,8 @@ struct ref_layer_normalization_fwd_t : public primitive_t {
         status_t init(engine_t *engine) {
             using namespace data_type;
             bool ok = is_fwd() && platform::has_data_type_support(d_type)
-                    && src_md()->data_type == d_type
+                    && utils::everyone_is(d_type, src_md()->data_type,
+                            dst_md()->data_type)
                     && stat_md()->data_type == f32
                     && check_scale_shift_data_type()
                     && attr()->has_default_values()
@@ -81,7 +82,8 @@ struct ref_layer_normalization_bwd_t : public primitive_t {
 
         status_t init(engine_t *engine) {
             using namespace data_type;
-            bool ok = is_bwd() && platform::has_data_type_support(d_type)
+            bool ok = is_bwd() && !use_rms_norm()
+                    && platform::has_data_type_support(d_type)
                     && set_default_formats_common()
                     && utils::everyone_is(d_type, src_md()->data_type,
                             diff_src_md()->data_type)
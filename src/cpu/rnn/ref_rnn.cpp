@@ -29,7 +29,11 @@
 
  */
 
+#include <atomic>
+#include <cstring>
+
 #include "common/dnnl_thread.hpp"
+#include "common/stream.hpp"
 
 #include "cpu/simple_q10n.hpp"
 
@@ -204,6 +208,253 @@ rnn_grid_execution_sig((_ref_rnn_common_t<aprop, src_type, weights_type,
     const auto src_iter_c_mdw = memory_desc_wrapper(pd()->src_md(2));
     const auto dst_iter_c_mdw = memory_desc_wrapper(pd()->dst_md(2));
 
+    // Executes the cell (lay, dir, iter) of the grid, j is the index of the
+    // layer in the execution order. The cells executed concurrently use
+    // different scratch slots.
+    const auto execute_cell = [&](int dir, int j, int lay, int iter,
+                                      int scratch_slot) -> status_t {
+        // We set parameters to the cell execution call
+
+        // dst_layer is equal to dst_iter. To avoid
+        // duplication of memory access we hence use only
+        // dst_layer and set dst_iter to nullptr, unless we
+        // cannot for one of the following condition:
+        // - in the last layer and last iteration, we need to
+        //   copy ht in two tensors (dst_layer and dst_iter)
+        dst_layer_t *cell_dst_layer
+                = &(ws_states_layer(lay + 1, dir, iter + 1, 0));
+        dst_iter_t *cell_dst_iter = nullptr;
+        const src_layer_t *cell_src_layer
+                = &(ws_states_layer(lay, dir, iter + 1, 0));
+        const src_iter_t *cell_src_iter
+                = &(ws_states_iter(lay + 1, dir, iter, 0));
+
+        void *cell_dst_iter_c = const_cast<void *>(
+                ws_states_iter_c(lay + 1, dir, iter + 1, 0));
+        const void *cell_src_iter_c
+                = ws_states_iter_c(lay + 1, dir, iter, 0);
+
+        // the cell_position is used only when skip_data_copy is
+        // supported currently supported only for forward
+        cell_position_t cell_position = middle_cell;
+        if (iter == 0) cell_position |= first_iter;
+        if (lay == 0) cell_position |= first_layer;
+        if (iter == rnn.n_iter - 1) cell_position |= last_iter;
+        if (lay == rnn.n_layer - 1) cell_position |= last_layer;
+
+        // The dst_* paths should be before the src_* paths as
+        // the later will override cell_src_layer and
+        // cell_src_iter appropriately for 1st layer and 1st
+        // iter.
+        const bool last_iter_skip_copy = rnn.skip_dst_iter_copy()
+                && (cell_position & last_iter);
+        if (last_iter_skip_copy) {
+            cell_dst_layer
+                    = dst_iter_ + dst_iter_mdw.off(lay, dir, 0, 0);
+            cell_src_layer
+                    = dst_iter_ + dst_iter_mdw.off(lay - 1, dir, 0, 0);
+        }
+
+        if (rnn.skip_dst_layer_copy() && (cell_position & last_layer)) {
+            // Note: for last layer and last iter, the output is in dst_layer
+            // and still need to be copied to dst_iter
+            cell_dst_layer = dst_layer_ + dst_layer_mdw.off(iter, 0, 0);
+            cell_dst_iter = last_iter_skip_copy
+                    ? dst_iter_ + dst_iter_mdw.off(lay, dir, 0, 0)
+                    : nullptr;
+            cell_src_iter = (iter != 0)
+                    ? dst_layer_ + dst_layer_mdw.off(iter - 1, 0, 0)
+                    : cell_src_iter;
+        }
+        if (rnn.skip_src_iter_copy() && (cell_position & first_iter))
+            cell_src_iter
+                    = src_iter_ + src_iter_mdw.off(lay, dir, 0, 0);
+
+        if (rnn.skip_src_layer_copy() && (cell_position & first_layer))
+            cell_src_layer = src_layer_ + src_layer_mdw.off(iter, 0, 0);
+
+        // because the c state is always f32 and require no
+        // conversion, we can always skip to copy for the 1st
+        // and last iteration
+        if (iter == 0 && src_iter_c_) {
+            cell_src_iter_c = inc_ptr(src_iter_c_, rnn.src_iter_c_dt,
+                    src_iter_c_mdw.off(lay, dir, 0, 0));
+            cell_position |= c_state_first_iter;
+        }
+        if (iter == rnn.n_iter - 1 && dst_iter_c_) {
+            cell_dst_iter_c = inc_ptr(dst_iter_c_, rnn.dst_iter_c_dt,
+                    dst_iter_c_mdw.off(lay, dir, 0, 0));
+            cell_position |= c_state_last_iter;
+        }
+
+        const auto cell_scratch_gates = scratch_gates_
+                + (rnn.n_iter_scratch_gates == 1 ? scratch_slot : iter)
+                        * rnn.scratch_gates_nld * rnn.scratch_gates_ld;
+        scratch_t *cell_scratch_cell = reinterpret_cast<scratch_t *>(
+                reinterpret_cast<char *>(scratch_cell_)
+                + scratch_slot * rnn.scratch_cell_size / rnn.n_scratch_slots);
+
+        dst_iter_t *proj_ht = nullptr;
+        if (rnn.is_lstm_projection) {
+            if (rnn.is_training)
+                proj_ht = &(ws_ht(lay, dir, iter, 0));
+            else
+                proj_ht = scratch_ht_;
+        }
+
+        // The sequences are sorted by the length in the decreasing order, so
+        // only the first n_rows rows of the batch are computed at the time
+        // step of the cell.
+        int n_rows = rnn.mb;
+        rnn_conf_t rnn_rows;
+        if (rnn.with_seq_lengths) {
+            const int t = (rnn.exec_dir == r2l || dir == 1)
+                    ? rnn.n_iter - 1 - iter
+                    : iter;
+            while (n_rows > 0 && seq_lengths_[n_rows - 1] <= t)
+                n_rows--;
+            if (n_rows < rnn.mb) {
+                rnn_rows = rnn;
+                rnn_rows.mb = n_rows;
+#if DNNL_X64
+                // The brgemm kernels compute the blocks of m_block rows.
+                if (rnn.is_brgemm) {
+                    rnn_rows.M_blocks = utils::div_up(n_rows, rnn.m_block);
+                    rnn_rows.M = rnn_rows.M_blocks * rnn.m_block;
+                    rnn_rows.mb = (int)rnn_rows.M;
+                }
+#endif
+            }
+        }
+        const rnn_conf_t &cell_rnn = n_rows < rnn.mb ? rnn_rows : rnn;
+
+// Since the function FN(...) returns by reference so an extra exception
+// has to be made for nullptr argument
+#define SAFE_PTR(FN, ...) CONCAT2(FN, _) ? &(FN(__VA_ARGS__)) : nullptr
+        if (n_rows > 0) {
+#if DNNL_X64
+            CHECK((this->*cell_func)(ctx, cell_rnn, cell_position,
+                    cell_dst_layer, cell_dst_iter_c,
+                    SAFE_PTR(ws_diff_states_layer, lay, dir, iter, 0),
+                    SAFE_PTR(diff_augru_attention, iter, 0, 0),
+                    SAFE_PTR(ws_diff_states_iter, lay, dir, iter, 0),
+                    SAFE_PTR(ws_diff_states_iter_c, lay, dir, iter, 0),
+                    SAFE_PTR(weights_layer, lay, dir, 0),
+                    SAFE_PTR(weights_iter, lay, dir, 0),
+                    SAFE_PTR(weights_projection, lay, dir),
+                    SAFE_PTR(weights_peephole, lay, dir, 0),
+                    w_proj_comp
+                            ? w_proj_comp + (j * rnn.n_dir + dir) * rnn.dic
+                            : nullptr,
+                    bias(lay, dir), cell_src_layer,
+                    SAFE_PTR(augru_attention, iter, 0, 0), cell_src_iter,
+                    cell_src_iter_c,
+                    SAFE_PTR(ws_diff_states_layer, lay + 1, dir, iter, 0),
+                    SAFE_PTR(ws_diff_states_iter, lay, dir, iter + 1, 0),
+                    SAFE_PTR(ws_diff_states_iter_c, lay, dir, iter + 1, 0),
+                    SAFE_PTR(diff_weights_layer, lay, dir, 0),
+                    SAFE_PTR(diff_weights_iter, lay, dir, 0),
+                    SAFE_PTR(diff_weights_projection, lay, dir, 0),
+                    SAFE_PTR(diff_weights_peephole, lay, dir, 0),
+                    SAFE_PTR(diff_bias, lay, dir, 0),
+                    SAFE_PTR(ws_gates, lay, dir, iter, 0),
+                    cell_scratch_gates, proj_ht, scratch_diff_ht_,
+                    SAFE_PTR(ws_grid, lay, dir, iter, 0), cell_scratch_cell,
+                    scratch_gates_blocked_, scratch_src_layer_,
+                    scratch_src_iter_, cell_dst_iter, amx_scratchpad,
+                    addr_batch_global));
+#else
+            CHECK((this->*cell_func)(cell_rnn, cell_position, cell_dst_layer,
+                    cell_dst_iter_c,
+                    SAFE_PTR(ws_diff_states_layer, lay, dir, iter, 0),
+                    SAFE_PTR(diff_augru_attention, iter, 0, 0),
+                    SAFE_PTR(ws_diff_states_iter, lay, dir, iter, 0),
+                    SAFE_PTR(ws_diff_states_iter_c, lay, dir, iter, 0),
+                    SAFE_PTR(weights_layer, lay, dir, 0),
+                    SAFE_PTR(weights_iter, lay, dir, 0),
+                    SAFE_PTR(weights_projection, lay, dir),
+                    SAFE_PTR(weights_peephole, lay, dir, 0),
+                    w_proj_comp
+                            ? w_proj_comp + (j * rnn.n_dir + dir) * rnn.dic
+                            : nullptr,
+                    bias(lay, dir), cell_src_layer,
+                    SAFE_PTR(augru_attention, iter, 0, 0), cell_src_iter,
+                    cell_src_iter_c,
+                    SAFE_PTR(ws_diff_states_layer, lay + 1, dir, iter, 0),
+                    SAFE_PTR(ws_diff_states_iter, lay, dir, iter + 1, 0),
+                    SAFE_PTR(ws_diff_states_iter_c, lay, dir, iter + 1, 0),
+                    SAFE_PTR(diff_weights_layer, lay, dir, 0),
+                    SAFE_PTR(diff_weights_iter, lay, dir, 0),
+                    SAFE_PTR(diff_weights_projection, lay, dir, 0),
+                    SAFE_PTR(diff_weights_peephole, lay, dir, 0),
+                    SAFE_PTR(diff_bias, lay, dir, 0),
+                    SAFE_PTR(ws_gates, lay, dir, iter, 0),
+                    cell_scratch_gates, proj_ht, scratch_diff_ht_,
+                    SAFE_PTR(ws_grid, lay, dir, iter, 0), cell_scratch_cell,
+                    cell_dst_iter, amx_scratchpad));
+#endif
+        }
+#undef SAFE_PTR
+
+        // The states of the rows of the finished (or not yet started for the
+        // right-to-left direction) sequences are passed to the next time step
+        // unchanged.
+        if (n_rows < rnn.mb) {
+            const auto src_iter_ld = rnn.src_iter_ld(cell_position);
+            const auto dst_layer_ld = rnn.dst_layer_ld(cell_position, true);
+            const auto dst_iter_ld = rnn.dst_iter_ld(cell_position);
+            const auto src_iter_c_ld = rnn.src_iter_c_ld(cell_position);
+            const auto dst_iter_c_ld = rnn.dst_iter_c_ld(cell_position);
+            parallel_nd(rnn.mb - n_rows, [&](dim_t i) {
+                const dim_t b = n_rows + i;
+                const src_iter_t *ht = cell_src_iter + b * src_iter_ld;
+                for (int c = 0; c < rnn.dic; c++) {
+                    cell_dst_layer[b * dst_layer_ld + c] = ht[c];
+                    if (cell_dst_iter)
+                        cell_dst_iter[b * dst_iter_ld + c] = ht[c];
+                }
+                if (!pd()->is_lstm()) return;
+                for (int c = 0; c < rnn.dhc; c++) {
+                    const float ct = to_float(
+                            inc_ptr(cell_src_iter_c, rnn.src_iter_c_dt,
+                                    (int)(b * src_iter_c_ld + c)),
+                            rnn.src_iter_c_dt);
+                    void *dst_ct = inc_ptr(cell_dst_iter_c, rnn.dst_iter_c_dt,
+                            (int)(b * dst_iter_c_ld + c));
+                    if (rnn.dst_iter_c_dt == data_type::f32)
+                        *static_cast<float *>(dst_ct) = ct;
+                    else if (rnn.dst_iter_c_dt == data_type::bf16)
+                        *static_cast<bfloat16_t *>(dst_ct)
+                                = cpu::saturate_and_round<bfloat16_t>(ct);
+                }
+            });
+        }
+
+        return status::success;
+    };
+
+    if (rnn.use_wavefront) {
+        // The cell (lay, iter) depends only on the cells (lay - 1, iter) and
+        // (lay, iter - 1), and the directions are independent. Hence the
+        // cells on an anti-diagonal lay + iter = diag of both directions are
+        // executed concurrently, each with the scratch slot of its layer and
+        // direction.
+        assert(aprop == prop_kind::forward && !rnn.merge_gemm_layer);
+        std::atomic<status_t> st(status::success);
+        for (int diag = 0; diag < rnn.n_layer + rnn.n_iter - 1; diag++) {
+            const int lay_beg = nstl::max(0, diag - rnn.n_iter + 1);
+            const int lay_end = nstl::min(rnn.n_layer, diag + 1);
+            parallel_nd(rnn.n_dir, lay_end - lay_beg, [&](dim_t dir, dim_t l) {
+                const int lay = lay_beg + (int)l;
+                const status_t st_cell = execute_cell((int)dir, lay, lay,
+                        diag - lay, (int)dir * rnn.n_layer + lay);
+                if (st_cell != status::success) st = st_cell;
+            });
+            if (st != status::success) return st;
+        }
+        return dnnl_success;
+    }
+
     // We run the grid of computation
     for (int dir = 0; dir < rnn.n_dir; dir++) {
         for (int j = 0; j < rnn.n_layer; j++) {
@@ -240,160 +491,7 @@ rnn_grid_execution_sig((_ref_rnn_common_t<aprop, src_type, weights_type,
                 const int iter = (aprop == prop_kind::forward)
                         ? i
                         : rnn.n_iter - i - 1;
-
-                // We set parameters to the cell execution call
-
-                // dst_layer is equal to dst_iter. To avoid
-                // duplication of memory access we hence use only
-                // dst_layer and set dst_iter to nullptr, unless we
-                // cannot for one of the following condition:
-                // - in the last layer and last iteration, we need to
-                //   copy ht in two tensors (dst_layer and dst_iter)
-                dst_layer_t *cell_dst_layer
-                        = &(ws_states_layer(lay + 1, dir, iter + 1, 0));
-                dst_iter_t *cell_dst_iter = nullptr;
-                const src_layer_t *cell_src_layer
-                        = &(ws_states_layer(lay, dir, iter + 1, 0));
-                const src_iter_t *cell_src_iter
-                        = &(ws_states_iter(lay + 1, dir, iter, 0));
-
-                void *cell_dst_iter_c = const_cast<void *>(
-                        ws_states_iter_c(lay + 1, dir, iter + 1, 0));
-                const void *cell_src_iter_c
-                        = ws_states_iter_c(lay + 1, dir, iter, 0);
-
-                // the cell_position is used only when skip_data_copy is
-                // supported currently supported only for forward
-                cell_position_t cell_position = middle_cell;
-                if (iter == 0) cell_position |= first_iter;
-                if (lay == 0) cell_position |= first_layer;
-                if (iter == rnn.n_iter - 1) cell_position |= last_iter;
-                if (lay == rnn.n_layer - 1) cell_position |= last_layer;
-
-                // The dst_* paths should be before the src_* paths as
-                // the later will override cell_src_layer and
-                // cell_src_iter appropriately for 1st layer and 1st
-                // iter.
-                const bool last_iter_skip_copy = rnn.skip_dst_iter_copy()
-                        && (cell_position & last_iter);
-                if (last_iter_skip_copy) {
-                    cell_dst_layer
-                            = dst_iter_ + dst_iter_mdw.off(lay, dir, 0, 0);
-                    cell_src_layer
-                            = dst_iter_ + dst_iter_mdw.off(lay - 1, dir, 0, 0);
-                }
-
-                if (rnn.skip_dst_layer_copy() && (cell_position & last_layer)) {
-                    // Note: for last layer and last iter, the output is in dst_layer
-                    // and still need to be copied to dst_iter
-                    cell_dst_layer = dst_layer_ + dst_layer_mdw.off(iter, 0, 0);
-                    cell_dst_iter = last_iter_skip_copy
-                            ? dst_iter_ + dst_iter_mdw.off(lay, dir, 0, 0)
-                            : nullptr;
-                    cell_src_iter = (iter != 0)
-                            ? dst_layer_ + dst_layer_mdw.off(iter - 1, 0, 0)
-                            : cell_src_iter;
-                }
-                if (rnn.skip_src_iter_copy() && (cell_position & first_iter))
-                    cell_src_iter
-                            = src_iter_ + src_iter_mdw.off(lay, dir, 0, 0);
-
-                if (rnn.skip_src_layer_copy() && (cell_position & first_layer))
-                    cell_src_layer = src_layer_ + src_layer_mdw.off(iter, 0, 0);
-
-                // because the c state is always f32 and require no
-                // conversion, we can always skip to copy for the 1st
-                // and last iteration
-                if (iter == 0 && src_iter_c_) {
-                    cell_src_iter_c = inc_ptr(src_iter_c_, rnn.src_iter_c_dt,
-                            src_iter_c_mdw.off(lay, dir, 0, 0));
-                    cell_position |= c_state_first_iter;
-                }
-                if (iter == rnn.n_iter - 1 && dst_iter_c_) {
-                    cell_dst_iter_c = inc_ptr(dst_iter_c_, rnn.dst_iter_c_dt,
-                            dst_iter_c_mdw.off(lay, dir, 0, 0));
-                    cell_position |= c_state_last_iter;
-                }
-
-                const auto cell_scratch_gates = rnn.n_iter_scratch_gates == 1
-                        ? scratch_gates_
-                        : scratch_gates_
-                                + iter * rnn.scratch_gates_nld
-                                        * rnn.scratch_gates_ld;
-
-                dst_iter_t *proj_ht = nullptr;
-                if (rnn.is_lstm_projection) {
-                    if (rnn.is_training)
-                        proj_ht = &(ws_ht(lay, dir, iter, 0));
-                    else
-                        proj_ht = scratch_ht_;
-                }
-
-// Since the function FN(...) returns by reference so an extra exception
-// has to be made for nullptr argument
-#define SAFE_PTR(FN, ...) CONCAT2(FN, _) ? &(FN(__VA_ARGS__)) : nullptr
-#if DNNL_X64
-                CHECK((this->*cell_func)(ctx, rnn, cell_position,
-                        cell_dst_layer, cell_dst_iter_c,
-                        SAFE_PTR(ws_diff_states_layer, lay, dir, iter, 0),
-                        SAFE_PTR(diff_augru_attention, iter, 0, 0),
-                        SAFE_PTR(ws_diff_states_iter, lay, dir, iter, 0),
-                        SAFE_PTR(ws_diff_states_iter_c, lay, dir, iter, 0),
-                        SAFE_PTR(weights_layer, lay, dir, 0),
-                        SAFE_PTR(weights_iter, lay, dir, 0),
-                        SAFE_PTR(weights_projection, lay, dir),
-                        SAFE_PTR(weights_peephole, lay, dir, 0),
-                        w_proj_comp
-                                ? w_proj_comp + (j * rnn.n_dir + dir) * rnn.dic
-                                : nullptr,
-                        bias(lay, dir), cell_src_layer,
-                        SAFE_PTR(augru_attention, iter, 0, 0), cell_src_iter,
-                        cell_src_iter_c,
-                        SAFE_PTR(ws_diff_states_layer, lay + 1, dir, iter, 0),
-                        SAFE_PTR(ws_diff_states_iter, lay, dir, iter + 1, 0),
-                        SAFE_PTR(ws_diff_states_iter_c, lay, dir, iter + 1, 0),
-                        SAFE_PTR(diff_weights_layer, lay, dir, 0),
-                        SAFE_PTR(diff_weights_iter, lay, dir, 0),
-                        SAFE_PTR(diff_weights_projection, lay, dir, 0),
-                        SAFE_PTR(diff_weights_peephole, lay, dir, 0),
-                        SAFE_PTR(diff_bias, lay, dir, 0),
-                        SAFE_PTR(ws_gates, lay, dir, iter, 0),
-                        cell_scratch_gates, proj_ht, scratch_diff_ht_,
-                        SAFE_PTR(ws_grid, lay, dir, iter, 0), scratch_cell_,
-                        scratch_gates_blocked_, scratch_src_layer_,
-                        scratch_src_iter_, cell_dst_iter, amx_scratchpad,
-                        addr_batch_global));
-#else
-                CHECK((this->*cell_func)(rnn, cell_position, cell_dst_layer,
-                        cell_dst_iter_c,
-                        SAFE_PTR(ws_diff_states_layer, lay, dir, iter, 0),
-                        SAFE_PTR(diff_augru_attention, iter, 0, 0),
-                        SAFE_PTR(ws_diff_states_iter, lay, dir, iter, 0),
-                        SAFE_PTR(ws_diff_states_iter_c, lay, dir, iter, 0),
-                        SAFE_PTR(weights_layer, lay, dir, 0),
-                        SAFE_PTR(weights_iter, lay, dir, 0),
-                        SAFE_PTR(weights_projection, lay, dir),
-                        SAFE_PTR(weights_peephole, lay, dir, 0),
-                        w_proj_comp
-                                ? w_proj_comp + (j * rnn.n_dir + dir) * rnn.dic
-                                : nullptr,
-                        bias(lay, dir), cell_src_layer,
-                        SAFE_PTR(augru_attention, iter, 0, 0), cell_src_iter,
-                        cell_src_iter_c,
-                        SAFE_PTR(ws_diff_states_layer, lay + 1, dir, iter, 0),
-                        SAFE_PTR(ws_diff_states_iter, lay, dir, iter + 1, 0),
-                        SAFE_PTR(ws_diff_states_iter_c, lay, dir, iter + 1, 0),
-                        SAFE_PTR(diff_weights_layer, lay, dir, 0),
-                        SAFE_PTR(diff_weights_iter, lay, dir, 0),
-                        SAFE_PTR(diff_weights_projection, lay, dir, 0),
-                        SAFE_PTR(diff_weights_peephole, lay, dir, 0),
-                        SAFE_PTR(diff_bias, lay, dir, 0),
-                        SAFE_PTR(ws_gates, lay, dir, iter, 0),
-                        cell_scratch_gates, proj_ht, scratch_diff_ht_,
-                        SAFE_PTR(ws_grid, lay, dir, iter, 0), scratch_cell_,
-                        cell_dst_iter, amx_scratchpad));
-#endif
-#undef SAFE_PTR
+                CHECK(execute_cell(dir, j, lay, iter, 0));
             }
 
             if ((aprop == prop_kind::backward) && rnn.merge_gemm_layer) {
@@ -1164,10 +1262,53 @@ rnn_weights_assign_sig((_ref_rnn_common_t<aprop, src_type, weights_type,
         }
 }
 
+template <prop_kind_t aprop, data_type_t src_type, data_type_t weights_type,
+        data_type_t acc_type>
+status_t
+_ref_rnn_common_t<aprop, src_type, weights_type, acc_type>::pack_weights(
+        const exec_ctx_t &ctx, weights_type_t type, int arg,
+        const char *&weights, std::shared_ptr<void> &cached) const {
+    const int idx = static_cast<int>(type);
+    const auto &reorder = weights_reorders_[idx];
+    if (!reorder) return status::success;
+
+    engine_t *engine = ctx.stream()->engine();
+    const memory_desc_t &packed_md = pd()->packed_weights_md_[idx];
+    const auto pack = [&](void *packed) {
+        memory_t packed_mem(engine, &packed_md,
+                memory_flags_t::use_runtime_ptr, packed);
+        exec_args_t r_args;
+        r_args[DNNL_ARG_SRC] = ctx.args().at(arg);
+        r_args[DNNL_ARG_DST] = {&packed_mem, false};
+        exec_ctx_t r_ctx(ctx, std::move(r_args));
+
+        nested_scratchpad_t ns(ctx, key_nested_multiple + idx, reorder);
+        r_ctx.set_scratchpad_grantor(ns.grantor());
+        return reorder->execute(r_ctx);
+    };
+
+    if (pd()->use_weights_cache_) {
+        const memory_desc_t *user_md = pd()->arg_md(arg);
+        CHECK(weights_cache_t::global().get_or_pack(
+                weights, *user_md, packed_md, pack, cached));
+        weights = static_cast<const char *>(cached.get());
+        return status::success;
+    }
+
+    const memory_tracking::key_t packed_wei_keys[3]
+            = {key_rnn_packed_wei_layer, key_rnn_packed_wei_iter,
+                    key_rnn_packed_wei_projection};
+    char *packed = ctx.get_scratchpad_grantor().template get<char>(
+            packed_wei_keys[idx]);
+    CHECK(pack(packed));
+    weights = packed;
+    return status::success;
+}
+
 //********************* Execution function *********************//
 template <prop_kind_t aprop, data_type_t src_type, data_type_t weights_type,
         data_type_t acc_type>
-void _ref_rnn_common_t<aprop, src_type, weights_type, acc_type>::execute_(
+status_t _ref_rnn_common_t<aprop, src_type, weights_type, acc_type>::execute_(
         const exec_ctx_t &ctx) const {
     const rnn_conf_t &rnn = this->pd()->rnn_;
     auto src_layer = CTX_IN_MEM(const src_layer_t *, DNNL_ARG_SRC_LAYER);
@@ -1183,6 +1324,19 @@ void _ref_rnn_common_t<aprop, src_type, weights_type, acc_type>::execute_(
     auto projection_weights_n_comp
             = CTX_IN_MEM(const char *, DNNL_ARG_WEIGHTS_PROJECTION);
     auto bias = CTX_IN_MEM(const void *, DNNL_ARG_BIAS);
+    auto seq_lengths = CTX_IN_MEM(const int32_t *, DNNL_ARG_SEQ_LENGTHS);
+
+    // The rows of the running sequences must be the first rows of the batch
+    // at every time step.
+    if (rnn.with_seq_lengths) {
+        if (seq_lengths == nullptr) return status::invalid_arguments;
+        for (int b = 0; b < rnn.mb; b++) {
+            const bool ok = seq_lengths[b] >= 0
+                    && seq_lengths[b] <= rnn.n_iter
+                    && IMPLICATION(b > 0, seq_lengths[b] <= seq_lengths[b - 1]);
+            if (!ok) return status::invalid_arguments;
+        }
+    }
 
     auto dst_layer = rnn.is_fwd
             ? CTX_OUT_MEM(char *, DNNL_ARG_DST_LAYER)
@@ -1197,6 +1351,18 @@ void _ref_rnn_common_t<aprop, src_type, weights_type, acc_type>::execute_(
     auto diff_dst_iter = CTX_IN_MEM(const gemm_acc_t *, DNNL_ARG_DIFF_DST_ITER);
     auto diff_dst_iter_c = CTX_IN_MEM(const float *, DNNL_ARG_DIFF_DST_ITER_C);
 
+    // The packed copies of the weights stay alive until the end of the
+    // execution.
+    std::shared_ptr<void> cached_weights[3];
+    CHECK(pack_weights(ctx, weights_type_t::layer, DNNL_ARG_WEIGHTS_LAYER,
+            layer_weights_n_comp, cached_weights[0]));
+    CHECK(pack_weights(ctx, weights_type_t::iter, DNNL_ARG_WEIGHTS_ITER,
+            iter_weights_n_comp, cached_weights[1]));
+    if (rnn.is_lstm_projection)
+        CHECK(pack_weights(ctx, weights_type_t::projection,
+                DNNL_ARG_WEIGHTS_PROJECTION, projection_weights_n_comp,
+                cached_weights[2]));
+
     auto w_layer = reinterpret_cast<const weights_t *>(layer_weights_n_comp);
     auto w_iter = reinterpret_cast<const weights_t *>(iter_weights_n_comp);
     auto w_projection
@@ -1291,16 +1457,24 @@ void _ref_rnn_common_t<aprop, src_type, weights_type, acc_type>::execute_(
      * dimension */
     (this->*bias_preparation_func)(rnn, ptr_bias, bias, ws_bias);
 
-    (this->*weights_iter_assign_func)(rnn, pd()->weights_md(1),
+    // The brgemm kernels use the weights in the packed layout.
+    const auto weights_md = [&](weights_type_t type, int arg) {
+        return rnn.is_brgemm ? &pd()->packed_weights_md_[(int)type]
+                             : pd()->arg_md(arg);
+    };
+    (this->*weights_iter_assign_func)(rnn,
+            weights_md(weights_type_t::iter, DNNL_ARG_WEIGHTS_ITER),
             rnn.n_parts_weights_iter, rnn.parts_weights_iter, ptr_wei_iter,
             w_iter);
-    (this->*weights_layer_assign_func)(rnn, pd()->weights_md(0),
+    (this->*weights_layer_assign_func)(rnn,
+            weights_md(weights_type_t::layer, DNNL_ARG_WEIGHTS_LAYER),
             rnn.n_parts_weights_layer, rnn.parts_weights_layer, ptr_wei_layer,
             w_layer);
 
     if (rnn.is_lstm_projection) {
         (this->*weights_projection_assign_func)(rnn,
-                pd()->arg_md(DNNL_ARG_WEIGHTS_PROJECTION),
+                weights_md(weights_type_t::projection,
+                        DNNL_ARG_WEIGHTS_PROJECTION),
                 rnn.n_parts_weights_projection, rnn.parts_weights_projection,
                 ptr_wei_projection, w_projection);
     }
@@ -1332,7 +1506,8 @@ void _ref_rnn_common_t<aprop, src_type, weights_type, acc_type>::execute_(
 #endif
             rnn, ptr_wei_layer, ptr_wei_iter, ptr_wei_projection,
             weights_peephole, w_projection_comp, ptr_bias, src_layer,
-            augru_attention, (const src_iter_t *)src_iter, src_iter_c,
+            augru_attention, seq_lengths, (const src_iter_t *)src_iter,
+            src_iter_c,
             (dst_layer_t *)dst_layer, (dst_iter_t *)dst_iter, dst_iter_c,
             ws_states_layer, ws_states_iter, ws_states_iter_c,
             ws_diff_states_layer, ws_diff_states_iter, ws_diff_states_iter_c,
@@ -1372,6 +1547,21 @@ void _ref_rnn_common_t<aprop, src_type, weights_type, acc_type>::execute_(
                     ws_states_iter_c, ws_diff_states_iter,
                     ws_diff_states_iter_c);
     }
+
+    // The outputs of the time steps past the end of a sequence are zeroes.
+    // Note: it goes after copy_res_iter, which may read the last states from
+    // dst_layer.
+    if (rnn.with_seq_lengths) {
+        const memory_desc_wrapper dst_layer_d(pd()->dst_md(0));
+        const size_t dt_size = dst_layer_d.data_type_size();
+        parallel_nd(rnn.n_iter, rnn.mb, [&](dim_t t, dim_t b) {
+            if (t < seq_lengths[b]) return;
+            std::memset(dst_layer + dst_layer_d.off(t, b, 0) * dt_size, 0,
+                    rnn.dlc * dt_size);
+        });
+    }
+
+    return status::success;
 };
 
 /* Fix for MSVS warning C4661 */
@@ -23,14 +23,17 @@
 #include "common/c_types_map.hpp"
 #include "common/memory_tracking.hpp"
 #include "common/primitive.hpp"
+#include "common/reorder.hpp"
 #include "common/type_helpers.hpp"
 #include "common/utils.hpp"
 
 #include "cpu/gemm/gemm.hpp"
 #include "cpu/gemm/os_blas.hpp"
+#include "cpu/platform.hpp"
 
 #include "cpu/rnn/cpu_rnn_pd.hpp"
 #include "cpu/rnn/postgemm_dispatcher.hpp"
+#include "cpu/rnn/rnn_weights_cache.hpp"
 #if DNNL_X64
 #include "cpu/x64/rnn/rnn_brgemm_utils.hpp"
 #endif
@@ -146,6 +149,8 @@ struct _ref_rnn_common_t : public primitive_t {
                                     forward_inference))
                     && IMPLICATION(aprop == backward,
                             one_of(this->desc()->prop_kind, backward))
+                    && IMPLICATION(this->with_seq_lengths(),
+                            aprop == prop_kind::forward)
                     && src_layer_dt == src_type
                     && everyone_is(
                             weights_type, weights_iter_dt, weights_layer_dt)
@@ -267,6 +272,8 @@ struct _ref_rnn_common_t : public primitive_t {
                                     forward_inference))
                     && IMPLICATION(aprop == backward,
                             one_of(this->desc()->prop_kind, backward))
+                    && IMPLICATION(this->with_seq_lengths(),
+                            aprop == prop_kind::forward)
                     && src_layer_dt == src_type
                     && everyone_is(
                             weights_type, weights_iter_dt, weights_layer_dt)
@@ -362,42 +369,48 @@ struct _ref_rnn_common_t : public primitive_t {
             if (rnn_.is_signed_int8() && !rnn_.is_int8_amx())
                 return status::unimplemented;
 
-            // Set weights descriptors to desired format
-            memory_desc_t new_weights_layer_md = *this->weights_md(0);
-            CHECK(set_expected_desc(rnn_, new_weights_layer_md,
-                    rnn_utils::weights_type_t::layer));
-            if (this->weights_layer_md_.format_kind == format_kind::any) {
-                this->weights_layer_md_ = new_weights_layer_md;
-            } else if (this->weights_layer_md_ != new_weights_layer_md) {
-                return status::unimplemented;
-            }
-
-            memory_desc_t new_weights_iter_md = *this->weights_md(1);
-            CHECK(set_expected_desc(rnn_, new_weights_iter_md,
-                    rnn_utils::weights_type_t::iter));
-            if (this->weights_iter_md_.format_kind == format_kind::any) {
-                this->weights_iter_md_ = new_weights_iter_md;
-            } else if (this->weights_iter_md_ != new_weights_iter_md) {
-                return status::unimplemented;
-            }
-            if (rnn_.is_lstm_projection) {
-                memory_desc_t new_weights_projection_md
-                        = *this->arg_md(DNNL_ARG_WEIGHTS_PROJECTION);
-                CHECK(set_expected_desc(rnn_, new_weights_projection_md,
-                        rnn_utils::weights_type_t::projection));
-                if (this->weights_projection_md_.format_kind
-                        == format_kind::any) {
-                    this->weights_projection_md_ = new_weights_projection_md;
-                } else if (this->weights_projection_md_
-                        != new_weights_projection_md) {
-                    return status::unimplemented;
+            // Set weights descriptors to desired format. The forward
+            // propagation also takes the weights in the other layouts and
+            // packs them at the execution.
+            const auto init_weights = [&](memory_desc_t &md,
+                                              weights_type_t type) {
+                const int idx = static_cast<int>(type);
+                memory_desc_t &packed_md = packed_weights_md_[idx];
+                packed_md = md;
+                CHECK(set_expected_desc(rnn_, packed_md, type));
+                if (md.format_kind == format_kind::any) {
+                    md = packed_md;
+                } else if (md != packed_md) {
+                    if (aprop != prop_kind::forward
+                            || md.format_kind != format_kind::blocked)
+                        return status::unimplemented;
+                    primitive_attr_t r_attr;
+                    CHECK(r_attr.rnn_weights_qparams_.copy_from(
+                            this->attr()->rnn_weights_qparams_));
+                    CHECK(r_attr.rnn_weights_projection_qparams_.copy_from(
+                            this->attr()->rnn_weights_projection_qparams_));
+                    CHECK(r_attr.set_scratchpad_mode(scratchpad_mode::user));
+                    CHECK(reorder_primitive_desc_create(
+                            weights_reorder_pd_[idx], engine, &md, &packed_md,
+                            &r_attr));
                 }
-            }
+                return status::success;
+            };
+            CHECK(init_weights(this->weights_layer_md_, weights_type_t::layer));
+            CHECK(init_weights(this->weights_iter_md_, weights_type_t::iter));
+            if (rnn_.is_lstm_projection)
+                CHECK(init_weights(this->weights_projection_md_,
+                        weights_type_t::projection));
+            // The packed weights are not modified in place by the inference,
+            // so they may be shared by the executions.
+            use_weights_cache_ = this->desc()->prop_kind == forward_inference
+                    && weights_cache_t::capacity() > 0;
+
             if (rnn_.is_unsigned_int8()) {
                 const memory_desc_wrapper &weights_layer_d(
-                        this->weights_layer_md_);
+                        packed_weights_md_[0]);
                 const memory_desc_wrapper &weights_iter_d(
-                        this->weights_iter_md_);
+                        packed_weights_md_[1]);
                 const auto &pdims_l = weights_layer_d.padded_dims();
                 const auto &pdims_i = weights_iter_d.padded_dims();
                 rnn_.weights_layer_comp_offset = rnn_.n_layer * rnn_.n_dir
@@ -406,7 +419,7 @@ struct _ref_rnn_common_t : public primitive_t {
                         * rnn_.n_gates * pdims_i[2] * pdims_i[4];
                 if (rnn_.is_lstm_projection) {
                     const memory_desc_wrapper &weights_proj_d(
-                            this->weights_projection_md_);
+                            packed_weights_md_[2]);
                     const auto &pdims_p = weights_proj_d.padded_dims();
                     rnn_.weights_projection_comp_offset = rnn_.n_layer
                             * rnn_.n_dir * pdims_p[2] * pdims_p[3];
@@ -426,6 +439,9 @@ struct _ref_rnn_common_t : public primitive_t {
             status_t st = init_brgemm(engine);
             if (st != status::success) {
                 rnn_.is_brgemm = false;
+                for (auto &r : weights_reorder_pd_)
+                    r.reset();
+                use_weights_cache_ = false;
                 st = init_ref(engine);
             }
             if (st == status::success) {
@@ -445,6 +461,13 @@ struct _ref_rnn_common_t : public primitive_t {
 
         rnn_utils::rnn_conf_t rnn_;
 
+        // The layouts of the layer, iter and projection weights used by the
+        // brgemm kernels, and the reorders that pack the user weights into
+        // them when the layouts differ.
+        memory_desc_t packed_weights_md_[3];
+        std::shared_ptr<primitive_desc_t> weights_reorder_pd_[3];
+        bool use_weights_cache_ = false;
+
     private:
         void init_scratchpad(size_t scratchpad_sz) {
             using namespace memory_tracking::names;
@@ -486,6 +509,20 @@ struct _ref_rnn_common_t : public primitive_t {
             scratchpad.template book<scratch_t>(
                     key_rnn_cell, rnn_.scratch_cell_size);
 
+            const memory_tracking::key_t packed_wei_keys[3]
+                    = {key_rnn_packed_wei_layer, key_rnn_packed_wei_iter,
+                            key_rnn_packed_wei_projection};
+            for (int i = 0; i < 3; i++) {
+                if (!weights_reorder_pd_[i]) continue;
+                if (!use_weights_cache_) {
+                    const memory_desc_wrapper packed_d(packed_weights_md_[i]);
+                    scratchpad.book(packed_wei_keys[i], packed_d.size(), 1,
+                            platform::get_cache_line_size());
+                }
+                scratchpad.book(key_nested_multiple + i,
+                        weights_reorder_pd_[i]->scratchpad_registry());
+            }
+
 #if DNNL_X64
             if (rnn_.is_brgemm) {
                 ref_rnn_brgemm_t::init_scratchpad(rnn_, scratchpad,
@@ -567,8 +604,13 @@ struct _ref_rnn_common_t : public primitive_t {
                 scratch_cell_offset_, scratchpad_size, workspace_size);
 #if DNNL_X64
         const auto rnn = pd()->rnn_;
-        if (rnn.is_brgemm)
+        if (rnn.is_brgemm) {
+            for (int i = 0; i < 3; i++)
+                if (pd()->weights_reorder_pd_[i])
+                    CHECK(pd()->weights_reorder_pd_[i]->create_primitive(
+                            weights_reorders_[i], engine));
             return rnn_brgemm_.init_kernels(rnn, src_type, weights_type);
+        }
 #endif
         return status::success;
     }
@@ -576,15 +618,19 @@ struct _ref_rnn_common_t : public primitive_t {
     ~_ref_rnn_common_t() { delete rnn_postgemm_; }
 
     status_t execute(const exec_ctx_t &ctx) const override {
-        execute_(ctx);
-        return status::success;
+        return execute_(ctx);
     }
 
 private:
 #if DNNL_X64
     ref_rnn_brgemm_t rnn_brgemm_;
 #endif
-    void execute_(const exec_ctx_t &ctx) const;
+    std::shared_ptr<primitive_t> weights_reorders_[3];
+
+    status_t execute_(const exec_ctx_t &ctx) const;
+    status_t pack_weights(const exec_ctx_t &ctx,
+            rnn_utils::weights_type_t type, int arg, const char *&weights,
+            std::shared_ptr<void> &cached) const;
 
     rnn_grid_execution_sig(linear_execution);
     rnn_cell_execution_sig(cell_execution_ref);
@@ -21,6 +21,7 @@
 #include <type_traits>
 
 #include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
 #include "common/memory_desc_wrapper.hpp"
 #include "common/primitive.hpp"
 #include "common/utils.hpp"
@@ -75,8 +76,9 @@
             weights_t **weights_projection_, const float *weights_peephole_, \
             const float *w_proj_comp, void **bias_, \
             const src_layer_t *src_layer_, \
-            const src_layer_t *augru_attention_, const src_iter_t *src_iter_, \
-            const void *src_iter_c_, dst_layer_t *dst_layer_, \
+            const src_layer_t *augru_attention_, const int32_t *seq_lengths_, \
+            const src_iter_t *src_iter_, const void *src_iter_c_, \
+            dst_layer_t *dst_layer_, \
             dst_iter_t *dst_iter_, void *dst_iter_c_, \
             src_layer_t *ws_states_layer_, src_iter_t *ws_states_iter_, \
             void *ws_states_iter_c_, gemm_acc_t *ws_diff_states_layer_, \
@@ -117,8 +119,9 @@
             weights_t **weights_projection_, const float *weights_peephole_, \
             const float *w_proj_comp, void **bias_, \
             const src_layer_t *src_layer_, \
-            const src_layer_t *augru_attention_, const src_iter_t *src_iter_, \
-            const void *src_iter_c_, dst_layer_t *dst_layer_, \
+            const src_layer_t *augru_attention_, const int32_t *seq_lengths_, \
+            const src_iter_t *src_iter_, const void *src_iter_c_, \
+            dst_layer_t *dst_layer_, \
             dst_iter_t *dst_iter_, void *dst_iter_c_, \
             src_layer_t *ws_states_layer_, src_iter_t *ws_states_iter_, \
             void *ws_states_iter_c_, gemm_acc_t *ws_diff_states_layer_, \
@@ -326,6 +329,9 @@ struct rnn_conf_t {
     bool is_fwd = 0, is_training = 0, is_lbr = 0, is_lstm_peephole = 0,
          is_lstm_projection = 0, is_augru = 0, is_orig_gru = 0;
     bool use_workspace = 0;
+    // The sequences of the batch have their own lengths, the rows of the
+    // finished sequences are not computed.
+    bool with_seq_lengths = 0;
 
     // Size of workspace for each tensor in bytes
     // Notes:
@@ -359,6 +365,11 @@ struct rnn_conf_t {
          force_nocopy = false, use_layer_packed_gemm = false,
          use_iter_packed_gemm = false, use_projection_packed_gemm = false;
     int n_iter_scratch_gates = 0;
+    // The cells on the anti-diagonals of the grid are executed concurrently,
+    // every layer and direction has its own slot of the scratch gates and
+    // the scratch cell.
+    bool use_wavefront = false;
+    int n_scratch_slots = 1;
 
     inline bool is_int8() const {
         return is_signed_int8() || is_unsigned_int8();
@@ -589,6 +600,7 @@ bool init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
     rnn.is_training = utils::one_of(
             rd.prop_kind, prop_kind::forward_training, prop_kind::backward);
     rnn.is_lbr = utils::one_of(rd.cell_kind, dnnl_lbr_gru, dnnl_lbr_augru);
+    rnn.with_seq_lengths = rd.flags & dnnl_rnn_flags_seq_lengths;
     rnn.is_lstm_peephole = rd.cell_kind == dnnl_vanilla_lstm
             && !memory_desc_wrapper(rd.weights_peephole_desc).is_zero();
     rnn.is_lstm_projection = rd.cell_kind == dnnl_vanilla_lstm
@@ -783,6 +795,23 @@ bool init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
     rnn.merge_gemm_iter = (!rnn.is_brgemm)
             ? dst_layer_is_trivial_stride && !(rnn.is_fwd || is_gru)
             : false;
+    // With the sequence lengths the layer GEMM of every cell is computed for
+    // the rows of the running sequences only.
+    if (rnn.with_seq_lengths) rnn.merge_gemm_layer = false;
+
+    /* Decide to execute the cells of the grid along the anti-diagonals:
+     * for small batches a single cell does not have enough work for all the
+     * threads, while the cells of different layers and directions on the same
+     * anti-diagonal are independent. The layer GEMM can not be merged across
+     * the iterations then, as the iterations of a layer are not executed at
+     * once. */
+    const int wavefront_max_mb = 16;
+    rnn.use_wavefront = !rnn.is_brgemm && rnn.is_fwd && is_inference
+            && (is_f32 || is_bf16) && !rnn.is_lstm_projection
+            && (rnn.n_layer > 1 || rnn.n_dir > 1)
+            && rnn.mb <= wavefront_max_mb && dnnl_get_max_threads() > 1;
+    if (rnn.use_wavefront) rnn.merge_gemm_layer = false;
+    rnn.n_scratch_slots = rnn.use_wavefront ? rnn.n_layer * rnn.n_dir : 1;
     rnn.force_nocopy = false;
 #if DNNL_X64
     rnn.force_nocopy = x64::mayiuse(x64::avx)
@@ -831,6 +860,13 @@ bool init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
     rnn.use_iter_packed_gemm = false;
     rnn.use_projection_packed_gemm = false;
 #endif
+    // The weights are packed for a fixed number of rows of the source, while
+    // it changes across the iterations with the sequence lengths.
+    if (rnn.with_seq_lengths) {
+        rnn.use_layer_packed_gemm = false;
+        rnn.use_iter_packed_gemm = false;
+        rnn.use_projection_packed_gemm = false;
+    }
 
     /* Set packed gemm sizes */
     /* TODO: investigate the benefit of mixing packed and non-packed weights parts */
@@ -1023,7 +1059,8 @@ void set_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
             : (size_t)0;
     rnn.n_iter_scratch_gates
             = (rnn.merge_gemm_layer || rnn.merge_gemm_iter) ? rnn.n_iter : 1;
-    rnn.scratch_gates_size = rnn.n_iter_scratch_gates * rnn.scratch_gates_nld
+    rnn.scratch_gates_size = (size_t)rnn.n_scratch_slots
+            * rnn.n_iter_scratch_gates * rnn.scratch_gates_nld
             * rnn.scratch_gates_ld * sizeof(typename T::scratch_t);
     rnn.scratch_ht_size
             = rnn.scratch_ht_nld * rnn.scratch_ht_ld * sizeof(typename T::ht_t);
@@ -1042,6 +1079,7 @@ void set_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
                                     * rnn.ws_states_layer_ld
                                     * sizeof(typename T::gemm_acc_t)
                             : 0);
+    rnn.scratch_cell_size *= rnn.n_scratch_slots;
     /// workspace needed for lbr GRU
     rnn.ws_per_cell = (size_t)rnn.is_lbr * rnn.mb * rnn.dhc
             * sizeof(typename T::gemm_acc_t);
@@ -0,0 +1,101 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "common/memory_desc_wrapper.hpp"
+#include "common/nstl.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/platform.hpp"
+#include "cpu/rnn/rnn_weights_cache.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace rnn_utils {
+
+weights_cache_t &weights_cache_t::global() {
+    static weights_cache_t cache(capacity());
+    return cache;
+}
+
+int weights_cache_t::capacity() {
+    static const int capacity = nstl::max(
+            getenv_int_user("RNN_WEIGHTS_CACHE_CAPACITY", 0), 0);
+    return capacity;
+}
+
+status_t weights_cache_t::get_or_pack(const void *weights,
+        const memory_desc_t &user_md, const memory_desc_t &packed_md,
+        const pack_func_t &pack, std::shared_ptr<void> &packed) {
+    const key_t key {weights, user_md, packed_md};
+
+    // The weights are packed outside of the lock, the other threads that
+    // need the same copy wait for the promise instead.
+    std::promise<value_t> promise;
+    std::shared_future<value_t> value;
+    bool found = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+            if (it->key == key) {
+                entries_.splice(entries_.begin(), entries_, it);
+                value = it->value;
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            value = promise.get_future().share();
+            entries_.push_front({key, value});
+            if ((int)entries_.size() > capacity_) entries_.pop_back();
+        }
+    }
+
+    if (found) {
+        const auto &v = value.get();
+        packed = v.packed;
+        return v.status;
+    }
+
+    const size_t size = memory_desc_wrapper(packed_md).size();
+    void *ptr = impl::malloc(size, platform::get_cache_line_size());
+    status_t status = ptr ? pack(ptr) : status::out_of_memory;
+    if (status == status::success) {
+        packed = std::shared_ptr<void>(ptr, impl::free);
+    } else {
+        impl::free(ptr);
+        packed.reset();
+        // do not keep the failures, the next call packs the weights again
+        remove(key);
+    }
+    promise.set_value({packed, status});
+    return status;
+}
+
+void weights_cache_t::remove(const key_t &key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+        if (it->key == key) {
+            entries_.erase(it);
+            return;
+        }
+    }
+}
+
+} // namespace rnn_utils
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
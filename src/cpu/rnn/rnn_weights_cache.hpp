@@ -0,0 +1,95 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_RNN_RNN_WEIGHTS_CACHE_HPP
+#define CPU_RNN_RNN_WEIGHTS_CACHE_HPP
+
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include "common/c_types_map.hpp"
+#include "common/type_helpers.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace rnn_utils {
+
+// Keeps the copies of the RNN weights packed from the user layout into the
+// layout of the brgemm kernels, so that the weights are packed once per
+// weights buffer instead of at every execution. A copy is identified by the
+// address of the user weights and by the user and the packed memory
+// descriptors. None of them depends on the batch size or the sequence length,
+// so the primitives that differ only in those share the copy.
+//
+// The cache can not detect the weights modified in place, hence it is
+// disabled by default and used for the inference only. It is enabled by
+// setting ONEDNN_RNN_WEIGHTS_CACHE_CAPACITY to the number of the copies to
+// keep; the least recently used copy is evicted first.
+struct weights_cache_t {
+    using pack_func_t = std::function<status_t(void *packed)>;
+
+    static weights_cache_t &global();
+    static int capacity();
+
+    // Returns the packed copy of the weights at `weights` in `packed`,
+    // calling `pack` to produce it on a miss. The copy stays alive as long as
+    // `packed` holds it, even if it is evicted from the cache meanwhile.
+    status_t get_or_pack(const void *weights, const memory_desc_t &user_md,
+            const memory_desc_t &packed_md, const pack_func_t &pack,
+            std::shared_ptr<void> &packed);
+
+private:
+    struct key_t {
+        const void *weights;
+        memory_desc_t user_md;
+        memory_desc_t packed_md;
+
+        bool operator==(const key_t &rhs) const {
+            return weights == rhs.weights && user_md == rhs.user_md
+                    && packed_md == rhs.packed_md;
+        }
+    };
+
+    struct value_t {
+        std::shared_ptr<void> packed;
+        status_t status;
+    };
+
+    struct entry_t {
+        key_t key;
+        std::shared_future<value_t> value;
+    };
+
+    weights_cache_t(int capacity) : capacity_(capacity) {}
+
+    void remove(const key_t &key);
+
+    const int capacity_;
+    // the most recently used entries go first
+    std::list<entry_t> entries_;
+    mutable std::mutex mutex_;
+};
+
+} // namespace rnn_utils
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
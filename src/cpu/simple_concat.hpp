@@ -41,6 +41,7 @@ struct simple_concat_t : public primitive_t {
             const memory_desc_wrapper dst_d(dst_md());
             bool ok = platform::has_data_type_support(data_type)
                     && cpu_concat_pd_t::init() == status::success
+                    && attr()->scales_.has_default_values()
                     && dst_d.ndims() <= 6;
             if (!ok) return status::unimplemented;
 
@@ -22,8 +22,10 @@
 #include "common/reorder.hpp"
 #include "common/type_helpers.hpp"
 
+#include "cpu/binary_injector_utils.hpp"
 #include "cpu/cpu_batch_normalization_utils.hpp"
 #include "cpu/cpu_engine.hpp"
+#include "cpu/cpu_primitive.hpp"
 
 #include "cpu/simple_layer_normalization.hpp"
 
@@ -49,21 +51,32 @@ status_t fill_compatible_stats_md(
 
 } // namespace
 
-template <data_type_t data_type>
-status_t simple_layer_normalization_fwd_t<data_type>::pd_t::init(
-        engine_t *engine) {
+status_t simple_layer_normalization_fwd_t::pd_t::init(engine_t *engine) {
     using namespace data_type;
+    using skip_mask_t = primitive_attr_t::skip_mask_t;
     const memory_desc_wrapper src_d(src_md());
-
-    const bool ok = is_fwd() && !has_zero_dim_memory()
-            && platform::has_data_type_support(data_type)
-            && utils::everyone_is(
-                    data_type, src_md()->data_type, dst_md()->data_type)
+    const data_type_t src_dt = src_md()->data_type;
+    const data_type_t dst_dt = dst_md()->data_type;
+
+    bool ok = is_fwd() && !has_zero_dim_memory()
+            && utils::one_of(src_dt, f32, bf16, s8, u8)
+            && utils::one_of(dst_dt, f32, bf16, s8, u8)
+            && platform::has_data_type_support(src_dt)
+            && platform::has_data_type_support(dst_dt)
             && (f32 == stat_md()->data_type) && check_scale_shift_data_type()
             && src_d.is_blocking_desc()
             && src_d.blocking_desc().strides[ndims() - 1]
                     == 1 // plain format, last logical dim is last physical
-            && attr()->has_default_values() && set_default_formats_common();
+            && attr()->has_default_values(
+                    skip_mask_t::oscale_runtime | skip_mask_t::post_ops)
+            && attr()->output_scales_.mask_ == 0
+            && set_default_formats_common()
+            && attr_.set_default_formats(dst_md(0)) == status::success;
+    if (!ok) return status::unimplemented;
+
+    // the kernel uses the same offsets for the source and the destination
+    ok = memory_desc_wrapper(dst_md()).similar_to(src_d, true, false, 0)
+            && lnorm_utils::stat_and_data_kernel_t::is_supported(this);
     if (!ok) return status::unimplemented;
 
     CHECK(fill_compatible_stats_md(*src_md(), reordered_stat_md_));
@@ -78,16 +91,19 @@ status_t simple_layer_normalization_fwd_t<data_type>::pd_t::init(
     return status::success;
 }
 
-template <data_type_t data_type>
-status_t simple_layer_normalization_fwd_t<data_type>::execute_forward(
+status_t simple_layer_normalization_fwd_t::execute_forward(
         const exec_ctx_t &ctx) const {
     const bool use_ss = pd()->use_scaleshift();
     const bool use_scale = pd()->use_scale();
     const bool use_shift = pd()->use_shift();
 
     auto scratchpad = ctx.get_scratchpad_grantor();
-    auto src = CTX_IN_MEM(const data_t *, DNNL_ARG_SRC);
-    auto dst = CTX_OUT_MEM(data_t *, DNNL_ARG_DST);
+    auto src = CTX_IN_MEM(const char *, DNNL_ARG_SRC);
+    auto dst = CTX_OUT_MEM(char *, DNNL_ARG_DST);
+    DEFINE_SCALES_BUFFER(oscales);
+    const auto post_ops_binary_rhs_arg_vec
+            = binary_injector_utils::prepare_binary_args(
+                    pd()->attr()->post_ops_, ctx);
 
     const memory_desc_wrapper ss_d(pd()->weights_md());
     const size_t shift_off
@@ -113,17 +129,22 @@ status_t simple_layer_normalization_fwd_t<data_type>::execute_forward(
     }
 
     const memory_desc_wrapper src_d(pd()->src_md());
+    const memory_desc_wrapper dst_d(pd()->dst_md());
 
     const dim_t N = pd()->across_axis();
     const dim_t C_padded = src_d.padded_dims()[pd()->ndims() - 1];
+    const size_t src_row_size = C_padded * src_d.data_type_size();
+    const size_t dst_row_size = C_padded * dst_d.data_type_size();
 
     parallel(0, [&](const int ithr, const int nthr) {
         dim_t N_start = 0, N_end = 0;
         balance211(N, nthr, ithr, N_start, N_end);
         const int block_size = N_end - N_start;
-        (*stat_and_data_kernel_)(&src[N_start * C_padded],
-                &dst[N_start * C_padded], scale, shift, &mean[N_start],
-                &variance[N_start], block_size);
+        // the mean is not used by the RMS normalization
+        (*stat_and_data_kernel_)(&src[N_start * src_row_size],
+                &dst[N_start * dst_row_size], scale, shift,
+                mean ? &mean[N_start] : nullptr, &variance[N_start], oscales,
+                post_ops_binary_rhs_arg_vec.data(), dst, block_size);
     });
     return status::success;
 }
@@ -134,7 +155,7 @@ status_t simple_layer_normalization_bwd_t<data_type>::pd_t::init(
     using namespace data_type;
     const memory_desc_wrapper src_d(src_md());
 
-    const bool ok = is_bwd() && !has_zero_dim_memory()
+    const bool ok = is_bwd() && !use_rms_norm() && !has_zero_dim_memory()
             && set_default_formats_common()
             && platform::has_data_type_support(data_type)
             && utils::everyone_is(
@@ -255,8 +276,6 @@ status_t simple_layer_normalization_bwd_t<data_type>::execute_backward(
     return status::success;
 }
 
-template struct simple_layer_normalization_fwd_t<bf16>;
-template struct simple_layer_normalization_fwd_t<f32>;
 template struct simple_layer_normalization_bwd_t<bf16>;
 template struct simple_layer_normalization_bwd_t<f32>;
 
@@ -34,7 +34,6 @@ namespace dnnl {
 namespace impl {
 namespace cpu {
 
-template <data_type_t data_type>
 struct simple_layer_normalization_fwd_t : public primitive_t {
     struct pd_t : public cpu_layer_normalization_fwd_pd_t {
         pd_t(const layer_normalization_desc_t *adesc,
@@ -75,7 +74,7 @@ struct simple_layer_normalization_fwd_t : public primitive_t {
         if (pd()->reorder_pd_)
             pd()->reorder_pd_->create_primitive(reorder_, engine);
         CHECK(safe_ptr_assign(stat_and_data_kernel_,
-                lnorm_utils::stat_and_data_kernel_t<data_type>::create(pd())));
+                lnorm_utils::stat_and_data_kernel_t::create(pd())));
         if (stat_and_data_kernel_)
             CHECK(stat_and_data_kernel_->create_kernel());
         return status::success;
@@ -110,10 +109,14 @@ struct simple_layer_normalization_fwd_t : public primitive_t {
         memory_t variance(
                 engine, &(pd()->reordered_stat_md_), std::move(variance_mem));
 
+        // the RMS normalization has no mean
+        const bool with_mean = !pd()->use_rms_norm();
+
         // reorder input stats
         if (pd()->stats_are_src() && reorder_) {
-            reorder_stat(
-                    ctx, engine, ctx.args().at(DNNL_ARG_MEAN), {&mean, false});
+            if (with_mean)
+                reorder_stat(ctx, engine, ctx.args().at(DNNL_ARG_MEAN),
+                        {&mean, false});
             reorder_stat(ctx, engine, ctx.args().at(DNNL_ARG_VARIANCE),
                     {&variance, false});
         }
@@ -121,8 +124,9 @@ struct simple_layer_normalization_fwd_t : public primitive_t {
         if (status != status::success) return status;
         // reorder output stats
         if (!pd()->stats_are_src() && reorder_) {
-            reorder_stat(
-                    ctx, engine, {&mean, true}, ctx.args().at(DNNL_ARG_MEAN));
+            if (with_mean)
+                reorder_stat(ctx, engine, {&mean, true},
+                        ctx.args().at(DNNL_ARG_MEAN));
             reorder_stat(ctx, engine, {&variance, true},
                     ctx.args().at(DNNL_ARG_VARIANCE));
         }
@@ -131,12 +135,10 @@ struct simple_layer_normalization_fwd_t : public primitive_t {
     }
 
 private:
-    using data_t = typename prec_traits<data_type>::type;
     status_t execute_forward(const exec_ctx_t &ctx) const;
     const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
 
-    std::unique_ptr<lnorm_utils::stat_and_data_kernel_t<data_type>>
-            stat_and_data_kernel_;
+    std::unique_ptr<lnorm_utils::stat_and_data_kernel_t> stat_and_data_kernel_;
     std::shared_ptr<primitive_t> reorder_;
 };
 
@@ -32,21 +32,26 @@ namespace lnorm_utils {
 
 using namespace data_type;
 
-template <>
-void stat_and_data_kernel_t<f32>::operator()(const float *src, float *dst,
+void stat_and_data_kernel_t::operator()(const void *src_, void *dst_,
         const float *scale, const float *shift, float *mean, float *var,
-        const size_t block_size) const {
+        const float *oscales, const void *post_ops_binary_rhs_arg_vec,
+        const void *dst_orig, const size_t block_size) const {
+    // The default kernel is created for f32 without attributes only.
+    const float *src = static_cast<const float *>(src_);
+    float *dst = static_cast<float *>(dst_);
     // XXX: manual unrolling for use_scaleshift_ due to clang issue.
     //      see: CLANG_WA_01_SAFE_TO_USE_OMP_SIMD
     for (size_t offset = 0; offset < block_size; offset++) {
         float v_mean, v_variance;
         if (calculate_stats_) {
             v_mean = 0;
-            PRAGMA_OMP_SIMD(reduction(+ : v_mean))
-            for (dim_t c = 0; c < C_; ++c) {
-                v_mean += src[c + C_ * offset];
+            if (!use_rms_norm_) {
+                PRAGMA_OMP_SIMD(reduction(+ : v_mean))
+                for (dim_t c = 0; c < C_; ++c) {
+                    v_mean += src[c + C_ * offset];
+                }
+                v_mean /= C_;
             }
-            v_mean /= C_;
 
             v_variance = 0;
             PRAGMA_OMP_SIMD(reduction(+ : v_variance))
@@ -56,7 +61,7 @@ void stat_and_data_kernel_t<f32>::operator()(const float *src, float *dst,
             }
             v_variance /= C_;
         } else {
-            v_mean = mean[offset];
+            v_mean = use_rms_norm_ ? 0 : mean[offset];
             v_variance = var[offset];
         }
 
@@ -93,7 +98,7 @@ void stat_and_data_kernel_t<f32>::operator()(const float *src, float *dst,
             }
         }
         if (calculate_stats_ && save_stats_) {
-            mean[offset] = v_mean;
+            if (!use_rms_norm_) mean[offset] = v_mean;
             var[offset] = v_variance;
         }
     }
@@ -188,13 +193,6 @@ void diff_data_kernel_t<bf16>::operator()(const bfloat16_t *src,
             "input!");
 }
 
-template <>
-void stat_and_data_kernel_t<bf16>::operator()(const bfloat16_t *src,
-        bfloat16_t *dst, const float *scale, const float *shift, float *mean,
-        float *var, const size_t block_size) const {
-    assert(!"No default stat_and_data_kernel_t operator() for bf16 input!");
-}
-
 template <>
 void diff_ss_kernel_t<bf16>::operator()(const bfloat16_t *src,
         const bfloat16_t *diff_dst, float *diff_gamma, float *diff_beta,
@@ -205,19 +203,28 @@ void diff_ss_kernel_t<bf16>::operator()(const bfloat16_t *src,
 
 // Interface section
 
-template <data_type_t data_type>
-stat_and_data_kernel_t<data_type> *stat_and_data_kernel_t<data_type>::create(
+stat_and_data_kernel_t *stat_and_data_kernel_t::create(
         const layer_normalization_pd_t *pd) {
 #if DNNL_X64
-    if (auto *res
-            = x64::lnorm_utils::stat_and_data_kernel_create<data_type>(pd))
+    if (auto *res = x64::lnorm_utils::stat_and_data_kernel_create(pd))
         return res;
 #endif
-    if (data_type == bf16) {
-        assert(!"No default stat_and_data_kernel_t for bf16 input!");
+    if (!utils::everyone_is(
+                f32, pd->src_md()->data_type, pd->dst_md()->data_type)
+            || !pd->attr()->has_default_values()) {
+        assert(!"No default stat_and_data_kernel_t for the configuration!");
         return nullptr;
     }
-    return new stat_and_data_kernel_t<data_type>(pd);
+    return new stat_and_data_kernel_t(pd);
+}
+
+bool stat_and_data_kernel_t::is_supported(const layer_normalization_pd_t *pd) {
+#if DNNL_X64
+    if (x64::lnorm_utils::stat_and_data_kernel_is_supported(pd)) return true;
+#endif
+    return utils::everyone_is(
+                   f32, pd->src_md()->data_type, pd->dst_md()->data_type)
+            && pd->attr()->has_default_values();
 }
 
 template <data_type_t data_type>
@@ -250,8 +257,6 @@ diff_data_kernel_t<data_type> *diff_data_kernel_t<data_type>::create(
 
 template struct diff_ss_kernel_t<f32>;
 template struct diff_ss_kernel_t<bf16>;
-template struct stat_and_data_kernel_t<f32>;
-template struct stat_and_data_kernel_t<bf16>;
 template struct diff_data_kernel_t<f32>;
 template struct diff_data_kernel_t<bf16>;
 
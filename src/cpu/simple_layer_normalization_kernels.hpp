@@ -24,15 +24,19 @@ namespace impl {
 namespace cpu {
 namespace lnorm_utils {
 
-template <data_type_t data_type>
 struct stat_and_data_kernel_t {
-    using data_t = typename prec_traits<data_type>::type;
-    static stat_and_data_kernel_t<data_type> *create(
-            const layer_normalization_pd_t *pd);
+    static stat_and_data_kernel_t *create(const layer_normalization_pd_t *pd);
+    // The default kernel supports f32 without attributes only, the other data
+    // types, the output scales and the post-ops require a JIT kernel.
+    static bool is_supported(const layer_normalization_pd_t *pd);
     virtual ~stat_and_data_kernel_t() = default;
 
-    virtual void operator()(const data_t *src, data_t *dst, const float *scale,
-            const float *shift, float *mean, float *var,
+    // The dst_orig pointer is the beginning of the destination tensor, it is
+    // used with post_ops_binary_rhs_arg_vec to find the offsets of the
+    // binary post-ops arguments.
+    virtual void operator()(const void *src, void *dst, const float *scale,
+            const float *shift, float *mean, float *var, const float *oscales,
+            const void *post_ops_binary_rhs_arg_vec, const void *dst_orig,
             const size_t block_size) const;
 
     virtual status_t create_kernel() { return status::success; }
@@ -45,6 +49,7 @@ protected:
         , use_shift_(pd->use_shift())
         , save_stats_(pd->is_training())
         , calculate_stats_(!pd->stats_are_src())
+        , use_rms_norm_(pd->use_rms_norm())
         , eps_(pd->desc()->layer_norm_epsilon) {}
 
     int C_;
@@ -53,6 +58,8 @@ protected:
     bool use_shift_;
     bool save_stats_;
     bool calculate_stats_;
+    // the mean is zero and is neither read nor written
+    bool use_rms_norm_;
     const float eps_;
 };
 
@@ -14,10 +14,16 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
 #include "cpu/x64/brgemm/brgemm.hpp"
 
 #include "common/c_types_map.hpp"
 #include "common/nstl.hpp"
+#include "common/serialization.hpp"
 #include "common/type_helpers.hpp"
 #include "common/utils.hpp"
 
@@ -142,26 +148,35 @@ void brgemm_kernel_execute_postops(const brgemm_kernel_t *brg_kernel, int bs,
 namespace {
 status_t brgemm_blocking(brgemm_t *brg) {
     if (!brg->is_int8_amx && !brg->is_bf16_amx) {
-        brg->ld_block = 16;
+        const bool is_ymm = brg->isa_impl == avx2;
+        brg->ld_block = is_ymm ? 8 : 16;
         brg->ldb = brg->load_dim / brg->ld_block;
         brg->ldb_tail = brg->load_dim % brg->ld_block;
 
-        brg->ld_block2 = 4; // (M < 9) ? 2 : 4 | TODO - fix this for INT8
+        // (M < 9) ? 2 : 4 | TODO - fix this for INT8
+        brg->ld_block2 = is_ymm ? 3 : 4;
         brg->ldb2 = brg->ldb / brg->ld_block2;
         brg->ldb2_tail = brg->ldb % brg->ld_block2;
 
         if (brg->ldb2 == 0) brg->ld_block2 = nstl::max(1, brg->ldb2_tail);
-        brg->embd_bcst = !brg->is_int8 && !brg->is_bf16
+        // Embedded broadcast is not available for Ymm registers
+        brg->embd_bcst = !is_ymm && !brg->is_int8 && !brg->is_bf16
                 && (brg->ldb2_tail <= 1 && brg->ldb2 == 0);
 
         int ld_block = (brg->ldb2 != 0) ? brg->ld_block2 : brg->ldb2_tail;
         int adj_ld_block = (ld_block == 0) ? (ld_block + 1) : ld_block;
 
-        const int max_avx512_regs = 32;
+        const int max_vregs = is_ymm ? cpu_isa_traits<avx2>::n_vregs
+                                     : cpu_isa_traits<avx512_core>::n_vregs;
         const int max_bcst_regs = 1;
+        // Ymm kernel reserves a register for post-ops and one more for the
+        // load tail mask
+        const int max_ymm_reserved_regs
+                = is_ymm ? 1 + (brg->ldb_tail != 0 ? 1 : 0) : 0;
         const bool req_compensation = brg->req_s8s8_compensation
                 || brg->zp_type_a != brgemm_broadcast_t::none;
-        int max_regs = max_avx512_regs - (adj_ld_block + max_bcst_regs);
+        int max_regs = max_vregs - (adj_ld_block + max_bcst_regs)
+                - max_ymm_reserved_regs;
         int max_block
                 = (brg->embd_bcst ? 28
                                   : ((brg->beta == 1.f || brg->beta == 0.f)
@@ -439,32 +454,49 @@ status_t brgemm_desc_init(brgemm_t *brg, cpu_isa_t isa,
     brg->dt_d = brg->dt_c;
     brg->dt_bias = brg->dt_c;
 
-    if (!IMPLICATION(brg->is_f32, mayiuse(avx512_core)))
-        return status::unimplemented;
-    if (!IMPLICATION(brg->is_bf16, mayiuse(avx512_core_bf16)))
-        return status::unimplemented;
-    if (!IMPLICATION(brg->is_int8, mayiuse(avx512_core_vnni)))
-        return status::unimplemented;
-
-    if (isa != isa_any) {
-        if (!one_of(isa, avx512_core, avx512_core_bf16, avx512_core_vnni,
-                    avx512_core_bf16_amx_bf16, avx512_core_bf16_amx_int8)) {
-            return status::invalid_arguments;
-        }
+    // The Ymm kernel is used for f32 and int8 on the machines without AVX512
+    // or when avx2 / avx2_vnni is requested explicitly.
+    const bool is_ymm = isa == isa_any ? !mayiuse(avx512_core)
+                                       : one_of(isa, avx2, avx2_vnni);
+    brg->isa_impl = is_ymm ? avx2 : avx512_core;
+    if (is_ymm) {
+        if (!IMPLICATION(brg->is_f32, mayiuse(avx2)))
+            return status::unimplemented;
+        if (brg->is_bf16) return status::unimplemented;
+        if (!IMPLICATION(brg->is_int8, mayiuse(avx2_vnni)))
+            return status::unimplemented;
         brg->is_int8_amx = brg->is_bf16_amx = false;
-        if (brg->is_int8 && isa == avx512_core_bf16_amx_int8) {
-            if (!mayiuse(avx512_core_bf16_amx_int8))
-                return status::invalid_arguments;
-            brg->is_int8_amx = true;
-        }
-        if (brg->is_bf16 && isa == avx512_core_bf16_amx_bf16) {
-            if (!mayiuse(avx512_core_bf16_amx_bf16))
+    } else {
+        if (!IMPLICATION(brg->is_f32, mayiuse(avx512_core)))
+            return status::unimplemented;
+        if (!IMPLICATION(brg->is_bf16, mayiuse(avx512_core_bf16)))
+            return status::unimplemented;
+        if (!IMPLICATION(brg->is_int8, mayiuse(avx512_core_vnni)))
+            return status::unimplemented;
+
+        if (isa != isa_any) {
+            if (!one_of(isa, avx512_core, avx512_core_bf16,
+                        avx512_core_vnni, avx512_core_bf16_amx_bf16,
+                        avx512_core_bf16_amx_int8)) {
                 return status::invalid_arguments;
-            brg->is_bf16_amx = true;
+            }
+            brg->is_int8_amx = brg->is_bf16_amx = false;
+            if (brg->is_int8 && isa == avx512_core_bf16_amx_int8) {
+                if (!mayiuse(avx512_core_bf16_amx_int8))
+                    return status::invalid_arguments;
+                brg->is_int8_amx = true;
+            }
+            if (brg->is_bf16 && isa == avx512_core_bf16_amx_bf16) {
+                if (!mayiuse(avx512_core_bf16_amx_bf16))
+                    return status::invalid_arguments;
+                brg->is_bf16_amx = true;
+            }
+        } else {
+            brg->is_int8_amx
+                    = brg->is_int8 && mayiuse(avx512_core_bf16_amx_int8);
+            brg->is_bf16_amx
+                    = brg->is_bf16 && mayiuse(avx512_core_bf16_amx_bf16);
         }
-    } else {
-        brg->is_int8_amx = brg->is_int8 && mayiuse(avx512_core_bf16_amx_int8);
-        brg->is_bf16_amx = brg->is_bf16 && mayiuse(avx512_core_bf16_amx_bf16);
     }
     brg->is_amx = (brg->is_int8_amx || brg->is_bf16_amx);
     brg->req_s8s8_compensation
@@ -612,8 +644,9 @@ status_t brgemm_desc_set_postops(brgemm_t *brg, const primitive_attr_t *attr,
                     data_type::f32)))
         return status::unimplemented;
     if ((brg->dt_a == data_type::f32 && brg->dt_b == data_type::f32)
-            && (!one_of(dt_d, data_type::f32))
-            && (!one_of(dt_bias, data_type::undef, data_type::f32)))
+            && (!one_of(dt_d, data_type::f32, data_type::f16))
+            && (!one_of(dt_bias, data_type::undef, data_type::f32,
+                    data_type::f16)))
         return status::unimplemented;
 
     brg->dt_d = dt_d;
@@ -622,6 +655,13 @@ status_t brgemm_desc_set_postops(brgemm_t *brg, const primitive_attr_t *attr,
     if (!IMPLICATION(
                 brg->is_int8 && brg->dt_d == bf16, mayiuse(avx512_core_vnni)))
         return status::unimplemented;
+    // The Ymm kernel doesn't support bf16 and f16 conversions.
+    if (brg->isa_impl == avx2 && brg->dt_d == bf16)
+        return status::unimplemented;
+    // The f16 conversions are implemented in the Zmm brgemm kernel only.
+    if ((brg->isa_impl == avx2 || brg->is_dgmm)
+            && one_of(f16, brg->dt_d, brg->dt_bias))
+        return status::unimplemented;
 
     if (brg->is_int8 && brg->dt_d == bf16)
         brg->is_bf16_emu = !mayiuse(avx512_core_bf16);
@@ -645,7 +685,8 @@ status_t brgemm_desc_set_postops(brgemm_t *brg, const primitive_attr_t *attr,
 
     const int binary_ind = post_ops.find(primitive_kind::binary);
     brg->with_binary = binary_ind != -1;
-    const cpu_isa_t isa = get_max_cpu_isa();
+    const cpu_isa_t isa
+            = brg->isa_impl == avx2 ? brg->isa_impl : get_max_cpu_isa();
 
     if ((brg->with_binary && !dst_md)
             || !injector::post_ops_ok(
@@ -753,8 +794,9 @@ status_t brgemm_desc_set_attr(brgemm_t *brg, const brgemm_attr_t &brgattr) {
     return status::success;
 }
 
-status_t brgemm_kernel_create(
-        brgemm_kernel_t **brg_kernel, const brgemm_t &brg) {
+namespace {
+
+status_t create_kernel(brgemm_kernel_t **brg_kernel, const brgemm_t &brg) {
     if (brg.is_dgmm) {
         CHECK(safe_ptr_assign<brgemm_kernel_t>(
                 *brg_kernel, new brdgmm_kernel_t(brg)));
@@ -766,13 +808,204 @@ status_t brgemm_kernel_create(
         CHECK(safe_ptr_assign<brgemm_kernel_t>(
                 *brg_kernel, new brgemm_amx_uker_t(brg)));
         return (*brg_kernel)->create_kernel();
+    } else if (brg.isa_impl == avx2) {
+        CHECK(safe_ptr_assign<brgemm_kernel_t>(*brg_kernel,
+                new brgemm_kernel_common_t<avx2, Xbyak::Ymm>(brg)));
+        return (*brg_kernel)->create_kernel();
     } else {
-        CHECK(safe_ptr_assign<brgemm_kernel_t>(
-                *brg_kernel, new brgemm_kernel_common_t(brg)));
+        CHECK(safe_ptr_assign<brgemm_kernel_t>(*brg_kernel,
+                new brgemm_kernel_common_t<avx512_core, Xbyak::Zmm>(brg)));
         return (*brg_kernel)->create_kernel();
     }
 }
 
+// Returns a key that identifies the code generated for the descriptor. The
+// pointers the descriptor holds are replaced with the data they point to.
+std::string get_kernel_key(const brgemm_t &brg) {
+    serialization_stream_t sstream;
+
+    sstream.write(&brg.bcast_dim);
+    sstream.write(&brg.load_dim);
+    sstream.write(&brg.reduce_dim);
+    sstream.write(&brg.LDA);
+    sstream.write(&brg.LDB);
+    sstream.write(&brg.LDC);
+    sstream.write(&brg.LDD);
+    sstream.write(&brg.alpha);
+    sstream.write(&brg.beta);
+    sstream.write(&brg.bdb);
+    sstream.write(&brg.bd_block);
+    sstream.write(&brg.bdb_tail);
+    sstream.write(&brg.bdb2);
+    sstream.write(&brg.bd_block2);
+    sstream.write(&brg.bdb2_tail);
+    sstream.write(&brg.ldb);
+    sstream.write(&brg.ld_block);
+    sstream.write(&brg.ldb_tail);
+    sstream.write(&brg.ldb2);
+    sstream.write(&brg.ld_block2);
+    sstream.write(&brg.ldb2_tail);
+    sstream.write(&brg.rdb);
+    sstream.write(&brg.rd_block);
+    sstream.write(&brg.rdb_tail);
+    sstream.write(&brg.rd_step);
+    sstream.write(&brg.ld_step);
+    sstream.write(&brg.dt_a);
+    sstream.write(&brg.dt_c);
+    sstream.write(&brg.dt_b);
+    sstream.write(&brg.dt_d);
+    sstream.write(&brg.dt_bias);
+    sstream.write(&brg.typesize_A);
+    sstream.write(&brg.typesize_B);
+    sstream.write(&brg.typesize_C);
+    sstream.write(&brg.typesize_D);
+    sstream.write(&brg.typesize_bias);
+    sstream.write(&brg.is_int8);
+    sstream.write(&brg.is_int8_amx);
+    sstream.write(&brg.is_bf16);
+    sstream.write(&brg.is_bf16_amx);
+    sstream.write(&brg.is_bf16_emu);
+    sstream.write(&brg.is_f32);
+    sstream.write(&brg.is_amx);
+    sstream.write(&brg.isa_impl);
+    sstream.write(&brg.stride_a);
+    sstream.write(&brg.stride_b);
+    sstream.write(&brg.layout);
+    sstream.write(&brg.type);
+    sstream.write(&brg.embd_bcst);
+    sstream.write(&brg.is_dgmm);
+    sstream.write(&brg.with_bias);
+    sstream.write(&brg.with_sum);
+    if (brg.with_sum) {
+        sstream.write(&brg.sum_scale);
+        sstream.write(&brg.sum_zp);
+        sstream.write(&brg.sum_dt);
+    }
+    sstream.write(&brg.with_eltwise);
+    sstream.write(&brg.with_binary);
+    sstream.write(&brg.with_scales);
+    sstream.write(&brg.with_comp_pads);
+    sstream.write(&brg.req_s8s8_compensation);
+    sstream.write(&brg.zp_type_a);
+    sstream.write(&brg.zp_type_b);
+    sstream.write(&brg.zp_type_c);
+    sstream.write(&brg.is_oc_scale);
+
+    const bool with_attr = brg.attr != nullptr;
+    sstream.write(&with_attr);
+    if (with_attr) serialization::serialize_attr(sstream, *brg.attr);
+    const bool with_dst_md = brg.dst_md != nullptr;
+    sstream.write(&with_dst_md);
+    if (with_dst_md) serialization::serialize_md(sstream, *brg.dst_md);
+
+    const auto &brgattr = brg.brgattr;
+    sstream.write(&brgattr.max_bs);
+    sstream.write(&brgattr.max_top_vpad);
+    sstream.write(&brgattr.max_bottom_vpad);
+    sstream.write(&brgattr.hint_expected_A_size);
+    sstream.write(&brgattr.hint_expected_B_size);
+    sstream.write(&brgattr.hint_expected_C_size);
+    sstream.write(&brgattr.hint_innermost_loop);
+    sstream.write(&brgattr.hint_loop_order);
+    sstream.write(&brgattr.hint_prefetching);
+    sstream.write(&brgattr.wary_tail_read);
+    sstream.write(&brgattr.generate_skip_accumulation);
+    sstream.write(&brgattr.bd_mask_level);
+    if (brgattr.bd_mask_level && brgattr.bd_mask)
+        sstream.write(brgattr.bd_mask, brg.bcast_dim);
+    sstream.write(&brgattr.use_uker);
+    sstream.write(&brgattr.use_interleave_stores);
+
+    const auto &data = sstream.get_data();
+    return std::string(data.begin(), data.end());
+}
+
+// A kernel that refers to a kernel shared with other primitives.
+struct brgemm_shared_kernel_t : public brgemm_kernel_t {
+    brgemm_shared_kernel_t(const std::shared_ptr<brgemm_kernel_t> &kernel)
+        : kernel_(kernel) {}
+
+    status_t create_kernel() override { return status::success; }
+    void operator()(brgemm_kernel_params_t *params) const override {
+        (*kernel_)(params);
+    }
+    const jit_generator *get_jit_generator() const override {
+        return kernel_->get_jit_generator();
+    }
+
+private:
+    std::shared_ptr<brgemm_kernel_t> kernel_;
+
+    DNNL_DISALLOW_COPY_AND_ASSIGN(brgemm_shared_kernel_t);
+};
+
+// A process-wide cache of the kernels that are in use. Primitives with
+// different shapes often generate identical kernels, e.g. convolutions that
+// differ in spatial sizes only, and share them through the cache. The cache
+// doesn't own the kernels: a kernel is destroyed once the last primitive that
+// uses it is destroyed.
+struct brgemm_kernel_cache_t {
+    std::shared_ptr<brgemm_kernel_t> get(const std::string &key) {
+        std::lock_guard<std::mutex> guard(mutex_);
+        auto it = kernels_.find(key);
+        if (it == kernels_.end()) return nullptr;
+        return it->second.lock();
+    }
+
+    // Returns the kernel already stored with the key by another thread if
+    // any, and the passed kernel otherwise.
+    std::shared_ptr<brgemm_kernel_t> add(const std::string &key,
+            const std::shared_ptr<brgemm_kernel_t> &kernel) {
+        std::lock_guard<std::mutex> guard(mutex_);
+        auto &entry = kernels_[key];
+        auto stored_kernel = entry.lock();
+        if (stored_kernel) return stored_kernel;
+        entry = kernel;
+
+        // Remove the entries of the destroyed kernels once their number is
+        // comparable with the number of alive ones.
+        if (kernels_.size() >= 2 * n_alive_after_cleanup_) {
+            for (auto it = kernels_.begin(); it != kernels_.end();) {
+                if (it->second.expired())
+                    it = kernels_.erase(it);
+                else
+                    ++it;
+            }
+            n_alive_after_cleanup_ = nstl::max(kernels_.size(), (size_t)64);
+        }
+        return kernel;
+    }
+
+private:
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::weak_ptr<brgemm_kernel_t>> kernels_;
+    size_t n_alive_after_cleanup_ = 64;
+};
+
+brgemm_kernel_cache_t &brgemm_kernel_cache() {
+    static brgemm_kernel_cache_t cache;
+    return cache;
+}
+
+} // namespace
+
+status_t brgemm_kernel_create(
+        brgemm_kernel_t **brg_kernel, const brgemm_t &brg) {
+    const std::string key = get_kernel_key(brg);
+    auto &cache = brgemm_kernel_cache();
+
+    std::shared_ptr<brgemm_kernel_t> kernel = cache.get(key);
+    if (!kernel) {
+        brgemm_kernel_t *new_kernel = nullptr;
+        const status_t status = create_kernel(&new_kernel, brg);
+        kernel.reset(new_kernel);
+        if (status != status::success) return status;
+        kernel = cache.add(key, kernel);
+    }
+    return safe_ptr_assign<brgemm_kernel_t>(
+            *brg_kernel, new brgemm_shared_kernel_t(kernel));
+}
+
 void brgemm_kernel_destroy(brgemm_kernel_t *brg_kernel) {
     delete brg_kernel;
 }
@@ -19,6 +19,7 @@
 
 #include "common/primitive_attr.hpp"
 #include "cpu/platform.hpp"
+#include "cpu/x64/cpu_isa_traits.hpp"
 
 namespace dnnl {
 namespace impl {
@@ -164,6 +165,9 @@ struct brgemm_t {
     bool is_bf16 = false, is_bf16_amx = false, is_bf16_emu = false;
     bool is_f32 = false;
     bool is_amx = false;
+    // The ISA the kernel is generated for: avx512_core or avx2 (the latter
+    // uses Ymm registers and serves avx2_vnni as well).
+    cpu_isa_t isa_impl = isa_any;
 
     dim_t stride_a = 0; // Offset in bytes
     dim_t stride_b = 0;
@@ -246,26 +250,32 @@ struct brgemm_kernel_params_t {
     int32_t zp_a_val = 1;
 };
 
+template <cpu_isa_t isa, typename Vmm>
 struct jit_brgemm_kernel_t;
 struct jit_brgemm_amx_uker_base_t;
 struct jit_brdgmm_kernel_base_t;
+struct jit_generator;
 
 struct brgemm_kernel_t {
     brgemm_kernel_t() {};
     virtual ~brgemm_kernel_t() {};
     virtual status_t create_kernel() = 0;
     virtual void operator()(brgemm_kernel_params_t *) const = 0;
+    // Returns the generator that holds the code of the kernel.
+    virtual const jit_generator *get_jit_generator() const = 0;
 };
 
+template <cpu_isa_t isa, typename Vmm>
 struct brgemm_kernel_common_t : public brgemm_kernel_t {
     brgemm_kernel_common_t(const brgemm_t abrd);
     ~brgemm_kernel_common_t();
 
     status_t create_kernel();
     void operator()(brgemm_kernel_params_t *) const;
+    const jit_generator *get_jit_generator() const;
 
 private:
-    jit_brgemm_kernel_t *brgemm_kernel_ = nullptr;
+    jit_brgemm_kernel_t<isa, Vmm> *brgemm_kernel_ = nullptr;
 
     DNNL_DISALLOW_COPY_AND_ASSIGN(brgemm_kernel_common_t);
 };
@@ -276,6 +286,7 @@ struct brgemm_amx_uker_t : public brgemm_kernel_t {
 
     status_t create_kernel();
     void operator()(brgemm_kernel_params_t *) const;
+    const jit_generator *get_jit_generator() const;
 
 private:
     jit_brgemm_amx_uker_base_t *brgemm_kernel_ = nullptr;
@@ -289,6 +300,7 @@ struct brdgmm_kernel_t : public brgemm_kernel_t {
 
     status_t create_kernel();
     void operator()(brgemm_kernel_params_t *) const;
+    const jit_generator *get_jit_generator() const;
 
 private:
     jit_brdgmm_kernel_base_t *brgemm_kernel_ = nullptr;
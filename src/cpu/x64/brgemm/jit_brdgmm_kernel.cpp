@@ -797,6 +797,10 @@ void brdgmm_kernel_t::operator()(brgemm_kernel_params_t *params) const {
     (*brgemm_kernel_)(params);
 }
 
+const jit_generator *brdgmm_kernel_t::get_jit_generator() const {
+    return brgemm_kernel_;
+}
+
 brdgmm_kernel_t::~brdgmm_kernel_t() {
     delete brgemm_kernel_;
 }
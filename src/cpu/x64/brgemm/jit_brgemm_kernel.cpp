@@ -38,11 +38,14 @@ namespace x64 {
 using namespace dnnl::impl::utils;
 using namespace Xbyak;
 
+template <cpu_isa_t isa, typename Vmm>
 struct jit_brgemm_kernel_t : public jit_generator {
     jit_brgemm_kernel_t(const brgemm_t &abrg)
-        : jit_generator(jit_name(), nullptr, MAX_CODE_SIZE, true, avx512_core)
+        : jit_generator(jit_name(), nullptr, MAX_CODE_SIZE, true, isa)
         , brg(abrg)
-        , postops_injector_(nullptr) {
+        , postops_injector_(nullptr)
+        , max_effective_vregs(
+                  max_vregs - (is_ymm_ && brg.ldb_tail != 0 ? 1 : 0)) {
 
         const int is_ldb2_tail = brg.ldb2_tail ? 1 : 0;
         const int is_ldb_tail = brg.ldb_tail ? 1 : 0;
@@ -63,17 +66,27 @@ struct jit_brgemm_kernel_t : public jit_generator {
                             broadcasting_strategy_t::per_mb_w,
                             broadcasting_strategy_t::per_w,
                             broadcasting_strategy_t::no_broadcast};
-            const binary_injector::rhs_arg_static_params_t rhs_sp {
-                    static_cast<size_t>(Xbyak::Zmm(1).getIdx()), this->r14,
-                    this->r15, preserve_gpr, preserve_vmm,
-                    GET_OFF(post_ops_binary_rhs_arg_vec), GET_OFF(data_C_ptr_),
-                    dst_md_wrapper, static_cast<size_t>(brg.ldb_tail),
-                    ld_tail_mask, use_exact_tail_scalar_bcast};
+            // Ymm kernels have no opmask registers, the binary injector
+            // handles the tail with a static tail size there.
+            const binary_injector::rhs_arg_static_params_t rhs_sp = is_ymm_
+                    ? binary_injector::rhs_arg_static_params_t {
+                            static_cast<size_t>(Vmm(1).getIdx()), this->r14,
+                            this->r15, preserve_gpr, preserve_vmm,
+                            GET_OFF(post_ops_binary_rhs_arg_vec),
+                            GET_OFF(data_C_ptr_), dst_md_wrapper,
+                            static_cast<size_t>(brg.ldb_tail),
+                            use_exact_tail_scalar_bcast}
+                    : binary_injector::rhs_arg_static_params_t {
+                            static_cast<size_t>(Vmm(1).getIdx()), this->r14,
+                            this->r15, preserve_gpr, preserve_vmm,
+                            GET_OFF(post_ops_binary_rhs_arg_vec),
+                            GET_OFF(data_C_ptr_), dst_md_wrapper,
+                            static_cast<size_t>(brg.ldb_tail), ld_tail_mask,
+                            use_exact_tail_scalar_bcast};
             const binary_injector::static_params_t bsp {
                     this->param1, enabled_bcast_strategy, rhs_sp};
 
-            postops_injector_ = utils::make_unique<
-                    injector::jit_uni_postops_injector_t<avx512_core>>(
+            postops_injector_ = utils::make_unique<po_injector_t>(
                     this, brg.attr->post_ops_, bsp);
 
             using namespace dnnl::impl::cpu::binary_injector_utils;
@@ -104,8 +117,8 @@ struct jit_brgemm_kernel_t : public jit_generator {
     brgemm_t brg;
 
 private:
-    std::unique_ptr<injector::jit_uni_postops_injector_t<avx512_core>>
-            postops_injector_;
+    using po_injector_t = injector::jit_uni_postops_injector_t<isa, Vmm>;
+    std::unique_ptr<po_injector_t> postops_injector_;
     std::unique_ptr<bf16_emulation_t> bf16_emu_;
 
     using reg64_t = const Xbyak::Reg64;
@@ -217,36 +230,45 @@ private:
     bool with_binary_per_w_bcast_ = false;
     bool with_binary_no_bcast_ = false;
 
+    static constexpr bool is_ymm_ = std::is_same<Vmm, Xbyak::Ymm>::value;
+    static constexpr int max_vregs = cpu_isa_traits<isa>::n_vregs;
+    // The number of vector registers available for the accumulators and the
+    // data registers. Ymm kernels keep the ld tail mask in the last one.
+    const int max_effective_vregs;
+
     Xbyak::Opmask ld_full_mask = Xbyak::Opmask(2);
     Xbyak::Opmask ld_tail_mask = Xbyak::Opmask(3);
 
-    Xbyak::Zmm accm(int ld_block, int bd, int ld) {
-        return Xbyak::Zmm(31 - (bd * ld_block + ld));
+    Vmm accm(int ld_block, int bd, int ld) {
+        return Vmm(max_effective_vregs - 1 - (bd * ld_block + ld));
     }
 
-    Xbyak::Zmm bcst(int bd = 0) {
+    Vmm bcst(int bd = 0) {
         if (n_bcast_1_load) {
-            int idx = 31 - (brg.ld_block2 * brg.bd_block) - bd;
+            int idx = max_effective_vregs - 1 - (brg.ld_block2 * brg.bd_block)
+                    - bd;
             assert(idx > 0);
-            return Xbyak::Zmm(idx);
+            return Vmm(idx);
         } else
-            return this->zmm0;
+            return Vmm(0);
     }
 
-    Xbyak::Zmm load(int ld = 0) {
+    Vmm load(int ld = 0) {
         if (n_bcast_1_load) {
-            return this->zmm0;
+            return Vmm(0);
         } else {
-            int idx = 31 - (brg.ld_block2 * brg.bd_block) - ld;
+            int idx = max_effective_vregs - 1 - (brg.ld_block2 * brg.bd_block)
+                    - ld;
             assert(idx > 0);
-            return Xbyak::Zmm(idx);
+            return Vmm(idx);
         }
     }
 
-    const Xbyak::Zmm &zmm_tmp_1() const noexcept { return this->zmm0; }
-    const Xbyak::Zmm &zmm_tmp_2() const noexcept { return this->zmm1; }
-    const Xbyak::Zmm &zmm_tmp_3() const noexcept { return this->zmm2; }
-    const Xbyak::Zmm &zmm_inp_shift() const noexcept { return this->zmm1; }
+    Vmm vmm_tmp_1() const noexcept { return Vmm(0); }
+    Vmm vmm_tmp_2() const noexcept { return Vmm(1); }
+    Vmm vmm_tmp_3() const noexcept { return Vmm(2); }
+    Vmm vmm_inp_shift() const noexcept { return Vmm(1); }
+    Vmm vmm_tail_mask() const noexcept { return Vmm(max_vregs - 1); }
 
     /* bf16 emulation */
     const Xbyak::Zmm &bf16_emu_reserv_1() const noexcept { return this->zmm0; }
@@ -255,14 +277,16 @@ private:
     const Xbyak::Zmm &bf16_emu_reserv_4() const noexcept { return this->zmm3; }
     // note: zmm reserv_5 is not necessary since it's only used for 'vdpbf16ps'
 
-    Xbyak::Zmm zmm_mask(const Xbyak::Zmm zmm_in, bool mask_flag, bool store,
+    Vmm vmm_mask(const Vmm vmm_in, bool mask_flag, bool store,
             Xbyak::Opmask ktail_mask) const;
     Xbyak::Ymm ymm_mask(const Xbyak::Ymm ymm_in, bool mask_flag, bool store,
             Xbyak::Opmask ktail_mask) const;
 
-    void cvt2ps(data_type_t type_in, const Xbyak::Zmm zmm_in,
-            const Xbyak::Operand &op, bool mask_flag, bool store,
-            Xbyak::Opmask ktail_mask);
+    void cvt2ps(data_type_t type_in, const Vmm vmm_in,
+            const Xbyak::Address &addr, bool mask_flag, bool store,
+            Xbyak::Opmask ktail_mask, int tail_size);
+    void load_vmm(const Vmm &vmm, const Xbyak::Address &addr, bool is_tail);
+    void store_vmm(const Xbyak::Address &addr, const Vmm &vmm, bool is_tail);
 
     void advance_ldb_post_op_regs();
     void restore_ldb_post_op_regs(int ld_block2);
@@ -339,118 +363,154 @@ private:
     bool vpad_exist = false;
 };
 
-int jit_brgemm_kernel_t::A_offset(int bd, int rd, bool is_amx) const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::A_offset(
+        int bd, int rd, bool is_amx) const noexcept {
     return (is_amx) ? brg.typesize_A * (bd * brg.bd_block * brg.LDA)
                     : brg.typesize_A * (bd * brg.LDA + rd);
 }
-int jit_brgemm_kernel_t::B_offset(int ld, int rd, bool is_amx) const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::B_offset(
+        int ld, int rd, bool is_amx) const noexcept {
     return (is_amx)
             ? brg.typesize_B * (brg.rd_step * ld * brg.ld_block)
             : brg.typesize_B * (rd * brg.LDB + brg.rd_step * ld * brg.ld_block);
 }
-int jit_brgemm_kernel_t::C_offset(int bd, int ld) const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::C_offset(int bd, int ld) const noexcept {
     return brg.typesize_C * (bd * brg.LDC + ld * brg.ld_block);
 }
-int jit_brgemm_kernel_t::D_offset(int bd, int ld) const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::D_offset(int bd, int ld) const noexcept {
     return brg.typesize_D * (bd * brg.LDD + ld * brg.ld_block);
 }
-int jit_brgemm_kernel_t::po_offset(int bd, int ld) const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::po_offset(int bd, int ld) const noexcept {
     return bd * brg.LDD + ld * brg.ld_block;
 }
 
-int jit_brgemm_kernel_t::rdb_A_offset() const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::rdb_A_offset() const noexcept {
     return brg.typesize_A * brg.rd_block;
 }
-int jit_brgemm_kernel_t::rdb_B_offset() const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::rdb_B_offset() const noexcept {
     return brg.typesize_B * brg.rd_block * brg.LDB;
 }
 
-int jit_brgemm_kernel_t::ldb_B_offset(int ld_block2, bool is_tail) const
-        noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::ldb_B_offset(
+        int ld_block2, bool is_tail) const noexcept {
     return (is_tail) ? brg.typesize_B * brg.ldb_tail * brg.ld_step
                      : brg.typesize_B * ld_block2 * brg.ld_block * brg.ld_step;
 }
-int jit_brgemm_kernel_t::ldb_C_offset(int ld_block2, bool is_tail) const
-        noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::ldb_C_offset(
+        int ld_block2, bool is_tail) const noexcept {
     return (is_tail) ? brg.typesize_C * brg.ldb_tail
                      : brg.typesize_C * ld_block2 * brg.ld_block;
 }
-int jit_brgemm_kernel_t::ldb_D_offset(int ld_block2, bool is_tail) const
-        noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::ldb_D_offset(
+        int ld_block2, bool is_tail) const noexcept {
     return (is_tail) ? brg.typesize_D * brg.ldb_tail
                      : brg.typesize_D * ld_block2 * brg.ld_block;
 }
-int jit_brgemm_kernel_t::ldb_po_offset(int ld_block2, bool is_tail) const
-        noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::ldb_po_offset(
+        int ld_block2, bool is_tail) const noexcept {
     return (is_tail) ? brg.ldb_tail : ld_block2 * brg.ld_block;
 }
 
-int jit_brgemm_kernel_t::bdb_A_offset(int bd_block2) const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::bdb_A_offset(int bd_block2) const noexcept {
     return brg.typesize_A * bd_block2 * brg.bd_block * brg.LDA;
 }
-int jit_brgemm_kernel_t::bdb_C_offset(int bd_block2) const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::bdb_C_offset(int bd_block2) const noexcept {
     return brg.typesize_C * bd_block2 * brg.bd_block * brg.LDC;
 }
-int jit_brgemm_kernel_t::bdb_D_offset(int bd_block2) const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::bdb_D_offset(int bd_block2) const noexcept {
     return brg.typesize_D * bd_block2 * brg.bd_block * brg.LDD;
 }
-int jit_brgemm_kernel_t::bdb_po_offset(int bd_block2) const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::bdb_po_offset(int bd_block2) const noexcept {
     return bd_block2 * brg.bd_block * brg.LDD;
 }
 
-int jit_brgemm_kernel_t::bias_offset(int ld, bool is_tail) const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::bias_offset(
+        int ld, bool is_tail) const noexcept {
     return (is_tail) ? brg.typesize_bias * brg.ldb_tail
                      : brg.typesize_bias * ld * brg.ld_block;
 }
 
-int jit_brgemm_kernel_t::oc_logical_offset(int ld, bool is_tail) const
-        noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::oc_logical_offset(
+        int ld, bool is_tail) const noexcept {
     return (is_tail) ? brg.ldb_tail : ld * brg.ld_block;
 }
 
-int jit_brgemm_kernel_t::compensations_offset(int ld, bool is_tail) const
-        noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::compensations_offset(
+        int ld, bool is_tail) const noexcept {
     return (is_tail) ? sizeof(int32_t) * brg.ldb_tail
                      : sizeof(int32_t) * ld * brg.ld_block;
 }
 
-int jit_brgemm_kernel_t::bdb_compensation_offset(int bd_block2) const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::bdb_compensation_offset(
+        int bd_block2) const noexcept {
     return sizeof(int32_t) * bd_block2 * brg.bd_block * brg.LDB;
 }
 
-int jit_brgemm_kernel_t::compensation_vpad_offset(int ld, int bd) const
-        noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::compensation_vpad_offset(
+        int ld, int bd) const noexcept {
     return sizeof(int32_t) * (ld * brg.ld_block + bd * brg.LDB);
 }
 
-int jit_brgemm_kernel_t::scales_offset(int ld, bool is_tail) const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::scales_offset(
+        int ld, bool is_tail) const noexcept {
     return (is_tail) ? brg.is_oc_scale * sizeof(float) * brg.ldb_tail
                      : brg.is_oc_scale * sizeof(float) * ld * brg.ld_block;
 }
 
-int jit_brgemm_kernel_t::zp_comp_a_offset(int ld, bool is_tail) const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::zp_comp_a_offset(
+        int ld, bool is_tail) const noexcept {
     return (is_tail) ? sizeof(int32_t) * brg.ldb_tail
                      : sizeof(int32_t) * ld * brg.ld_block;
 }
 
-int jit_brgemm_kernel_t::bdb_zp_comp_a_offset(int bd_block2) const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::bdb_zp_comp_a_offset(
+        int bd_block2) const noexcept {
     return sizeof(int32_t) * bd_block2 * brg.bd_block * brg.LDB;
 }
 
-int jit_brgemm_kernel_t::zp_comp_a_vpad_offset(int ld, int bd) const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::zp_comp_a_vpad_offset(
+        int ld, int bd) const noexcept {
     return sizeof(int32_t) * (ld * brg.ld_block + bd * brg.LDB);
 }
 
-int jit_brgemm_kernel_t::zp_comp_b_offset(int bd) const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::zp_comp_b_offset(int bd) const noexcept {
     return sizeof(int32_t) * bd;
 }
 
-int jit_brgemm_kernel_t::bdb_zp_comp_b_offset(int bd_block2) const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::bdb_zp_comp_b_offset(
+        int bd_block2) const noexcept {
     return zp_comp_b_offset(bd_block2 * brg.bd_block);
 }
 
-int jit_brgemm_kernel_t::zp_c_values_offset(int ld, bool is_tail) const
-        noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::zp_c_values_offset(
+        int ld, bool is_tail) const noexcept {
     if (brg.zp_type_c == brgemm_broadcast_t::per_n) {
         return (is_tail) ? sizeof(int32_t) * brg.ldb_tail
                          : sizeof(int32_t) * ld * brg.ld_block;
@@ -459,38 +519,86 @@ int jit_brgemm_kernel_t::zp_c_values_offset(int ld, bool is_tail) const
     return 0;
 }
 
-Xbyak::Zmm jit_brgemm_kernel_t::zmm_mask(const Xbyak::Zmm zmm_in,
-        bool mask_flag, bool store, Xbyak::Opmask ktail_mask) const {
-    return mask_flag ? (store ? zmm_in | ktail_mask : zmm_in | ktail_mask | T_z)
-                     : zmm_in;
+template <cpu_isa_t isa, typename Vmm>
+Vmm jit_brgemm_kernel_t<isa, Vmm>::vmm_mask(const Vmm vmm_in, bool mask_flag,
+        bool store, Xbyak::Opmask ktail_mask) const {
+    return mask_flag && !is_ymm_
+            ? (store ? vmm_in | ktail_mask : vmm_in | ktail_mask | T_z)
+            : vmm_in;
 }
 
-Xbyak::Ymm jit_brgemm_kernel_t::ymm_mask(const Xbyak::Ymm ymm_in,
+template <cpu_isa_t isa, typename Vmm>
+Xbyak::Ymm jit_brgemm_kernel_t<isa, Vmm>::ymm_mask(const Xbyak::Ymm ymm_in,
         bool mask_flag, bool store, Xbyak::Opmask ktail_mask) const {
     return mask_flag ? (store ? ymm_in | ktail_mask : ymm_in | ktail_mask | T_z)
                      : ymm_in;
 }
 
-void jit_brgemm_kernel_t::cvt2ps(data_type_t type_in, const Xbyak::Zmm zmm_in,
-        const Xbyak::Operand &op, bool mask_flag, bool store,
-        Xbyak::Opmask ktail_mask) {
-    const Xbyak::Zmm zmm = zmm_mask(zmm_in, mask_flag, store, ktail_mask);
-    switch (type_in) {
-        case data_type::f32:
-        case data_type::s32: vmovups(zmm, op); break;
-        case data_type::bf16:
-            vpmovzxwd(zmm, op);
-            vpslld(zmm, zmm, 16);
-            break;
-        case data_type::s8: vpmovsxbd(zmm, op); break;
-        case data_type::u8: vpmovzxbd(zmm, op); break;
-        default: assert(!"unsupported data type");
-    }
-    if (!one_of(type_in, data_type::f32, data_type::bf16))
-        vcvtdq2ps(zmm_in, zmm_in);
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::cvt2ps(data_type_t type_in,
+        const Vmm vmm_in, const Xbyak::Address &addr, bool mask_flag,
+        bool store, Xbyak::Opmask ktail_mask, int tail_size) {
+    if (is_ymm_) {
+        const Xbyak::Ymm ymm(vmm_in.getIdx());
+        const bool is_tail = mask_flag && tail_size < brg.ld_block;
+        switch (type_in) {
+            case data_type::f32:
+            case data_type::s32: load_vmm(vmm_in, addr, is_tail); break;
+            case data_type::s8:
+            case data_type::u8:
+                if (is_tail)
+                    load_bytes_to_dword_extension(
+                            ymm, addr, type_in == data_type::s8, tail_size);
+                else if (type_in == data_type::s8)
+                    vpmovsxbd(ymm, addr);
+                else
+                    vpmovzxbd(ymm, addr);
+                break;
+            default: assert(!"unsupported data type");
+        }
+    } else {
+        const Vmm vmm = vmm_mask(vmm_in, mask_flag, store, ktail_mask);
+        switch (type_in) {
+            case data_type::f32:
+            case data_type::s32: vmovups(vmm, addr); break;
+            case data_type::bf16:
+                vpmovzxwd(vmm, addr);
+                vpslld(vmm, vmm, 16);
+                break;
+            case data_type::f16: vcvtph2ps(vmm, addr); break;
+            case data_type::s8: vpmovsxbd(vmm, addr); break;
+            case data_type::u8: vpmovzxbd(vmm, addr); break;
+            default: assert(!"unsupported data type");
+        }
+    }
+    if (!one_of(type_in, data_type::f32, data_type::bf16, data_type::f16))
+        vcvtdq2ps(vmm_in, vmm_in);
+}
+
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::load_vmm(
+        const Vmm &vmm, const Xbyak::Address &addr, bool is_tail) {
+    if (!is_tail)
+        vmovups(vmm, addr);
+    else if (is_ymm_)
+        vmaskmovps(vmm, vmm_tail_mask(), addr);
+    else
+        vmovups(vmm | ld_tail_mask | T_z, addr);
 }
 
-void jit_brgemm_kernel_t::advance_ldb_post_op_regs() {
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::store_vmm(
+        const Xbyak::Address &addr, const Vmm &vmm, bool is_tail) {
+    if (!is_tail)
+        vmovups(addr, vmm);
+    else if (is_ymm_)
+        vmaskmovps(addr, vmm_tail_mask(), vmm);
+    else
+        vmovups(addr | ld_tail_mask, vmm);
+}
+
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::advance_ldb_post_op_regs() {
     if (brg.with_bias) {
         mov(reg_aux_bias, ptr[rsp + reg_aux_bias_offs_]);
         add(reg_aux_bias, bias_offset(1));
@@ -520,7 +628,8 @@ void jit_brgemm_kernel_t::advance_ldb_post_op_regs() {
     }
 }
 
-void jit_brgemm_kernel_t::restore_ldb_post_op_regs(int ld_block2) {
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::restore_ldb_post_op_regs(int ld_block2) {
     if (brg.with_bias) {
         mov(reg_aux_bias, ptr[rsp + reg_aux_bias_offs_]);
         sub(reg_aux_bias, bias_offset(ld_block2 - 1));
@@ -550,7 +659,8 @@ void jit_brgemm_kernel_t::restore_ldb_post_op_regs(int ld_block2) {
     }
 }
 
-void jit_brgemm_kernel_t::advance_bdb_post_op_regs(int adj_bd_block) {
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::advance_bdb_post_op_regs(int adj_bd_block) {
     if (brg.zp_type_b != brgemm_broadcast_t::none) {
         mov(reg_aux_zp_comp_b, ptr[rsp + reg_aux_zp_comp_b_offs_]);
         add(reg_aux_zp_comp_b, bdb_zp_comp_b_offset(1));
@@ -569,7 +679,8 @@ void jit_brgemm_kernel_t::advance_bdb_post_op_regs(int adj_bd_block) {
     }
 }
 
-void jit_brgemm_kernel_t::restore_bdb_post_op_regs(int bd_block2) {
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::restore_bdb_post_op_regs(int bd_block2) {
     bool post_processed = false;
     if (bd_block2 > 1) {
         if (brg.zp_type_b != brgemm_broadcast_t::none) {
@@ -594,7 +705,9 @@ void jit_brgemm_kernel_t::restore_bdb_post_op_regs(int bd_block2) {
     if (post_processed) mov(reg_buf, ptr[rsp + reg_buf_offs_]);
 }
 
-void jit_brgemm_kernel_t::ldb_regs_shift(int ld_block2, bool is_tail) {
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::ldb_regs_shift(
+        int ld_block2, bool is_tail) {
     int C_offset = (is_tail) ? ldb_C_offset(1, true) : ldb_C_offset(ld_block2);
     int D_offset = (is_tail) ? ldb_D_offset(1, true) : ldb_D_offset(ld_block2);
     add(reg_aux_C, C_offset);
@@ -656,7 +769,9 @@ void jit_brgemm_kernel_t::ldb_regs_shift(int ld_block2, bool is_tail) {
     }
 }
 
-void jit_brgemm_kernel_t::advance_bd_block2_post_op_regs(int bd_block2) {
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::advance_bd_block2_post_op_regs(
+        int bd_block2) {
     if (with_binary_per_oc_sp_bcast_) {
         mov(reg_aux_binary_postops_oc_l,
                 ptr[rsp + reg_binary_postops_oc_l_offs_]);
@@ -686,7 +801,9 @@ void jit_brgemm_kernel_t::advance_bd_block2_post_op_regs(int bd_block2) {
     }
 }
 
-void jit_brgemm_kernel_t::copy_post_ops_stack_values_to_aux(bool is_reg_tail) {
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::copy_post_ops_stack_values_to_aux(
+        bool is_reg_tail) {
     if (!is_reg_tail) {
         mov(reg_aux_C, reg_C);
         mov(reg_aux_D, reg_D);
@@ -738,7 +855,8 @@ void jit_brgemm_kernel_t::copy_post_ops_stack_values_to_aux(bool is_reg_tail) {
     }
 }
 
-void jit_brgemm_kernel_t::read_params() {
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::read_params() {
     Label label_done;
 
     if (brg.with_binary) mov(ptr[rsp + abi_param1_offs_], param1);
@@ -825,8 +943,10 @@ void jit_brgemm_kernel_t::read_params() {
     mov(ptr[rsp + reg_zp_a_val_offs_], reg_zp_a_val);
 }
 
-void jit_brgemm_kernel_t::zero_accumulators(int bd_block2, bool is_bdb_tail,
-        int ld_block2, bool is_ld_tail, bool skip_accumulation) {
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::zero_accumulators(int bd_block2,
+        bool is_bdb_tail, int ld_block2, bool is_ld_tail,
+        bool skip_accumulation) {
     if (brg.is_amx) {
         // avoid usage of tile registers if there is no accumulation
         if (skip_accumulation) return;
@@ -839,18 +959,20 @@ void jit_brgemm_kernel_t::zero_accumulators(int bd_block2, bool is_bdb_tail,
         int bd_block = (is_bdb_tail) ? brg.bdb_tail : brg.bd_block;
         for_(int bd = 0; bd < bd_block; bd++)
         for (int ld = 0; ld < ld_block2; ld++) {
-            auto zmm = accm(ld_block2, bd, ld);
-            vxorps(zmm, zmm, zmm);
+            auto vmm = accm(ld_block2, bd, ld);
+            vxorps(vmm, vmm, vmm);
         }
     }
 }
 
-void jit_brgemm_kernel_t::apply_alpha_beta(
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::apply_alpha_beta(
         int bd_block, int ld_block2, bool is_ld_tail) {
     auto k_mask = (!is_ld_tail) ? ld_full_mask : ld_tail_mask;
-    auto zmm_beta = zmm_tmp_1();
-    auto zmm_alpha = zmm_tmp_2();
-    auto zmm_prev_dst = zmm_tmp_3();
+    const int tail_size = is_ld_tail ? brg.ldb_tail : brg.ld_block;
+    auto vmm_beta = vmm_tmp_1();
+    auto vmm_alpha = vmm_tmp_2();
+    auto vmm_prev_dst = vmm_tmp_3();
 
     const bool apply_alpha = brg.alpha != 1.f;
     const bool apply_beta = brg.beta != 0.f;
@@ -861,36 +983,44 @@ void jit_brgemm_kernel_t::apply_alpha_beta(
 
     if (apply_beta && !use_vadd_for_beta) {
         mov(reg_tmp_gpr, float2int(static_cast<float>(brg.beta)));
-        movq(Xmm(zmm_beta.getIdx()), reg_tmp_gpr);
-        vbroadcastss(zmm_beta, Xmm(zmm_beta.getIdx()));
+        movq(Xmm(vmm_beta.getIdx()), reg_tmp_gpr);
+        vbroadcastss(vmm_beta, Xmm(vmm_beta.getIdx()));
     }
     if (apply_alpha) {
         mov(reg_tmp_gpr, float2int(static_cast<float>(brg.alpha)));
-        movq(Xmm(zmm_alpha.getIdx()), reg_tmp_gpr);
-        vbroadcastss(zmm_alpha, Xmm(zmm_alpha.getIdx()));
+        movq(Xmm(vmm_alpha.getIdx()), reg_tmp_gpr);
+        vbroadcastss(vmm_alpha, Xmm(vmm_alpha.getIdx()));
     }
     for_(int bd = 0; bd < bd_block; bd++)
     for (int ld = 0; ld < ld_block2; ld++) {
-        auto zmm = accm(ld_block2, bd, ld);
-        if (dq2ps_required) vcvtdq2ps(zmm, zmm);
-        if (apply_alpha) vmulps(zmm, zmm, zmm_alpha);
+        auto vmm = accm(ld_block2, bd, ld);
+        if (dq2ps_required) vcvtdq2ps(vmm, vmm);
+        if (apply_alpha) vmulps(vmm, vmm, vmm_alpha);
         if (apply_beta) {
             auto ptr_C = ptr[reg_aux_C + C_offset(bd, ld)];
-            if (use_vadd_for_beta) {
-                auto zmm_masked = zmm | k_mask | T_z;
+            if (use_vadd_for_beta && is_ymm_) {
+                load_vmm(vmm_prev_dst, ptr_C, is_ld_tail);
+                if (brg.is_int8)
+                    vpaddd(vmm, vmm, vmm_prev_dst);
+                else
+                    vaddps(vmm, vmm, vmm_prev_dst);
+            } else if (use_vadd_for_beta) {
+                auto vmm_masked = vmm | k_mask | T_z;
                 if (brg.is_int8)
-                    vpaddd(zmm_masked, zmm, ptr_C);
+                    vpaddd(vmm_masked, vmm, ptr_C);
                 else
-                    vaddps(zmm_masked, zmm, ptr_C);
+                    vaddps(vmm_masked, vmm, ptr_C);
             } else {
-                cvt2ps(brg.dt_c, zmm_prev_dst, ptr_C, true, false, k_mask);
-                vfmadd231ps(zmm, zmm_prev_dst, zmm_beta);
+                cvt2ps(brg.dt_c, vmm_prev_dst, ptr_C, true, false, k_mask,
+                        tail_size);
+                vfmadd231ps(vmm, vmm_prev_dst, vmm_beta);
             }
         }
     }
 }
 
-void jit_brgemm_kernel_t::apply_post_ops(
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::apply_post_ops(
         int bd_block, int ld_block2, int ldb_and_bdb_offset, bool is_ld_tail) {
 
     binary_injector::rhs_arg_dynamic_params_t rhs_arg_params;
@@ -904,12 +1034,12 @@ void jit_brgemm_kernel_t::apply_post_ops(
         if (handle_binary_po_offset_) {
             for_(int bd = 0; bd < bd_block; bd++)
             for (int ld = 0; ld < ld_block2; ld++) {
-                const auto zmm_idx = accm(ld_block2, bd, ld).getIdx();
+                const auto vmm_idx = accm(ld_block2, bd, ld).getIdx();
 
-                rhs_arg_params.vmm_idx_to_out_reg.emplace(zmm_idx, reg_aux_D);
+                rhs_arg_params.vmm_idx_to_out_reg.emplace(vmm_idx, reg_aux_D);
                 rhs_arg_params.vmm_idx_to_out_elem_off_val.emplace(
-                        zmm_idx, D_offset(bd, ld));
-                if (is_ld_tail) rhs_arg_params.vmm_tail_idx_.emplace(zmm_idx);
+                        vmm_idx, D_offset(bd, ld));
+                if (is_ld_tail) rhs_arg_params.vmm_tail_idx_.emplace(vmm_idx);
             }
         }
     }
@@ -932,26 +1062,39 @@ void jit_brgemm_kernel_t::apply_post_ops(
             if (p_sum_scale_reg_set)
                 mov(reg_ptr_sum_scale, reinterpret_cast<size_t>(p_sum_scale));
 
-            const auto &zmm_sum_zp = zmm_tmp_2();
+            const auto vmm_sum_zp = vmm_tmp_2();
             if (p_sum_zp_reg_set) {
                 mov(reg_ptr_sum_zp, reinterpret_cast<size_t>(p_sum_zp));
-                vcvtdq2ps(zmm_sum_zp, ptr_b[reg_ptr_sum_zp]);
+                if (is_ymm_) {
+                    vpbroadcastd(vmm_sum_zp, ptr[reg_ptr_sum_zp]);
+                    vcvtdq2ps(vmm_sum_zp, vmm_sum_zp);
+                } else
+                    vcvtdq2ps(vmm_sum_zp, ptr_b[reg_ptr_sum_zp]);
             }
+            // Ymm kernels have no embedded broadcast, the sum scale is kept
+            // in a register there.
+            const auto vmm_sum_scale = vmm_tmp_3();
+            if (is_ymm_ && p_sum_scale_reg_set)
+                vbroadcastss(vmm_sum_scale, ptr[reg_ptr_sum_scale]);
 
             const auto k_mask = (!is_ld_tail) ? ld_full_mask : ld_tail_mask;
+            const int tail_size = is_ld_tail ? brg.ldb_tail : brg.ld_block;
 
             for (int bd = 0; bd < bd_block; bd++) {
                 for (int ld = 0; ld < ld_block2; ld++) {
-                    const auto zmm = accm(ld_block2, bd, ld);
+                    const auto vmm = accm(ld_block2, bd, ld);
                     const auto addr = ptr[reg_aux_D + D_offset(bd, ld)];
-                    const auto zmm_prev_dst = Xbyak::Zmm(0);
-                    cvt2ps(brg.sum_dt, zmm_prev_dst, addr, true, false, k_mask);
-                    if (p_sum_zp_reg_set) vsubps(zmm_prev_dst, zmm_sum_zp);
+                    const auto vmm_prev_dst = Vmm(0);
+                    cvt2ps(brg.sum_dt, vmm_prev_dst, addr, true, false, k_mask,
+                            tail_size);
+                    if (p_sum_zp_reg_set) vsubps(vmm_prev_dst, vmm_sum_zp);
                     if (!p_sum_scale_reg_set)
-                        vaddps(zmm, zmm_prev_dst);
+                        vaddps(vmm, vmm_prev_dst);
+                    else if (is_ymm_)
+                        vfmadd231ps(vmm, vmm_prev_dst, vmm_sum_scale);
                     else
                         vfmadd231ps(
-                                zmm, zmm_prev_dst, zword_b[reg_ptr_sum_scale]);
+                                vmm, vmm_prev_dst, zword_b[reg_ptr_sum_scale]);
                 }
             }
         }
@@ -963,12 +1106,15 @@ void jit_brgemm_kernel_t::apply_post_ops(
     }
 
     postops_injector_->compute_vector_range(
-            32 - bd_block * ld_block2, 32, rhs_arg_params);
+            max_effective_vregs - bd_block * ld_block2, max_effective_vregs,
+            rhs_arg_params);
 }
 
-void jit_brgemm_kernel_t::store_accumulators_apply_post_ops(
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::store_accumulators_apply_post_ops(
         int bd_block, int ld_block2, int ldb_and_bdb_offset, bool is_ld_tail) {
     auto k_mask = (!is_ld_tail) ? ld_full_mask : ld_tail_mask;
+    const int tail_size = is_ld_tail ? brg.ldb_tail : brg.ld_block;
 
     // if (brg.is_int8 && alpha_or_beta_applicable && !beta_uses_vadd) ->
     // accumulated values are already converted to ps in apply_alpha_beta()
@@ -981,13 +1127,14 @@ void jit_brgemm_kernel_t::store_accumulators_apply_post_ops(
     if (brg.with_bias) { mov(reg_aux_bias, ptr[rsp + reg_aux_bias_offs_]); }
     for_(int bd = 0; bd < bd_block; bd++)
     for (int ld = 0; ld < ld_block2; ld++) {
-        auto zmm = accm(ld_block2, bd, ld);
-        if (dq2ps_required) vcvtdq2ps(zmm, zmm);
+        auto vmm = accm(ld_block2, bd, ld);
+        if (dq2ps_required) vcvtdq2ps(vmm, vmm);
         if (brg.with_bias) {
-            auto zmm_bias = zmm_tmp_1();
+            auto vmm_bias = vmm_tmp_1();
             auto ptr_bias = ptr[reg_aux_bias + bias_offset(ld)];
-            cvt2ps(brg.dt_bias, zmm_bias, ptr_bias, true, false, k_mask);
-            vaddps(zmm, zmm, zmm_bias);
+            cvt2ps(brg.dt_bias, vmm_bias, ptr_bias, true, false, k_mask,
+                    tail_size);
+            vaddps(vmm, vmm, vmm_bias);
         }
     }
 
@@ -995,9 +1142,17 @@ void jit_brgemm_kernel_t::store_accumulators_apply_post_ops(
         mov(reg_aux_scales, ptr[rsp + reg_aux_scales_offs_]);
         for (int bd = 0; bd < bd_block; bd++) {
             for (int ld = 0; ld < ld_block2; ld++) {
-                const Xbyak::Zmm zmm = zmm_mask(
-                        accm(ld_block2, bd, ld), true, false, k_mask);
-                vmulps(zmm, zmm, ptr[reg_aux_scales + scales_offset(ld)]);
+                const auto addr = ptr[reg_aux_scales + scales_offset(ld)];
+                if (is_ymm_) {
+                    auto vmm_scales = vmm_tmp_1();
+                    load_vmm(vmm_scales, addr, is_ld_tail);
+                    auto vmm = accm(ld_block2, bd, ld);
+                    vmulps(vmm, vmm, vmm_scales);
+                } else {
+                    const Vmm vmm = vmm_mask(
+                            accm(ld_block2, bd, ld), true, false, k_mask);
+                    vmulps(vmm, vmm, addr);
+                }
             }
         }
     }
@@ -1007,33 +1162,36 @@ void jit_brgemm_kernel_t::store_accumulators_apply_post_ops(
 
     if (brg.zp_type_c != brgemm_broadcast_t::none) {
         mov(reg_aux_zp_c_values, ptr[rsp + reg_aux_zp_c_values_offs_]);
-        auto zmm_zp_c = zmm_tmp_1();
+        auto vmm_zp_c = vmm_tmp_1();
         if (brg.zp_type_c == brgemm_broadcast_t::per_tensor) {
-            vcvtdq2ps(
-                    zmm_zp_c, EVEX_compress_addr(reg_aux_zp_c_values, 0, true));
+            if (is_ymm_) {
+                vpbroadcastd(vmm_zp_c, ptr[reg_aux_zp_c_values]);
+                vcvtdq2ps(vmm_zp_c, vmm_zp_c);
+            } else
+                vcvtdq2ps(vmm_zp_c,
+                        EVEX_compress_addr(reg_aux_zp_c_values, 0, true));
         }
         for (int ld = 0; ld < ld_block2; ld++) {
             if (brg.zp_type_c == brgemm_broadcast_t::per_n) {
                 int zp_c_off = zp_c_values_offset(ld);
-                auto zp_c_addr
-                        = EVEX_compress_addr(reg_aux_zp_c_values, zp_c_off);
-                cvt2ps(data_type::s32, zmm_zp_c, zp_c_addr, true, false,
-                        k_mask);
+                auto zp_c_addr = ptr[reg_aux_zp_c_values + zp_c_off];
+                cvt2ps(data_type::s32, vmm_zp_c, zp_c_addr, true, false,
+                        k_mask, tail_size);
             }
             for (int bd = 0; bd < bd_block; bd++) {
-                auto zmm = accm(ld_block2, bd, ld);
-                vaddps(zmm, zmm, zmm_zp_c);
+                auto vmm = accm(ld_block2, bd, ld);
+                vaddps(vmm, vmm, vmm_zp_c);
             }
         }
     }
 
     const bool dt_requires_saturation
             = one_of(brg.dt_d, data_type::u8, data_type::s8, data_type::s32);
-    auto zmm_lbound = zmm_tmp_1();
-    auto zmm_ubound = zmm_tmp_2();
+    auto vmm_lbound = vmm_tmp_1();
+    auto vmm_ubound = vmm_tmp_2();
     if (dt_requires_saturation) {
         init_saturate_f32(
-                zmm_lbound, zmm_ubound, reg_tmp_gpr, data_type::f32, brg.dt_d);
+                vmm_lbound, vmm_ubound, reg_tmp_gpr, data_type::f32, brg.dt_d);
     }
 
     if (brg.is_bf16_emu) bf16_emu_->init_vcvtneps2bf16();
@@ -1041,16 +1199,32 @@ void jit_brgemm_kernel_t::store_accumulators_apply_post_ops(
     for (int bd = 0; bd < bd_block; bd++) {
         if (dt_requires_saturation) {
             for (int ld = 0; ld < ld_block2; ld++) {
-                auto zmm = accm(ld_block2, bd, ld);
-                saturate_f32(zmm, zmm_lbound, zmm_ubound, brg.dt_d);
-                vcvtps2dq(zmm, zmm);
+                auto vmm = accm(ld_block2, bd, ld);
+                saturate_f32(vmm, vmm_lbound, vmm_ubound, brg.dt_d);
+                vcvtps2dq(vmm, vmm);
             }
         }
         for (int ld = 0; ld < ld_block2; ld++) {
             auto addr = ptr[reg_aux_D + D_offset(bd, ld)];
-            auto zmm = accm(ld_block2, bd, ld);
-            auto ymm = Xbyak::Ymm(zmm.getIdx());
-            const Xbyak::Zmm r_zmm = zmm_mask(zmm, true, true, k_mask);
+            auto vmm = accm(ld_block2, bd, ld);
+            if (is_ymm_) {
+                switch (brg.dt_d) {
+                    case data_type::f32:
+                    case data_type::s32:
+                        store_vmm(addr, vmm, is_ld_tail);
+                        break;
+                    case data_type::s8:
+                    case data_type::u8:
+                        store_data(brg.dt_d, Xbyak::Ymm(vmm.getIdx()),
+                                reg_aux_D, D_offset(bd, ld), tail_size);
+                        break;
+                    default: assert(!"unknown dst_dt");
+                }
+                continue;
+            }
+            auto zmm = Xbyak::Zmm(vmm.getIdx());
+            auto ymm = Xbyak::Ymm(vmm.getIdx());
+            const Xbyak::Zmm r_zmm = zmm | k_mask;
             const Xbyak::Ymm r_ymm = ymm_mask(ymm, true, true, k_mask);
             switch (brg.dt_d) {
                 case data_type::f32:
@@ -1064,6 +1238,10 @@ void jit_brgemm_kernel_t::store_accumulators_apply_post_ops(
                         vmovdqu16(addr, r_ymm);
                     }
                     break;
+                case data_type::f16:
+                    vcvtps2ph(ymm, zmm, _op_mxcsr);
+                    vmovdqu16(addr, r_ymm);
+                    break;
                 case data_type::s8: vpmovsdb(addr, r_zmm); break;
                 case data_type::u8: vpmovusdb(addr, r_zmm); break;
                 default: assert(!"unknown dst_dt");
@@ -1072,38 +1250,39 @@ void jit_brgemm_kernel_t::store_accumulators_apply_post_ops(
     }
 }
 
-void jit_brgemm_kernel_t::apply_compensation(
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::apply_compensation(
         int bd_block, int ld_block2, bool is_ld_tail) {
     // apply compensation to accumulated values
     // to avoid the loss of accuracy when converting s32 to f32
-    auto k_mask = (!is_ld_tail) ? ld_full_mask : ld_tail_mask;
-
     if (brg.zp_type_a != brgemm_broadcast_t::none) {
-        auto zmm_zp_a_val = zmm_tmp_2();
+        auto vmm_zp_a_val = vmm_tmp_2();
         mov(reg_zp_a_val, ptr[rsp + reg_zp_a_val_offs_]);
-        vpbroadcastd(zmm_zp_a_val, reg_zp_a_val.cvt32());
+        if (is_ymm_) {
+            vmovd(Xmm(vmm_zp_a_val.getIdx()), reg_zp_a_val.cvt32());
+            vpbroadcastd(vmm_zp_a_val, Xmm(vmm_zp_a_val.getIdx()));
+        } else
+            vpbroadcastd(vmm_zp_a_val, reg_zp_a_val.cvt32());
 
         mov(reg_aux_zp_comp_a, ptr[rsp + reg_aux_zp_comp_a_offs_]);
         for (int ld = 0; ld < ld_block2; ld++) {
-            auto zmm_zp_comp_a = zmm_tmp_1();
+            auto vmm_zp_comp_a = vmm_tmp_1();
             int zp_comp_a_off = zp_comp_a_offset(ld);
-            auto zp_comp_a_addr
-                    = EVEX_compress_addr(reg_aux_zp_comp_a, zp_comp_a_off);
+            auto zp_comp_a_addr = ptr[reg_aux_zp_comp_a + zp_comp_a_off];
             // apply src zero points value to the accumulated values
-            zmm_zp_comp_a = zmm_mask(zmm_zp_comp_a, true, false, k_mask);
-            vmovups(zmm_zp_comp_a, zp_comp_a_addr);
-            vpmulld(zmm_zp_comp_a, zmm_zp_comp_a, zmm_zp_a_val);
+            load_vmm(vmm_zp_comp_a, zp_comp_a_addr, is_ld_tail);
+            vpmulld(vmm_zp_comp_a, vmm_zp_comp_a, vmm_zp_a_val);
 
             for (int bd = 0; bd < bd_block; bd++) {
                 if (brg.with_comp_pads) {
                     auto zp_comp_a_vpad_offs = zp_comp_a_vpad_offset(ld, bd);
                     auto zp_comp_a_vpad_addr
-                            = zword[reg_aux_zp_comp_a + zp_comp_a_vpad_offs];
-                    vmovups(zmm_zp_comp_a, zp_comp_a_vpad_addr);
-                    vpmulld(zmm_zp_comp_a, zmm_zp_comp_a, zmm_zp_a_val);
+                            = ptr[reg_aux_zp_comp_a + zp_comp_a_vpad_offs];
+                    vmovups(vmm_zp_comp_a, zp_comp_a_vpad_addr);
+                    vpmulld(vmm_zp_comp_a, vmm_zp_comp_a, vmm_zp_a_val);
                 }
-                auto zmm = accm(ld_block2, bd, ld);
-                vpaddd(zmm, zmm, zmm_zp_comp_a);
+                auto vmm = accm(ld_block2, bd, ld);
+                vpaddd(vmm, vmm, vmm_zp_comp_a);
             }
         }
     }
@@ -1112,11 +1291,18 @@ void jit_brgemm_kernel_t::apply_compensation(
         mov(reg_aux_zp_comp_b, ptr[rsp + reg_aux_zp_comp_b_offs_]);
         for (int bd = 0; bd < bd_block; bd++) {
             int zp_comp_b_off = zp_comp_b_offset(bd);
-            auto zp_comp_b_addr = EVEX_compress_addr(
-                    reg_aux_zp_comp_b, zp_comp_b_off, true);
+            auto vmm_zp_comp_b = vmm_tmp_1();
+            if (is_ymm_)
+                vpbroadcastd(vmm_zp_comp_b,
+                        ptr[reg_aux_zp_comp_b + zp_comp_b_off]);
             for (int ld = 0; ld < ld_block2; ld++) {
-                auto zmm = accm(ld_block2, bd, ld);
-                vpaddd(zmm, zmm, zp_comp_b_addr);
+                auto vmm = accm(ld_block2, bd, ld);
+                if (is_ymm_)
+                    vpaddd(vmm, vmm, vmm_zp_comp_b);
+                else
+                    vpaddd(vmm, vmm,
+                            EVEX_compress_addr(
+                                    reg_aux_zp_comp_b, zp_comp_b_off, true));
             }
         }
     }
@@ -1124,28 +1310,27 @@ void jit_brgemm_kernel_t::apply_compensation(
     if (brg.req_s8s8_compensation) {
         mov(reg_aux_compensation, ptr[rsp + reg_aux_comp_offs_]);
         for (int ld = 0; ld < ld_block2; ld++) {
-            auto zmm_comp = zmm_tmp_1();
+            auto vmm_comp = vmm_tmp_1();
             int comp_offset = compensations_offset(ld);
-            auto comp_addr
-                    = EVEX_compress_addr(reg_aux_compensation, comp_offset);
-            zmm_comp = zmm_mask(zmm_comp, true, false, k_mask);
-            vmovups(zmm_comp, comp_addr);
+            auto comp_addr = ptr[reg_aux_compensation + comp_offset];
+            load_vmm(vmm_comp, comp_addr, is_ld_tail);
 
             for (int bd = 0; bd < bd_block; bd++) {
                 if (brg.with_comp_pads) {
                     auto comp_vpad_offs = compensation_vpad_offset(ld, bd);
                     auto comp_vpad_addr
-                            = zword[reg_aux_compensation + comp_vpad_offs];
-                    vmovups(zmm_comp, comp_vpad_addr);
+                            = ptr[reg_aux_compensation + comp_vpad_offs];
+                    vmovups(vmm_comp, comp_vpad_addr);
                 }
-                auto zmm = accm(ld_block2, bd, ld);
-                vpaddd(zmm, zmm, zmm_comp);
+                auto vmm = accm(ld_block2, bd, ld);
+                vpaddd(vmm, vmm, vmm_comp);
             }
         }
     }
 }
 
-void jit_brgemm_kernel_t::store_accumulators_without_post_ops(
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::store_accumulators_without_post_ops(
         int bd_block, int ld_block2, bool is_ld_tail) {
 
     // if (brg.is_int8 && alpha_or_beta_applicable && !beta_uses_vadd) ->
@@ -1155,34 +1340,32 @@ void jit_brgemm_kernel_t::store_accumulators_without_post_ops(
             = brg.beta == 1.f && IMPLICATION(brg.is_int8, brg.alpha == 1.0f);
     const bool dt_requires_saturation = brg.is_int8
             && !IMPLICATION(alpha_or_beta_applicable, beta_uses_vadd);
-    auto zmm_lbound = zmm_tmp_1();
-    auto zmm_ubound = zmm_tmp_2();
+    auto vmm_lbound = vmm_tmp_1();
+    auto vmm_ubound = vmm_tmp_2();
     if (dt_requires_saturation) {
         init_saturate_f32(
-                zmm_lbound, zmm_ubound, reg_tmp_gpr, data_type::f32, brg.dt_d);
+                vmm_lbound, vmm_ubound, reg_tmp_gpr, data_type::f32, brg.dt_d);
     }
 
     for (int bd = 0; bd < bd_block; bd++) {
         if (dt_requires_saturation) {
             for (int ld = 0; ld < ld_block2; ld++) {
-                auto zmm = accm(ld_block2, bd, ld);
-                saturate_f32(zmm, zmm_lbound, zmm_ubound, brg.dt_d);
-                vcvtps2dq(zmm, zmm);
+                auto vmm = accm(ld_block2, bd, ld);
+                saturate_f32(vmm, vmm_lbound, vmm_ubound, brg.dt_d);
+                vcvtps2dq(vmm, vmm);
             }
         }
         for (int ld = 0; ld < ld_block2; ld++) {
-            auto zmm = accm(ld_block2, bd, ld);
-            if (is_ld_tail)
-                vmovups(ptr[reg_aux_C + C_offset(bd, ld)] | ld_tail_mask | T_z,
-                        zmm);
-            else
-                vmovups(ptr[reg_aux_C + C_offset(bd, ld)], zmm);
+            auto vmm = accm(ld_block2, bd, ld);
+            store_vmm(ptr[reg_aux_C + C_offset(bd, ld)], vmm, is_ld_tail);
         }
     }
 }
 
-void jit_brgemm_kernel_t::store_accumulators(int bd_block2, bool is_bdb_tail,
-        int ld_block2, bool is_ld_tail, bool skip_accumulation) {
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::store_accumulators(int bd_block2,
+        bool is_bdb_tail, int ld_block2, bool is_ld_tail,
+        bool skip_accumulation) {
     const bool has_zero_points = !everyone_is(brgemm_broadcast_t::none,
             brg.zp_type_a, brg.zp_type_b, brg.zp_type_c);
     const bool are_post_ops_applicable = one_of(true, brg.with_eltwise,
@@ -1320,7 +1503,8 @@ void jit_brgemm_kernel_t::store_accumulators(int bd_block2, bool is_bdb_tail,
     }
 }
 
-void jit_brgemm_kernel_t::restore_A_B_matrices() {
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::restore_A_B_matrices() {
     auto restore_reg_batch = brg.brgattr.max_bs > 1 || vpad_exist;
     if (brg.type == brgemm_addr) {
         if (restore_reg_batch) mov(reg_aux1_batch, reg_addr_batch);
@@ -1337,7 +1521,8 @@ void jit_brgemm_kernel_t::restore_A_B_matrices() {
     }
 }
 
-void jit_brgemm_kernel_t::set_A_B_matrices() {
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::set_A_B_matrices() {
     if (brg.type == brgemm_addr) {
         if (brg.brgattr.max_bs > 1) {
             if (brg.layout == brgemm_row_major) {
@@ -1391,8 +1576,9 @@ void jit_brgemm_kernel_t::set_A_B_matrices() {
     add(reg_aux_B, reg_b_offset);
 }
 
-void jit_brgemm_kernel_t::gemm_microkernel_amx(int bd_block2, bool is_bdb_tail,
-        int ld_block2, bool is_rd_tail, bool is_ld_tail) {
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::gemm_microkernel_amx(int bd_block2,
+        bool is_bdb_tail, int ld_block2, bool is_rd_tail, bool is_ld_tail) {
     auto tdpbxxd = [=](const Tmm &x1, const Tmm &x2, const Tmm &x3) {
         if (brg.dt_a == data_type::bf16 && brg.dt_b == data_type::bf16) {
             tdpbf16ps(x1, x2, x3);
@@ -1450,17 +1636,20 @@ void jit_brgemm_kernel_t::gemm_microkernel_amx(int bd_block2, bool is_bdb_tail,
     }
 }
 
-void jit_brgemm_kernel_t::gemm_microkernel_avx512(int bd_block2,
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::gemm_microkernel_avx512(int bd_block2,
         bool is_bdb_tail, int ld_block2, bool is_rd_tail, bool is_ld_tail,
         int vpad, int rows_for_rd_tail) {
     MAYBE_UNUSED(bd_block2);
-    auto dot_product = [=](Zmm z1, Zmm z2, Zmm z3) {
+    auto dot_product = [=](Vmm v1, Vmm v2, Vmm v3) {
         if (brg.is_f32)
-            vfmadd231ps(z1, z2, z3);
+            vfmadd231ps(v1, v2, v3);
         else if (brg.is_bf16)
-            vdpbf16ps(z1, z2, z3);
+            vdpbf16ps(v1, v2, v3);
+        else if (brg.is_int8 && is_ymm_)
+            vpdpbusd(v1, v3, v2, Xbyak::VexEncoding);
         else if (brg.is_int8)
-            vpdpbusd(z1, z3, z2);
+            vpdpbusd(v1, v3, v2);
     };
 
     int bd_block = (is_bdb_tail) ? brg.bdb_tail : brg.bd_block;
@@ -1482,21 +1671,21 @@ void jit_brgemm_kernel_t::gemm_microkernel_avx512(int bd_block2,
     } else
         rd_loop = brg.rd_block;
 
-    auto broadcast = [=](Zmm z1, size_t offset, bool is_tail) {
+    auto broadcast = [=](Vmm v1, size_t offset, bool is_tail) {
         if (is_tail) {
-            vpxord(z1, z1, z1);
-            Xmm xmm_tmp = Xmm(z1.getIdx());
+            uni_vpxor(v1, v1, v1);
+            Xmm xmm_tmp = Xmm(v1.getIdx());
             load_bytes(
                     xmm_tmp, reg_aux_A, offset, rd_tail_size * brg.typesize_A);
-            vpbroadcastd(z1, xmm_tmp);
+            vpbroadcastd(v1, xmm_tmp);
         } else {
             if (brg.is_f32)
-                vbroadcastss(z1, ptr[reg_aux_A + offset]);
+                vbroadcastss(v1, ptr[reg_aux_A + offset]);
             else if (brg.is_bf16 || brg.is_int8)
-                vpbroadcastd(z1, ptr[reg_aux_A + offset]);
+                vpbroadcastd(v1, ptr[reg_aux_A + offset]);
         }
 
-        if (brg.req_s8s8_compensation) vpaddb(z1, z1, zmm_inp_shift());
+        if (brg.req_s8s8_compensation) vpaddb(v1, v1, vmm_inp_shift());
     };
 
     bool maybe_load_bytes = (rows_for_rd_tail > 0 || brg.brgattr.wary_tail_read)
@@ -1514,19 +1703,14 @@ void jit_brgemm_kernel_t::gemm_microkernel_avx512(int bd_block2,
                         have_to_load_bytes && bd_by_load_bytes);
             }
             for (int ld = 0; ld < ld_block2; ld++) {
-                if (is_ld_tail) {
-                    vmovups(load() | ld_tail_mask | T_z,
-                            ptr[reg_aux_B + B_offset(ld, rd)]);
-                } else {
-                    vmovups(load(), ptr[reg_aux_B + B_offset(ld, rd)]);
-                }
+                load_vmm(load(), ptr[reg_aux_B + B_offset(ld, rd)], is_ld_tail);
                 for (int bd = bd_b; bd < bd_e; bd++) {
-                    auto zmm = accm(ld_block2, bd, ld);
+                    auto vmm = accm(ld_block2, bd, ld);
                     if (is_emdbd)
-                        vfmadd231ps(zmm, load(),
+                        vfmadd231ps(vmm, load(),
                                 zword_b[reg_aux_A + A_offset(bd, rd)]);
                     else
-                        dot_product(zmm, load(), bcst(bd));
+                        dot_product(vmm, load(), bcst(bd));
                 }
             }
         }
@@ -1534,12 +1718,8 @@ void jit_brgemm_kernel_t::gemm_microkernel_avx512(int bd_block2,
         for (int rd = 0; rd < rd_loop; rd += brg.rd_step) {
             int prefetch_count_B = 0;
             for (int ld = 0; ld < ld_block2; ld++) {
-                if (is_ld_tail) {
-                    vmovups(load(ld) | ld_tail_mask | T_z,
-                            ptr[reg_aux_B + B_offset(ld, rd)]);
-                } else {
-                    vmovups(load(ld), ptr[reg_aux_B + B_offset(ld, rd)]);
-                }
+                load_vmm(
+                        load(ld), ptr[reg_aux_B + B_offset(ld, rd)], is_ld_tail);
             }
 
             bool have_to_load_bytes
@@ -1559,19 +1739,20 @@ void jit_brgemm_kernel_t::gemm_microkernel_avx512(int bd_block2,
                             + brg.LDB * brg.rd_block * brg.typesize_B]);
                 }
                 for (int ld = 0; ld < ld_block2; ld++) {
-                    auto zmm = accm(ld_block2, bd, ld);
+                    auto vmm = accm(ld_block2, bd, ld);
                     if (is_emdbd)
-                        vfmadd231ps(zmm, load(ld),
+                        vfmadd231ps(vmm, load(ld),
                                 zword_b[reg_aux_A + A_offset(bd, rd)]);
                     else
-                        dot_product(zmm, load(ld), bcst());
+                        dot_product(vmm, load(ld), bcst());
                 }
             }
         }
     }
 }
 
-void jit_brgemm_kernel_t::ldb_loop(int bd_block2, bool is_bdb_tail,
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::ldb_loop(int bd_block2, bool is_bdb_tail,
         int ld_block2, int ldb_loop_length, bool is_reg_tail, bool is_ld_tail,
         bool check_top_vpad, bool check_bottom_vpad, int rows_for_rd_tail,
         bool skip_accumulation) {
@@ -1651,7 +1832,12 @@ void jit_brgemm_kernel_t::ldb_loop(int bd_block2, bool is_bdb_tail,
             if (brg.req_s8s8_compensation) {
                 mov(ptr[rsp + reg_bdb_loop_offs_], reg_bdb_loop);
                 mov(reg_s8_input_shift, 128);
-                vpbroadcastb(zmm_inp_shift(), reg_s8_input_shift.cvt8());
+                if (is_ymm_) {
+                    const Xmm xmm_inp_shift = Xmm(vmm_inp_shift().getIdx());
+                    vmovd(xmm_inp_shift, reg_s8_input_shift.cvt32());
+                    vpbroadcastb(vmm_inp_shift(), xmm_inp_shift);
+                } else
+                    vpbroadcastb(vmm_inp_shift(), reg_s8_input_shift.cvt8());
                 mov(reg_bdb_loop, ptr[rsp + reg_bdb_loop_offs_]);
             }
 
@@ -1742,7 +1928,8 @@ void jit_brgemm_kernel_t::ldb_loop(int bd_block2, bool is_bdb_tail,
     }
 }
 
-void jit_brgemm_kernel_t::bdb_loop() {
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::bdb_loop() {
     auto do_ldb_loop = [=](int bd_block2, bool is_bdb_tail, bool check_top_vpad,
                                bool check_bottom_vpad, int rows_for_rd_tail,
                                bool skip_accumulation) {
@@ -1807,9 +1994,8 @@ void jit_brgemm_kernel_t::bdb_loop() {
                 ? brg.ld_block2
                 : ((brg.ldb2_tail > 0) ? brg.ldb2_tail : 1);
         n_bcast_1_load = brg.is_int8
-                && ((brg.bd_block * (ld_block2 + 1) < 32)
-                        && (bd_blocks_for_rd_tail == 0)
-                        && (rows_for_rd_tail == 0));
+                && (brg.bd_block * (ld_block2 + 1) < max_effective_vregs)
+                && (bd_blocks_for_rd_tail == 0) && (rows_for_rd_tail == 0);
         // loop order may be specified in brgemm attributes
         if (brg.brgattr.hint_loop_order != brgemm_lo_default)
             n_bcast_1_load = (brg.brgattr.hint_loop_order == brgemm_lo_bl_1load)
@@ -1951,7 +2137,8 @@ void jit_brgemm_kernel_t::bdb_loop() {
         bdb_loop_general(false);
 }
 
-void jit_brgemm_kernel_t::generate() {
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::generate() {
     preamble();
 
     sub(rsp, stack_space_needed_);
@@ -1966,10 +2153,23 @@ void jit_brgemm_kernel_t::generate() {
 
     reg64_t reg_mask = rax;
 
-    mov(reg_mask, full_mask);
-    kmovq(ld_full_mask, reg_mask);
-    mov(reg_mask, tail_mask);
-    kmovq(ld_tail_mask, reg_mask);
+    if (is_ymm_) {
+        if (brg.ldb_tail > 0) {
+            // vmaskmovps uses the sign bits of the mask elements
+            static const uint32_t mask_f32[16]
+                    = {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+                            0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0,
+                            0, 0, 0, 0, 0, 0, 0};
+            mov(reg_mask,
+                    reinterpret_cast<size_t>(&mask_f32[8 - brg.ldb_tail]));
+            vmovups(vmm_tail_mask(), ptr[reg_mask]);
+        }
+    } else {
+        mov(reg_mask, full_mask);
+        kmovq(ld_full_mask, reg_mask);
+        mov(reg_mask, tail_mask);
+        kmovq(ld_tail_mask, reg_mask);
+    }
 
     read_params();
 
@@ -1999,22 +2199,36 @@ brgemm_attr_t::brgemm_attr_t()
     , use_uker(false)
     , use_interleave_stores(false) {}
 
-brgemm_kernel_common_t::brgemm_kernel_common_t(const brgemm_t abrd) {
-    brgemm_kernel_ = new jit_brgemm_kernel_t(abrd);
+template <cpu_isa_t isa, typename Vmm>
+brgemm_kernel_common_t<isa, Vmm>::brgemm_kernel_common_t(const brgemm_t abrd) {
+    brgemm_kernel_ = new jit_brgemm_kernel_t<isa, Vmm>(abrd);
 }
 
-status_t brgemm_kernel_common_t::create_kernel() {
+template <cpu_isa_t isa, typename Vmm>
+status_t brgemm_kernel_common_t<isa, Vmm>::create_kernel() {
     return brgemm_kernel_->create_kernel();
 }
 
-void brgemm_kernel_common_t::operator()(brgemm_kernel_params_t *params) const {
+template <cpu_isa_t isa, typename Vmm>
+void brgemm_kernel_common_t<isa, Vmm>::operator()(
+        brgemm_kernel_params_t *params) const {
     (*brgemm_kernel_)(params);
 }
 
-brgemm_kernel_common_t::~brgemm_kernel_common_t() {
+template <cpu_isa_t isa, typename Vmm>
+const jit_generator *
+brgemm_kernel_common_t<isa, Vmm>::get_jit_generator() const {
+    return brgemm_kernel_;
+}
+
+template <cpu_isa_t isa, typename Vmm>
+brgemm_kernel_common_t<isa, Vmm>::~brgemm_kernel_common_t() {
     delete brgemm_kernel_;
 }
 
+template struct brgemm_kernel_common_t<avx512_core, Xbyak::Zmm>;
+template struct brgemm_kernel_common_t<avx2, Xbyak::Ymm>;
+
 } // namespace x64
 } // namespace cpu
 } // namespace impl
@@ -0,0 +1,374 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "common/dnnl_thread.hpp"
+#include "common/memory_desc_wrapper.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/cpu_primitive.hpp"
+#include "cpu/platform.hpp"
+
+#include "cpu/x64/jit_avx512_core_concat.hpp"
+
+#define GET_OFF(field) offsetof(jit_concat_call_s, field)
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+using namespace dnnl::impl::data_type;
+using namespace dnnl::impl::utils;
+using namespace Xbyak;
+
+void jit_avx512_core_concat_kernel_t::set_mask(const Opmask &k, unsigned mask) {
+    mov(reg_tmp.cvt32(), mask);
+    kmovw(k, reg_tmp.cvt32());
+}
+
+void jit_avx512_core_concat_kernel_t::load(const Address &addr) {
+    const Zmm zmm = zmm_data | k_load | T_z;
+    if (is_copy()) {
+        switch (types::data_type_size(jcp.src_dt)) {
+            case 4: vmovdqu32(zmm, addr); break;
+            case 2:
+                vmovdqu16(Ymm(zmm_data.getIdx()) | k_load | T_z, addr);
+                break;
+            case 1:
+                vmovdqu8(Xmm(zmm_data.getIdx()) | k_load | T_z, addr);
+                break;
+            default: assert(!"unsupported data type");
+        }
+        return;
+    }
+
+    switch (jcp.src_dt) {
+        case f32: vmovups(zmm, addr); break;
+        case s32: vcvtdq2ps(zmm, addr); break;
+        case bf16:
+            vpmovzxwd(zmm, addr);
+            vpslld(zmm_data, zmm_data, 16);
+            break;
+        case f16: vcvtph2ps(zmm, addr); break;
+        case s8:
+            vpmovsxbd(zmm, addr);
+            vcvtdq2ps(zmm_data, zmm_data);
+            break;
+        case u8:
+            vpmovzxbd(zmm, addr);
+            vcvtdq2ps(zmm_data, zmm_data);
+            break;
+        default: assert(!"unsupported data type");
+    }
+    if (jcp.scale != 1.f) vmulps(zmm_data, zmm_data, zmm_scale);
+}
+
+void jit_avx512_core_concat_kernel_t::convert_to_dst_dt() {
+    if (is_copy()) return;
+
+    const Ymm ymm_data(zmm_data.getIdx());
+    switch (jcp.dst_dt) {
+        case f32: break;
+        case s32:
+        case s8:
+        case u8:
+            vmaxps(zmm_data, zmm_data, zmm_lbound);
+            vminps(zmm_data, zmm_data, zmm_ubound);
+            vcvtps2dq(zmm_data, zmm_data);
+            break;
+        case bf16: vcvtneps2bf16(ymm_data, zmm_data); break;
+        case f16: vcvtps2ph(ymm_data, zmm_data, _op_mxcsr); break;
+        default: assert(!"unsupported data type");
+    }
+}
+
+void jit_avx512_core_concat_kernel_t::store(
+        const Address &addr, const Zmm &zmm) {
+    // The converted values are laid out as the destination data type, except
+    // for the 8-bit integers which are down-converted by the store itself.
+    if (!is_copy() && one_of(jcp.dst_dt, s8, u8)) {
+        if (jcp.dst_dt == s8)
+            vpmovsdb(addr, zmm);
+        else
+            vpmovusdb(addr, zmm);
+        return;
+    }
+
+    switch (types::data_type_size(jcp.dst_dt)) {
+        case 4: vmovdqu32(addr, zmm); break;
+        case 2: vmovdqu16(addr, Ymm(zmm.getIdx())); break;
+        case 1: vmovdqu8(addr, Xmm(zmm.getIdx())); break;
+        default: assert(!"unsupported data type");
+    }
+}
+
+void jit_avx512_core_concat_kernel_t::points_loop(
+        dim_t src_off, const std::vector<store_t> &stores, bool zero) {
+    assert(stores.size() <= max_store_masks);
+    auto store_mask = [&](size_t i) {
+        return Opmask(k_load.getIdx() + 1 + static_cast<int>(i));
+    };
+    for (size_t i = 0; i < stores.size(); i++)
+        set_mask(store_mask(i), stores[i].mask);
+
+    // signed, as the offsets of the stores may be negative
+    const dim_t src_dt_size = types::data_type_size(jcp.src_dt);
+    const dim_t dst_dt_size = types::data_type_size(jcp.dst_dt);
+
+    mov(reg_ptr_src, reg_src);
+    mov(reg_ptr_dst, reg_dst);
+    mov(reg_cnt, reg_work);
+
+    Label loop;
+    L(loop);
+    {
+        if (!zero) {
+            load(ptr[reg_ptr_src + src_off * src_dt_size]);
+            convert_to_dst_dt();
+        }
+        for (size_t i = 0; i < stores.size(); i++)
+            store(ptr[reg_ptr_dst + stores[i].dst_off * dst_dt_size]
+                            | store_mask(i),
+                    zero ? zmm_zero : zmm_data);
+        if (!zero)
+            safe_add(reg_ptr_src, jcp.src_sp_stride * src_dt_size, reg_tmp);
+        safe_add(reg_ptr_dst, jcp.dst_sp_stride * dst_dt_size, reg_tmp);
+        dec(reg_cnt);
+        jnz(loop, T_NEAR);
+    }
+}
+
+void jit_avx512_core_concat_kernel_t::generate() {
+    preamble();
+
+    mov(reg_src, ptr[reg_param + GET_OFF(src)]);
+    mov(reg_dst, ptr[reg_param + GET_OFF(dst)]);
+    mov(reg_work, ptr[reg_param + GET_OFF(work)]);
+
+    auto broadcast = [&](const Zmm &zmm, float value) {
+        mov(reg_tmp.cvt32(), float2int(value));
+        vpbroadcastd(zmm, reg_tmp.cvt32());
+    };
+    if (!is_copy()) {
+        if (jcp.scale != 1.f) broadcast(zmm_scale, jcp.scale);
+        // Saturate in f32 as the conversion of the out of range values to
+        // the integers is not saturating.
+        switch (jcp.dst_dt) {
+            case s32:
+                broadcast(zmm_lbound, -2147483648.f);
+                broadcast(zmm_ubound, 2147483520.f);
+                break;
+            case s8:
+                broadcast(zmm_lbound, -128.f);
+                broadcast(zmm_ubound, 127.f);
+                break;
+            case u8:
+                broadcast(zmm_lbound, 0.f);
+                broadcast(zmm_ubound, 255.f);
+                break;
+            default: break;
+        }
+    }
+
+    // The address of the channel c of the destination relative to the
+    // spatial point.
+    auto dst_off = [&](int c) {
+        return (c / jcp.dst_blk) * jcp.dst_cb_stride + c % jcp.dst_blk;
+    };
+
+    // The channels are processed in chunks of up to simd_w channels that lie
+    // within a single block of the source. A chunk may cross the block
+    // boundaries of the destination, then it is written by several masked
+    // stores: the lanes [l, l + len) of the vector go to the address of
+    // the destination channel of the lane l minus l elements.
+    for (int c = 0; c < jcp.C;) {
+        const int c_in_blk = c % jcp.src_blk;
+        const int len = nstl::min(
+                nstl::min(simd_w, jcp.src_blk - c_in_blk), jcp.C - c);
+        const dim_t src_off
+                = (c / jcp.src_blk) * jcp.src_cb_stride + c_in_blk;
+
+        std::vector<store_t> stores;
+        for (int l = 0; l < len;) {
+            const int dc = jcp.c_off + c + l;
+            const int seg = nstl::min(len - l, jcp.dst_blk - dc % jcp.dst_blk);
+            stores.push_back({dst_off(dc) - l, ((1u << seg) - 1) << l});
+            l += seg;
+        }
+
+        set_mask(k_load, (1u << len) - 1);
+        points_loop(src_off, stores);
+        c += len;
+    }
+
+    if (jcp.dst_zero_pad > 0) {
+        vpxord(zmm_zero, zmm_zero, zmm_zero);
+        const store_t pad_store {
+                dst_off(jcp.c_off + jcp.C), (1u << jcp.dst_zero_pad) - 1};
+        points_loop(0, {pad_store}, true);
+    }
+
+    postamble();
+}
+
+status_t jit_avx512_core_concat_t::pd_t::init(engine_t *engine) {
+    using namespace format_kind;
+    using skip_mask_t = primitive_attr_t::skip_mask_t;
+
+    // The destination is not required to have the images of the inputs, as
+    // the offsets of the inputs do not need to be aligned with the blocks.
+    bool ok = mayiuse(avx512_core) && concat_dim() == 1
+            && attr()->has_default_values(skip_mask_t::scales)
+            && attr_scales_ok() && set_default_params() == status::success;
+    if (!ok) return status::unimplemented;
+
+    const memory_desc_wrapper dst_d(dst_md());
+    const int ndims = dst_d.ndims();
+    if (ndims < 2 || ndims > 5 || dst_d.has_zero_dim()
+            || dst_d.has_runtime_dims_or_strides())
+        return status::unimplemented;
+
+    const data_type_t src_dt = src_md(0)->data_type;
+    const data_type_t dst_dt = dst_d.data_type();
+    for (const auto dt : {src_dt, dst_dt})
+        if (!one_of(dt, f32, s32, bf16, f16, s8, u8))
+            return status::unimplemented;
+
+    // The channels of a tensor are either blocked by 4, 8 or 16 or
+    // dense, and the spatial dimensions are dense in their natural order.
+    struct layout_t {
+        int blk;
+        dim_t cb_stride, sp_stride;
+    };
+    auto get_layout = [&](const memory_desc_wrapper &d, layout_t &l) {
+        if (d.format_kind() != blocked || d.extra().flags != 0) return false;
+        const auto &bd = d.blocking_desc();
+        if (bd.inner_nblks == 1 && bd.inner_idxs[0] == 1
+                && one_of(bd.inner_blks[0], 4, 8, 16))
+            l.blk = (int)bd.inner_blks[0];
+        else if (bd.inner_nblks == 0 && bd.strides[1] == 1)
+            l.blk = (int)d.padded_dims()[1];
+        else
+            return false;
+        l.cb_stride = bd.strides[1];
+        for (int d_idx = 2; d_idx < ndims - 1; d_idx++)
+            if (bd.strides[d_idx]
+                    != bd.strides[d_idx + 1] * d.padded_dims()[d_idx + 1])
+                return false;
+        l.sp_stride = ndims > 2 ? bd.strides[ndims - 1] : 0;
+        return true;
+    };
+
+    layout_t dst_l;
+    if (!get_layout(dst_d, dst_l)) return status::unimplemented;
+
+    const dim_t C = dst_d.dims()[1];
+    sp_ = dst_d.nelems() / (dst_d.dims()[0] * C);
+
+    jcps_.resize(n_inputs());
+    int c_off = 0;
+    for (int i = 0; i < n_inputs(); i++) {
+        const memory_desc_wrapper src_d(src_md(i));
+        layout_t src_l;
+        if (src_d.data_type() != src_dt || src_d.has_runtime_dims_or_strides()
+                || !get_layout(src_d, src_l))
+            return status::unimplemented;
+
+        auto &jcp = jcps_[i];
+        jcp.src_dt = src_dt;
+        jcp.dst_dt = dst_dt;
+        jcp.C = (int)src_d.dims()[1];
+        jcp.c_off = c_off;
+        jcp.src_blk = src_l.blk;
+        jcp.dst_blk = dst_l.blk;
+        jcp.src_cb_stride = src_l.cb_stride;
+        jcp.dst_cb_stride = dst_l.cb_stride;
+        jcp.src_sp_stride = src_l.sp_stride;
+        jcp.dst_sp_stride = dst_l.sp_stride;
+        jcp.scale = src_scale(i);
+        jcp.dst_zero_pad = i == n_inputs() - 1
+                ? (int)(dst_d.padded_dims()[1] - dst_d.dims()[1])
+                : 0;
+        c_off += jcp.C;
+
+        // The conversion to bf16 is native only.
+        const bool is_copy = src_dt == dst_dt && jcp.scale == 1.f;
+        if (!is_copy && dst_dt == bf16 && !mayiuse(avx512_core_bf16))
+            return status::unimplemented;
+    }
+
+    // The chunk of the spatial points processed by a single kernel call is
+    // about the size of L1 for the destination.
+    const dim_t L1_size = platform::get_per_core_cache_size(1);
+    const dim_t point_size
+            = dst_d.padded_dims()[1] * (dim_t)types::data_type_size(dst_dt);
+    sp_chunk_ = nstl::max((dim_t)1, nstl::min(sp_, L1_size / 2 / point_size));
+
+    return status::success;
+}
+
+status_t jit_avx512_core_concat_t::init(engine_t *engine) {
+    for (const auto &jcp : pd()->jcps_) {
+        kernels_.emplace_back(new jit_avx512_core_concat_kernel_t(jcp));
+        CHECK(kernels_.back()->create_kernel());
+    }
+    return status::success;
+}
+
+status_t jit_avx512_core_concat_t::execute(const exec_ctx_t &ctx) const {
+    const int n = pd()->n_inputs();
+    const memory_desc_wrapper dst_d(pd()->dst_md());
+    const size_t dst_dt_size = dst_d.data_type_size();
+    auto dst = CTX_OUT_MEM(char *, DNNL_ARG_DST)
+            + dst_d.offset0() * dst_dt_size;
+
+    std::vector<const char *> srcs(n);
+    for (int i = 0; i < n; i++) {
+        const memory_desc_wrapper src_d(pd()->src_md(i));
+        srcs[i] = CTX_IN_MEM(const char *, DNNL_ARG_MULTIPLE_SRC + i)
+                + src_d.offset0() * src_d.data_type_size();
+    }
+
+    const dim_t N = dst_d.dims()[0];
+    const dim_t sp = pd()->sp_, sp_chunk = pd()->sp_chunk_;
+    const dim_t nchunks = utils::div_up(sp, sp_chunk);
+    const dim_t dst_n_stride = dst_d.blocking_desc().strides[0];
+
+    parallel_nd(N, nchunks, [&](dim_t b, dim_t chunk) {
+        const dim_t sp_start = chunk * sp_chunk;
+        jit_concat_call_s p;
+        p.work = nstl::min(sp_chunk, sp - sp_start);
+        for (int i = 0; i < n; i++) {
+            const auto &jcp = pd()->jcps_[i];
+            const memory_desc_wrapper src_d(pd()->src_md(i));
+            p.src = srcs[i]
+                    + (b * src_d.blocking_desc().strides[0]
+                              + sp_start * jcp.src_sp_stride)
+                            * src_d.data_type_size();
+            p.dst = dst
+                    + (b * dst_n_stride + sp_start * jcp.dst_sp_stride)
+                            * dst_dt_size;
+            (*kernels_[i])(&p);
+        }
+    });
+
+    return status::success;
+}
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
@@ -0,0 +1,140 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_X64_JIT_AVX512_CORE_CONCAT_HPP
+#define CPU_X64_JIT_AVX512_CORE_CONCAT_HPP
+
+#include <memory>
+#include <vector>
+
+#include "common/c_types_map.hpp"
+#include "common/primitive.hpp"
+
+#include "cpu/cpu_concat_pd.hpp"
+#include "cpu/x64/jit_generator.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+// Describes how a single input is copied into the destination. The channels
+// of a tensor are addressed as (c / blk) * cb_stride + c % blk inside of a
+// spatial point, where blk is the channel block (the padded number of
+// channels for the channels-last layouts). The spatial points of a tensor
+// are sp_stride elements apart.
+struct jit_concat_conf_t {
+    data_type_t src_dt, dst_dt;
+    int C; // channels of the input
+    int c_off; // offset of the input along the channels of the destination
+    int src_blk, dst_blk;
+    dim_t src_cb_stride, dst_cb_stride;
+    dim_t src_sp_stride, dst_sp_stride;
+    float scale;
+    // The last input also zeroes the padded channels of the destination.
+    int dst_zero_pad;
+};
+
+struct jit_concat_call_s {
+    const void *src;
+    void *dst;
+    dim_t work; // the number of spatial points
+};
+
+struct jit_avx512_core_concat_kernel_t : public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_avx512_core_concat_kernel_t)
+
+    jit_avx512_core_concat_kernel_t(const jit_concat_conf_t &ajcp)
+        : jit_generator(jit_name()), jcp(ajcp) {}
+
+    static constexpr int simd_w = 16;
+
+    const jit_concat_conf_t jcp;
+
+private:
+    using reg64_t = const Xbyak::Reg64;
+
+    reg64_t reg_param = abi_param1;
+    reg64_t reg_src = r8;
+    reg64_t reg_dst = r9;
+    reg64_t reg_work = r10;
+    reg64_t reg_ptr_src = r11;
+    reg64_t reg_ptr_dst = r12;
+    reg64_t reg_cnt = r13;
+    reg64_t reg_tmp = rax;
+
+    const Xbyak::Opmask k_load = k1;
+    // A chunk of the source is stored into at most (simd_w / 4 + 1) blocks
+    // of the destination.
+    static constexpr int max_store_masks = 6;
+
+    const Xbyak::Zmm zmm_data = zmm0;
+    const Xbyak::Zmm zmm_zero = zmm1;
+    const Xbyak::Zmm zmm_scale = zmm2;
+    const Xbyak::Zmm zmm_lbound = zmm3;
+    const Xbyak::Zmm zmm_ubound = zmm4;
+
+    // A part of the loaded vector that lands in a single destination block:
+    // the lanes of the mask are written at the offset plus the lane index.
+    struct store_t {
+        dim_t dst_off;
+        unsigned mask;
+    };
+
+    bool is_copy() const {
+        return jcp.src_dt == jcp.dst_dt && jcp.scale == 1.f;
+    }
+
+    void generate() override;
+    void set_mask(const Xbyak::Opmask &k, unsigned mask);
+    void load(const Xbyak::Address &addr);
+    void convert_to_dst_dt();
+    void store(const Xbyak::Address &addr, const Xbyak::Zmm &zmm);
+    void points_loop(dim_t src_off, const std::vector<store_t> &stores,
+            bool zero = false);
+};
+
+struct jit_avx512_core_concat_t : public primitive_t {
+    struct pd_t : public cpu_concat_pd_t {
+        using cpu_concat_pd_t::cpu_concat_pd_t;
+
+        DECLARE_CONCAT_PD_T(JIT_IMPL_NAME_HELPER("jit:", avx512_core, ""),
+                jit_avx512_core_concat_t);
+
+        status_t init(engine_t *engine);
+
+        std::vector<jit_concat_conf_t> jcps_;
+        // the number of spatial points of the destination, processed in
+        // chunks of sp_chunk_ points
+        dim_t sp_, sp_chunk_;
+    };
+
+    jit_avx512_core_concat_t(const pd_t *apd) : primitive_t(apd) {}
+
+    status_t init(engine_t *engine) override;
+    status_t execute(const exec_ctx_t &ctx) const override;
+
+private:
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+    std::vector<std::unique_ptr<jit_avx512_core_concat_kernel_t>> kernels_;
+};
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
@@ -83,6 +83,10 @@ struct brgemm_1x1_convolution_fwd_t : public primitive_t {
         return status::success;
     }
 
+    size_t get_owned_memory_size() const override {
+        return brg_kernel_palette_.size() * sizeof(amx_palette_t);
+    }
+
 protected:
     status_t init(engine_t *engine) override;
 
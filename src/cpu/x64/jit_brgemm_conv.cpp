@@ -854,6 +854,7 @@ status_t brgemm_convolution_fwd_t<isa, use_inversion>::execute(
     // or made ic_chunks = 1 if use_buffer
     // or (looks more general) increase buffer size to store several rows
 
+    work_scheduler_t scheduler(work_amount, jcp.nthr);
     parallel(jcp.nthr, [&](const int ithr, const int nthr) {
         if (ithr >= work_amount) return;
 
@@ -880,18 +881,6 @@ status_t brgemm_convolution_fwd_t<isa, use_inversion>::execute(
         char *const wsp_tile = is_amx
                 ? wsp_tile_global + ithr * 2 * brgemm_convolution_utils::P4K
                 : nullptr;
-        dim_t start {0}, end {0};
-        balance211(work_amount, nthr, ithr, start, end);
-        int n {0}, g {0}, ocb {0}, odb {0}, ohb {0}, owb {0};
-        if (jcp.loop_order == loop_ndhwgc)
-            nd_iterator_init(start, n, jcp.mb, odb, jcp.nb_od, ohb, jcp.nb_oh,
-                    owb, jcp.nb_ow, g, jcp.ngroups, ocb, jcp.nb_oc);
-        else if (jcp.loop_order == loop_ngcdhw)
-            nd_iterator_init(start, n, jcp.mb, g, jcp.ngroups, ocb, jcp.nb_oc,
-                    odb, jcp.nb_od, ohb, jcp.nb_oh, owb, jcp.nb_ow);
-        else
-            assert(!"Unknown loop order");
-
         brgemm_thread_ctx_t btc(
                 brgemm_ctx, ithr, brg_batch, c_buffer, wsp_tile);
         std::memset(btc.cur_palette.a, 0, AMX_PALETTE_SIZE);
@@ -902,66 +891,92 @@ status_t brgemm_convolution_fwd_t<isa, use_inversion>::execute(
         int last_odb = -1;
         int last_ohb = -1;
         int last_owb = -1;
-        for (auto work = start; work < end; work++) {
-            btc.g = g;
-            btc.n = n;
-            btc.ocb = ocb;
-            btc.odb = odb;
-            btc.ohb = ohb;
-            btc.owb = owb;
-            btc.src_zp_vals = src_zp_vals;
-            btc.dst_zp_vals = jcp.dst_zero_point ? dst_zp_vals : nullptr;
-            btc.src_zp_comp_ptr
-                    = jcp.src_zero_point ? src_zp_comp_base : nullptr;
-            btc.s8s8_comp_ptr = jcp.s8s8_avx512 ? s8s8_comp_base : nullptr;
-
-            if (jcp.exec_type == exec_trans && (last_n != n || last_g != g)) {
-                if (!jcp.copy_block_only)
-                    std::memset(
-                            inp_buffer_mask, false, jcp.inp_buffer_mask_size);
-            }
-            auto od_begin = odb * jcp.od_block;
-            auto od_end = nstl::min(OD, od_begin + jcp.od_block);
-            auto oh_begin = ohb * jcp.oh_block;
-            // if is_os_blocking is true then we do only one iteration of loop
-            // by oh and process entire oh block in kernel call
-            auto oh_end = jcp.is_os_blocking
-                    ? oh_begin + 1
-                    : nstl::min(OH, oh_begin + jcp.oh_block);
-            for_(int od = od_begin; od < od_end; od++)
-            for (int oh = oh_begin; oh < oh_end; oh++) {
-                for (int icc = 0; icc < ic_chunks; icc++) {
-                    btc.od = od;
-                    btc.oh = oh;
-                    btc.icc = icc;
-
-                    if (jcp.exec_type == exec_base) {
-                        ker_base(btc);
-                    } else if (jcp.exec_type == exec_trans) {
-                        maybe_conv_inp(ithr, src, inp_buffer, inp_buffer_mask,
-                                g, n, icc, odb, ohb, owb, last_g, last_n,
-                                last_icc, last_odb, last_ohb, last_owb);
-                        ker_trans(btc, inp_buffer);
-                    } else if (jcp.exec_type == exec_vpad) {
-                        ker_vpad(btc);
-                    } else
-                        assert(!"Unknown exec type");
-                    last_n = n;
-                    last_g = g;
-                    last_icc = icc;
-                    last_odb = odb;
-                    last_ohb = ohb;
-                    last_owb = owb;
-                }
-            }
+        // With dynamic scheduling the thread may get several ranges. The
+        // input buffer mask is per thread and is reset on (n, g) change, so
+        // it stays valid when jumping between the ranges.
+        // The runtime may provide less threads than requested, the work is
+        // split statically between them then.
+        work_scheduler_t static_scheduler(work_amount, nthr, false);
+        auto &thr_scheduler = nthr == jcp.nthr ? scheduler : static_scheduler;
+        dim_t start {0}, end {0};
+        while (thr_scheduler.next(ithr, start, end)) {
+            int n {0}, g {0}, ocb {0}, odb {0}, ohb {0}, owb {0};
             if (jcp.loop_order == loop_ndhwgc)
-                nd_iterator_step(n, jcp.mb, odb, jcp.nb_od, ohb, jcp.nb_oh, owb,
-                        jcp.nb_ow, g, jcp.ngroups, ocb, jcp.nb_oc);
+                nd_iterator_init(start, n, jcp.mb, odb, jcp.nb_od, ohb,
+                        jcp.nb_oh, owb, jcp.nb_ow, g, jcp.ngroups, ocb,
+                        jcp.nb_oc);
             else if (jcp.loop_order == loop_ngcdhw)
-                nd_iterator_step(n, jcp.mb, g, jcp.ngroups, ocb, jcp.nb_oc, odb,
-                        jcp.nb_od, ohb, jcp.nb_oh, owb, jcp.nb_ow);
+                nd_iterator_init(start, n, jcp.mb, g, jcp.ngroups, ocb,
+                        jcp.nb_oc, odb, jcp.nb_od, ohb, jcp.nb_oh, owb,
+                        jcp.nb_ow);
             else
                 assert(!"Unknown loop order");
+
+            for (auto work = start; work < end; work++) {
+                btc.g = g;
+                btc.n = n;
+                btc.ocb = ocb;
+                btc.odb = odb;
+                btc.ohb = ohb;
+                btc.owb = owb;
+                btc.src_zp_vals = src_zp_vals;
+                btc.dst_zp_vals = jcp.dst_zero_point ? dst_zp_vals : nullptr;
+                btc.src_zp_comp_ptr
+                        = jcp.src_zero_point ? src_zp_comp_base : nullptr;
+                btc.s8s8_comp_ptr = jcp.s8s8_avx512 ? s8s8_comp_base : nullptr;
+
+                if (jcp.exec_type == exec_trans
+                        && (last_n != n || last_g != g)) {
+                    if (!jcp.copy_block_only)
+                        std::memset(inp_buffer_mask, false,
+                                jcp.inp_buffer_mask_size);
+                }
+                auto od_begin = odb * jcp.od_block;
+                auto od_end = nstl::min(OD, od_begin + jcp.od_block);
+                auto oh_begin = ohb * jcp.oh_block;
+                // if is_os_blocking is true then we do only one iteration of
+                // loop by oh and process entire oh block in kernel call
+                auto oh_end = jcp.is_os_blocking
+                        ? oh_begin + 1
+                        : nstl::min(OH, oh_begin + jcp.oh_block);
+                for_(int od = od_begin; od < od_end; od++)
+                for (int oh = oh_begin; oh < oh_end; oh++) {
+                    for (int icc = 0; icc < ic_chunks; icc++) {
+                        btc.od = od;
+                        btc.oh = oh;
+                        btc.icc = icc;
+
+                        if (jcp.exec_type == exec_base) {
+                            ker_base(btc);
+                        } else if (jcp.exec_type == exec_trans) {
+                            maybe_conv_inp(ithr, src, inp_buffer,
+                                    inp_buffer_mask, g, n, icc, odb, ohb, owb,
+                                    last_g, last_n, last_icc, last_odb,
+                                    last_ohb, last_owb);
+                            ker_trans(btc, inp_buffer);
+                        } else if (jcp.exec_type == exec_vpad) {
+                            ker_vpad(btc);
+                        } else
+                            assert(!"Unknown exec type");
+                        last_n = n;
+                        last_g = g;
+                        last_icc = icc;
+                        last_odb = odb;
+                        last_ohb = ohb;
+                        last_owb = owb;
+                    }
+                }
+                if (jcp.loop_order == loop_ndhwgc)
+                    nd_iterator_step(n, jcp.mb, odb, jcp.nb_od, ohb,
+                            jcp.nb_oh, owb, jcp.nb_ow, g, jcp.ngroups, ocb,
+                            jcp.nb_oc);
+                else if (jcp.loop_order == loop_ngcdhw)
+                    nd_iterator_step(n, jcp.mb, g, jcp.ngroups, ocb,
+                            jcp.nb_oc, odb, jcp.nb_od, ohb, jcp.nb_oh, owb,
+                            jcp.nb_ow);
+                else
+                    assert(!"Unknown loop order");
+            }
         }
         if (is_amx) { amx_tile_release(); }
     });
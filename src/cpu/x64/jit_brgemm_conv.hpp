@@ -116,6 +116,14 @@ struct brgemm_convolution_fwd_t : public primitive_t {
 
     status_t execute(const exec_ctx_t &ctx) const override;
 
+    size_t get_owned_memory_size() const override {
+        return brg_kernel_palettes_.size() * sizeof(S_t)
+                + (owb_kw_top_vpads.size() + owb_kw_bottom_vpads.size()
+                          + kd_bs.size() + kd_es.size() + kh_bs.size()
+                          + kh_es.size())
+                * sizeof(dim_t);
+    }
+
 protected:
     status_t init(engine_t *engine) override;
 
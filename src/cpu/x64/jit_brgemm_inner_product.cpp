@@ -472,6 +472,8 @@ template struct brgemm_inner_product_fwd_t<avx512_core_bf16>;
 template struct brgemm_inner_product_fwd_t<avx512_core_vnni>;
 template struct brgemm_inner_product_fwd_t<avx512_core_bf16_amx_bf16>;
 template struct brgemm_inner_product_fwd_t<avx512_core_bf16_amx_int8>;
+template struct brgemm_inner_product_fwd_t<avx2_vnni>;
+template struct brgemm_inner_product_fwd_t<avx2>;
 
 template <cpu_isa_t isa>
 void brgemm_inner_product_bwd_data_t<isa>::execute_backward_data(
@@ -794,7 +794,11 @@ status_t init_ip_conf(cpu_isa_t isa, jit_brgemm_primitive_conf_t &jbgp,
     const memory_desc_wrapper dst_d(&dst_md);
 
     using namespace prop_kind;
-    if (!mayiuse(avx512_core)) return status::unimplemented;
+    if (!mayiuse(isa)) return status::unimplemented;
+    // AVX2 brgemm kernels are used for the forward propagation only
+    const bool is_avx2 = one_of(isa, avx2, avx2_vnni);
+    if (is_avx2 && !one_of(ipd.prop_kind, forward_training, forward_inference))
+        return status::unimplemented;
 
     int ndims = src_d.ndims();
     if (weights_d.ndims() != ndims || dst_d.ndims() != 2)
@@ -842,7 +846,8 @@ status_t init_ip_conf(cpu_isa_t isa, jit_brgemm_primitive_conf_t &jbgp,
             ? pick_by_prop_kind(jbgp.prop_kind, ipd.bias_desc.data_type,
                     data_type::undef, ipd.diff_bias_desc.data_type)
             : data_type::undef;
-    jbgp.signed_input = one_of(isa, avx512_core_vnni, avx512_core_bf16)
+    jbgp.signed_input
+            = one_of(isa, avx512_core_vnni, avx512_core_bf16, avx2_vnni)
             && jbgp.src_dt == s8;
     const bool is_int8 = one_of(jbgp.src_dt, u8, s8) && jbgp.wei_dt == s8;
     const bool is_bf16
@@ -858,12 +863,13 @@ status_t init_ip_conf(cpu_isa_t isa, jit_brgemm_primitive_conf_t &jbgp,
 
     if (!IMPLICATION(is_int8,
                 one_of(isa, avx512_core_vnni, avx512_core_bf16,
-                        avx512_core_bf16_amx_int8)))
+                        avx512_core_bf16_amx_int8, avx2_vnni)))
         return status::unimplemented;
     if (!IMPLICATION(is_bf16,
                 one_of(isa, avx512_core_bf16, avx512_core_bf16_amx_bf16)))
         return status::unimplemented;
-    if (!IMPLICATION(is_f32, isa == avx512_core)) return status::unimplemented;
+    if (!IMPLICATION(is_f32, one_of(isa, avx512_core, avx2)))
+        return status::unimplemented;
 
     if (is_int8) {
         jbgp.acc_dt = s32;
@@ -913,8 +919,11 @@ status_t init_ip_conf(cpu_isa_t isa, jit_brgemm_primitive_conf_t &jbgp,
                     | memory_extra_flags::compensation_conv_s8s8
                     | memory_extra_flags::scale_adjust;
             want_wei_md.extra.compensation_mask = (1 << 0);
-            want_wei_md.extra.scale_adjust
-                    = platform::s8s8_weights_scale_factor();
+            // vpdpbusd doesn't saturate intermediate results, so the weights
+            // are not scaled down for the AVX-VNNI kernel
+            want_wei_md.extra.scale_adjust = isa == avx2_vnni
+                    ? 1.0f
+                    : platform::s8s8_weights_scale_factor();
             if (weights_md.format_kind != format_kind::any
                     && want_wei_md != weights_md)
                 return status::unimplemented;
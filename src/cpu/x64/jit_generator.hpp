@@ -18,8 +18,10 @@
 #define CPU_X64_JIT_GENERATOR_HPP
 
 #include <limits.h>
+#include <vector>
 
 #include "common/bit_cast.hpp"
+#include "common/cache_blob.hpp"
 #include "common/compiler_workarounds.hpp"
 #include "common/type_helpers.hpp"
 #include "common/utils.hpp"
@@ -187,6 +189,21 @@ public:
 
     inline size_t get_size_of_abi_save_regs() { return size_of_abi_save_regs; }
 
+    // Both `mov(reg, label)` and `putL(label)` embed an absolute address of
+    // the code buffer into the code. The positions of such addresses are
+    // tracked to be able to relocate the code restored from a cache blob.
+    using Xbyak::CodeGenerator::mov;
+    void mov(const Xbyak::Reg64 &reg, const Xbyak::Label &label) {
+        Xbyak::CodeGenerator::mov(reg, label);
+        code_relocs_.push_back(getSize() - sizeof(size_t));
+    }
+
+    using Xbyak::CodeGenerator::putL;
+    void putL(const Xbyak::Label &label) {
+        code_relocs_.push_back(getSize());
+        Xbyak::CodeGenerator::putL(label);
+    }
+
     void preamble() {
         if (xmm_to_preserve) {
             sub(rsp, xmm_to_preserve * xmm_len);
@@ -2211,6 +2228,73 @@ public:
         return (jit_ker_) ? status::success : status::runtime_error;
     }
 
+    // Cache blob support.
+    //
+    // The kernel is stored as a single binary of the following layout:
+    // [number of relocations][relocation offsets][code], where the absolute
+    // addresses at the relocation offsets are replaced with the offsets from
+    // the beginning of the code.
+    //
+    // Note: only kernels that do not embed host addresses (e.g. pointers to
+    // static tables or to the primitive descriptor data) into the code can be
+    // stored, it is up to the primitive to check that.
+    status_t get_cache_blob_size(size_t *size) const {
+        if (!jit_ker_) return status::runtime_error;
+        (*size) += sizeof(size_t) + cache_blob_binary_size();
+        return status::success;
+    }
+
+    status_t get_cache_blob(cache_blob_t &cache_blob) const {
+        if (!jit_ker_) return status::runtime_error;
+
+        std::vector<uint8_t> binary(cache_blob_binary_size());
+        const size_t nrelocs = code_relocs_.size();
+        uint8_t *ptr = binary.data();
+        std::memcpy(ptr, &nrelocs, sizeof(nrelocs));
+        ptr += sizeof(nrelocs);
+        std::memcpy(ptr, code_relocs_.data(), nrelocs * sizeof(size_t));
+        ptr += nrelocs * sizeof(size_t);
+        std::memcpy(ptr, jit_ker_, getSize());
+        for (size_t off : code_relocs_) {
+            size_t addr;
+            std::memcpy(&addr, ptr + off, sizeof(addr));
+            addr -= reinterpret_cast<size_t>(jit_ker_);
+            std::memcpy(ptr + off, &addr, sizeof(addr));
+        }
+        return cache_blob.add_binary(binary.data(), binary.size());
+    }
+
+    // Restores the kernel code from the cache blob instead of generating it.
+    status_t create_kernel_from_cache_blob(cache_blob_t &cache_blob) {
+        const uint8_t *binary = nullptr;
+        size_t binary_size = 0;
+        CHECK(cache_blob.get_binary(&binary, &binary_size));
+
+        size_t nrelocs = 0;
+        if (binary_size < sizeof(nrelocs)) return status::invalid_arguments;
+        std::memcpy(&nrelocs, binary, sizeof(nrelocs));
+        const size_t relocs_size = (nrelocs + 1) * sizeof(size_t);
+        if (binary_size < relocs_size) return status::invalid_arguments;
+
+        code_relocs_.resize(nrelocs);
+        std::memcpy(code_relocs_.data(), binary + sizeof(nrelocs),
+                nrelocs * sizeof(size_t));
+        const size_t code_size = binary_size - relocs_size;
+        for (size_t off : code_relocs_)
+            if (off + sizeof(size_t) > code_size)
+                return status::invalid_arguments;
+
+        db(binary + relocs_size, code_size);
+        // The code buffer doesn't move after the code is emitted.
+        for (size_t off : code_relocs_) {
+            size_t addr;
+            std::memcpy(&addr, top_ + off, sizeof(addr));
+            rewrite(off, addr + reinterpret_cast<size_t>(top_), sizeof(addr));
+        }
+        jit_ker_ = getCode();
+        return (jit_ker_) ? status::success : status::runtime_error;
+    }
+
 private:
     const cpu_isa_t max_cpu_isa_;
     const Xbyak::uint8 *getCode() {
@@ -2229,6 +2313,13 @@ private:
         return Xbyak::GetError() == Xbyak::ERR_NONE;
     }
 
+    size_t cache_blob_binary_size() const {
+        return (code_relocs_.size() + 1) * sizeof(size_t) + getSize();
+    }
+
+    // Offsets of absolute code buffer addresses embedded into the code.
+    std::vector<size_t> code_relocs_;
+
 protected:
     virtual void generate() = 0;
     const Xbyak::uint8 *jit_ker_ = nullptr;
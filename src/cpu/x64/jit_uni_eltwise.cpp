@@ -283,6 +283,19 @@ private:
     std::unique_ptr<bf16_emulation_t> bf16_emu_;
 };
 
+// The kernel code is position independent unless it calls powf() from the
+// library, whose address is embedded into the code.
+bool kernel_supports_cache_blob(const eltwise_pd_t *pd) {
+    return pd->desc()->alg_kind != alg_kind::eltwise_pow;
+}
+
+status_t init_kernel(jit_generator *kernel, const eltwise_pd_t *pd,
+        cache_blob_t &cache_blob) {
+    if (cache_blob && kernel_supports_cache_blob(pd))
+        return kernel->create_kernel_from_cache_blob(cache_blob);
+    return kernel->create_kernel();
+}
+
 } // namespace
 
 template <cpu_isa_t isa, data_type_t d_type>
@@ -312,7 +325,22 @@ jit_uni_eltwise_fwd_t<isa, d_type>::~jit_uni_eltwise_fwd_t() = default;
 template <cpu_isa_t isa, data_type_t d_type>
 status_t jit_uni_eltwise_fwd_t<isa, d_type>::init(engine_t *engine) {
     CHECK(safe_ptr_assign(kernel_, new jit_uni_kernel_t<isa>(pd())));
-    return kernel_->create_kernel();
+    return init_kernel(kernel_.get(), pd(), cache_blob_);
+}
+
+template <cpu_isa_t isa, data_type_t d_type>
+status_t jit_uni_eltwise_fwd_t<isa, d_type>::get_cache_blob_size(
+        size_t *size) const {
+    if (!size) return status::invalid_arguments;
+    if (!kernel_supports_cache_blob(pd())) return status::unimplemented;
+    return kernel_->get_cache_blob_size(size);
+}
+
+template <cpu_isa_t isa, data_type_t d_type>
+status_t jit_uni_eltwise_fwd_t<isa, d_type>::get_cache_blob(
+        engine_t *engine, cache_blob_t &cache_blob) const {
+    if (!kernel_supports_cache_blob(pd())) return status::unimplemented;
+    return kernel_->get_cache_blob(cache_blob);
 }
 
 template <cpu_isa_t isa, data_type_t d_type>
@@ -378,7 +406,22 @@ jit_uni_eltwise_bwd_t<isa, d_type>::~jit_uni_eltwise_bwd_t() = default;
 template <cpu_isa_t isa, data_type_t d_type>
 status_t jit_uni_eltwise_bwd_t<isa, d_type>::init(engine_t *engine) {
     CHECK(safe_ptr_assign(kernel_, new jit_uni_kernel_t<isa>(pd())));
-    return kernel_->create_kernel();
+    return init_kernel(kernel_.get(), pd(), cache_blob_);
+}
+
+template <cpu_isa_t isa, data_type_t d_type>
+status_t jit_uni_eltwise_bwd_t<isa, d_type>::get_cache_blob_size(
+        size_t *size) const {
+    if (!size) return status::invalid_arguments;
+    if (!kernel_supports_cache_blob(pd())) return status::unimplemented;
+    return kernel_->get_cache_blob_size(size);
+}
+
+template <cpu_isa_t isa, data_type_t d_type>
+status_t jit_uni_eltwise_bwd_t<isa, d_type>::get_cache_blob(
+        engine_t *engine, cache_blob_t &cache_blob) const {
+    if (!kernel_supports_cache_blob(pd())) return status::unimplemented;
+    return kernel_->get_cache_blob(cache_blob);
 }
 
 template <cpu_isa_t isa, data_type_t d_type>
@@ -60,6 +60,10 @@ struct jit_uni_eltwise_fwd_t : public primitive_t {
 
     status_t execute(const exec_ctx_t &ctx) const override;
 
+    status_t get_cache_blob_size(size_t *size) const override;
+    status_t get_cache_blob(
+            engine_t *engine, cache_blob_t &cache_blob) const override;
+
 private:
     const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
     std::unique_ptr<jit_uni_eltwise_kernel> kernel_;
@@ -90,6 +94,10 @@ struct jit_uni_eltwise_bwd_t : public primitive_t {
 
     status_t execute(const exec_ctx_t &ctx) const override;
 
+    status_t get_cache_blob_size(size_t *size) const override;
+    status_t get_cache_blob(
+            engine_t *engine, cache_blob_t &cache_blob) const override;
+
 private:
     const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
     std::unique_ptr<jit_uni_eltwise_kernel> kernel_;
@@ -19,6 +19,9 @@
 #include "cpu/x64/cpu_isa_traits.hpp"
 #include "cpu/x64/jit_avx512_core_bf16cvt.hpp"
 #include "cpu/x64/jit_generator.hpp"
+#include "cpu/x64/injectors/jit_uni_postops_injector.hpp"
+#include "cpu/x64/utils/jit_io_helper.hpp"
+
 namespace dnnl {
 namespace impl {
 namespace cpu {
@@ -163,41 +166,47 @@ void jit_transfer_t<bf16>::store<bf16>(
         assert(!"unsupported nelems");
 }
 
-template <data_type_t data_type>
-struct jit_stat_and_data_kernel_t : stat_and_data_kernel_t<data_type>,
+template <cpu_isa_t isa>
+struct jit_stat_and_data_kernel_t : stat_and_data_kernel_t,
                                     public jit_generator {
     DECLARE_CPU_JIT_AUX_FUNCTIONS(lnorm_utils::jit_stat_and_data_kernel_t);
 
     jit_stat_and_data_kernel_t(const layer_normalization_pd_t *pd);
 
-    using data_t = typename prec_traits<data_type>::type;
-    void operator()(const data_t *src, data_t *dst, const float *scale,
-            const float *shift, float *mean, float *var,
+    void operator()(const void *src, void *dst, const float *scale,
+            const float *shift, float *mean, float *var, const float *oscales,
+            const void *post_ops_binary_rhs_arg_vec, const void *dst_orig,
             const size_t block_size) const override;
 
     status_t create_kernel() override { return jit_generator::create_kernel(); }
 
 private:
-    jit_transfer_t<data_type> jit_transfer_;
-    static constexpr int unroll_factor_ = 8;
-    static constexpr int simd_w = data_type == bf16 ? 16 : 8;
-    using Vmm = typename utils::conditional<data_type == bf16, Xbyak::Zmm,
-            Xbyak::Ymm>::type;
-    using stat_and_data_kernel_t<data_type>::C_;
-    using stat_and_data_kernel_t<data_type>::use_scaleshift_;
-    using stat_and_data_kernel_t<data_type>::use_scale_;
-    using stat_and_data_kernel_t<data_type>::use_shift_;
-    using stat_and_data_kernel_t<data_type>::save_stats_;
-    using stat_and_data_kernel_t<data_type>::calculate_stats_;
-    using stat_and_data_kernel_t<data_type>::eps_;
+    using Vmm = typename cpu_isa_traits<isa>::Vmm;
+    static constexpr int simd_w = cpu_isa_traits<isa>::vlen / sizeof(float);
+
+    const data_type_t src_dt_;
+    const data_type_t dst_dt_;
+    const bool with_oscale_;
+    const bool with_eltwise_;
+    const bool with_binary_;
+    // C_ % simd_w, the statistics process it element by element and the data
+    // pass with the masked loads and stores
+    const int tail_;
+    // On AVX2 the registers of the data pass alias the accumulators of the
+    // statistics beyond the fourth one, hence the unrolling is reduced.
+    const bool use_aux_vmms_;
+    const int unroll_factor_;
 
     struct ker_args_t {
-        const data_t *src;
-        data_t *dst;
+        const void *src;
+        void *dst;
         const float *scale;
         const float *shift;
         const float *mean;
         const float *var;
+        const float *oscales;
+        const void *post_ops_binary_rhs_arg_vec;
+        const void *dst_orig;
         size_t block_size;
         float eps;
     };
@@ -208,6 +217,8 @@ private:
     void compute(F op);
 
     void reduce();
+    void load_scalar(const Xbyak::Xmm &xmm, int offt_elems);
+    void apply_postops(bool tail, int offt_elems);
 
     const Xbyak::Reg64 reg_param = abi_param1;
     const Xbyak::Reg64 reg_src = rdx;
@@ -219,6 +230,12 @@ private:
     const Xbyak::Reg64 reg_eps = r10;
     const Xbyak::Reg64 reg_tmp = r11;
     const Xbyak::Reg64 reg_shift = r12;
+    const Xbyak::Reg64 reg_po_helper_1 = r13;
+    const Xbyak::Reg64 reg_po_helper_2 = r14;
+    const Xbyak::Reg64 reg_oscales = r15;
+
+    const Xbyak::Opmask k_tail_mask = k1;
+    const Xbyak::Opmask k_eltwise = k2;
 
     Vmm vmm_ones = Vmm(8);
     Vmm vmm_eps = Vmm(9);
@@ -230,68 +247,161 @@ private:
     Vmm vmm_src = vmm_inv_sqrtvar;
     Vmm vmm_dst = vmm_data;
 
+    // the registers of the data pass that live through the whole kernel
+    Vmm vmm_aux(int idx) const {
+        return Vmm((is_superset(isa, avx512_core) ? 16 : 4) + idx);
+    }
+    Vmm vmm_zero() const { return vmm_aux(0); }
+    Vmm vmm_ubound() const { return vmm_aux(1); }
+    Vmm vmm_tail_mask() const { return vmm_aux(2); }
+    Vmm vmm_rhs_helper() const { return vmm_aux(3); }
+
     Xmm xmm_return_value = Xmm(0);
     Xmm xmm_tmp = Xmm(14);
+
+    io::jit_io_helper_t<Vmm> src_io_;
+    io::jit_io_helper_t<Vmm> dst_io_;
+    // the scale and the shift
+    io::jit_io_helper_t<Vmm> ss_io_;
+    std::unique_ptr<injector::jit_uni_postops_injector_t<isa>>
+            postops_injector_;
 };
 
-template <data_type_t data_type>
-jit_stat_and_data_kernel_t<data_type>::jit_stat_and_data_kernel_t(
+namespace {
+// The bf16 conversions require AVX-512, the other data types are processed
+// with the AVX2 vectors. Returns isa_any if no JIT kernel can be used.
+cpu_isa_t get_stat_and_data_isa(const layer_normalization_pd_t *pd) {
+    const bool with_bf16 = utils::one_of(
+            bf16, pd->src_md()->data_type, pd->dst_md()->data_type);
+    if (!with_bf16) return mayiuse(avx2) ? avx2 : isa_any;
+    if (mayiuse(avx512_core_bf16)) return avx512_core_bf16;
+    return mayiuse(avx512_core) ? avx512_core : isa_any;
+}
+
+const bcast_set_t &get_supported_postops_bcast_strategies() {
+    static const bcast_set_t supported_strategies
+            = {broadcasting_strategy_t::scalar, broadcasting_strategy_t::per_oc,
+                    broadcasting_strategy_t::per_oc_spatial,
+                    broadcasting_strategy_t::no_broadcast};
+    return supported_strategies;
+}
+} // namespace
+
+template <cpu_isa_t isa>
+jit_stat_and_data_kernel_t<isa>::jit_stat_and_data_kernel_t(
         const layer_normalization_pd_t *pd)
-    : stat_and_data_kernel_t<data_type>(pd)
+    : stat_and_data_kernel_t(pd)
     , jit_generator(jit_name())
-    , jit_transfer_ {*this} {
-    assert(data_type == bf16 ? mayiuse(avx512_core) : mayiuse(avx2));
+    , src_dt_(pd->src_md()->data_type)
+    , dst_dt_(pd->dst_md()->data_type)
+    , with_oscale_(!pd->attr()->output_scales_.has_default_values())
+    , with_eltwise_(pd->attr()->post_ops_.find(primitive_kind::eltwise) != -1)
+    , with_binary_(pd->attr()->post_ops_.find(primitive_kind::binary) != -1)
+    , tail_(C_ % simd_w)
+    , use_aux_vmms_(!is_superset(isa, avx512_core)
+              && (tail_ > 0 || utils::one_of(dst_dt_, s8, u8)
+                      || with_binary_))
+    , unroll_factor_(use_aux_vmms_ ? 4 : 8)
+    , src_io_(this, isa, src_dt_, io::io_conf_t {},
+              io::io_tail_conf_t {(size_t)simd_w, (size_t)tail_, k_tail_mask,
+                      vmm_tail_mask().getIdx(), reg_tmp},
+              io::io_emu_bf16_conf_t {Zmm(28), Zmm(29), Zmm(30), reg_tmp,
+                      Zmm(31)})
+    , dst_io_(this, isa, dst_dt_, io::io_conf_t {},
+              io::io_tail_conf_t {(size_t)simd_w, (size_t)tail_, k_tail_mask,
+                      vmm_tail_mask().getIdx(), reg_tmp},
+              io::io_emu_bf16_conf_t {Zmm(28), Zmm(29), Zmm(30), reg_tmp,
+                      Zmm(31)},
+              io::io_saturation_conf_t {vmm_zero().getIdx(),
+                      vmm_ubound().getIdx(), reg_tmp})
+    , ss_io_(this, isa, f32, io::io_conf_t {},
+              io::io_tail_conf_t {(size_t)simd_w, (size_t)tail_, k_tail_mask,
+                      vmm_tail_mask().getIdx(), reg_tmp}) {
+    assert(mayiuse(isa));
+
+    if (with_eltwise_ || with_binary_) {
+        const memory_desc_wrapper dst_d(pd->dst_md());
+        const eltwise_injector::static_params_t esp(true /*save_state*/,
+                reg_po_helper_1, k_eltwise, true /*is_fwd*/,
+                false /*use_dst*/);
+        const binary_injector::rhs_arg_static_params_t rhs_arg_bsp {
+                static_cast<size_t>(vmm_rhs_helper().getIdx()),
+                reg_po_helper_1, reg_po_helper_2, true /*preserve gpr*/,
+                true /*preserve vmm*/,
+                offsetof(ker_args_t, post_ops_binary_rhs_arg_vec),
+                offsetof(ker_args_t, dst_orig), dst_d,
+                static_cast<size_t>(tail_), k_tail_mask,
+                false /*use_exact_tail_scalar_bcast*/};
+        const binary_injector::static_params_t bsp(reg_param,
+                get_supported_postops_bcast_strategies(), rhs_arg_bsp);
+
+        postops_injector_ = utils::make_unique<
+                injector::jit_uni_postops_injector_t<isa>>(
+                this, pd->attr()->post_ops_, bsp, esp);
+    }
 }
 
-template <data_type_t data_type>
-void jit_stat_and_data_kernel_t<data_type>::operator()(const data_t *src,
-        data_t *dst, const float *scale, const float *shift, float *mean,
-        float *var, const size_t block_size) const {
+template <cpu_isa_t isa>
+void jit_stat_and_data_kernel_t<isa>::operator()(const void *src, void *dst,
+        const float *scale, const float *shift, float *mean, float *var,
+        const float *oscales, const void *post_ops_binary_rhs_arg_vec,
+        const void *dst_orig, const size_t block_size) const {
     ker_args_t args;
     args.src = src;
     args.dst = dst;
     args.scale = scale;
     args.shift = shift;
     args.mean = mean;
-    args.block_size = block_size * C_ * types::data_type_size(data_type);
+    args.block_size = block_size * C_ * types::data_type_size(src_dt_);
     args.eps = eps_;
     args.var = var;
+    args.oscales = oscales;
+    args.post_ops_binary_rhs_arg_vec = post_ops_binary_rhs_arg_vec;
+    args.dst_orig = dst_orig;
     jit_generator::operator()(&args);
 }
 
-template <data_type_t data_type>
-void jit_stat_and_data_kernel_t<data_type>::generate() {
-    const auto c_size = C_ * types::data_type_size(data_type);
-    static const auto float_size = types::data_type_size(f32);
+template <cpu_isa_t isa>
+void jit_stat_and_data_kernel_t<isa>::generate() {
+    const int src_dt_size = types::data_type_size(src_dt_);
+    const int dst_dt_size = types::data_type_size(dst_dt_);
+    static const int float_size = types::data_type_size(f32);
 
     preamble();
-    if (jit_transfer_.bf16_emu_) jit_transfer_.bf16_emu_->init_vcvtneps2bf16();
+    src_io_.init_bf16();
+    dst_io_.init_bf16();
 #define PARAM_OFF(x) offsetof(ker_args_t, x)
     mov(reg_src, ptr[reg_param + PARAM_OFF(src)]);
     mov(reg_dst, ptr[reg_param + PARAM_OFF(dst)]);
     mov(reg_scale, ptr[reg_param + PARAM_OFF(scale)]);
     mov(reg_shift, ptr[reg_param + PARAM_OFF(shift)]);
-    mov(reg_mean, ptr[reg_param + PARAM_OFF(mean)]);
+    if (!use_rms_norm_) mov(reg_mean, ptr[reg_param + PARAM_OFF(mean)]);
     mov(reg_var, ptr[reg_param + PARAM_OFF(var)]);
     mov(reg_block_end, ptr[reg_param + PARAM_OFF(block_size)]);
     mov(reg_eps, ptr[reg_param + PARAM_OFF(eps)]);
+    mov(reg_oscales, ptr[reg_param + PARAM_OFF(oscales)]);
 #undef PARAM_OFF
     const int C_vecs = C_ / simd_w;
     // float value of 1
     static constexpr float one = 1.0;
 
-    const auto calculate_dst = [=](int nelems, size_t offt_elems) {
+    if (utils::one_of(dst_dt_, s8, u8)) {
+        uni_vpxor(vmm_zero(), vmm_zero(), vmm_zero());
+        dst_io_.init_saturate_f32();
+    }
+    if (tail_) ss_io_.prepare_tail_mask();
+
+    const auto calculate_dst = [=](bool tail, int offt_elems) {
         if (use_scaleshift_ || use_scale_) {
-            jit_transfer_.template load<f32>(
-                    vmm_gamma, reg_scale, nelems, offt_elems);
+            ss_io_.load(ptr[reg_scale + offt_elems * float_size], vmm_gamma,
+                    tail);
         }
         if (use_scaleshift_ || use_shift_) {
-            jit_transfer_.template load<f32>(
-                    vmm_beta, reg_shift, nelems, offt_elems);
+            ss_io_.load(
+                    ptr[reg_shift + offt_elems * float_size], vmm_beta, tail);
         }
-        jit_transfer_.template load<data_type>(
-                vmm_data, reg_src, nelems, offt_elems);
-        vsubps(vmm_data, vmm_data, vmm_mean);
+        src_io_.load(ptr[reg_src + offt_elems * src_dt_size], vmm_data, tail);
+        if (!use_rms_norm_) vsubps(vmm_data, vmm_data, vmm_mean);
         vmulps(vmm_data, vmm_data, vmm_inv_sqrtvar);
         if (use_scaleshift_ || (use_scale_ && use_shift_))
             vfmadd213ps(vmm_data, vmm_gamma, vmm_beta);
@@ -299,8 +409,13 @@ void jit_stat_and_data_kernel_t<data_type>::generate() {
             if (use_scale_) vmulps(vmm_data, vmm_data, vmm_gamma);
             if (use_shift_) vaddps(vmm_data, vmm_data, vmm_beta);
         }
-        jit_transfer_.template store<data_type>(
-                vmm_data, reg_dst, nelems, offt_elems);
+        if (with_oscale_) {
+            // gamma is not used anymore for this vector
+            uni_vbroadcastss(vmm_gamma, ptr[reg_oscales]);
+            vmulps(vmm_data, vmm_data, vmm_gamma);
+        }
+        if (postops_injector_) apply_postops(tail, offt_elems);
+        dst_io_.store(vmm_data, ptr[reg_dst + offt_elems * dst_dt_size], tail);
     };
 
     // add block_start to block_size to define block_end
@@ -319,23 +434,28 @@ void jit_stat_and_data_kernel_t<data_type>::generate() {
         jle(end, T_NEAR);
 
         if (calculate_stats_) {
-            // compute mean
-            compute([&](Vmm vmm_dst) { vaddps(vmm_dst, vmm_dst, vmm_src); });
-            if (save_stats_) vmovss(ptr[reg_mean], xmm_return_value);
-            vbroadcastss(vmm_mean, xmm_return_value);
+            if (!use_rms_norm_) {
+                // compute mean
+                compute([&](Vmm vmm_dst) {
+                    vaddps(vmm_dst, vmm_dst, vmm_src);
+                });
+                if (save_stats_) vmovss(ptr[reg_mean], xmm_return_value);
+                vbroadcastss(vmm_mean, xmm_return_value);
+            }
 
-            //compute var
-            vbroadcastss(vmm_mean, xmm_return_value);
+            //compute var, the mean square for the RMS normalization
             compute([&](Vmm vmm_dst) {
-                vsubps(vmm_src, vmm_mean, vmm_src);
+                if (!use_rms_norm_) vsubps(vmm_src, vmm_mean, vmm_src);
                 vfmadd231ps(vmm_dst, vmm_src, vmm_src);
             });
             if (save_stats_) vmovss(ptr[reg_var], xmm_return_value);
             vbroadcastss(vmm_inv_sqrtvar, xmm_return_value);
         } else {
             // read mean and var from input
-            vmovss(xmm_tmp, dword[reg_mean]);
-            vbroadcastss(vmm_mean, xmm_tmp);
+            if (!use_rms_norm_) {
+                vmovss(xmm_tmp, dword[reg_mean]);
+                vbroadcastss(vmm_mean, xmm_tmp);
+            }
             vmovss(xmm_tmp, dword[reg_var]);
             vbroadcastss(vmm_inv_sqrtvar, xmm_tmp);
         }
@@ -347,26 +467,27 @@ void jit_stat_and_data_kernel_t<data_type>::generate() {
 
         // calculate dst
         for (int i = 0; i < C_vecs; i++)
-            calculate_dst(simd_w, i * simd_w);
-
-        for (int i = utils::rnd_dn(C_, simd_w); i < C_; i++)
-            calculate_dst(1, i);
+            calculate_dst(false, i * simd_w);
+        if (tail_) calculate_dst(true, C_vecs * simd_w);
 
-        add(reg_src, c_size);
-        add(reg_dst, c_size);
-        add(reg_mean, float_size);
+        add(reg_src, C_ * src_dt_size);
+        add(reg_dst, C_ * dst_dt_size);
+        if (!use_rms_norm_) add(reg_mean, float_size);
         add(reg_var, float_size);
         jmp(unroll_loop);
     }
     L(end);
 
     postamble();
+
+    if (with_eltwise_ && postops_injector_) postops_injector_->prepare_table();
 }
 
-template <data_type_t data_type>
+template <cpu_isa_t isa>
 template <typename F>
-void jit_stat_and_data_kernel_t<data_type>::compute(F op) {
+void jit_stat_and_data_kernel_t<isa>::compute(F op) {
     const int C_vecs = C_ / simd_w;
+    const int src_dt_size = types::data_type_size(src_dt_);
 
     uni_vpxor(Vmm(0), Vmm(0), Vmm(0));
     if (C_vecs > 0) {
@@ -379,8 +500,9 @@ void jit_stat_and_data_kernel_t<data_type>::compute(F op) {
         // unrolled loop
         for (int i = 0; i < C_vecs / unroll; i++)
             for (int j = 0; j < unroll; j++) {
-                jit_transfer_.template load<data_type>(
-                        vmm_src, reg_src, simd_w, (i * unroll + j) * simd_w);
+                const int offt_elems = (i * unroll + j) * simd_w;
+                src_io_.load(ptr[reg_src + offt_elems * src_dt_size], vmm_src,
+                        false);
                 op(Vmm(j));
             }
 
@@ -394,8 +516,8 @@ void jit_stat_and_data_kernel_t<data_type>::compute(F op) {
 
         // unrolled loop remainder
         for (int i = utils::rnd_dn(C_vecs, unroll); i < C_vecs; i++) {
-            jit_transfer_.template load<data_type>(
-                    vmm_src, reg_src, simd_w, i * simd_w);
+            src_io_.load(
+                    ptr[reg_src + i * simd_w * src_dt_size], vmm_src, false);
             op(Vmm(0));
         }
 
@@ -405,7 +527,7 @@ void jit_stat_and_data_kernel_t<data_type>::compute(F op) {
 
     // vector remainder
     for (int i = utils::rnd_dn(C_, simd_w); i < C_; i++) {
-        jit_transfer_.template load<data_type>(vmm_src, reg_src, 1, i);
+        load_scalar(Xmm(vmm_src.getIdx()), i);
         op(Vmm(0));
     }
 
@@ -416,25 +538,63 @@ void jit_stat_and_data_kernel_t<data_type>::compute(F op) {
     vdivss(xmm_return_value, xmm_return_value, xmm_tmp);
 };
 
-template <>
-void jit_stat_and_data_kernel_t<bf16>::reduce() {
-    Ymm ymm_high = Ymm(1);
-    vextractf32x8(ymm_high, Zmm(0), 1);
-    vaddps(Ymm(0), ymm_high, Ymm(0));
-    vhaddps(Ymm(0), Ymm(0), Ymm(0));
-    vhaddps(Ymm(0), Ymm(0), Ymm(0));
-    Xmm xmm_high = Xmm(1);
-    vextractf128(xmm_high, Ymm(0), 1);
-    vaddps(xmm_return_value, xmm_high, xmm_return_value);
+template <cpu_isa_t isa>
+void jit_stat_and_data_kernel_t<isa>::reduce() {
+    if (is_superset(isa, avx512_core)) {
+        Ymm ymm_high = Ymm(1);
+        vextractf32x8(ymm_high, Zmm(0), 1);
+        vaddps(Ymm(0), ymm_high, Ymm(0));
+        vhaddps(Ymm(0), Ymm(0), Ymm(0));
+        vhaddps(Ymm(0), Ymm(0), Ymm(0));
+        Xmm xmm_high = Xmm(1);
+        vextractf128(xmm_high, Ymm(0), 1);
+        vaddps(xmm_return_value, xmm_high, xmm_return_value);
+    } else {
+        Xmm xmm_high = Xmm(1);
+        vextractf128(xmm_high, Ymm(0), 1);
+        vaddps(xmm_return_value, xmm_high, xmm_return_value);
+        vhaddps(xmm_return_value, xmm_return_value, xmm_return_value);
+        vhaddps(xmm_return_value, xmm_return_value, xmm_return_value);
+    }
 }
 
-template <>
-void jit_stat_and_data_kernel_t<f32>::reduce() {
-    Xmm xmm_high = Xmm(1);
-    vextractf128(xmm_high, Ymm(0), 1);
-    vaddps(xmm_return_value, xmm_high, xmm_return_value);
-    vhaddps(xmm_return_value, xmm_return_value, xmm_return_value);
-    vhaddps(xmm_return_value, xmm_return_value, xmm_return_value);
+// Loads a single element of the source into the lowest lane, the other lanes
+// are zeroed.
+template <cpu_isa_t isa>
+void jit_stat_and_data_kernel_t<isa>::load_scalar(
+        const Xmm &xmm, int offt_elems) {
+    const int offt = offt_elems * types::data_type_size(src_dt_);
+    switch (src_dt_) {
+        case f32: vmovss(xmm, dword[reg_src + offt]); break;
+        case bf16:
+            movzx(reg_tmp.cvt32(), word[reg_src + offt]);
+            vmovd(xmm, reg_tmp.cvt32());
+            vpslld(xmm, xmm, 0x10);
+            break;
+        case s8:
+        case u8:
+            if (src_dt_ == s8)
+                movsx(reg_tmp.cvt32(), byte[reg_src + offt]);
+            else
+                movzx(reg_tmp.cvt32(), byte[reg_src + offt]);
+            vmovd(xmm, reg_tmp.cvt32());
+            vcvtdq2ps(xmm, xmm);
+            break;
+        default: assert(!"unsupported data type");
+    }
+}
+
+template <cpu_isa_t isa>
+void jit_stat_and_data_kernel_t<isa>::apply_postops(
+        bool tail, int offt_elems) {
+    binary_injector::rhs_arg_dynamic_params_t rhs_arg_params;
+    if (with_binary_) {
+        const int idx = vmm_data.getIdx();
+        rhs_arg_params.vmm_idx_to_out_reg.emplace(idx, reg_dst);
+        rhs_arg_params.vmm_idx_to_out_elem_off_val.emplace(idx, offt_elems);
+        if (tail) rhs_arg_params.vmm_tail_idx_.emplace(idx);
+    }
+    postops_injector_->compute_vector(vmm_data.getIdx(), rhs_arg_params);
 }
 
 template <data_type_t data_type>
@@ -827,17 +987,32 @@ void jit_diff_data_kernel_t<bf16>::reduce(
     vaddps(xmm_vec, xmm_high, xmm_vec);
 };
 
-template <>
-stat_and_data_kernel_t<bf16> *stat_and_data_kernel_create(
-        const layer_normalization_pd_t *pd) {
-    return mayiuse(avx512_core) ? new jit_stat_and_data_kernel_t<bf16>(pd)
-                                : nullptr;
+bool stat_and_data_kernel_is_supported(const layer_normalization_pd_t *pd) {
+    const cpu_isa_t isa = get_stat_and_data_isa(pd);
+    if (isa == isa_any) return false;
+
+    const memory_desc_wrapper dst_d(pd->dst_md());
+    static constexpr bool sum_at_pos_0_only = false;
+    static constexpr bool sum_requires_scale_one = false;
+    static constexpr bool sum_requires_zp_zero = true;
+    const injector::post_ops_ok_args_t post_ops_args(isa,
+            {injector::eltwise, injector::binary}, pd->attr()->post_ops_,
+            &dst_d, sum_at_pos_0_only, sum_requires_scale_one,
+            sum_requires_zp_zero, get_supported_postops_bcast_strategies());
+    return injector::post_ops_ok(post_ops_args);
 }
 
-template <>
-stat_and_data_kernel_t<f32> *stat_and_data_kernel_create(
+stat_and_data_kernel_t *stat_and_data_kernel_create(
         const layer_normalization_pd_t *pd) {
-    return mayiuse(avx2) ? new jit_stat_and_data_kernel_t<f32>(pd) : nullptr;
+    if (!stat_and_data_kernel_is_supported(pd)) return nullptr;
+    switch (get_stat_and_data_isa(pd)) {
+        case avx512_core_bf16:
+            return new jit_stat_and_data_kernel_t<avx512_core_bf16>(pd);
+        case avx512_core:
+            return new jit_stat_and_data_kernel_t<avx512_core>(pd);
+        case avx2: return new jit_stat_and_data_kernel_t<avx2>(pd);
+        default: return nullptr;
+    }
 }
 
 template <>
@@ -25,8 +25,9 @@ namespace cpu {
 namespace x64 {
 namespace lnorm_utils {
 
-template <data_type_t d_type>
-cpu::lnorm_utils::stat_and_data_kernel_t<d_type> *stat_and_data_kernel_create(
+bool stat_and_data_kernel_is_supported(const layer_normalization_pd_t *pd);
+
+cpu::lnorm_utils::stat_and_data_kernel_t *stat_and_data_kernel_create(
         const layer_normalization_pd_t *pd);
 
 template <data_type_t d_type>
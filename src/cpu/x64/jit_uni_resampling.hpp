@@ -55,6 +55,12 @@ struct jit_uni_resampling_fwd_t : public primitive_t {
     status_t init(engine_t *engine) override;
     status_t execute(const exec_ctx_t &ctx) const override;
 
+    // The interpolation indices and weights are precomputed at creation.
+    size_t get_owned_memory_size() const override {
+        return indices_.size() * sizeof(unsigned)
+                + weights_.size() * sizeof(float);
+    }
+
 private:
     status_t fill_data_for_interpolation();
     /*
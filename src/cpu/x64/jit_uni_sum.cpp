@@ -0,0 +1,258 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "common/dnnl_thread.hpp"
+#include "common/memory_desc_wrapper.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/cpu_primitive.hpp"
+#include "cpu/platform.hpp"
+
+#include "cpu/x64/jit_uni_sum.hpp"
+
+#define GET_OFF(field) offsetof(jit_uni_sum_call_s, field)
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+using namespace dnnl::impl::data_type;
+using namespace dnnl::impl::utils;
+using namespace Xbyak;
+
+template <cpu_isa_t isa>
+jit_uni_sum_kernel_t<isa>::jit_uni_sum_kernel_t(
+        const jit_uni_sum_conf_t &ajsp, bool nt_stores)
+    : jit_generator(jit_name())
+    , jsp(ajsp)
+    , nt_stores_(nt_stores)
+    , src_io_(this, isa, jsp.src_dt, io::io_conf_t {},
+              io::io_tail_conf_t {(size_t)simd_w, (size_t)jsp.tail,
+                      k_tail_mask, vmm_tail_mask().getIdx(), reg_tmp})
+    , dst_io_(this, isa, jsp.dst_dt, io::io_conf_t {nt_stores},
+              io::io_tail_conf_t {(size_t)simd_w, (size_t)jsp.tail,
+                      k_tail_mask, vmm_tail_mask().getIdx(), reg_tmp},
+              utils::nullopt,
+              io::io_saturation_conf_t {vmm_zero().getIdx(),
+                      vmm_ubound().getIdx(), reg_tmp})
+    , dst_tail_io_(this, isa, jsp.dst_dt, io::io_conf_t {},
+              io::io_tail_conf_t {(size_t)simd_w, (size_t)jsp.tail,
+                      k_tail_mask, vmm_tail_mask().getIdx(), reg_tmp},
+              utils::nullopt,
+              io::io_saturation_conf_t {vmm_zero().getIdx(),
+                      vmm_ubound().getIdx(), reg_tmp}) {}
+
+template <cpu_isa_t isa>
+status_t jit_uni_sum_kernel_t<isa>::init_conf(jit_uni_sum_conf_t &jsp,
+        int num_srcs, const memory_desc_wrapper &src_d,
+        const memory_desc_wrapper &dst_d) {
+    jsp.num_srcs = num_srcs;
+    jsp.src_dt = src_d.data_type();
+    jsp.dst_dt = dst_d.data_type();
+    jsp.simd_w = simd_w;
+    jsp.unroll = is_superset(isa, avx512_core) ? 8 : 4;
+    jsp.nelems = dst_d.nelems(true);
+    jsp.tail = (int)(jsp.nelems % simd_w);
+
+    // Bypass the caches for the destination when the data does not fit the
+    // LLC anyway, so that the inputs are not evicted by the output.
+    const size_t data_size = jsp.nelems
+            * (num_srcs * types::data_type_size(jsp.src_dt)
+                    + types::data_type_size(jsp.dst_dt));
+    const size_t llc_size = platform::get_per_core_cache_size(3)
+            * (size_t)dnnl_get_max_threads();
+    jsp.use_nt = data_size > llc_size;
+
+    return status::success;
+}
+
+template <cpu_isa_t isa>
+void jit_uni_sum_kernel_t<isa>::compute(int nvecs, bool tail) {
+    const int src_dt_size = (int)types::data_type_size(jsp.src_dt);
+    const int dst_dt_size = (int)types::data_type_size(jsp.dst_dt);
+    const auto src_addr = [&](int u) {
+        return ptr[reg_src + reg_off * src_dt_size
+                + u * simd_w * src_dt_size];
+    };
+    const auto dst_addr = [&](int u) {
+        return ptr[reg_dst + reg_off * dst_dt_size
+                + u * simd_w * dst_dt_size];
+    };
+
+    for (int i = 0; i < jsp.num_srcs; i++) {
+        mov(reg_src, ptr[reg_srcs + i * (int)sizeof(void *)]);
+        uni_vbroadcastss(
+                vmm_scale(), ptr[reg_scales + i * (int)sizeof(float)]);
+        for (int u = 0; u < nvecs; u++) {
+            src_io_.load(src_addr(u), vmm_src(u), tail);
+            if (i == 0)
+                uni_vmulps(vmm_acc(u), vmm_src(u), vmm_scale());
+            else
+                uni_vfmadd231ps(vmm_acc(u), vmm_src(u), vmm_scale());
+        }
+    }
+
+    auto &io = tail ? dst_tail_io_ : dst_io_;
+    for (int u = 0; u < nvecs; u++)
+        io.store(vmm_acc(u), dst_addr(u), tail);
+}
+
+template <cpu_isa_t isa>
+void jit_uni_sum_kernel_t<isa>::generate() {
+    preamble();
+
+    mov(reg_srcs, ptr[reg_param + GET_OFF(srcs)]);
+    mov(reg_dst, ptr[reg_param + GET_OFF(dst)]);
+    mov(reg_scales, ptr[reg_param + GET_OFF(scales)]);
+    mov(reg_off, ptr[reg_param + GET_OFF(start)]);
+    mov(reg_size, ptr[reg_param + GET_OFF(size)]);
+
+    if (one_of(jsp.dst_dt, s8, u8)) {
+        uni_vpxor(vmm_zero(), vmm_zero(), vmm_zero());
+        dst_io_.init_saturate_f32();
+    }
+    if (jsp.tail) src_io_.prepare_tail_mask();
+
+    const int unroll_step = jsp.unroll * simd_w;
+    Label unroll_loop, vec_loop, tail_label, done;
+
+    L(unroll_loop);
+    {
+        cmp(reg_size, unroll_step);
+        jl(vec_loop, T_NEAR);
+        compute(jsp.unroll, false);
+        add(reg_off, unroll_step);
+        sub(reg_size, unroll_step);
+        jmp(unroll_loop, T_NEAR);
+    }
+
+    L(vec_loop);
+    {
+        cmp(reg_size, simd_w);
+        jl(tail_label, T_NEAR);
+        compute(1, false);
+        add(reg_off, simd_w);
+        sub(reg_size, simd_w);
+        jmp(vec_loop, T_NEAR);
+    }
+
+    // only the call with the last elements has the tail
+    L(tail_label);
+    if (jsp.tail) {
+        cmp(reg_size, 0);
+        jle(done, T_NEAR);
+        compute(1, true);
+    }
+    L(done);
+
+    if (nt_stores_) sfence();
+
+    postamble();
+}
+
+template <cpu_isa_t isa>
+status_t jit_uni_sum_t<isa>::pd_t::init(engine_t *engine) {
+    const int n = n_inputs();
+    bool ok = mayiuse(isa) && cpu_sum_pd_t::init(engine) == status::success;
+    if (!ok) return status::unimplemented;
+
+    // f16 is converted by the AVX-512 instructions only.
+    const auto dt_ok = [&](data_type_t dt) {
+        return one_of(dt, f32, s8, u8)
+                || (dt == f16 && is_superset(isa, avx512_core));
+    };
+
+    const memory_desc_wrapper o_d(dst_md());
+    ok = dt_ok(o_d.data_type()) && o_d.is_dense(true);
+    if (!ok) return status::unimplemented;
+
+    const memory_desc_wrapper i0_d(src_md(0));
+    for (int i = 0; i < n; ++i) {
+        const memory_desc_wrapper i_d(src_md(i));
+        ok = i_d.data_type() == i0_d.data_type() && dt_ok(i_d.data_type())
+                && o_d.similar_to(i_d, true, false, 0) && i_d.is_dense(true);
+        if (!ok) return status::unimplemented;
+    }
+
+    return jit_uni_sum_kernel_t<isa>::init_conf(jsp_, n, i0_d, o_d);
+}
+
+template <cpu_isa_t isa>
+status_t jit_uni_sum_t<isa>::init(engine_t *engine) {
+    CHECK(safe_ptr_assign(
+            kernel_, new jit_uni_sum_kernel_t<isa>(pd()->jsp_, false)));
+    CHECK(kernel_->create_kernel());
+    if (pd()->jsp_.use_nt) {
+        CHECK(safe_ptr_assign(
+                kernel_nt_, new jit_uni_sum_kernel_t<isa>(pd()->jsp_, true)));
+        CHECK(kernel_nt_->create_kernel());
+    }
+    return status::success;
+}
+
+template <cpu_isa_t isa>
+status_t jit_uni_sum_t<isa>::execute(const exec_ctx_t &ctx) const {
+    const auto &jsp = pd()->jsp_;
+    const int n = pd()->n_inputs();
+
+    const memory_desc_wrapper o_d(pd()->dst_md());
+    auto dst = CTX_OUT_MEM(char *, DNNL_ARG_DST)
+            + o_d.offset0() * o_d.data_type_size();
+
+    std::vector<const void *> srcs(n);
+    for (int i = 0; i < n; i++) {
+        const memory_desc_wrapper i_d(pd()->src_md(i));
+        srcs[i] = CTX_IN_MEM(const char *, DNNL_ARG_MULTIPLE_SRC + i)
+                + i_d.offset0() * i_d.data_type_size();
+    }
+
+    // The threads start at the multiples of the unrolled block, so that the
+    // non-temporal stores stay aligned once the destination is.
+    const bool dst_aligned = reinterpret_cast<uintptr_t>(dst)
+                    % cpu_isa_traits<isa>::vlen
+            == 0;
+    const auto *kernel
+            = jsp.use_nt && dst_aligned ? kernel_nt_.get() : kernel_.get();
+    const dim_t block = jsp.unroll * jsp.simd_w;
+    const dim_t nblocks = utils::div_up(jsp.nelems, block);
+
+    parallel(0, [&](const int ithr, const int nthr) {
+        dim_t start {0}, end {0};
+        balance211(nblocks, nthr, ithr, start, end);
+        if (start >= end) return;
+
+        jit_uni_sum_call_s p;
+        p.srcs = srcs.data();
+        p.dst = dst;
+        p.scales = pd()->scales();
+        p.start = start * block;
+        p.size = nstl::min(end * block, jsp.nelems) - p.start;
+        (*kernel)(&p);
+    });
+
+    return status::success;
+}
+
+template struct jit_uni_sum_kernel_t<avx512_core>;
+template struct jit_uni_sum_kernel_t<avx2>;
+template struct jit_uni_sum_t<avx512_core>;
+template struct jit_uni_sum_t<avx2>;
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
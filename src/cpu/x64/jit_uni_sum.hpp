@@ -0,0 +1,130 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_X64_JIT_UNI_SUM_HPP
+#define CPU_X64_JIT_UNI_SUM_HPP
+
+#include <memory>
+
+#include "common/c_types_map.hpp"
+#include "common/primitive.hpp"
+
+#include "cpu/cpu_sum_pd.hpp"
+#include "cpu/x64/cpu_isa_traits.hpp"
+#include "cpu/x64/jit_generator.hpp"
+#include "cpu/x64/utils/jit_io_helper.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+struct jit_uni_sum_conf_t {
+    int num_srcs;
+    data_type_t src_dt, dst_dt;
+    int simd_w;
+    int unroll;
+    dim_t nelems;
+    int tail; // nelems % simd_w, processed by the call with the last elements
+    bool use_nt; // non-temporal stores for the outputs that exceed the LLC
+};
+
+struct jit_uni_sum_call_s {
+    const void *const *srcs;
+    void *dst;
+    const float *scales;
+    dim_t start; // the first element to process
+    dim_t size; // in elements
+};
+
+// Computes dst = sum(scales[i] * srcs[i]) in a single pass: every vector of
+// the destination is accumulated in f32 over all the inputs and stored once.
+template <cpu_isa_t isa>
+struct jit_uni_sum_kernel_t : public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_uni_sum_kernel_t)
+
+    jit_uni_sum_kernel_t(const jit_uni_sum_conf_t &ajsp, bool nt_stores);
+
+    static status_t init_conf(jit_uni_sum_conf_t &jsp, int num_srcs,
+            const memory_desc_wrapper &src_d, const memory_desc_wrapper &dst_d);
+
+    using Vmm = typename cpu_isa_traits<isa>::Vmm;
+    static constexpr int simd_w = cpu_isa_traits<isa>::vlen / sizeof(float);
+
+    const jit_uni_sum_conf_t jsp;
+
+private:
+    using reg64_t = const Xbyak::Reg64;
+
+    reg64_t reg_param = abi_param1;
+    reg64_t reg_srcs = r8;
+    reg64_t reg_dst = r9;
+    reg64_t reg_scales = r10;
+    reg64_t reg_size = r11;
+    reg64_t reg_src = r12;
+    reg64_t reg_off = r13; // in elements
+    reg64_t reg_tmp = rax;
+
+    const Xbyak::Opmask k_tail_mask = k1;
+
+    Vmm vmm_acc(int u) const { return Vmm(u); }
+    Vmm vmm_src(int u) const { return Vmm(jsp.unroll + u); }
+    Vmm vmm_scale() const { return Vmm(2 * jsp.unroll); }
+    Vmm vmm_zero() const { return Vmm(2 * jsp.unroll + 1); }
+    Vmm vmm_ubound() const { return Vmm(2 * jsp.unroll + 2); }
+    Vmm vmm_tail_mask() const { return Vmm(2 * jsp.unroll + 3); }
+
+    const bool nt_stores_;
+    io::jit_io_helper_t<Vmm> src_io_;
+    io::jit_io_helper_t<Vmm> dst_io_;
+    // the non-temporal stores can not be masked
+    io::jit_io_helper_t<Vmm> dst_tail_io_;
+
+    void generate() override;
+    void compute(int nvecs, bool tail);
+};
+
+template <cpu_isa_t isa>
+struct jit_uni_sum_t : public primitive_t {
+    struct pd_t : public cpu_sum_pd_t {
+        using cpu_sum_pd_t::cpu_sum_pd_t;
+
+        DECLARE_SUM_PD_T(JIT_IMPL_NAME_HELPER("jit:", isa, ""), jit_uni_sum_t);
+
+        status_t init(engine_t *engine);
+
+        jit_uni_sum_conf_t jsp_;
+    };
+
+    jit_uni_sum_t(const pd_t *apd) : primitive_t(apd) {}
+
+    status_t init(engine_t *engine) override;
+    status_t execute(const exec_ctx_t &ctx) const override;
+
+private:
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+
+    std::unique_ptr<jit_uni_sum_kernel_t<isa>> kernel_;
+    // used for the destinations aligned to the vector length
+    std::unique_ptr<jit_uni_sum_kernel_t<isa>> kernel_nt_;
+};
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
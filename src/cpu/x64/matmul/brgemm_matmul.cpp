@@ -22,6 +22,7 @@
 #include "common/utils.hpp"
 
 #include "cpu/cpu_primitive.hpp"
+#include "cpu/ref_io_helper.hpp"
 
 #include "cpu/x64/amx_tile_configure.hpp"
 #include "cpu/x64/injectors/jit_uni_binary_injector.hpp"
@@ -46,11 +47,18 @@ status_t brgemm_matmul_t<isa>::pd_t::init(engine_t *engine) {
     const auto wei_dt = weights_md_.data_type;
     const auto dst_dt = dst_md_.data_type;
 
-    const bool is_f32 = everyone_is(f32, src_dt, wei_dt, dst_dt);
+    // The decompressed weights are computed in the source data type.
+    const bool is_wei_decomp = is_wei_decompression();
+    const auto comp_wei_dt = is_wei_decomp ? src_dt : wei_dt;
+
+    const bool is_f32 = everyone_is(f32, src_dt, comp_wei_dt, dst_dt);
     const bool is_int8 = one_of(src_dt, u8, s8) && wei_dt == s8
             && one_of(dst_dt, u8, s8, s32, f32, bf16);
-    const bool is_bf16
-            = everyone_is(bf16, src_dt, wei_dt) && one_of(dst_dt, bf16, f32);
+    const bool is_bf16 = everyone_is(bf16, src_dt, comp_wei_dt)
+            && one_of(dst_dt, bf16, f32);
+    // f16 is up-converted to f32 by the copy routines.
+    const bool is_f16 = isa == avx512_core && everyone_is(f16, src_dt, wei_dt)
+            && one_of(dst_dt, f16, f32);
 
     auto check_bias = [&]() -> bool {
         const bool is_bia_dt_correct
@@ -58,7 +66,8 @@ status_t brgemm_matmul_t<isa>::pd_t::init(engine_t *engine) {
                           && one_of(weights_md(1)->data_type, f32, s32, s8, u8,
                                   bf16))
                 || (is_bf16 && one_of(weights_md(1)->data_type, f32, bf16))
-                || (is_f32 && weights_md(1)->data_type == f32);
+                || (is_f32 && weights_md(1)->data_type == f32)
+                || (is_f16 && one_of(weights_md(1)->data_type, f32, f16));
         return IMPLICATION(with_bias(), is_bia_dt_correct && is_bias_1xN());
     };
 
@@ -68,77 +77,59 @@ status_t brgemm_matmul_t<isa>::pd_t::init(engine_t *engine) {
                 oscale.mask_ != 0, oscale.mask_ == (1 << (dst_md_.ndims - 1)));
     };
 
-    auto check_attr_zero_points
-            = [&]() -> bool { return attr()->zero_points_.common(); };
+    auto check_attr_zero_points = [&]() -> bool {
+        return is_wei_decomp ? attr_wei_decompression_ok()
+                             : attr()->zero_points_.common();
+    };
+
+    auto skip_mask = primitive_attr_t::skip_mask_t::oscale
+            | primitive_attr_t::skip_mask_t::zero_points_runtime
+            | primitive_attr_t::skip_mask_t::post_ops
+            | primitive_attr_t::skip_mask_t::sum_dt;
+    if (is_wei_decomp)
+        skip_mask |= primitive_attr_t::skip_mask_t::scales_runtime;
 
-    const bool problem_dt_correct = is_int8 || is_bf16 || is_f32;
+    const bool problem_dt_correct = is_int8 || is_bf16 || is_f32 || is_f16;
+    // The runtime dimensions are checked by init_brgemm_matmul_conf().
     bool ok = mayiuse(isa) && problem_dt_correct
-            && !has_runtime_dims_or_strides()
-            && attr()->has_default_values(primitive_attr_t::skip_mask_t::oscale
-                            | primitive_attr_t::skip_mask_t::zero_points_runtime
-                            | primitive_attr_t::skip_mask_t::post_ops
-                            | primitive_attr_t::skip_mask_t::sum_dt,
-                    dst_dt)
+            && attr()->has_default_values(skip_mask, dst_dt)
             && attr()->post_ops_.check_sum_consistent_dt(dst_dt)
             && check_attr_oscale() && check_attr_zero_points() && check_bias();
     if (!ok) return status::unimplemented;
 
+    // Only the int8 implementations quantize the source at runtime. Others
+    // defer to them if the problem can be computed this way.
+    constexpr bool is_int8_isa
+            = one_of(isa, avx512_core_vnni, avx512_core_bf16_amx_int8);
+    if (is_wei_decomp && attr()->src_dynamic_quantization_ && !is_int8_isa) {
+        for (cpu_isa_t int8_isa :
+                {avx512_core_bf16_amx_int8, avx512_core_vnni}) {
+            if (!mayiuse(int8_isa)) continue;
+            brgemm_matmul_conf_t int8_bgmmc;
+            memory_desc_t int8_src_md(src_md_), int8_wei_md(weights_md_),
+                    int8_dst_md(dst_md_), int8_bias_md(bias_md_);
+            primitive_attr_t int8_attr(*attr());
+            const status_t int8_status = init_brgemm_matmul_conf(int8_isa,
+                    int8_bgmmc, *desc(), int8_src_md, int8_wei_md,
+                    int8_dst_md, int8_bias_md, int8_attr);
+            if (int8_status == status::success
+                    && int8_bgmmc.with_src_dynamic_quant)
+                return status::unimplemented;
+        }
+    }
+
     CHECK(init_brgemm_matmul_conf(isa, bgmmc_, *desc(), src_md_, weights_md_,
             dst_md_, bias_md_, attr_));
 
-    const float alpha = 1.0;
-    const float beta = 1.0;
-    const float beta_init = 0.0;
-
     for_(int i_bs = 0; i_bs < 2; i_bs++)
     for_(int i_init = 0; i_init < 2; i_init++)
     for_(int i_M = 0; i_M < 2; i_M++)
     for_(int i_N = 0; i_N < 2; i_N++)
     for (int i_K = 0; i_K < 2; i_K++) {
-        auto vbeta = (i_init) ? beta_init : beta;
-        auto vM = (i_M) ? bgmmc_.M_tail : bgmmc_.M_blk;
-        auto vN = (i_N) ? bgmmc_.N_tail : bgmmc_.N_blk;
-        auto vK = (i_K) ? bgmmc_.K_tail : bgmmc_.K_blk;
-
-        int bs = get_brg_batchsize(bgmmc_, i_bs, i_K);
         int idx = get_brg_kernel_idx(i_bs, i_init, i_M, i_N, i_K);
         if (idx < 0) continue;
-        brgemm_t &brg = brg_descs_[idx];
-        auto LDA = i_K && bgmmc_.use_buffer_a_tail_only
-                ? (dim_t)bgmmc_.wei_k_blk
-                : bgmmc_.LDA;
-        CHECK(brgemm_desc_init(&brg, isa, bgmmc_.brg_type, bgmmc_.src_dt,
-                bgmmc_.wei_dt, false, false, brgemm_row_major, alpha, vbeta,
-                LDA, bgmmc_.LDB, bgmmc_.LDC, vM, vN, vK));
-
-        auto LDD = bgmmc_.LDD;
-        CHECK(brgemm_desc_set_postops(
-                &brg, attr(), &dst_md_, LDD, bgmmc_.bia_dt));
-
-        brgemm_attr_t brgattr;
-        brgattr.generate_skip_accumulation
-                = bgmmc_.post_ops_applicable && bgmmc_.nthr_k > 1;
-        constexpr bool is_amx = one_of(
-                isa, avx512_core_bf16_amx_int8, avx512_core_bf16_amx_bf16);
-        if (is_amx) {
-            if (!brgattr.generate_skip_accumulation) {
-                // TODO: uker doesn't yet support generate_skip_accumulation
-                brgattr.use_uker = true;
-                brgattr.use_interleave_stores = true;
-            }
-            brgattr.max_bs = bs;
-            brgattr.wary_tail_read = false;
-
-            // TODO: change expected sizes to local chunks wrt L2 blocking
-            brgattr.hint_expected_A_size = vM * vK * bs;
-            brgattr.hint_expected_B_size = vN * vK * bs;
-            brgattr.hint_expected_C_size = vM * vN * bs;
-            brgattr.hint_innermost_loop = brgemm_ld_loop_innermost;
-            brgattr.hint_prefetching
-                    = brgemm_kernel_prefetching_t::brgemm_prf_output1;
-        }
-
-        CHECK(brgemm_desc_set_attr(&brg, brgattr));
+        CHECK(init_brg_desc(&brg_descs_[idx], i_bs, i_init, i_N, i_K,
+                i_M ? bgmmc_.M_tail : bgmmc_.M_blk));
     }
 
     auto scratchpad = scratchpad_registry().registrar();
@@ -147,6 +138,53 @@ status_t brgemm_matmul_t<isa>::pd_t::init(engine_t *engine) {
     return status::success;
 }
 
+template <cpu_isa_t isa>
+status_t brgemm_matmul_t<isa>::pd_t::init_brg_desc(brgemm_t *brg, int i_bs,
+        int i_init, int i_N, int i_K, dim_t vM) const {
+    const float alpha = 1.0;
+    const float beta = 1.0;
+    const float beta_init = 0.0;
+
+    auto vbeta = (i_init) ? beta_init : beta;
+    auto vN = (i_N) ? bgmmc_.N_tail : bgmmc_.N_blk;
+    auto vK = (i_K) ? bgmmc_.K_tail : bgmmc_.K_blk;
+
+    int bs = get_brg_batchsize(bgmmc_, i_bs, i_K);
+    auto LDA = i_K && bgmmc_.use_buffer_a_tail_only ? (dim_t)bgmmc_.wei_k_blk
+                                                     : bgmmc_.LDA;
+    CHECK(brgemm_desc_init(brg, isa, bgmmc_.brg_type, bgmmc_.src_dt,
+            bgmmc_.wei_dt, false, false, brgemm_row_major, alpha, vbeta, LDA,
+            bgmmc_.LDB, bgmmc_.LDC, vM, vN, vK));
+
+    auto LDD = bgmmc_.LDD;
+    CHECK(brgemm_desc_set_postops(brg, attr(), &dst_md_, LDD, bgmmc_.bia_dt));
+
+    brgemm_attr_t brgattr;
+    brgattr.generate_skip_accumulation
+            = bgmmc_.post_ops_applicable && bgmmc_.nthr_k > 1;
+    constexpr bool is_amx
+            = one_of(isa, avx512_core_bf16_amx_int8, avx512_core_bf16_amx_bf16);
+    if (is_amx) {
+        if (!brgattr.generate_skip_accumulation) {
+            // TODO: uker doesn't yet support generate_skip_accumulation
+            brgattr.use_uker = true;
+            brgattr.use_interleave_stores = true;
+        }
+        brgattr.max_bs = bs;
+        brgattr.wary_tail_read = false;
+
+        // TODO: change expected sizes to local chunks wrt L2 blocking
+        brgattr.hint_expected_A_size = vM * vK * bs;
+        brgattr.hint_expected_B_size = vN * vK * bs;
+        brgattr.hint_expected_C_size = vM * vN * bs;
+        brgattr.hint_innermost_loop = brgemm_ld_loop_innermost;
+        brgattr.hint_prefetching
+                = brgemm_kernel_prefetching_t::brgemm_prf_output1;
+    }
+
+    return brgemm_desc_set_attr(brg, brgattr);
+}
+
 template <cpu_isa_t isa>
 status_t brgemm_matmul_t<isa>::init(engine_t *engine) {
     for_(int i_bs = 0; i_bs < 2; i_bs++)
@@ -187,27 +225,48 @@ status_t brgemm_matmul_t<isa>::init(engine_t *engine) {
 
 template <cpu_isa_t isa>
 status_t brgemm_matmul_t<isa>::execute_body(const exec_ctx_t &ctx) const {
+    brgemm_matmul_conf_t bgmmc = pd()->get_brgemm_matmul_conf();
+    const brg_M_tail_kernels_t *M_tail_kernels = nullptr;
+    if (bgmmc.is_runtime_M) {
+        const auto dst_d = ctx.memory_mdw(DNNL_ARG_DST, pd()->dst_md());
+        update_runtime_M_values(bgmmc, dst_d.dims()[bgmmc.ndims - 2]);
+        if (bgmmc.M_tail > 0)
+            CHECK(get_runtime_M_tail_kernels(bgmmc.M_tail, &M_tail_kernels));
+    }
+
     DEFINE_ZERO_POINT_VALUE(src_zero_point, DNNL_ARG_SRC);
-    DEFINE_ZERO_POINT_VALUE(wei_zero_point, DNNL_ARG_WEIGHTS);
     DEFINE_ZERO_POINT_VALUE(dst_zero_point, DNNL_ARG_DST);
+    // The weights zero points of the decompressed weights are applied by the
+    // copy B routine, they may be defined per group of K rows or per N.
+    int32_t wei_zero_point = 0;
+    if (!bgmmc.with_wei_decompression) {
+        DEFINE_ZERO_POINT_VALUE(zero_point, DNNL_ARG_WEIGHTS);
+        wei_zero_point = zero_point;
+    }
+    DEFINE_ARG_SCALES_BUFFER(wei_decomp_scales, DNNL_ARG_WEIGHTS);
+    DEFINE_ZERO_POINTS_BUFFER(wei_decomp_zero_points, DNNL_ARG_WEIGHTS);
 
-    brg_matmul_exec_ctx_t brgmm_ctx(
-            ctx, pd(), src_zero_point, wei_zero_point, dst_zero_point);
-
-    const auto &bgmmc = pd()->get_brgemm_matmul_conf();
+    brg_matmul_exec_ctx_t brgmm_ctx(ctx, pd(), bgmmc, M_tail_kernels,
+            src_zero_point, wei_zero_point, dst_zero_point, wei_decomp_scales,
+            wei_decomp_zero_points);
+    if (bgmmc.with_src_dynamic_quant) compute_src_quant_scales(brgmm_ctx);
     const bool use_buffer_a
             = bgmmc.use_buffer_a || bgmmc.use_buffer_a_tail_only;
     constexpr bool is_amx
             = one_of(isa, avx512_core_bf16_amx_int8, avx512_core_bf16_amx_bf16);
     const int num_threads = brgmm_ctx.get_num_threads_for_parallelization();
 
+    // The threads sharing the same (b, m, n) work with the parallel reduction
+    // have to process the same ranges, hence it requires static scheduling.
+    work_scheduler_t scheduler(brgmm_ctx.get_parallel_work_amount(),
+            brgmm_ctx.get_num_threads_for_bmn(),
+            get_dynamic_scheduling()
+                    && !brgmm_ctx.parallel_reduction_is_used());
+
     parallel(num_threads, [&](const int ithr, const int nthr) {
         const int ithr_bmn = brgmm_ctx.get_thread_idx_for_bmn(ithr);
         const int ithr_k = brgmm_ctx.get_thread_idx_for_k(ithr);
         if (ithr_bmn < 0 || ithr_k < 0) return;
-        int start {0}, end {0};
-        balance211(brgmm_ctx.get_parallel_work_amount(),
-                brgmm_ctx.get_num_threads_for_bmn(), ithr_bmn, start, end);
         int kc_start {0}, kc_end {bgmmc.K_chunks};
         if (brgmm_ctx.parallel_reduction_is_used())
             balance211((int)bgmmc.K_chunks, brgmm_ctx.get_num_threads_for_k(),
@@ -218,30 +277,39 @@ status_t brgemm_matmul_t<isa>::execute_body(const exec_ctx_t &ctx) const {
             amx_tile_configure(&brg_kernel_palettes_[base_ker_idx][0]);
         }
 
-        int b {0}, mc {0}, nc {0};
-        nd_iterator_init(
-                start, b, bgmmc.batch, mc, bgmmc.M_chunks, nc, bgmmc.N_chunks);
-        while (start < end) {
-            auto m_start = mc * bgmmc.M_chunk_size;
-            auto m_end = nstl::min(
-                    (mc + 1) * bgmmc.M_chunk_size, bgmmc.num_M_blocks);
-            auto n_start = nc * bgmmc.N_chunk_size;
-            auto n_end = nstl::min(
-                    (nc + 1) * bgmmc.N_chunk_size, bgmmc.num_N_blocks);
-            for_(int kc = kc_start; kc < kc_end; kc++)
-            for (int nb = n_start; nb < n_end; nb++) {
-                if (bgmmc.use_buffer_b)
-                    copy_b_chunk_in_buffer(brgmm_ctx, ithr, b, nb, kc);
-                for (int mb = m_start; mb < m_end; mb++) {
-                    if (use_buffer_a && nb == n_start)
-                        copy_a_chunk_in_buffer(brgmm_ctx, ithr, b, mb, kc);
-                    compute_kernel(
-                            brgmm_ctx, ithr, b, mb, nb, kc, kc == kc_start);
+        // The runtime may provide less threads than requested, the work is
+        // split statically then.
+        work_scheduler_t static_scheduler(brgmm_ctx.get_parallel_work_amount(),
+                brgmm_ctx.get_num_threads_for_bmn(), false);
+        auto &thr_scheduler
+                = nthr == num_threads ? scheduler : static_scheduler;
+        dim_t start {0}, end {0};
+        while (thr_scheduler.next(ithr_bmn, start, end)) {
+            int b {0}, mc {0}, nc {0};
+            nd_iterator_init(start, b, bgmmc.batch, mc, bgmmc.M_chunks, nc,
+                    bgmmc.N_chunks);
+            while (start < end) {
+                auto m_start = mc * bgmmc.M_chunk_size;
+                auto m_end = nstl::min(
+                        (mc + 1) * bgmmc.M_chunk_size, bgmmc.num_M_blocks);
+                auto n_start = nc * bgmmc.N_chunk_size;
+                auto n_end = nstl::min(
+                        (nc + 1) * bgmmc.N_chunk_size, bgmmc.num_N_blocks);
+                for_(int kc = kc_start; kc < kc_end; kc++)
+                for (int nb = n_start; nb < n_end; nb++) {
+                    if (bgmmc.use_buffer_b)
+                        copy_b_chunk_in_buffer(brgmm_ctx, ithr, b, nb, kc);
+                    for (int mb = m_start; mb < m_end; mb++) {
+                        if (use_buffer_a && nb == n_start)
+                            copy_a_chunk_in_buffer(brgmm_ctx, ithr, b, mb, kc);
+                        compute_kernel(brgmm_ctx, ithr, b, mb, nb, kc,
+                                kc == kc_start);
+                    }
                 }
+                ++start;
+                nd_iterator_step(
+                        b, bgmmc.batch, mc, bgmmc.M_chunks, nc, bgmmc.N_chunks);
             }
-            ++start;
-            nd_iterator_step(
-                    b, bgmmc.batch, mc, bgmmc.M_chunks, nc, bgmmc.N_chunks);
         }
         if (is_amx) { amx_tile_release(); }
     });
@@ -257,7 +325,7 @@ void brgemm_matmul_t<isa>::compute_kernel(
         int m_blk_idx, int n_blk_idx, int k_chunk_idx, bool do_init) const {
     constexpr bool is_amx
             = one_of(isa, avx512_core_bf16_amx_int8, avx512_core_bf16_amx_bf16);
-    const auto &bgmmc = pd()->get_brgemm_matmul_conf();
+    const auto &bgmmc = brgmm_ctx.get_conf();
     const auto addr_batch = brgmm_ctx.get_batch_elem_ptr(ithr);
     const int base_brg_ker_idx = brgmm_ctx.get_base_brgemm_kernel_idx();
 
@@ -278,7 +346,7 @@ void brgemm_matmul_t<isa>::compute_kernel(
     const bool is_K_tail
             = is_last_K_chunk && (gemm_batch * bgmmc.K_blk) != remaining_k_blks;
     auto is_bs_tail = (gemm_batch != bgmmc.brgemm_batch_size);
-    const int brg_ker_idx = pd()->get_brg_kernel_idx(
+    const int brg_ker_idx = brgmm_ctx.get_brg_kernel_idx(
             is_bs_tail, do_init, is_M_tail, is_N_tail, false);
     const auto ptr_bias = brgmm_ctx.get_bias_ptr(n);
     auto ptr_D = brgmm_ctx.get_data_C_ptr(b_idx, m, n);
@@ -296,12 +364,12 @@ void brgemm_matmul_t<isa>::compute_kernel(
             && (bgmmc.nthr_k <= 1 || bgmmc.K_chunks == 1);
 
     if (gemm_batch > 0 && brg_ker_idx >= 0) {
-        const auto brg_kernel = brg_kernels_[brg_ker_idx].get();
+        const auto brg_kernel = get_brg_kernel(brgmm_ctx, brg_ker_idx);
         assert(brg_kernel != nullptr);
 
         const bool is_tile_reconf_required = is_amx && (is_M_tail || is_N_tail);
         if (is_tile_reconf_required)
-            amx_tile_configure(&brg_kernel_palettes_[brg_ker_idx][0]);
+            amx_tile_configure(get_brg_kernel_palette(brgmm_ctx, brg_ker_idx));
 
         brgmm_ctx.init_brgemm_batch_elements_values(
                 ithr, 0, gemm_batch, b_idx, m_blk_idx, k_blk_idx, n_blk_idx);
@@ -344,13 +412,13 @@ void brgemm_matmul_t<isa>::compute_kernel(
                 ithr, gemm_batch, 1, b_idx, m_blk_idx, k_blk_idx, n_blk_idx);
 
         const bool use_init_ker = (do_init && gemm_batch == 0);
-        const int brg_ker_idx = pd()->get_brg_kernel_idx(
+        const int brg_ker_idx = brgmm_ctx.get_brg_kernel_idx(
                 false, use_init_ker, is_M_tail, is_N_tail, true);
-        const auto brg_kernel_k_tail = brg_kernels_[brg_ker_idx].get();
+        const auto brg_kernel_k_tail = get_brg_kernel(brgmm_ctx, brg_ker_idx);
         const bool is_tile_reconf_required
                 = is_amx && bgmmc.K_tail != bgmmc.K_blk;
         if (is_tile_reconf_required)
-            amx_tile_configure(&brg_kernel_palettes_[brg_ker_idx][0]);
+            amx_tile_configure(get_brg_kernel_palette(brgmm_ctx, brg_ker_idx));
         if (post_ops_applicable) {
             void *scratch = is_amx
                     ? static_cast<void *>(wsp_tile)
@@ -383,6 +451,63 @@ void brgemm_matmul_t<isa>::compute_kernel(
         if (is_tile_reconf_required)
             amx_tile_configure(&brg_kernel_palettes_[base_brg_ker_idx][0]);
     }
+
+    if (bgmmc.with_src_dynamic_quant && is_last_K_chunk)
+        dequantize_dst(brgmm_ctx, ithr, b_idx, m_blk_idx, n_blk_idx);
+}
+
+// Computes the factors the source rows are multiplied by before conversion
+// to s8, so that the maximum absolute value of a row maps to 127.
+template <cpu_isa_t isa>
+void brgemm_matmul_t<isa>::compute_src_quant_scales(
+        const brg_matmul_exec_ctx_t &brgmm_ctx) const {
+    const auto &bgmmc = brgmm_ctx.get_conf();
+
+    parallel_nd(bgmmc.batch, bgmmc.M, [&](dim_t b, dim_t m) {
+        const char *src = brgmm_ctx.get_data_A_ptr(b, m, 0);
+        float amax = 0.f;
+        for (dim_t k = 0; k < bgmmc.K; k++) {
+            const float s = io::load_float_value(bgmmc.orig_src_dt, src, k);
+            amax = nstl::max(amax, nstl::abs(s));
+        }
+        *brgmm_ctx.get_src_quant_scales_ptr(b, m)
+                = amax > 0.f ? 127.f / amax : 1.f;
+    });
+}
+
+// Converts the s32 result of a block to the destination data type as
+// (acc + s8s8_comp) * wei_scale / src_quant_scale + bias.
+template <cpu_isa_t isa>
+void brgemm_matmul_t<isa>::dequantize_dst(
+        const brg_matmul_exec_ctx_t &brgmm_ctx, int ithr, int b_idx,
+        int m_blk_idx, int n_blk_idx) const {
+    const auto &bgmmc = brgmm_ctx.get_conf();
+    const int m = m_blk_idx * bgmmc.M_blk;
+    const int n = n_blk_idx * bgmmc.N_blk;
+    const int M_blk = nstl::min(bgmmc.M - m, bgmmc.M_blk);
+    const int N_blk = nstl::min(bgmmc.N - n, bgmmc.N_blk);
+
+    const auto acc = reinterpret_cast<const int32_t *>(
+            brgmm_ctx.get_buf_C_ptr(ithr, m_blk_idx, n_blk_idx));
+    const int32_t *comp = brgmm_ctx.get_s8s8_comp_ptr(ithr, b_idx, n_blk_idx);
+    const float *src_scales = brgmm_ctx.get_src_quant_scales_ptr(b_idx, m);
+    const float *wei_scales = brgmm_ctx.get_wei_decomp_scales_ptr(0, n);
+    const dim_t wei_scales_str = bgmmc.wei_decomp_scales_n_str;
+    const char *bias = brgmm_ctx.get_bias_ptr(n);
+
+    for (int i = 0; i < M_blk; i++) {
+        const int32_t *acc_row = acc + i * bgmmc.LDC;
+        char *dst_row = brgmm_ctx.get_data_C_ptr(b_idx, m + i, n);
+        const float src_scale = 1.f / src_scales[i];
+        PRAGMA_OMP_SIMD()
+        for (int j = 0; j < N_blk; j++) {
+            const int32_t s = acc_row[j] + (comp ? comp[j] : 0);
+            float d = s * src_scale;
+            if (wei_scales) d *= wei_scales[j * wei_scales_str];
+            if (bias) d += io::load_float_value(bgmmc.bia_dt, bias, j);
+            io::store_float_value(bgmmc.dst_dt, d, dst_row, j);
+        }
+    }
 }
 
 template <cpu_isa_t isa>
@@ -390,7 +515,7 @@ void brgemm_matmul_t<isa>::maybe_reduce_partial_results_and_apply_postops(
         const brg_matmul_exec_ctx_t &brgmm_ctx) const {
     if (!brgmm_ctx.parallel_reduction_is_used()) return;
 
-    const auto &bgmmc = pd()->get_brgemm_matmul_conf();
+    const auto &bgmmc = brgmm_ctx.get_conf();
     const int num_threads = brgmm_ctx.get_num_threads_for_parallelization();
 
     parallel(num_threads, [&](const int ithr, const int nthr) {
@@ -444,9 +569,10 @@ void brgemm_matmul_t<isa>::maybe_reduce_partial_results_and_apply_postops(
                     for (int nb = nb_start; nb < nb_end; nb++) {
                         const bool is_N_tail
                                 = (bgmmc.N - nb * bgmmc.N_blk < bgmmc.N_blk);
-                        const int brg_ker_idx = pd()->get_brg_kernel_idx(
+                        const int brg_ker_idx = brgmm_ctx.get_brg_kernel_idx(
                                 false, false, is_M_tail, is_N_tail, false);
-                        const auto brg_kernel = brg_kernels_[brg_ker_idx].get();
+                        const auto brg_kernel
+                                = get_brg_kernel(brgmm_ctx, brg_ker_idx);
                         const int m = mb * bgmmc.M_blk;
                         const int n = nb * bgmmc.N_blk;
                         const auto ptr_bias = brgmm_ctx.get_bias_ptr(n);
@@ -503,7 +629,7 @@ template <cpu_isa_t isa>
 void brgemm_matmul_t<isa>::copy_a_chunk_in_buffer(
         const brg_matmul_exec_ctx_t &brgmm_ctx, int ithr, int b_idx,
         int m_blk_idx, int k_chunk_idx) const {
-    const auto &bgmmc = pd()->get_brgemm_matmul_conf();
+    const auto &bgmmc = brgmm_ctx.get_conf();
 
     auto ctx = jit_brgemm_matmul_copy_a_t::ctx_t();
     const int k_start = k_chunk_idx * bgmmc.K_chunk_elems;
@@ -523,6 +649,8 @@ void brgemm_matmul_t<isa>::copy_a_chunk_in_buffer(
                     ithr, m_blk_idx);
     ctx.zp_b_neg_value_ptr = (void *)brgmm_ctx.get_zp_b_neg_val_ptr();
     ctx.zp_ab_comp_ptr = (void *)brgmm_ctx.get_zp_ab_mixed_comp_ptr();
+    ctx.src_quant_scales_ptr
+            = (void *)brgmm_ctx.get_src_quant_scales_ptr(b_idx, m);
 
     for (int gb = 0; gb < gemm_batch_iters; gb++) {
         const int k = k_start + gb * bgmmc.K_blk;
@@ -550,7 +678,7 @@ template <cpu_isa_t isa>
 void brgemm_matmul_t<isa>::copy_b_chunk_in_buffer(
         const brg_matmul_exec_ctx_t &brgmm_ctx, int ithr, int b_idx,
         int n_blk_idx, int k_chunk_idx) const {
-    const auto &bgmmc = pd()->get_brgemm_matmul_conf();
+    const auto &bgmmc = brgmm_ctx.get_conf();
 
     const int k_start = k_chunk_idx * bgmmc.K_chunk_elems;
     const bool is_K_tail
@@ -565,29 +693,41 @@ void brgemm_matmul_t<isa>::copy_b_chunk_in_buffer(
             = (void *)brgmm_ctx.get_zp_a_compensation_ptr(ithr, n_blk_idx);
     ctx.zp_a_neg_value_ptr = (void *)brgmm_ctx.get_zp_a_neg_val_ptr();
 
+    // The weights decompression parameters are shared by the groups of K
+    // rows only, so a single copy call must not cross a group boundary.
+    auto copy_b = [&](int gb, int k, int k_iters) {
+        const int k_group = bgmmc.wei_decomp_k_group;
+        char *tr_src = brgmm_ctx.get_buf_B_ptr(ithr, gb, n_blk_idx);
+        for (int k_off = 0; k_off < k_iters;) {
+            const int k_cur = k + k_off;
+            const int k_cur_iters = bgmmc.with_wei_decompression
+                    ? nstl::min(k_iters - k_off, k_group - k_cur % k_group)
+                    : k_iters;
+            ctx.src = (void *)brgmm_ctx.get_data_B_ptr(b_idx, k_cur, n);
+            ctx.tr_src = (void *)(tr_src + k_off * bgmmc.LDB * bgmmc.b_dt_sz);
+            ctx.compensation_ptr = (void *)brgmm_ctx.get_s8s8_comp_ptr(
+                    ithr, b_idx, n_blk_idx);
+            ctx.wei_decomp_scales_ptr
+                    = brgmm_ctx.get_wei_decomp_scales_ptr(k_cur, n);
+            ctx.wei_decomp_zero_points_ptr
+                    = brgmm_ctx.get_wei_decomp_zero_points_ptr(k_cur, n);
+            ctx.current_K_start = k_cur;
+            ctx.current_K_iters = k_cur_iters;
+
+            (*copy_B_kernel_)(&ctx);
+            k_off += k_cur_iters;
+        }
+    };
+
     int gb = 0;
     for (; gb < gemm_batch; gb++) {
         const int k = k_start + gb * bgmmc.K_blk;
-        ctx.src = (void *)brgmm_ctx.get_data_B_ptr(b_idx, k, n);
-        ctx.tr_src = (void *)brgmm_ctx.get_buf_B_ptr(ithr, gb, n_blk_idx);
-        ctx.compensation_ptr
-                = (void *)brgmm_ctx.get_s8s8_comp_ptr(ithr, b_idx, n_blk_idx);
-        ctx.current_K_start = k;
-        ctx.current_K_iters = nstl::min(bgmmc.K_blk, bgmmc.K);
-
-        (*copy_B_kernel_)(&ctx);
+        copy_b(gb, k, nstl::min(bgmmc.K_blk, bgmmc.K));
     }
 
     if (is_K_tail) {
         const int k = k_start + gb * bgmmc.K_blk;
-        ctx.src = (void *)brgmm_ctx.get_data_B_ptr(b_idx, k, n);
-        ctx.tr_src = (void *)brgmm_ctx.get_buf_B_ptr(ithr, gb, n_blk_idx);
-        ctx.compensation_ptr
-                = (void *)brgmm_ctx.get_s8s8_comp_ptr(ithr, b_idx, n_blk_idx);
-        ctx.current_K_start = k;
-        ctx.current_K_iters = bgmmc.K % bgmmc.K_blk;
-
-        (*copy_B_kernel_)(&ctx);
+        copy_b(gb, k, bgmmc.K % bgmmc.K_blk);
     }
 }
 
@@ -604,11 +744,69 @@ void brgemm_matmul_t<isa>::accumulate(
         assert(!"unsupported accumulation data type");
 }
 
+template <cpu_isa_t isa>
+status_t brgemm_matmul_t<isa>::get_runtime_M_tail_kernels(
+        dim_t M_tail, const brg_M_tail_kernels_t **kernels) const {
+    std::lock_guard<std::mutex> lock(runtime_M_tail_kernels_mtx_);
+
+    auto &M_tail_kernels = runtime_M_tail_kernels_[M_tail];
+    if (!M_tail_kernels) {
+        brgemm_matmul_conf_t bgmmc = pd()->get_brgemm_matmul_conf();
+        bgmmc.M_tail = M_tail;
+
+        std::unique_ptr<brg_M_tail_kernels_t> new_kernels(
+                new brg_M_tail_kernels_t());
+        for_(int i_bs = 0; i_bs < 2; i_bs++)
+        for_(int i_N = 0; i_N < 2; i_N++)
+        for_(int i_K = 0; i_K < 2; i_K++)
+        for (int i_init = 0; i_init < 2; i_init++) {
+            int bs = get_brg_batchsize(bgmmc, i_bs, i_K);
+            int idx = get_brg_kernel_index(
+                    bgmmc, i_bs, i_init, true, i_N, i_K, bs);
+            if (idx < 0) continue;
+
+            brgemm_t brg;
+            CHECK(pd()->init_brg_desc(&brg, i_bs, i_init, i_N, i_K, M_tail));
+            brgemm_kernel_t *ker = nullptr;
+            CHECK(brgemm_kernel_create(&ker, brg));
+            CHECK(safe_ptr_assign(new_kernels->kernels[idx], ker));
+            if (one_of(isa, avx512_core_bf16_amx_int8,
+                        avx512_core_bf16_amx_bf16))
+                CHECK(brgemm_init_tiles(brg, &new_kernels->palettes[idx][0]));
+        }
+        M_tail_kernels = std::move(new_kernels);
+    }
+
+    *kernels = M_tail_kernels.get();
+    return status::success;
+}
+
+template <cpu_isa_t isa>
+const brgemm_kernel_t *brgemm_matmul_t<isa>::get_brg_kernel(
+        const brg_matmul_exec_ctx_t &brgmm_ctx, int idx) const {
+    const auto M_tail_kernels = brgmm_ctx.get_runtime_M_tail_kernels();
+    if (M_tail_kernels && M_tail_kernels->kernels[idx])
+        return M_tail_kernels->kernels[idx].get();
+    return brg_kernels_[idx].get();
+}
+
+template <cpu_isa_t isa>
+const char *brgemm_matmul_t<isa>::get_brg_kernel_palette(
+        const brg_matmul_exec_ctx_t &brgmm_ctx, int idx) const {
+    const auto M_tail_kernels = brgmm_ctx.get_runtime_M_tail_kernels();
+    if (M_tail_kernels && M_tail_kernels->kernels[idx])
+        return &M_tail_kernels->palettes[idx][0];
+    return &brg_kernel_palettes_[idx][0];
+}
+
 template <cpu_isa_t isa>
 struct brgemm_matmul_t<isa>::brg_matmul_exec_ctx_t {
-    brg_matmul_exec_ctx_t(const exec_ctx_t &ctx, const pd_t *pd, int32_t src_zp,
-            int32_t wei_zp, int32_t dst_zp)
-        : bgmmc_(pd->get_brgemm_matmul_conf()) {
+    brg_matmul_exec_ctx_t(const exec_ctx_t &ctx, const pd_t *pd,
+            const brgemm_matmul_conf_t &bgmmc,
+            const brg_M_tail_kernels_t *M_tail_kernels, int32_t src_zp,
+            int32_t wei_zp, int32_t dst_zp, const float *wei_decomp_scales,
+            const int32_t *wei_decomp_zero_points)
+        : bgmmc_(bgmmc), M_tail_kernels_(M_tail_kernels) {
 
         data_A_ptr_ = CTX_IN_MEM(const char *, DNNL_ARG_SRC);
         data_B_ptr_ = CTX_IN_MEM(const char *, DNNL_ARG_WEIGHTS);
@@ -617,7 +815,6 @@ struct brgemm_matmul_t<isa>::brg_matmul_exec_ctx_t {
         bias_ptr_ = CTX_IN_MEM(const char *, DNNL_ARG_BIAS);
         oscales_ptr_ = pd->attr()->output_scales_.scales_;
         memory_tracking::grantor_t scratchpad = ctx.get_scratchpad_grantor();
-        const auto &bgmmc = pd->get_brgemm_matmul_conf();
 
         batch_element_ptr_ = scratchpad.template get<brgemm_batch_element_t>(
                 key_brgemm_primitive_batch);
@@ -663,6 +860,10 @@ struct brgemm_matmul_t<isa>::brg_matmul_exec_ctx_t {
                 ? scratchpad.template get<int32_t>(
                         key_brgemm_primitive_zp_comp_b)
                 : nullptr;
+        src_quant_scales_ptr_ = bgmmc.with_src_dynamic_quant
+                ? scratchpad.template get<float>(
+                        key_brgemm_primitive_src_quant_scales)
+                : nullptr;
 
         zero_point_a_negative_val_ = -src_zp;
         zero_point_b_negative_val_ = -wei_zp;
@@ -671,6 +872,9 @@ struct brgemm_matmul_t<isa>::brg_matmul_exec_ctx_t {
 
         zero_point_c_val_ = dst_zp;
 
+        wei_decomp_scales_ptr_ = wei_decomp_scales;
+        wei_decomp_zero_points_ptr_ = wei_decomp_zero_points;
+
         post_ops_binary_rhs_arg_vec_ = binary_injector::prepare_binary_args(
                 pd->attr()->post_ops_, ctx);
         base_brg_ker_idx_
@@ -928,6 +1132,29 @@ struct brgemm_matmul_t<isa>::brg_matmul_exec_ctx_t {
         }
     }
 
+    const float *get_wei_decomp_scales_ptr(int k, int n) const {
+        if (!bgmmc_.with_wei_decomp_scales) return nullptr;
+
+        return wei_decomp_scales_ptr_
+                + (k / bgmmc_.wei_decomp_k_group)
+                * bgmmc_.wei_decomp_scales_k_str
+                + n * bgmmc_.wei_decomp_scales_n_str;
+    }
+
+    const int32_t *get_wei_decomp_zero_points_ptr(int k, int n) const {
+        if (!bgmmc_.with_wei_decomp_zero_points) return nullptr;
+
+        return wei_decomp_zero_points_ptr_
+                + (k / bgmmc_.wei_decomp_k_group) * bgmmc_.wei_decomp_zp_k_str
+                + n * bgmmc_.wei_decomp_zp_n_str;
+    }
+
+    float *get_src_quant_scales_ptr(int b, int m) const {
+        if (!bgmmc_.with_src_dynamic_quant) return nullptr;
+
+        return src_quant_scales_ptr_ + (dim_t)b * bgmmc_.M + m;
+    }
+
     const char *get_bias_ptr(int n) const {
         if (!bgmmc_.with_bias) return nullptr;
 
@@ -1014,6 +1241,19 @@ struct brgemm_matmul_t<isa>::brg_matmul_exec_ctx_t {
 
     int get_base_brgemm_kernel_idx() const { return base_brg_ker_idx_; }
 
+    int get_brg_kernel_idx(bool is_bs_tail, bool do_initialization,
+            bool is_M_tail, bool is_N_tail, bool is_K_tail) const {
+        int bs = get_brg_batchsize(bgmmc_, is_bs_tail, is_K_tail);
+        return get_brg_kernel_index(bgmmc_, is_bs_tail, do_initialization,
+                is_M_tail, is_N_tail, is_K_tail, bs);
+    }
+
+    const brg_M_tail_kernels_t *get_runtime_M_tail_kernels() const {
+        return M_tail_kernels_;
+    }
+
+    const brgemm_matmul_conf_t &get_conf() const { return bgmmc_; }
+
     bool is_last_K_chunk(int k_chunk_idx) const {
         return k_chunk_idx == bgmmc_.K_chunks - 1;
     }
@@ -1045,6 +1285,7 @@ struct brgemm_matmul_t<isa>::brg_matmul_exec_ctx_t {
 private:
     bool is_amx_;
     const brgemm_matmul_conf_t &bgmmc_;
+    const brg_M_tail_kernels_t *M_tail_kernels_;
     const char *data_A_ptr_;
     const char *data_B_ptr_;
     char *data_C_ptr_;
@@ -1067,6 +1308,9 @@ private:
     int32_t zero_point_b_negative_val_;
     int32_t zero_point_mixed_ab_compensation_component_;
     int32_t zero_point_c_val_;
+    const float *wei_decomp_scales_ptr_;
+    const int32_t *wei_decomp_zero_points_ptr_;
+    float *src_quant_scales_ptr_;
     std::vector<const void *> post_ops_binary_rhs_arg_vec_;
 
     int base_brg_ker_idx_;
@@ -1083,6 +1327,8 @@ template struct brgemm_matmul_t<avx512_core_bf16_amx_bf16>;
 template struct brgemm_matmul_t<avx512_core_bf16>;
 template struct brgemm_matmul_t<avx512_core_vnni>;
 template struct brgemm_matmul_t<avx512_core>;
+template struct brgemm_matmul_t<avx2_vnni>;
+template struct brgemm_matmul_t<avx2>;
 
 } // namespace matmul
 } // namespace x64
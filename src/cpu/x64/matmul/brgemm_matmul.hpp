@@ -17,6 +17,9 @@
 #ifndef CPU_X64_MATMUL_BRGEMM_MATMUL_HPP
 #define CPU_X64_MATMUL_BRGEMM_MATMUL_HPP
 
+#include <mutex>
+#include <unordered_map>
+
 #include "common/c_types_map.hpp"
 #include "common/primitive.hpp"
 #include "common/type_helpers.hpp"
@@ -79,6 +82,8 @@ struct brgemm_matmul_t : public primitive_t {
                     is_M_tail, is_N_tail, is_K_tail, bs);
         }
         const brgemm_t &get_brg_desc(int idx) const { return brg_descs_[idx]; }
+        status_t init_brg_desc(brgemm_t *brg, int i_bs, int i_init, int i_N,
+                int i_K, dim_t vM) const;
         const brgemm_matmul_conf_t &get_brgemm_matmul_conf() const {
             return bgmmc_;
         }
@@ -101,6 +106,14 @@ struct brgemm_matmul_t : public primitive_t {
 private:
     struct brg_matmul_exec_ctx_t;
 
+    // The kernels computing the M tail of a problem with runtime M. They are
+    // generated on the first execution with a given M tail and reused by the
+    // following ones.
+    struct brg_M_tail_kernels_t {
+        std::unique_ptr<brgemm_kernel_t> kernels[max_num_brg_kernels_matmul];
+        char palettes[max_num_brg_kernels_matmul][64];
+    };
+
     const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
     status_t execute_body(const exec_ctx_t &ctx) const;
     void compute_kernel(const brg_matmul_exec_ctx_t &brgmm_ctx, int ithr,
@@ -112,8 +125,17 @@ private:
             int ithr, int b_idx, int n_blk_idx, int k_blk_idx) const;
     void maybe_reduce_partial_results_and_apply_postops(
             const brg_matmul_exec_ctx_t &brgmm_ctx) const;
+    void compute_src_quant_scales(const brg_matmul_exec_ctx_t &brgmm_ctx) const;
+    void dequantize_dst(const brg_matmul_exec_ctx_t &brgmm_ctx, int ithr,
+            int b_idx, int m_blk_idx, int n_blk_idx) const;
     void accumulate(
             char *result_ptr, const char *reduce_ptr, size_t size) const;
+    status_t get_runtime_M_tail_kernels(
+            dim_t M_tail, const brg_M_tail_kernels_t **kernels) const;
+    const brgemm_kernel_t *get_brg_kernel(
+            const brg_matmul_exec_ctx_t &brgmm_ctx, int idx) const;
+    const char *get_brg_kernel_palette(
+            const brg_matmul_exec_ctx_t &brgmm_ctx, int idx) const;
 
     std::unique_ptr<brgemm_kernel_t> brg_kernels_[max_num_brg_kernels_matmul];
     char brg_kernel_palettes_[max_num_brg_kernels_matmul][64];
@@ -121,6 +143,10 @@ private:
     std::unique_ptr<jit_brgemm_matmul_copy_a_t> copy_A_kernel_;
     std::unique_ptr<cpu_accumulator_1d_t<data_type::f32>> acc_ker_f32_;
     std::unique_ptr<cpu_accumulator_1d_t<data_type::s32>> acc_ker_s32_;
+
+    mutable std::mutex runtime_M_tail_kernels_mtx_;
+    mutable std::unordered_map<dim_t, std::unique_ptr<brg_M_tail_kernels_t>>
+            runtime_M_tail_kernels_;
 };
 
 } // namespace matmul
@@ -42,6 +42,7 @@ struct jit_brgemm_matmul_copy_a_impl_t : public jit_brgemm_matmul_copy_a_t,
         : jit_brgemm_matmul_copy_a_t(conf)
         , jit_generator(jit_name())
         , typesize(conf_->a_dt_sz)
+        , src_typesize(conf_->orig_a_dt_sz)
         , vnni_granularity(granularity_max / typesize)
         , k_step(bytes_in_zmm / typesize) {}
 
@@ -61,8 +62,10 @@ private:
         num_comp_acc = 8,
         k_loop_unroll = 16,
         bytes_in_zmm = 64,
+        quant_k_step = 16,
     };
     const int typesize;
+    const int src_typesize;
     const int vnni_granularity;
     const int k_step;
 
@@ -89,9 +92,12 @@ private:
     reg64_t imm_addr64 = r15;
     reg64_t reg_zp_ab_comp_ptr = imm_addr64;
     reg64_t reg_zp_b_neg_val_ptr = reg_K_blk;
+    reg64_t reg_src_quant_scales = r8;
 
     zmm zmm_comp_mul = zmm30;
     zmm zmm_comp_add = zmm31;
+    // No compensation is computed for the source quantized at runtime.
+    zmm zmm_src_quant_scale = zmm30;
 
     // Allows to shift A data by 128 for s8s8 problem for AVX512 in copy
     // routine, not in compute kernel. It's disabled for now, as it
@@ -109,6 +115,8 @@ private:
     }
     void reduce_compensation_across_accumulators(int num_accumulators);
     void copy_row(int ncolumns);
+    void quantize_K_loop(bool is_K_tail);
+    void up_convert_K_loop(bool is_K_tail);
     void copy_K_loop(bool is_K_tail, bool is_first_K_iter, bool is_last_K_iter);
     void copy_M_loop(bool is_K_tail, bool is_first_K_iter, bool is_last_K_iter);
     void generate() override;
@@ -127,12 +135,89 @@ void jit_brgemm_matmul_copy_a_impl_t::reduce_compensation_across_accumulators(
     }
 }
 
+// Converts a row of f32 / bf16 source values to s8 as
+// saturate(round(src * src_quant_scale)).
+void jit_brgemm_matmul_copy_a_impl_t::quantize_K_loop(bool is_K_tail) {
+    const int K_blk = is_K_tail ? conf_->K % conf_->K_blk
+                                : nstl::min(conf_->K, conf_->K_blk);
+    const int k_tail = K_blk % quant_k_step;
+    const int num_k_iters = K_blk / quant_k_step;
+
+    auto quantize = [=](int k_idx, bool is_tail) {
+        const auto zmm_q = get_zmm_copy(k_idx % k_loop_unroll);
+        const auto zmm_load = is_tail ? zmm_q | kTail_load | T_z : zmm_q;
+        const auto addr = EVEX_compress_addr(
+                reg_src, (size_t)k_idx * quant_k_step * src_typesize);
+        if (conf_->orig_src_dt == data_type::bf16) {
+            vpmovzxwd(zmm_load, addr);
+            vpslld(zmm_q, zmm_q, 16);
+        } else
+            vmovups(zmm_load, addr);
+        vmulps(zmm_q, zmm_q, zmm_src_quant_scale);
+        vcvtps2dq(zmm_q, zmm_q);
+
+        const auto tr_addr = EVEX_compress_addr(
+                reg_tr_src, (size_t)k_idx * quant_k_step * typesize);
+        vpmovsdb(tr_addr, is_tail ? zmm_q | kTail_store : zmm_q);
+    };
+
+    for (int k = 0; k < num_k_iters; k++)
+        quantize(k, false);
+
+    if (k_tail > 0) {
+        // The tail is padded by zeros up to the vnni granularity.
+        const int k_tail_st = rnd_up(k_tail, vnni_granularity);
+        mov(regq_tmp.cvt32(), (1 << k_tail) - 1);
+        kmovw(kTail_load, regq_tmp.cvt32());
+        mov(regq_tmp.cvt32(), (1 << k_tail_st) - 1);
+        kmovw(kTail_store, regq_tmp.cvt32());
+        quantize(num_k_iters, true);
+    }
+}
+
+// Converts a row of f16 source values to f32.
+void jit_brgemm_matmul_copy_a_impl_t::up_convert_K_loop(bool is_K_tail) {
+    const int K_blk = is_K_tail ? conf_->K % conf_->K_blk
+                                : nstl::min(conf_->K, conf_->K_blk);
+    const int k_tail = K_blk % k_step;
+    const int num_k_iters = K_blk / k_step;
+
+    auto up_convert = [=](int k_idx, bool is_tail) {
+        const auto zmm_cvt = get_zmm_copy(k_idx % k_loop_unroll);
+        const auto addr = EVEX_compress_addr(
+                reg_src, (size_t)k_idx * k_step * src_typesize);
+        vcvtph2ps(is_tail ? zmm_cvt | kTail_load | T_z : zmm_cvt, addr);
+
+        const auto tr_addr = EVEX_compress_addr(
+                reg_tr_src, (size_t)k_idx * k_step * typesize);
+        vmovups(tr_addr, is_tail ? zmm_cvt | kTail_load : zmm_cvt);
+    };
+
+    for (int k = 0; k < num_k_iters; k++)
+        up_convert(k, false);
+
+    if (k_tail > 0) {
+        mov(regq_tmp.cvt32(), (1 << k_tail) - 1);
+        kmovw(kTail_load, regq_tmp.cvt32());
+        up_convert(num_k_iters, true);
+    }
+}
+
 void jit_brgemm_matmul_copy_a_impl_t::copy_K_loop(
         bool is_K_tail, bool is_first_K_iter, bool is_last_K_iter) {
     MAYBE_UNUSED(is_K_tail);
     MAYBE_UNUSED(is_first_K_iter);
     MAYBE_UNUSED(is_last_K_iter);
 
+    if (conf_->with_src_dynamic_quant) {
+        quantize_K_loop(is_K_tail);
+        return;
+    }
+    if (conf_->with_f16_up_conversion) {
+        up_convert_K_loop(is_K_tail);
+        return;
+    }
+
     const int K_blk = is_K_tail ? conf_->K % conf_->K_blk
                                 : nstl::min(conf_->K, conf_->K_blk);
     const int k_tail = K_blk % k_step;
@@ -281,10 +366,15 @@ void jit_brgemm_matmul_copy_a_impl_t::copy_M_loop(
     Label loop_M;
     L(loop_M);
 
+    if (conf_->with_src_dynamic_quant)
+        vbroadcastss(zmm_src_quant_scale, ptr[reg_src_quant_scales]);
+
     copy_K_loop(is_K_tail, is_first_K_iter, is_last_K_iter);
 
     add(reg_src, src_stride);
     add(reg_tr_src, tr_src_stride);
+    if (conf_->with_src_dynamic_quant)
+        add(reg_src_quant_scales, sizeof(float));
     if (do_compute_compensation) {
         // shift comp pointers
         if (!(is_first_K_iter && is_last_K_iter))
@@ -299,7 +389,7 @@ void jit_brgemm_matmul_copy_a_impl_t::copy_M_loop(
 void jit_brgemm_matmul_copy_a_impl_t::generate() {
     preamble();
     src_stride = (conf_->src_tag == format_tag::acbd ? conf_->copy_A_src_stride
-                                                     : conf_->K * typesize);
+                                                     : conf_->K * src_typesize);
     const dim_t LDA = conf_->use_buffer_a_tail_only ? (dim_t)conf_->wei_k_blk
                                                     : conf_->LDA;
     tr_src_stride = LDA * typesize;
@@ -309,6 +399,8 @@ void jit_brgemm_matmul_copy_a_impl_t::generate() {
     mov(reg_tr_src, ptr[param1 + GET_OFF(tr_src)]);
     mov(reg_K_blk, ptr[param1 + GET_OFF(current_K_blk)]);
     mov(reg_M_blk, ptr[param1 + GET_OFF(current_M_blk)]);
+    if (conf_->with_src_dynamic_quant)
+        mov(reg_src_quant_scales, ptr[param1 + GET_OFF(src_quant_scales_ptr)]);
 
     if (allow_input_shift_for_s8s8 && conf_->s8s8_compensation_required) {
         mov(imm_addr64, 128);
@@ -1382,7 +1474,7 @@ private:
     using ymm = const Xbyak::Ymm;
 
     enum { typesize = sizeof(int16_t), k_blk_step = 2, n_blk_step = 16 };
-    dim_t src_stride = 0, tr_src_stride = 0;
+    dim_t src_stride = 0, tr_src_stride = 0, src_typesize = 0;
 
     opmask_t kTail = k7;
     opmask_t kFFFF = k6;
@@ -1393,6 +1485,8 @@ private:
     reg64_t reg_K_iters = r8;
     reg64_t reg_N_blk = r9;
     reg64_t reg_K_start = r10;
+    reg64_t reg_wei_scales = r11;
+    reg64_t reg_wei_zp = r12;
     reg32_t regw_tmp = r14d;
     reg64_t imm_addr64 = r15;
 
@@ -1403,6 +1497,34 @@ private:
     void generate() override;
 };
 
+// Converts 16 s8 / u8 weights to f32 and applies the weights zero points and
+// scales: (wei - zp) * scale.
+template <typename jit_copy_t>
+void load_and_decompress_weights(jit_copy_t *h,
+        const brgemm_matmul_conf_t *conf, const Xbyak::Zmm &zmm,
+        const Xbyak::Opmask &mask, const Xbyak::Address &addr,
+        const Xbyak::Reg64 &reg_scales, const Xbyak::Reg64 &reg_zp, int n) {
+    const auto zmm_m = zmm | mask | Xbyak::util::T_z;
+    if (conf->orig_wei_dt == data_type::s8)
+        h->vpmovsxbd(zmm_m, addr);
+    else
+        h->vpmovzxbd(zmm_m, addr);
+
+    if (conf->with_wei_decomp_zero_points) {
+        const auto zp_addr = conf->wei_decomp_zp_n_str
+                ? h->ptr[reg_zp + n * sizeof(int32_t)]
+                : h->ptr_b[reg_zp];
+        h->vpsubd(zmm_m, zmm, zp_addr);
+    }
+    h->vcvtdq2ps(zmm, zmm);
+    if (conf->with_wei_decomp_scales) {
+        const auto scales_addr = conf->wei_decomp_scales_n_str
+                ? h->ptr[reg_scales + n * sizeof(float)]
+                : h->ptr_b[reg_scales];
+        h->vmulps(zmm_m, zmm, scales_addr);
+    }
+}
+
 void jit_brgemm_matmul_copy_b_bf16_t::copy_2x32_vnni(int nrows, int ncolumns) {
 
     auto kmovd = [=](Opmask k, unsigned w) {
@@ -1426,6 +1548,12 @@ void jit_brgemm_matmul_copy_b_bf16_t::copy_2x32_vnni(int nrows, int ncolumns) {
 
     auto load = [=](int blk, int k, int n, opmask_t current_mask) {
         auto src_reg = get_zmm(blk, k % k_blk_step);
+        if (conf_->with_wei_decompression) {
+            load_and_decompress_weights(this, conf_, src_reg, current_mask,
+                    ptr[reg_src + k * src_stride + n * src_typesize],
+                    reg_wei_scales, reg_wei_zp, n);
+            return;
+        }
         auto src_load = src_reg | current_mask | T_z;
         vmovdqu16(src_load,
                 EVEX_compress_addr(reg_src, k * src_stride + n * typesize));
@@ -1447,7 +1575,16 @@ void jit_brgemm_matmul_copy_b_bf16_t::copy_2x32_vnni(int nrows, int ncolumns) {
         const int blk_idx = iter % max_unroll;
         load(blk_idx, k, n, curr_msk);
         const auto src_zmm0 = get_zmm(blk_idx, 0);
-        if (nrows - k >= k_blk_step) {
+        if (conf_->with_wei_decompression) {
+            // Pack the pair of decompressed f32 rows into bf16 values with
+            // the row k in the lower half, as the plain bf16 load does.
+            auto src_zmm1 = zmm_zero;
+            if (nrows - k >= k_blk_step) {
+                load(blk_idx, k + 1, n, curr_msk);
+                src_zmm1 = get_zmm(blk_idx, 1);
+            }
+            vcvtne2ps2bf16(src_zmm0, src_zmm1, src_zmm0);
+        } else if (nrows - k >= k_blk_step) {
             load(blk_idx, k + 1, n, curr_msk);
             const auto src_zmm1 = get_zmm(blk_idx, 1);
             const auto src_ymm1 = ymm(src_zmm1.getIdx());
@@ -1464,8 +1601,9 @@ void jit_brgemm_matmul_copy_b_bf16_t::copy_2x32_vnni(int nrows, int ncolumns) {
 void jit_brgemm_matmul_copy_b_bf16_t::generate() {
     preamble();
     vpxord(zmm_zero, zmm_zero, zmm_zero);
+    src_typesize = conf_->orig_b_dt_sz;
     src_stride = (conf_->wei_tag == format_tag::acbd ? conf_->copy_B_wei_stride
-                                                     : conf_->N * typesize);
+                                                     : conf_->N * src_typesize);
     tr_src_stride = conf_->LDB * k_blk_step * typesize;
 
     alignas(64) static constexpr const int16_t bf16_vnni_permute[32]
@@ -1476,6 +1614,10 @@ void jit_brgemm_matmul_copy_b_bf16_t::generate() {
     mov(reg_tr_src, ptr[param1 + GET_OFF(tr_src)]);
     mov(reg_K_iters, ptr[param1 + GET_OFF(current_K_iters)]);
     mov(reg_N_blk, ptr[param1 + GET_OFF(current_N_blk)]);
+    if (conf_->with_wei_decomp_scales)
+        mov(reg_wei_scales, ptr[param1 + GET_OFF(wei_decomp_scales_ptr)]);
+    if (conf_->with_wei_decomp_zero_points)
+        mov(reg_wei_zp, ptr[param1 + GET_OFF(wei_decomp_zero_points_ptr)]);
 
     auto kmovw = [=](Opmask k, unsigned w) {
         mov(regw_tmp, w);
@@ -1556,8 +1698,9 @@ struct jit_brgemm_matmul_copy_b_f32_t : public jit_brgemm_matmul_copy_b_t,
     jit_brgemm_matmul_copy_b_f32_t(const brgemm_matmul_conf_t *conf)
         : jit_brgemm_matmul_copy_b_t(conf)
         , jit_generator(jit_name())
+        , src_typesize_(conf_->orig_b_dt_sz)
         , src_stride_(conf_->wei_tag == acbd ? conf_->copy_B_wei_stride
-                                             : conf_->N * typesize)
+                                             : conf_->N * src_typesize_)
         , tr_src_stride_(conf_->LDB * typesize) {}
 
     void operator()(ctx_t *ctx) override { jit_generator::operator()(ctx); }
@@ -1570,7 +1713,7 @@ private:
     using zmm = const Xbyak::Zmm;
 
     enum { typesize = sizeof(float), n_blk_step = 16, max_regs_available = 30 };
-    dim_t src_stride_, tr_src_stride_;
+    dim_t src_typesize_, src_stride_, tr_src_stride_;
 
     opmask_t kTail = k7;
     opmask_t kFFFF = k6;
@@ -1581,6 +1724,8 @@ private:
     reg64_t reg_K_iters = r8;
     reg64_t reg_N_blk = r9;
     reg64_t reg_K_start = r10;
+    reg64_t reg_wei_scales = r11;
+    reg64_t reg_wei_zp = r12;
     reg32_t regw_tmp = r14d;
     reg64_t imm_addr64 = r15;
 
@@ -1606,7 +1751,18 @@ void jit_brgemm_matmul_copy_b_f32_t::copy_16_x_n_block(
 
     auto load = [=](int blk, int k, int n, opmask_t current_mask) {
         auto src_zmm = get_zmm(blk);
+        if (conf_->with_wei_decompression) {
+            load_and_decompress_weights(this, conf_, src_zmm, current_mask,
+                    ptr[reg_src + k * src_stride_ + n * src_typesize_],
+                    reg_wei_scales, reg_wei_zp, n);
+            return;
+        }
         auto src_zmm_m = src_zmm | current_mask | T_z;
+        if (conf_->with_f16_up_conversion) {
+            vcvtph2ps(src_zmm_m,
+                    ptr[reg_src + k * src_stride_ + n * src_typesize_]);
+            return;
+        }
         vmovups(src_zmm_m,
                 EVEX_compress_addr(reg_src, k * src_stride_ + n * typesize));
     };
@@ -1669,6 +1825,10 @@ void jit_brgemm_matmul_copy_b_f32_t::generate() {
     mov(reg_tr_src, ptr[param1 + GET_OFF(tr_src)]);
     mov(reg_K_iters, ptr[param1 + GET_OFF(current_K_iters)]);
     mov(reg_N_blk, ptr[param1 + GET_OFF(current_N_blk)]);
+    if (conf_->with_wei_decomp_scales)
+        mov(reg_wei_scales, ptr[param1 + GET_OFF(wei_decomp_scales_ptr)]);
+    if (conf_->with_wei_decomp_zero_points)
+        mov(reg_wei_zp, ptr[param1 + GET_OFF(wei_decomp_zero_points_ptr)]);
     kmovw(kFFFF, 0xffff); // 1111111111111111
 
     Label done;
@@ -32,6 +32,8 @@ struct jit_brgemm_matmul_copy_b_t {
         const void *compensation_ptr;
         const void *zp_a_compensation_ptr;
         const void *zp_a_neg_value_ptr;
+        const void *wei_decomp_scales_ptr;
+        const void *wei_decomp_zero_points_ptr;
 
         dim_t current_K_start;
         dim_t current_K_iters;
@@ -56,6 +58,7 @@ struct jit_brgemm_matmul_copy_a_t {
         const void *zp_a_compensation_result_ptr;
         const void *zp_b_neg_value_ptr;
         const void *zp_ab_comp_ptr;
+        const void *src_quant_scales_ptr;
 
         dim_t current_K_start;
         dim_t current_K_blk;
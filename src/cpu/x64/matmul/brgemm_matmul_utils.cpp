@@ -38,6 +38,9 @@ using namespace dnnl::impl::utils;
 using namespace data_type;
 using namespace format_tag;
 
+// The M the blocking of the problems with runtime M is chosen for.
+constexpr dim_t runtime_M_nominal = 512;
+
 int get_default_n_block(format_tag_t matrix_b_tag) {
     // Note: consider using weights mem_descriptor 'inner_blks' to
     // return B's inner block for non-default cases.
@@ -103,13 +106,15 @@ bool post_ops_ok(brgemm_matmul_conf_t &bgmmc, const primitive_attr_t &attr,
 
 status_t check_isa_with_datatype(
         const cpu_isa_t isa, const brgemm_matmul_conf_utils_t &bm_conf_utils) {
-    const bool ok = IMPLICATION(bm_conf_utils.is_f32(), isa == avx512_core)
+    const bool ok = IMPLICATION(bm_conf_utils.is_f32(),
+                            one_of(isa, avx512_core, avx2))
             && IMPLICATION(bm_conf_utils.is_int8(),
-                    one_of(isa, avx512_core_bf16_amx_int8, avx512_core_vnni))
+                    one_of(isa, avx512_core_bf16_amx_int8, avx512_core_vnni,
+                            avx2_vnni))
             && IMPLICATION(bm_conf_utils.is_bf16(),
                     one_of(isa, avx512_core_bf16_amx_bf16, avx512_core_bf16))
             && IMPLICATION(bm_conf_utils.is_int8_with_bf16_dst(),
-                    mayiuse(avx512_core_vnni));
+                    isa != avx2_vnni && mayiuse(avx512_core_vnni));
     return ok ? status::success : status::unimplemented;
 }
 
@@ -117,7 +122,9 @@ brgemm_matmul_conf_utils_t::brgemm_matmul_conf_utils_t(
         brgemm_matmul_conf_t &bgmmc, bool A_any_layout, bool B_any_layout,
         bool C_any_layout, bool bias_any_layout)
     : bgmmc(bgmmc)
-    , f32_dt(utils::everyone_is(f32, bgmmc.src_dt, bgmmc.wei_dt, bgmmc.dst_dt))
+    , f32_dt(utils::everyone_is(f32, bgmmc.src_dt, bgmmc.wei_dt)
+              && (bgmmc.dst_dt == f32
+                      || (bgmmc.with_f16_up_conversion && bgmmc.dst_dt == f16)))
     , bf16_dt(utils::everyone_is(bf16, bgmmc.src_dt, bgmmc.wei_dt)
               && one_of(bgmmc.dst_dt, bf16, f32))
     , int8_dt(utils::one_of(bgmmc.src_dt, u8, s8) && bgmmc.wei_dt == s8
@@ -161,7 +168,7 @@ status_t brgemm_matmul_conf_utils_t::set_or_check_B_tag(
         for (int d = 0; d < dmax; d++) {
             int dim = bgmmc.ndims - 1 - d;
             bgmmc.B_strides[d]
-                    = bgmmc.b_dt_sz * B_d.blocking_desc().strides[dim];
+                    = bgmmc.orig_b_dt_sz * B_d.blocking_desc().strides[dim];
         }
     } else {
         bgmmc.wei_tag = blocked_B_layouts_allowed
@@ -243,7 +250,9 @@ status_t brgemm_matmul_conf_utils_t::set_B_flags(memory_desc_t &B_md) const {
 
 format_tag_t brgemm_matmul_conf_utils_t::pick_blocked_B_layout(
         int n_blk) const {
-    if (bgmmc.ndims > 2) return format_tag::undef;
+    if (bgmmc.ndims > 2 || bgmmc.with_wei_decompression
+            || bgmmc.with_f16_up_conversion)
+        return format_tag::undef;
     if (this->is_int8()) switch (n_blk) {
             case 64: return BA16a64b4a;
             case 48: return BA16a48b4a;
@@ -759,10 +768,42 @@ status_t init_brgemm_matmul_conf(cpu_isa_t isa, brgemm_matmul_conf_t &bgmmc,
     bgmmc.dst_dt = dst_d.data_type();
     bgmmc.wei_dt = weights_d.data_type();
 
+    // The source quantized at runtime is computed as s8, so the rest of the
+    // configuration is the same as for int8 problems with f32 / bf16 dst.
+    const int n_mask = 1 << (dst_d.ndims() - 1);
+    bgmmc.orig_src_dt = bgmmc.src_dt;
+    bgmmc.with_src_dynamic_quant = attr.src_dynamic_quantization_
+            && one_of(isa, avx512_core_vnni, avx512_core_bf16_amx_int8)
+            && one_of(bgmmc.src_dt, f32, bf16) && bgmmc.wei_dt == s8
+            && one_of(bgmmc.dst_dt, f32, bf16)
+            && one_of(attr.scales_.get(DNNL_ARG_WEIGHTS).mask_, 0, n_mask)
+            && attr.output_scales_.has_default_values()
+            && attr.zero_points_.has_default_values()
+            && attr.post_ops_.len() == 0;
+    if (bgmmc.with_src_dynamic_quant) bgmmc.src_dt = s8;
+
+    // The decompressed weights are computed in the source data type, so the
+    // rest of the configuration is the same as for f32 or bf16 weights.
+    bgmmc.orig_wei_dt = bgmmc.wei_dt;
+    bgmmc.with_wei_decompression
+            = one_of(bgmmc.src_dt, f32, bf16) && one_of(bgmmc.wei_dt, s8, u8);
+    if (bgmmc.with_wei_decompression) bgmmc.wei_dt = bgmmc.src_dt;
+
+    // The f16 source and weights are computed in f32, so the rest of the
+    // configuration is the same as for f32 problems. The user tensors keep
+    // their f16 sizes in orig_a_dt_sz / orig_b_dt_sz.
+    bgmmc.with_f16_up_conversion = everyone_is(f16, bgmmc.src_dt, bgmmc.wei_dt)
+            && one_of(bgmmc.dst_dt, f16, f32);
+    if (bgmmc.with_f16_up_conversion) {
+        if (isa != avx512_core) return status::unimplemented;
+        bgmmc.orig_src_dt = bgmmc.orig_wei_dt = f16;
+        bgmmc.src_dt = bgmmc.wei_dt = f32;
+    }
+
     bgmmc.with_bias = mmd.bias_desc.format_kind != format_kind::undef;
     bgmmc.bia_dt = bgmmc.with_bias ? mmd.bias_desc.data_type : data_type::undef;
     bgmmc.s8s8_compensation_required
-            = isa == avx512_core_vnni && bgmmc.src_dt == s8;
+            = one_of(isa, avx512_core_vnni, avx2_vnni) && bgmmc.src_dt == s8;
     bgmmc.ndims = dst_d.ndims();
 
     brgemm_matmul_conf_utils_t bm_conf_utils(bgmmc,
@@ -780,7 +821,9 @@ status_t init_brgemm_matmul_conf(cpu_isa_t isa, brgemm_matmul_conf_t &bgmmc,
     bgmmc.acc_dt = bm_conf_utils.is_int8() ? s32 : f32;
 
     bgmmc.a_dt_sz = types::data_type_size(bgmmc.src_dt);
+    bgmmc.orig_a_dt_sz = types::data_type_size(bgmmc.orig_src_dt);
     bgmmc.b_dt_sz = types::data_type_size(bgmmc.wei_dt);
+    bgmmc.orig_b_dt_sz = types::data_type_size(bgmmc.orig_wei_dt);
     bgmmc.c_dt_sz = types::data_type_size(bgmmc.dst_dt);
     bgmmc.acc_dt_sz = types::data_type_size(bgmmc.acc_dt);
     if (bgmmc.with_bias) bgmmc.bias_dt_sz = types::data_type_size(bgmmc.bia_dt);
@@ -805,7 +848,11 @@ status_t init_brgemm_matmul_conf(cpu_isa_t isa, brgemm_matmul_conf_t &bgmmc,
     if (!post_ops_ok(bgmmc, attr, dst_d)) return status::unimplemented;
 
     bgmmc.src_zp_type = get_zp_type(attr, DNNL_ARG_SRC);
-    bgmmc.wei_zp_type = get_zp_type(attr, DNNL_ARG_WEIGHTS);
+    // The weights zero points of the decompressed weights are applied by the
+    // copy B routine instead of the A compensation.
+    bgmmc.wei_zp_type = bgmmc.with_wei_decompression
+            ? brgemm_broadcast_t::none
+            : get_zp_type(attr, DNNL_ARG_WEIGHTS);
     bgmmc.dst_zp_type = get_zp_type(attr, DNNL_ARG_DST);
 
     if (!IMPLICATION(!bm_conf_utils.is_int8(),
@@ -813,16 +860,63 @@ status_t init_brgemm_matmul_conf(cpu_isa_t isa, brgemm_matmul_conf_t &bgmmc,
                         bgmmc.wei_zp_type, bgmmc.dst_zp_type)))
         return status::unimplemented;
 
+    // Only M may be defined at execution time. The source quantized at
+    // runtime and the binary post-ops use buffers depending on M.
+    bgmmc.is_runtime_M = is_runtime_value(dst_d.dims()[bgmmc.ndims - 2]);
+    if (bgmmc.is_runtime_M) {
+        const int m_idx = bgmmc.ndims - 2;
+        for (int d = 0; d < bgmmc.ndims; d++) {
+            if (d == m_idx) continue;
+            if (is_runtime_value(src_d.dims()[d])
+                    || is_runtime_value(dst_d.dims()[d]))
+                return status::unimplemented;
+        }
+        if (weights_d.has_runtime_dims_or_strides()
+                || !is_runtime_value(src_d.dims()[m_idx])
+                || bgmmc.with_src_dynamic_quant || bgmmc.with_binary)
+            return status::unimplemented;
+    } else if (src_d.has_runtime_dims_or_strides()
+            || weights_d.has_runtime_dims_or_strides()
+            || dst_d.has_runtime_dims_or_strides()) {
+        return status::unimplemented;
+    }
+
     matmul_helper_t helper(src_d, weights_d, dst_d);
 
     bgmmc.batch_ndims = bgmmc.ndims - 2;
-    bgmmc.M = helper.M();
+    bgmmc.M = bgmmc.is_runtime_M ? runtime_M_nominal : helper.M();
     bgmmc.N = helper.N();
     bgmmc.K = helper.K();
     bgmmc.batch = helper.batch();
     bgmmc.batch_without_first_dim
             = bgmmc.batch_ndims > 1 ? helper.batch() / dst_d.dims()[0] : 0;
 
+    if (bgmmc.with_wei_decompression || bgmmc.with_src_dynamic_quant) {
+        const auto &wei_scales = attr.scales_.get(DNNL_ARG_WEIGHTS);
+        int wei_zp_mask = 0;
+        attr.zero_points_.get(DNNL_ARG_WEIGHTS, nullptr, &wei_zp_mask, nullptr);
+        bgmmc.with_wei_decomp_scales = !wei_scales.has_default_values();
+        bgmmc.with_wei_decomp_zero_points
+                = !attr.zero_points_.has_default_values(DNNL_ARG_WEIGHTS);
+
+        const int k_mask = 1 << (bgmmc.ndims - 2);
+        const bool per_k = (wei_scales.mask_ | wei_zp_mask) & k_mask;
+        bgmmc.wei_decomp_k_group = per_k ? attr.weights_group_size_ : bgmmc.K;
+        // The bf16 copy routine converts pairs of rows along K at once.
+        if (bgmmc.src_dt == bf16 && bgmmc.wei_decomp_k_group % 2 != 0
+                && bgmmc.wei_decomp_k_group != bgmmc.K)
+            return status::unimplemented;
+
+        auto k_str = [&](int mask) -> dim_t {
+            if (!(mask & k_mask)) return 0;
+            return (mask & n_mask) ? bgmmc.N : 1;
+        };
+        bgmmc.wei_decomp_scales_k_str = k_str(wei_scales.mask_);
+        bgmmc.wei_decomp_scales_n_str = (wei_scales.mask_ & n_mask) ? 1 : 0;
+        bgmmc.wei_decomp_zp_k_str = k_str(wei_zp_mask);
+        bgmmc.wei_decomp_zp_n_str = (wei_zp_mask & n_mask) ? 1 : 0;
+    }
+
     bgmmc.bcast_A_desc.set_params(
             src_d.dims(), dst_d.dims(), bgmmc.batch_ndims, bgmmc.batch);
     bgmmc.bcast_B_desc.set_params(
@@ -838,6 +932,18 @@ status_t init_brgemm_matmul_conf(cpu_isa_t isa, brgemm_matmul_conf_t &bgmmc,
     CHECK(bm_conf_utils.set_or_check_B_tag(weights_md));
     CHECK(attr.set_default_formats(&dst_md));
 
+    // The strides of the user tensors must not depend on the runtime M.
+    if (bgmmc.is_runtime_M
+            && (src_d.has_runtime_strides() || dst_d.has_runtime_strides()))
+        return status::unimplemented;
+
+    if ((bgmmc.with_wei_decompression || bgmmc.with_f16_up_conversion)
+            && !bm_conf_utils.check_is_plain(bgmmc.wei_tag))
+        return status::unimplemented;
+    if ((bgmmc.with_src_dynamic_quant || bgmmc.with_f16_up_conversion)
+            && !bm_conf_utils.check_is_plain(bgmmc.src_tag))
+        return status::unimplemented;
+
     bgmmc.wei_n_blk = get_default_n_block(bgmmc.wei_tag);
 
     bgmmc.blocked_B = bm_conf_utils.get_blocked_B();
@@ -850,7 +956,8 @@ status_t init_brgemm_matmul_conf(cpu_isa_t isa, brgemm_matmul_conf_t &bgmmc,
     const bool is_copy_a_required
             = (bgmmc.is_amx && (bgmmc.K % bgmmc.required_k_granularity != 0))
             || bgmmc.wei_zp_type != brgemm_broadcast_t::none
-            || bgmmc.transposed_A || lda_is_big_2pow;
+            || bgmmc.transposed_A || lda_is_big_2pow
+            || bgmmc.with_src_dynamic_quant || bgmmc.with_f16_up_conversion;
     bgmmc.use_buffer_a = is_copy_a_required;
 
     // Supported computation with copy only part of A related to K_tail if
@@ -862,12 +969,21 @@ status_t init_brgemm_matmul_conf(cpu_isa_t isa, brgemm_matmul_conf_t &bgmmc,
     const int dmax = nstl::min(bgmmc.ndims, 3);
     for (int d = 0; d < dmax; d++) {
         int dim = bgmmc.ndims - 1 - d;
-        bgmmc.A_strides[d] = bgmmc.a_dt_sz * src_d.blocking_desc().strides[dim];
+        bgmmc.A_strides[d]
+                = bgmmc.orig_a_dt_sz * src_d.blocking_desc().strides[dim];
         bgmmc.B_strides[d]
-                = bgmmc.b_dt_sz * weights_d.blocking_desc().strides[dim];
+                = bgmmc.orig_b_dt_sz * weights_d.blocking_desc().strides[dim];
         bgmmc.C_strides[d] = bgmmc.c_dt_sz * dst_d.blocking_desc().strides[dim];
     }
 
+    // The copy routines are implemented for AVX512 only, so AVX2 kernels
+    // work with the user buffers directly.
+    if (one_of(isa, avx2, avx2_vnni)) {
+        bgmmc.use_buffer_b = bm_conf_utils.use_buffer_b(false);
+        if (bgmmc.use_buffer_a || bgmmc.use_buffer_b)
+            return status::unimplemented;
+    }
+
     // Heuristic tries to optimize the following parameters:
     // - M_blk, M_Chunk
     // - N_blk, N_Chunk
@@ -885,7 +1001,14 @@ status_t init_brgemm_matmul_conf(cpu_isa_t isa, brgemm_matmul_conf_t &bgmmc,
 
     CHECK(bm_conf_utils.set_B_flags(weights_md));
 
-    bgmmc.M_tail = bgmmc.M % bgmmc.M_blk;
+    // The parallel reduction buffers are sized by M. The s32 result of the
+    // source quantized at runtime is dequantized from the accumulation buffer
+    // once the whole K is processed, so a single thread has to own it.
+    if (bgmmc.is_runtime_M || bgmmc.with_src_dynamic_quant) bgmmc.nthr_k = 1;
+    if (bgmmc.with_src_dynamic_quant) bgmmc.use_buffer_c = true;
+
+    // The M tail of the runtime M is known at execution time only.
+    bgmmc.M_tail = bgmmc.is_runtime_M ? 0 : bgmmc.M % bgmmc.M_blk;
     bgmmc.N_tail = bgmmc.N % bgmmc.N_blk;
     bgmmc.K_tail = bgmmc.K > bgmmc.K_blk
             ? rnd_up(bgmmc.K % bgmmc.K_blk, bgmmc.required_k_granularity)
@@ -987,11 +1110,12 @@ void init_aux_values(brgemm_matmul_conf_t &bgmmc,
     bgmmc.has_zero_point_a = bgmmc.src_zp_type != brgemm_broadcast_t::none;
     bgmmc.has_zero_point_b = bgmmc.wei_zp_type != brgemm_broadcast_t::none;
     bgmmc.has_zero_point_c = bgmmc.dst_zp_type != brgemm_broadcast_t::none;
-    bgmmc.post_ops_applicable = one_of(true, bgmmc.with_sum, bgmmc.with_bias,
-            bgmmc.with_scales, bgmmc.with_eltwise, bgmmc.with_binary,
-            bgmmc.acc_dt != bgmmc.dst_dt, bgmmc.s8s8_compensation_required,
-            bgmmc.has_zero_point_a, bgmmc.has_zero_point_b,
-            bgmmc.has_zero_point_c);
+    bgmmc.post_ops_applicable = !bgmmc.with_src_dynamic_quant
+            && one_of(true, bgmmc.with_sum, bgmmc.with_bias, bgmmc.with_scales,
+                    bgmmc.with_eltwise, bgmmc.with_binary,
+                    bgmmc.acc_dt != bgmmc.dst_dt,
+                    bgmmc.s8s8_compensation_required, bgmmc.has_zero_point_a,
+                    bgmmc.has_zero_point_b, bgmmc.has_zero_point_c);
 
     bgmmc.zp_a_comp_shift_n = bgmmc.wei_n_blk;
     bgmmc.zp_a_comp_elems_per_thr
@@ -1008,6 +1132,14 @@ void init_aux_values(brgemm_matmul_conf_t &bgmmc,
     bgmmc.brgemm_batch_element_per_thr_sz = 16 * bgmmc.brgemm_batch_size;
 }
 
+void update_runtime_M_values(brgemm_matmul_conf_t &bgmmc, dim_t M) {
+    assert(bgmmc.is_runtime_M);
+    bgmmc.M = M;
+    bgmmc.M_tail = M % bgmmc.M_blk;
+    bgmmc.M_chunks = div_up(M, bgmmc.M_chunk_elems);
+    bgmmc.num_M_blocks = div_up(M, bgmmc.M_blk);
+}
+
 void init_scratchpad(memory_tracking::registrar_t &scratchpad,
         const brgemm_matmul_conf_t &bgmmc) {
     const size_t default_data_align = sizeof(char);
@@ -1046,6 +1178,10 @@ void init_scratchpad(memory_tracking::registrar_t &scratchpad,
                 bgmmc.nthr * bgmmc.zp_b_comp_elems_per_thr,
                 types::data_type_size(s32));
 
+    if (bgmmc.with_src_dynamic_quant)
+        scratchpad.book(key_brgemm_primitive_src_quant_scales,
+                bgmmc.batch * bgmmc.M, types::data_type_size(f32));
+
     if (one_of(bgmmc.isa, avx512_core_bf16_amx_int8, avx512_core_bf16_amx_bf16))
         scratchpad.book(key_conv_amx_tile_buffer,
                 static_cast<size_t>(bgmmc.nthr) * bgmmc.wsp_tile_per_thr_bytes,
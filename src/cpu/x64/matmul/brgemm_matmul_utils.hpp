@@ -119,6 +119,37 @@ struct brgemm_matmul_conf_t {
     // Auxiliary values for init_config() and execute()
     dim_t a_dt_sz, b_dt_sz, c_dt_sz, acc_dt_sz, bias_dt_sz;
 
+    // Weights decompression: the s8 / u8 user weights (orig_wei_dt) are
+    // converted to wei_dt == src_dt by the copy B routine. The scales and
+    // zero points are shared by wei_decomp_k_group consecutive rows along K.
+    bool with_wei_decompression;
+    bool with_wei_decomp_scales;
+    bool with_wei_decomp_zero_points;
+    data_type_t orig_wei_dt;
+    dim_t orig_b_dt_sz;
+    dim_t wei_decomp_k_group;
+    dim_t wei_decomp_scales_k_str, wei_decomp_scales_n_str;
+    dim_t wei_decomp_zp_k_str, wei_decomp_zp_n_str;
+
+    // Source dynamic quantization: the f32 / bf16 user source (orig_src_dt)
+    // is quantized to src_dt == s8 by the copy A routine, each row is
+    // multiplied by its own factor computed at runtime. The s32 result is
+    // dequantized using the same factors and the weights scales, which share
+    // the weights decompression strides.
+    bool with_src_dynamic_quant;
+    data_type_t orig_src_dt;
+    dim_t orig_a_dt_sz;
+
+    // f16: the user source and weights are converted to src_dt == wei_dt ==
+    // f32 by the copy routines, an f16 destination is converted by the brgemm
+    // kernel on store.
+    bool with_f16_up_conversion;
+
+    // Runtime M: the blocking is chosen for a nominal M at creation time and
+    // the values depending on the actual M are set by
+    // update_runtime_M_values() at execution time.
+    bool is_runtime_M;
+
     int M_chunks;
     int N_chunks;
     int K_chunks;
@@ -188,6 +219,9 @@ struct brgemm_matmul_conf_utils_t {
     }
 
     inline bool use_buffer_b(bool use_heuristic = true) const {
+        // The weights are decompressed or converted by the copy routine only.
+        if (bgmmc.with_wei_decompression || bgmmc.with_f16_up_conversion)
+            return true;
         if (bgmmc.is_amx) return !bgmmc.blocked_B;
 
         // Values based on measured performance difference
@@ -267,6 +301,8 @@ status_t init_brgemm_matmul_conf(cpu_isa_t isa, brgemm_matmul_conf_t &bgmmc,
 void init_scratchpad(memory_tracking::registrar_t &scratchpad,
         const brgemm_matmul_conf_t &bgmmc);
 
+void update_runtime_M_values(brgemm_matmul_conf_t &bgmmc, dim_t M);
+
 } // namespace matmul
 } // namespace x64
 } // namespace cpu
@@ -0,0 +1,184 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/type_helpers.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/cpu_primitive.hpp"
+
+#include "cpu/x64/matmul/brgemm_small_batched_matmul.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+namespace matmul {
+
+using namespace dnnl::impl::utils;
+using namespace data_type;
+using namespace format_tag;
+
+namespace {
+// The largest matrices computed by a single brgemm call.
+constexpr dim_t max_M = 64;
+constexpr dim_t max_N = 64;
+constexpr dim_t max_K = 256;
+} // namespace
+
+template <cpu_isa_t isa>
+status_t brgemm_small_batched_matmul_t<isa>::pd_t::init(engine_t *engine) {
+    using skip_mask_t = primitive_attr_t::skip_mask_t;
+
+    auto check_attr_oscale = [&]() -> bool {
+        const auto &oscale = attr()->output_scales_;
+        return IMPLICATION(
+                oscale.mask_ != 0, oscale.mask_ == (1 << (ndims() - 1)));
+    };
+
+    // The binary post-ops would require the offsets of the whole batch.
+    auto check_attr_post_ops = [&]() -> bool {
+        const auto &p = attr()->post_ops_;
+        for (int i = 0; i < p.len(); i++)
+            if (!p.contain(primitive_kind::eltwise, i)
+                    && !p.contain(primitive_kind::sum, i))
+                return false;
+        return true;
+    };
+
+    bool ok = mayiuse(isa) && batched() && ndims() <= 5
+            && everyone_is(f32, src_md()->data_type, weights_md()->data_type,
+                    dst_md()->data_type)
+            && IMPLICATION(with_bias(),
+                    weights_md(1)->data_type == f32 && is_bias_1xN())
+            && !has_runtime_dims_or_strides()
+            && attr()->has_default_values(
+                    skip_mask_t::oscale | skip_mask_t::post_ops, f32)
+            && attr()->post_ops_.check_sum_consistent_dt(f32)
+            && check_attr_oscale() && check_attr_post_ops()
+            && set_default_formats()
+            && attr_.set_default_formats(dst_md(0)) == status::success;
+    if (!ok) return status::unimplemented;
+
+    // A batch item is a dense row-major matrix for every tensor.
+    const auto plain_tag = pick(ndims() - 3, abc, abcd, abcde);
+    ok = memory_desc_wrapper(src_md()).matches_tag(plain_tag)
+            && memory_desc_wrapper(weights_md()).matches_tag(plain_tag)
+            && memory_desc_wrapper(dst_md()).matches_tag(plain_tag);
+    if (!ok) return status::unimplemented;
+
+    // The source is not broadcast, the weights may be broadcast along any of
+    // the batch dimensions.
+    const memory_desc_wrapper wei_d(weights_md());
+    for (int d = 0; d < ndims() - 2; d++) {
+        const dim_t wei_dim = weights_md()->dims[d];
+        if (src_md()->dims[d] != dst_md()->dims[d]
+                || !one_of(wei_dim, 1, dst_md()->dims[d]))
+            return status::unimplemented;
+        wei_batch_strides_[d] = wei_dim == 1 && dst_md()->dims[d] != 1
+                ? 0
+                : wei_d.blocking_desc().strides[d];
+    }
+
+    // The matrices are small enough for a single brgemm call, and there is
+    // enough batch items for all the threads.
+    const dim_t M = this->M(), N = this->N(), K = this->K();
+    if (M > max_M || N > max_N || K > max_K || batch() < dnnl_get_max_threads()
+            || has_zero_dim_memory())
+        return status::unimplemented;
+
+    src_batch_stride_ = M * K;
+    dst_batch_stride_ = M * N;
+
+    CHECK(brgemm_desc_init(&brg_desc_, isa, brgemm_addr, f32, f32, false,
+            false, brgemm_row_major, 1.f, 0.f, K, N, N, M, N, K));
+    CHECK(brgemm_desc_set_postops(&brg_desc_, attr(), &dst_md_, N,
+            with_bias() ? f32 : data_type::undef));
+
+    brgemm_attr_t brgattr;
+    brgattr.max_bs = 1;
+    CHECK(brgemm_desc_set_attr(&brg_desc_, brgattr));
+
+    post_ops_applicable_ = with_bias() || attr()->post_ops_.len() > 0
+            || !attr()->output_scales_.has_default_values();
+
+    return status::success;
+}
+
+template <cpu_isa_t isa>
+status_t brgemm_small_batched_matmul_t<isa>::init(engine_t *engine) {
+    brgemm_kernel_t *ker = nullptr;
+    CHECK(brgemm_kernel_create(&ker, pd()->get_brg_desc()));
+    CHECK(safe_ptr_assign(brg_kernel_, ker));
+    return status::success;
+}
+
+template <cpu_isa_t isa>
+status_t brgemm_small_batched_matmul_t<isa>::execute(
+        const exec_ctx_t &ctx) const {
+    const auto src = CTX_IN_MEM(const float *, DNNL_ARG_SRC);
+    const auto wei = CTX_IN_MEM(const float *, DNNL_ARG_WEIGHTS);
+    const auto bias = CTX_IN_MEM(const char *, DNNL_ARG_BIAS);
+    auto dst = CTX_OUT_MEM(float *, DNNL_ARG_DST);
+    const float *oscales = pd()->attr()->output_scales_.scales_;
+
+    const dim_t batch = pd()->batch();
+    const int batch_ndims = pd()->ndims() - 2;
+    const dim_t *batch_dims = pd()->dst_md()->dims;
+    const dim_t *wei_strs = pd()->wei_batch_strides_;
+    const dim_t src_str = pd()->src_batch_stride_;
+    const dim_t dst_str = pd()->dst_batch_stride_;
+    const bool post_ops_applicable = pd()->post_ops_applicable();
+    const brgemm_kernel_t *brg_kernel = brg_kernel_.get();
+
+    parallel(0, [&](const int ithr, const int nthr) {
+        dim_t start {0}, end {0};
+        balance211(batch, nthr, ithr, start, end);
+
+        brgemm_batch_element_t addr_batch;
+        for (dim_t b = start; b < end; b++) {
+            addr_batch.ptr.A = src + b * src_str;
+            dim_t wei_off = 0, rem = b;
+            for (int d = batch_ndims - 1; d >= 0; d--) {
+                wei_off += (rem % batch_dims[d]) * wei_strs[d];
+                rem /= batch_dims[d];
+            }
+            addr_batch.ptr.B = wei + wei_off;
+            float *ptr_D = dst + b * dst_str;
+            if (post_ops_applicable) {
+                const brgemm_post_ops_data_t post_ops_data {
+                        static_cast<const void *>(bias), oscales, nullptr, 0};
+                brgemm_kernel_execute_postops(brg_kernel, 1, &addr_batch,
+                        (void *)ptr_D, (void *)ptr_D, post_ops_data, nullptr);
+            } else {
+                brgemm_kernel_execute(
+                        brg_kernel, 1, &addr_batch, (void *)ptr_D, nullptr);
+            }
+        }
+    });
+
+    return status::success;
+}
+
+template struct brgemm_small_batched_matmul_t<avx512_core>;
+template struct brgemm_small_batched_matmul_t<avx2>;
+
+} // namespace matmul
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
@@ -0,0 +1,79 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_X64_MATMUL_BRGEMM_SMALL_BATCHED_MATMUL_HPP
+#define CPU_X64_MATMUL_BRGEMM_SMALL_BATCHED_MATMUL_HPP
+
+#include "common/c_types_map.hpp"
+#include "common/primitive.hpp"
+#include "common/type_helpers.hpp"
+
+#include "cpu/matmul/cpu_matmul_pd.hpp"
+
+#include "cpu/x64/brgemm/brgemm.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+namespace matmul {
+
+// Batched matmul of small matrices, e.g. the attention scores: a single
+// brgemm kernel generated for the whole matrix shape computes one batch item
+// straight from the user buffers, and every thread processes a contiguous
+// range of the batch. There are no copy routines and no blocking.
+template <cpu_isa_t isa>
+struct brgemm_small_batched_matmul_t : public primitive_t {
+    struct pd_t : public ::dnnl::impl::cpu::matmul::cpu_matmul_pd_t {
+        using ::dnnl::impl::cpu::matmul::cpu_matmul_pd_t::cpu_matmul_pd_t;
+
+        DECLARE_COMMON_PD_T(JIT_IMPL_NAME_HELPER("brg_small_batch:", isa, ""),
+                brgemm_small_batched_matmul_t);
+
+        status_t init(engine_t *engine);
+
+        const brgemm_t &get_brg_desc() const { return brg_desc_; }
+        bool post_ops_applicable() const { return post_ops_applicable_; }
+
+        // Offsets between the consecutive batch items of the source and the
+        // destination, and the weights strides of the batch dimensions (0 for
+        // the broadcast ones), in elements
+        dim_t src_batch_stride_, dst_batch_stride_;
+        dims_t wei_batch_strides_;
+
+    private:
+        brgemm_t brg_desc_;
+        bool post_ops_applicable_;
+    };
+
+    brgemm_small_batched_matmul_t(const pd_t *apd) : primitive_t(apd) {}
+
+    status_t init(engine_t *engine) override;
+    status_t execute(const exec_ctx_t &ctx) const override;
+
+private:
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+
+    std::unique_ptr<brgemm_kernel_t> brg_kernel_;
+};
+
+} // namespace matmul
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
@@ -476,15 +476,16 @@ template <typename src_layer_t, typename src_iter_t, typename scratch_t,
         typename gemm_acc_t>
 void brgemm_diff_weights_layer_iter_t<src_layer_t, src_iter_t, scratch_t,
         gemm_acc_t>::reorder_scratch_gates(const scratch_t *src, scratch_t *dst,
-        const bool do_n_tail) const {
-    auto ctx = matmul::jit_brgemm_matmul_copy_b_t::ctx_t();
-    ctx.src = (void *)src;
-    ctx.tr_src = (void *)dst;
-    ctx.current_K_start = 0;
-    ctx.current_K_iters = rnn_.mb;
-    ctx.current_N_blk = do_n_tail ? rnn_.diff_wei_brgemm.n_tail
-                                  : rnn_.diff_wei_brgemm.n_block;
-    (*rnn_brgemm_.diff_wei_.srcatch_gates_reorder_kernel_)(&ctx);
+        gemm_acc_t *diff_bias, const bool do_n_tail) const {
+    // diff_bias is reduced in the same pass if requested, so the scratch gates
+    // are read once per n block
+    jit_gates_reduction_t::call_params_t params;
+    params.src = reinterpret_cast<const void *>(src);
+    params.tr_src = reinterpret_cast<void *>(dst);
+    params.dst = reinterpret_cast<void *>(diff_bias);
+    const auto *kernel = do_n_tail ? kernel_gates_reduction_tail_
+                                   : kernel_gates_reduction_;
+    (*kernel)(&params);
 }
 
 template <typename src_layer_t, typename src_iter_t, typename scratch_t,
@@ -558,26 +559,17 @@ void brgemm_diff_weights_layer_iter_t<src_layer_t, src_iter_t, scratch_t,
         const brgemm_kernel_t *kernel_iter_k_tail = kernel_iter_k_tail_;
         const brgemm_kernel_t *kernel_layer = kernel_layer_full_blocks_;
         const brgemm_kernel_t *kernel_layer_k_tail = kernel_layer_k_tail_;
-        const auto *kernel_reduction = kernel_gates_reduction_;
 
         if (do_n_tail) {
             kernel_iter = kernel_iter_n_tail_;
             kernel_iter_k_tail = kernel_iter_nk_tail_;
             kernel_layer = kernel_layer_n_tail_;
             kernel_layer_k_tail = kernel_layer_nk_tail_;
-            kernel_reduction = kernel_gates_reduction_tail_;
         }
 
-        if (should_reorder_gates) {
-            reorder_scratch_gates(B_n, B_blocked, do_n_tail);
-
-            if (m_block_id == 0) {
-                jit_gates_reduction_t::call_params_t params;
-                params.src = reinterpret_cast<const void *>(B_blocked);
-                params.dst = reinterpret_cast<void *>(diff_bias_ + n);
-                (*kernel_reduction)(&params);
-            }
-        }
+        if (should_reorder_gates)
+            reorder_scratch_gates(B_n, B_blocked,
+                    m_block_id == 0 ? diff_bias_ + n : nullptr, do_n_tail);
 
         for (int k_block_id = 0; k_block_id < k_blocks_; k_block_id++) {
             addr_batch[k_block_id].ptr.A
@@ -714,7 +706,6 @@ void brgemm_diff_weights_layer_iter_t<src_layer_t, src_iter_t, scratch_t,
         const brgemm_kernel_t *kernel_iter_k_tail = kernel_iter_k_tail_;
         const brgemm_kernel_t *kernel_layer = kernel_layer_full_blocks_;
         const brgemm_kernel_t *kernel_layer_k_tail = kernel_layer_k_tail_;
-        const auto *kernel_reduction = kernel_gates_reduction_;
 
         const char *kernel_iter_config
                 = rnn_brgemm_.diff_wei_.pallete_buff_iter_;
@@ -732,7 +723,6 @@ void brgemm_diff_weights_layer_iter_t<src_layer_t, src_iter_t, scratch_t,
             kernel_iter_k_tail = kernel_iter_nk_tail_;
             kernel_layer = kernel_layer_n_tail_;
             kernel_layer_k_tail = kernel_layer_nk_tail_;
-            kernel_reduction = kernel_gates_reduction_tail_;
 
             kernel_iter_config
                     = rnn_brgemm_.diff_wei_.pallete_buff_iter_n_tail_;
@@ -746,16 +736,9 @@ void brgemm_diff_weights_layer_iter_t<src_layer_t, src_iter_t, scratch_t,
                     : rnn_brgemm_.diff_wei_.pallete_buff_layer_nk_tail_;
         }
 
-        if (should_reorder_gates) {
-            reorder_scratch_gates(B_n, B_blocked, do_n_tail);
-
-            if (m_block_id == 0) {
-                jit_gates_reduction_t::call_params_t params;
-                params.src = reinterpret_cast<const void *>(B_blocked);
-                params.dst = reinterpret_cast<void *>(diff_bias_ + n);
-                (*kernel_reduction)(&params);
-            }
-        }
+        if (should_reorder_gates)
+            reorder_scratch_gates(B_n, B_blocked,
+                    m_block_id == 0 ? diff_bias_ + n : nullptr, do_n_tail);
 
         for (int k_block_id = 0; k_block_id < k_blocks_; k_block_id++) {
             addr_batch[k_block_id].ptr.A
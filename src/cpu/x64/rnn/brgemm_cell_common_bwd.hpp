@@ -200,8 +200,8 @@ private:
 
     void kernel_amx(const int ithr, const int nthr) const;
     void kernel(const int ithr, const int nthr) const;
-    void reorder_scratch_gates(
-            const scratch_t *src, scratch_t *dst, const bool do_n_tail) const;
+    void reorder_scratch_gates(const scratch_t *src, scratch_t *dst,
+            gemm_acc_t *diff_bias, const bool do_n_tail) const;
 };
 
 template <typename scratch_t>
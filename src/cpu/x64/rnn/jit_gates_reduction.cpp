@@ -16,7 +16,6 @@
 
 #include "cpu/x64/rnn/jit_gates_reduction.hpp"
 
-#include <cmath>
 #include "cpu/rnn/rnn_utils.hpp"
 
 namespace dnnl {
@@ -33,15 +32,36 @@ jit_gates_reduction_t::jit_gates_reduction_t(
                           : rnn_.diff_wei_brgemm.n_block)
     , n_simd_w_blks_(n_block_ / simd_w_)
     , n_tail_(n_block_ % simd_w_)
-    , bf16_ones_(rnn_.is_bf16() ? reserve_vmm() : 0)
+    , src_stride_(rnn_.scratch_gates_ld
+              * (rnn_.is_bf16() ? sizeof(bfloat16_t) : sizeof(float)))
+    , tr_src_stride_(rnn_.diff_wei_brgemm.n_block
+              * (rnn_.is_bf16() ? 2 * sizeof(bfloat16_t) : sizeof(float)))
+    , bf16_ones_(reserve_vmm())
+    , bf16_idx_lo_(reserve_vmm())
+    , bf16_idx_hi_(reserve_vmm())
+    , row0_(reserve_vmm())
+    , row1_(reserve_vmm())
+    , tmp_(reserve_vmm())
     , acc_regs_(reserve_acc_regs()) {}
 
 void jit_gates_reduction_t::generate() {
     preamble();
     load_addresses();
     init();
-    compute_loop();
+
+    Xbyak::Label no_reduction, end;
+
+    test(reg_dst_, reg_dst_);
+    jz(no_reduction, T_NEAR);
+    load_acc();
+    compute_loop(true);
     store_data();
+    jmp(end, T_NEAR);
+
+    L(no_reduction);
+    compute_loop(false);
+
+    L(end);
     postamble();
 }
 
@@ -65,26 +85,41 @@ std::vector<Xbyak::Zmm> jit_gates_reduction_t::reserve_acc_regs() {
 
 void jit_gates_reduction_t::load_addresses() {
     mov(reg_src_, ptr[abi_param1 + PARAM_OFF(src)]);
+    mov(reg_tr_src_, ptr[abi_param1 + PARAM_OFF(tr_src)]);
     mov(reg_dst_, ptr[abi_param1 + PARAM_OFF(dst)]);
 }
 
 void jit_gates_reduction_t::init() {
-    static constexpr auto off_step = simd_w_ * sizeof(float);
-
-    for (int i = 0; i < n_simd_w_blks_; ++i)
-        uni_vmovups(acc_regs_[i], ptr[reg_dst_ + (i * off_step)]);
+    const Xbyak::Reg32 regw_tmp = reg_tmp_.cvt32();
 
     if (n_tail_) {
         const int mask_f32 = (1 << n_tail_) - 1;
-        const Xbyak::Reg32 regw_tmp = reg_tmp_.cvt32();
         mov(regw_tmp, mask_f32);
         kmovw(tail_mask_, regw_tmp);
-
-        uni_vmovups(acc_regs_.back() | tail_mask_ | T_z,
-                ptr[reg_dst_ + (n_simd_w_blks_ * off_step)]);
     }
 
     if (rnn_.is_bf16()) {
+        // Interleave the columns of two rows of the scratch gates into the
+        // pairs of the OI32o2i layout, the lower and the upper 16 columns.
+        alignas(64) static constexpr const uint16_t idx_lo[bf16_simd_w_]
+                = {0, 32, 1, 33, 2, 34, 3, 35, 4, 36, 5, 37, 6, 38, 7, 39, 8,
+                        40, 9, 41, 10, 42, 11, 43, 12, 44, 13, 45, 14, 46, 15,
+                        47};
+        alignas(64) static constexpr const uint16_t idx_hi[bf16_simd_w_]
+                = {16, 48, 17, 49, 18, 50, 19, 51, 20, 52, 21, 53, 22, 54, 23,
+                        55, 24, 56, 25, 57, 26, 58, 27, 59, 28, 60, 29, 61, 30,
+                        62, 31, 63};
+        mov(reg_tmp_, reinterpret_cast<size_t>(idx_lo));
+        vmovups(bf16_idx_lo_, ptr[reg_tmp_]);
+        mov(reg_tmp_, reinterpret_cast<size_t>(idx_hi));
+        vmovups(bf16_idx_hi_, ptr[reg_tmp_]);
+
+        const dim_t bf16_tail = n_block_ % bf16_simd_w_;
+        if (bf16_tail) {
+            mov(regw_tmp, (1u << bf16_tail) - 1);
+            kmovd(bf16_tail_mask_, regw_tmp);
+        }
+
         xor_(reg_tmp_, reg_tmp_);
         mov(reg_tmp_.cvt16(), bfloat16_t(1.0f).raw_bits_);
         const Xbyak::Xmm xmm_tmp(bf16_ones_.getIdx());
@@ -93,70 +128,87 @@ void jit_gates_reduction_t::init() {
     }
 }
 
-void jit_gates_reduction_t::compute_step(
-        const Xbyak::Zmm &acc, const Xbyak::Address &addr, bool tail) {
+void jit_gates_reduction_t::load_acc() {
+    static constexpr auto off_step = simd_w_ * sizeof(float);
 
-    const auto dst = tail ? (acc | tail_mask_) : acc;
+    for (int i = 0; i < n_simd_w_blks_; ++i)
+        uni_vmovups(acc_regs_[i], ptr[reg_dst_ + (i * off_step)]);
 
-    if (rnn_.is_bf16())
-        vdpbf16ps(dst, bf16_ones_, addr);
-    else
-        uni_vaddps(dst, acc, addr);
+    if (n_tail_)
+        uni_vmovups(acc_regs_.back() | tail_mask_ | T_z,
+                ptr[reg_dst_ + (n_simd_w_blks_ * off_step)]);
 }
 
-void jit_gates_reduction_t::compute(dim_t unrolling) {
-
-    const int n_block_off = rnn_.diff_wei_brgemm.n_block * sizeof(float);
+void jit_gates_reduction_t::compute_f32(bool with_reduction) {
+    static constexpr auto off_step = simd_w_ * sizeof(float);
 
-    for (dim_t k = 0; k < unrolling; ++k) {
-        const int k_offset = -1 * (k + 1) * n_block_off;
-        const int first_reversed_block = acc_regs_.size() - 1;
+    for (size_t i = 0; i < acc_regs_.size(); ++i) {
+        const bool tail = n_tail_ && i == acc_regs_.size() - 1;
+        const auto off = i * off_step;
+        uni_vmovups(tail ? row0_ | tail_mask_ | T_z : row0_,
+                ptr[reg_src_ + off]);
+        uni_vmovups(ptr[reg_tr_src_ + off], row0_);
+        if (with_reduction) uni_vaddps(acc_regs_[i], acc_regs_[i], row0_);
+    }
+}
 
-        for (int n_block = first_reversed_block; n_block >= 0; --n_block) {
-            const bool tail = static_cast<bool>(n_tail_)
-                    && n_block == first_reversed_block;
-            const auto &acc_zmm = acc_regs_[n_block];
-            const int nk_offset = k_offset + n_block * simd_w_ * sizeof(float);
-            compute_step(acc_zmm, ptr[reg_src_ + reg_loop_ + nk_offset], tail);
+void jit_gates_reduction_t::compute_bf16(
+        bool second_row, bool with_reduction) {
+    static constexpr auto off_step = bf16_simd_w_ * sizeof(bfloat16_t);
+    const dim_t n_blks = utils::div_up(n_block_, bf16_simd_w_);
+
+    if (!second_row) vpxord(row1_, row1_, row1_);
+
+    for (dim_t i = 0; i < n_blks; ++i) {
+        const bool tail = (i + 1) * bf16_simd_w_ > n_block_;
+        const auto off = i * off_step;
+        const auto row0 = tail ? row0_ | bf16_tail_mask_ | T_z : row0_;
+        const auto row1 = tail ? row1_ | bf16_tail_mask_ | T_z : row1_;
+
+        vmovdqu16(row0, ptr[reg_src_ + off]);
+        if (second_row) vmovdqu16(row1, ptr[reg_src_ + src_stride_ + off]);
+
+        vmovups(tmp_, row0_);
+        vpermt2w(tmp_, bf16_idx_lo_, row1_);
+        vpermt2w(row0_, bf16_idx_hi_, row1_);
+        vmovups(ptr[reg_tr_src_ + 2 * off], tmp_);
+        vmovups(ptr[reg_tr_src_ + 2 * off + off_step], row0_);
+
+        if (!with_reduction) continue;
+        const auto &acc_lo = acc_regs_[2 * i];
+        vdpbf16ps(acc_lo, bf16_ones_, tmp_);
+        if (2 * i + 1 < (dim_t)acc_regs_.size()) {
+            const auto &acc_hi = acc_regs_[2 * i + 1];
+            vdpbf16ps(acc_hi, bf16_ones_, row0_);
         }
     }
 }
 
-void jit_gates_reduction_t::compute_loop() {
-    const dim_t k_block = 32;
+void jit_gates_reduction_t::compute_loop(bool with_reduction) {
+    // The bf16 rows are blocked by pairs, the odd one is paired with zeros.
     const dim_t k_pack = rnn_.is_bf16() ? 2 : 1;
-    const dim_t k = rnn_.diff_wei_brgemm.Kpadded;
-    const auto res = std::div(k, k_block);
-    const int n_block_off = rnn_.diff_wei_brgemm.n_block
-            * (rnn_.is_bf16() ? sizeof(bfloat16_t) : sizeof(float));
-    const auto &num_k_blks = res.quot;
-    const auto &k_tail = res.rem;
-
-    Xbyak::Label unroll_loop, unroll_loop_tail, end;
-
-    mov(reg_loop_, k * n_block_off);
-
-    const dim_t tail_bytes = k_tail * n_block_off;
-    const dim_t block_bytes = k_block * n_block_off;
-
-    L(unroll_loop);
-    {
-        if (num_k_blks) {
-            cmp(reg_loop_, tail_bytes);
-            jle(unroll_loop_tail, T_NEAR);
-            compute(k_block / k_pack);
-
-            sub(reg_loop_, block_bytes);
-            jmp(unroll_loop);
+    const dim_t k_blks = rnn_.mb / k_pack;
+    const dim_t k_tail = rnn_.mb % k_pack;
+
+    Xbyak::Label loop;
+
+    if (k_blks) {
+        mov(reg_loop_, k_blks);
+        L(loop);
+        {
+            if (rnn_.is_bf16())
+                compute_bf16(true, with_reduction);
+            else
+                compute_f32(with_reduction);
+
+            add(reg_src_, k_pack * src_stride_);
+            add(reg_tr_src_, tr_src_stride_);
+            dec(reg_loop_);
+            jnz(loop, T_NEAR);
         }
     }
 
-    L(unroll_loop_tail);
-    {
-        if (tail_bytes) { compute(res.rem / k_pack); }
-    }
-
-    L(end);
+    if (k_tail) compute_bf16(false, with_reduction);
 }
 
 void jit_gates_reduction_t::store_data() {
@@ -31,11 +31,16 @@ namespace x64 {
 
 /*
  * Used in gates reduction phase during backward rnn/lstm calculations.
- * Fused into diff weights calculations. Performing diff_bias calculations.
+ * Fused into diff weights calculations. Reorders the scratch gates into the
+ * blocked layout expected by the diff weights brgemm kernels and performs the
+ * diff_bias calculations in the same pass, so the scratch gates are read
+ * once.
  *
- * diff_bias = scratch_blocked reduction over mb
+ * scratch_blocked = scratch
+ * diff_bias = scratch reduction over mb (skipped if dst is nullptr)
  *
  * Data formats
+ * scratch = (mb, scratch_gates_ld)
  * scratch_blocked Oi32o(f32)/OI32o2i(bf16) (n_gates * rnn.dhc, mb)
  * diff_bias = o(n_gates * rnn.dhc)
  */
@@ -45,6 +50,7 @@ public:
 
     struct call_params_t {
         const void *src = nullptr;
+        void *tr_src = nullptr;
         void *dst = nullptr;
     };
 
@@ -57,17 +63,18 @@ private:
     void generate() override;
     void load_addresses();
     void init();
+    void load_acc();
     void store_data();
-    void compute_loop();
-    void compute(dim_t unrolling);
-    void compute_step(
-            const Xbyak::Zmm &acc, const Xbyak::Address &addr, bool tail);
+    void compute_loop(bool with_reduction);
+    void compute_f32(bool with_reduction);
+    void compute_bf16(bool second_row, bool with_reduction);
     size_t reserve_vmm();
 
     DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_gates_reduction_t)
     DNNL_DISALLOW_COPY_AND_ASSIGN(jit_gates_reduction_t);
 
     static constexpr dim_t simd_w_ = 16;
+    static constexpr dim_t bf16_simd_w_ = 32;
 
     size_t number_reserved_vmms_ = 0;
     const rnn_utils::rnn_conf_t &rnn_;
@@ -75,13 +82,22 @@ private:
     const dim_t n_block_;
     const dim_t n_simd_w_blks_;
     const dim_t n_tail_;
+    const dim_t src_stride_;
+    const dim_t tr_src_stride_;
 
     const Xbyak::Reg64 &reg_src_ = r8;
     const Xbyak::Reg64 &reg_dst_ = r9;
     const Xbyak::Reg64 &reg_tmp_ = r10;
     const Xbyak::Reg64 &reg_loop_ = r11;
+    const Xbyak::Reg64 &reg_tr_src_ = r12;
     const Xbyak::Opmask &tail_mask_ = k3;
+    const Xbyak::Opmask &bf16_tail_mask_ = k4;
     const Xbyak::Zmm bf16_ones_;
+    const Xbyak::Zmm bf16_idx_lo_;
+    const Xbyak::Zmm bf16_idx_hi_;
+    const Xbyak::Zmm row0_;
+    const Xbyak::Zmm row1_;
+    const Xbyak::Zmm tmp_;
     std::vector<Xbyak::Zmm> acc_regs_;
 };
 
@@ -91,9 +91,13 @@ jit_io_helper_t<Vmm>::jit_io_helper_t(jit_generator *host, const cpu_isa_t &isa,
                 bf16_conf->bf16_emu_reserv_4_);
     }
 
-    assert(utils::one_of(data_type_, data_type::bf16, data_type::f32,
-                   data_type::s8, data_type::u8, data_type::s32)
-            && "Supported data types bf16, f32, s8, u8, s32");
+    assert(utils::one_of(data_type_, data_type::bf16, data_type::f16,
+                   data_type::f32, data_type::s8, data_type::u8,
+                   data_type::s32)
+            && "Supported data types bf16, f16, f32, s8, u8, s32");
+    assert(IMPLICATION(data_type_ == data_type::f16,
+                   is_superset(isa_, avx512_core))
+            && "f16 is supported only on avx512_core and newer");
 
     /*
      * vpmovsxbd, vpmovzxbd for AVX are defined only for XMM. Since AVX2
@@ -466,6 +470,7 @@ void jit_io_helper_t<Vmm>::load(const Xbyak::Address &src_addr,
             case data_type::f32: load_f32(src_addr, dst_vmm, tail); break;
             case data_type::s32: load_s32(src_addr, dst_vmm, tail); break;
             case data_type::bf16: load_bf16(src_addr, dst_vmm); break;
+            case data_type::f16: load_f16(src_addr, dst_vmm); break;
             case data_type::s8:
             case data_type::u8: load_i8(src_addr, dst_vmm); break;
             default: assert(!"Unsupported data type.");
@@ -523,6 +528,12 @@ void jit_io_helper_t<Vmm>::load_bf16(
     convert_to_f32(dst_vmm, dst_vmm, data_type::bf16);
 }
 
+template <typename Vmm>
+void jit_io_helper_t<Vmm>::load_f16(
+        const Xbyak::Address &src_addr, const Vmm &dst_vmm) {
+    host_->vcvtph2ps(dst_vmm, src_addr);
+}
+
 template <typename Vmm>
 void jit_io_helper_t<Vmm>::load_i8(
         const Xbyak::Address &src_addr, const Vmm &dst_vmm) {
@@ -567,6 +578,7 @@ void jit_io_helper_t<Vmm>::store(const Vmm &src_raw_vmm,
             case data_type::f32:
             case data_type::s32: store_f32(src_vmm, dst_addr, tail); break;
             case data_type::bf16: store_bf16(src_vmm, dst_addr); break;
+            case data_type::f16: store_f16(src_vmm, dst_addr); break;
             case data_type::s8:
             case data_type::u8: store_i8(src_vmm, dst_raw_addr); break;
             default: assert(!"Unsupported data type.");
@@ -641,6 +653,22 @@ void jit_io_helper_t<Vmm>::store_bf16(
         host_->vmovdqu16(dst_addr, src);
 }
 
+template <typename Vmm>
+void jit_io_helper_t<Vmm>::store_f16(
+        const Vmm &src_vmm, const Xbyak::Address &dst_addr) {
+    static constexpr bool is_zmm = std::is_same<Vmm, Xbyak::Zmm>::value;
+
+    const Vmm src_raw_vmm(src_vmm.getIdx());
+    if (io_conf_.nt_stores_enabled_) {
+        const Xbyak::Ymm src_ymm(src_vmm.getIdx());
+        const Xbyak::Xmm src_xmm(src_vmm.getIdx());
+        const Xbyak::Xmm &src = is_zmm ? src_ymm : src_xmm;
+        host_->vcvtps2ph(src, src_raw_vmm, jit_generator::_op_mxcsr);
+        host_->uni_vmovntps(dst_addr, src);
+    } else
+        host_->vcvtps2ph(dst_addr, src_raw_vmm, jit_generator::_op_mxcsr);
+}
+
 template <typename Vmm>
 void jit_io_helper_t<Vmm>::store_i8(
         const Vmm &src_vmm, const Xbyak::Address &dst_addr) {
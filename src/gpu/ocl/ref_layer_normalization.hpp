@@ -46,7 +46,7 @@ struct ref_layer_normalization_fwd_t : public gpu_primitive_t {
             auto src_data_t = src_md()->data_type;
             auto dst_data_t = dst_md()->data_type;
 
-            bool ok = is_fwd()
+            bool ok = is_fwd() && !use_rms_norm()
                     && (utils::everyone_is(f16, src_data_t, dst_data_t)
                             || utils::everyone_is(bf16, src_data_t, dst_data_t)
                             || utils::everyone_is(f32, src_data_t, dst_data_t))
@@ -102,7 +102,7 @@ struct ref_layer_normalization_bwd_t : public gpu_primitive_t {
             auto src_data_t = src_md()->data_type;
             auto diff_dst_data_t = diff_dst_md()->data_type;
 
-            bool ok = is_bwd()
+            bool ok = is_bwd() && !use_rms_norm()
                     && (utils::everyone_is(f32, src_data_t, diff_dst_data_t)
                             || utils::everyone_is(
                                     bf16, src_data_t, diff_dst_data_t))
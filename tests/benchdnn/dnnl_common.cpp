@@ -44,6 +44,7 @@
 
 #include "dnnl_common.hpp"
 #include "dnnl_memory.hpp"
+#include "utils/cold_cache.hpp"
 
 int check_pd_cache(dnnl_primitive_desc_t pd) {
 #ifndef DNNL_DISABLE_PRIMITIVE_CACHE
@@ -324,9 +325,14 @@ inline bool should_stop(const timer::timer_t &t) {
 }
 
 inline int measure_perf_individual(timer::timer_t &t, dnnl_stream_t stream,
-        perf_function_t &perf_func, std::vector<dnnl_exec_arg_t> &dnnl_args) {
+        perf_function_t &perf_func, std::vector<dnnl_exec_arg_t> &dnnl_args,
+        cold_cache_t *cold_cache = nullptr) {
     t.reset();
     while (true) {
+        if (cold_cache) {
+            cold_cache->update_dnnl_args(dnnl_args);
+            t.start(); // switching the arguments is not measured
+        }
         DNN_SAFE(perf_func(stream, dnnl_args), WARN);
         t.stamp();
         if (should_stop(t)) break;
@@ -335,7 +341,8 @@ inline int measure_perf_individual(timer::timer_t &t, dnnl_stream_t stream,
 }
 
 inline int measure_perf_aggregate(timer::timer_t &t, dnnl_stream_t stream,
-        perf_function_t &perf_func, std::vector<dnnl_exec_arg_t> &dnnl_args) {
+        perf_function_t &perf_func, std::vector<dnnl_exec_arg_t> &dnnl_args,
+        cold_cache_t *cold_cache = nullptr) {
     const int max_batch_times = 10000;
 
     // Warm-up run, this is not measured due to possibility the associated
@@ -351,6 +358,7 @@ inline int measure_perf_aggregate(timer::timer_t &t, dnnl_stream_t stream,
     bool is_first_loop = true;
     while (true) {
         for (int i = 0; i < cur_batch_times; i++) {
+            if (cold_cache) cold_cache->update_dnnl_args(dnnl_args);
             DNN_SAFE(perf_func(stream, dnnl_args), WARN);
         }
         DNN_SAFE(dnnl_stream_wait(stream), WARN);
@@ -379,17 +387,31 @@ int measure_perf(res_t *res, perf_function_t &perf_func, args_t &args) {
     if (is_bench_mode(PERF)) {
         const auto &engine = get_test_engine();
         stream_t stream(engine);
+        // The copies are made from the mapped memories, before the unmapping.
+        cold_cache_t cold_cache(args);
         std::vector<dnnl_exec_arg_t> dnnl_args;
         execute_unmap_args(args, dnnl_args);
 
         auto &t = res->timer_map.perf_timer();
+        auto &ct = res->timer_map.get_timer(timer::timer_t::cold_timer);
         // For non-DPCPP CPU: measure individual iterations.
         // For DPCPP CPU and GPU: measure iterations in batches to hide driver
         // overhead. DPCPP CPU follows the model of GPU, thus, handled similar.
-        if (is_cpu() && !is_sycl_engine(engine))
+        // With cold cache, the same measurement is repeated with the execution
+        // arguments taken from the rotated copies.
+        if (is_cpu() && !is_sycl_engine(engine)) {
             ret = measure_perf_individual(t, stream, perf_func, dnnl_args);
-        else
+            if (ret == OK && cold_cache.is_enabled())
+                ret = measure_perf_individual(
+                        ct, stream, perf_func, dnnl_args, &cold_cache);
+        } else {
             ret = measure_perf_aggregate(t, stream, perf_func, dnnl_args);
+            if (ret == OK && cold_cache.is_enabled())
+                ret = measure_perf_aggregate(
+                        ct, stream, perf_func, dnnl_args, &cold_cache);
+        }
+        // The copies are released with `cold_cache`, nothing may use them.
+        if (cold_cache.is_enabled()) DNN_SAFE(dnnl_stream_wait(stream), WARN);
 
         if (ret == OK) execute_map_args(args);
     }
@@ -0,0 +1,172 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+
+#include "oneapi/dnnl/dnnl.h"
+
+#include "cpu/platform.hpp"
+
+#include "common.hpp"
+#include "dnnl_common.hpp"
+#include "dnnl_memory.hpp"
+
+#include "utils/cold_cache.hpp"
+
+cold_cache_mode_t cold_cache_mode {cold_cache_mode_t::none};
+
+// Arguments used with `--cold-cache=custom`. Update the list to make the
+// arguments of interest cold.
+static const std::vector<int> cold_cache_custom_args = {
+        DNNL_ARG_WEIGHTS,
+};
+
+cold_cache_mode_t str2cold_cache_mode(const char *str) {
+#define CASE(param) \
+    if (!strcasecmp(#param, str)) return cold_cache_mode_t::param
+
+    CASE(none);
+    CASE(wei);
+    CASE(all);
+    CASE(custom);
+
+#undef CASE
+
+    BENCHDNN_PRINT(0, "Error: cold cache mode value \"%s\" is not supported.\n",
+            str);
+    SAFE_V(FAIL);
+    return cold_cache_mode_t::none;
+}
+
+std::string cold_cache_mode2str(cold_cache_mode_t mode) {
+    switch (mode) {
+        case cold_cache_mode_t::none: return "none";
+        case cold_cache_mode_t::wei: return "wei";
+        case cold_cache_mode_t::all: return "all";
+        case cold_cache_mode_t::custom: return "custom";
+    }
+    assert(!"unknown cold cache mode");
+    return "unknown cold cache mode";
+}
+
+namespace {
+
+bool is_cold_arg(int arg) {
+    switch (cold_cache_mode) {
+        case cold_cache_mode_t::none: return false;
+        case cold_cache_mode_t::wei:
+            return arg == DNNL_ARG_WEIGHTS_0 || arg == DNNL_ARG_WEIGHTS_1
+                    || arg == DNNL_ARG_WEIGHTS_2 || arg == DNNL_ARG_WEIGHTS_3
+                    || arg == DNNL_ARG_BIAS;
+        case cold_cache_mode_t::all: return arg != DNNL_ARG_SCRATCHPAD;
+        case cold_cache_mode_t::custom:
+            return std::find(cold_cache_custom_args.begin(),
+                           cold_cache_custom_args.end(), arg)
+                    != cold_cache_custom_args.end();
+    }
+    return false;
+}
+
+// Returns the amount of memory the copies have to exceed to be evicted from
+// the second and the last level caches of all the cores.
+size_t get_cpu_cache_size() {
+    size_t cache_size = 0;
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE
+    using namespace dnnl::impl::cpu::platform;
+    const size_t per_core_size
+            = get_per_core_cache_size(2) + get_per_core_cache_size(3);
+    cache_size = per_core_size * std::max(1u, get_num_cores());
+#endif
+    return cache_size;
+}
+
+} // namespace
+
+cold_cache_t::cold_cache_t(const args_t &args) {
+    if (cold_cache_mode == cold_cache_mode_t::none) return;
+
+    // Only a host memory is evicted this way.
+    if (!is_cpu()) {
+        BENCHDNN_PRINT(0, "%s\n",
+                "Warning: cold cache is supported for CPU engine only, the "
+                "option is ignored.");
+        return;
+    }
+
+    std::vector<const dnn_mem_t *> mems;
+    size_t cold_bytes = 0;
+    for (int i = 0; i < args.size(); ++i) {
+        const int arg = args.arg(i);
+        const auto &mem = args.dnn_mem(i);
+        if (!is_cold_arg(arg) || mem.size() == 0) continue;
+
+        auto it = std::find(mems.begin(), mems.end(), &mem);
+        if (it == mems.end()) {
+            it = mems.insert(mems.end(), &mem);
+            cold_bytes += mem.size();
+        }
+        args_.push_back({arg, (size_t)(it - mems.begin())});
+    }
+    if (cold_bytes == 0) {
+        BENCHDNN_PRINT(2, "%s\n",
+                "cold cache: no arguments to rotate, cold numbers are not "
+                "collected.");
+        return;
+    }
+
+    // Every copy set is touched once per `n_copies_` executions; all the other
+    // sets are touched in between and are supposed to evict it.
+    static const size_t max_copies = 1024;
+    const size_t cache_size = get_cpu_cache_size();
+    n_copies_ = div_up(cache_size, cold_bytes) + 1;
+    if (n_copies_ > max_copies) {
+        BENCHDNN_PRINT(2,
+                "cold cache: %zu copies of %zu bytes are needed to exceed %zu "
+                "bytes of caches, limited to %zu copies.\n",
+                n_copies_, cold_bytes, cache_size, max_copies);
+        n_copies_ = max_copies;
+    }
+    BENCHDNN_PRINT(2, "cold cache: rotating %zu copies of %zu bytes.\n",
+            n_copies_, cold_bytes);
+
+    // The copies replicate the original data: the same values are used no
+    // matter which copy an execution takes.
+    copies_.resize(mems.size());
+    for (size_t m = 0; m < mems.size(); ++m) {
+        const auto &mem = *mems[m];
+        if (!mem.is_mapped()) mem.map();
+        copies_[m].reserve(n_copies_);
+        for (size_t c = 0; c < n_copies_; ++c) {
+            copies_[m].emplace_back(mem.md_, mem.engine());
+            auto &copy = copies_[m].back();
+            if (!copy.is_mapped()) copy.map();
+            std::memcpy((void *)copy, (const void *)mem, mem.size());
+            copy.unmap();
+        }
+    }
+}
+
+void cold_cache_t::update_dnnl_args(std::vector<dnnl_exec_arg_t> &dnnl_args) {
+    if (!is_enabled()) return;
+
+    for (const auto &a : args_) {
+        const auto &copy = copies_[a.copies_idx][cur_copy_];
+        for (auto &dnnl_arg : dnnl_args)
+            if (dnnl_arg.arg == a.arg) dnnl_arg.memory = copy.m_;
+    }
+    cur_copy_ = (cur_copy_ + 1) % n_copies_;
+}
@@ -0,0 +1,75 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef UTILS_COLD_CACHE_HPP
+#define UTILS_COLD_CACHE_HPP
+
+#include <string>
+#include <vector>
+
+#include "oneapi/dnnl/dnnl_types.h"
+
+#include "dnnl_memory.hpp"
+
+struct args_t;
+
+enum class cold_cache_mode_t {
+    // Cold cache is disabled, only warm cache numbers are reported.
+    none,
+    // Weights and bias arguments are taken cold.
+    wei,
+    // All execution arguments but the scratchpad are taken cold.
+    all,
+    // Arguments from `cold_cache_custom_args` are taken cold. The list is
+    // supposed to be updated in the source code.
+    custom,
+};
+
+extern cold_cache_mode_t cold_cache_mode;
+
+cold_cache_mode_t str2cold_cache_mode(const char *str);
+std::string cold_cache_mode2str(cold_cache_mode_t mode);
+
+// `cold_cache_t` keeps enough copies of the execution arguments selected by
+// `cold_cache_mode` for the copies used by the next execution not to reside in
+// the CPU caches after the previous ones were touched. Every call to
+// `update_dnnl_args` switches the execution arguments to the next copies.
+struct cold_cache_t {
+    cold_cache_t(const args_t &args);
+
+    // Returns `true` when at least one argument is rotated.
+    bool is_enabled() const { return n_copies_ > 0; }
+    size_t n_copies() const { return n_copies_; }
+
+    // Replaces the memories of selected arguments in `dnnl_args` with the
+    // next set of copies.
+    void update_dnnl_args(std::vector<dnnl_exec_arg_t> &dnnl_args);
+
+private:
+    // A copy set per argument, arguments sharing a memory object (in-place
+    // case) share the copies as well.
+    struct arg_copies_t {
+        int arg;
+        size_t copies_idx;
+    };
+
+    std::vector<arg_copies_t> args_;
+    std::vector<std::vector<dnn_mem_t>> copies_;
+    size_t n_copies_ = 0;
+    size_t cur_copy_ = 0;
+};
+
+#endif
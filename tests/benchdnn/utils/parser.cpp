@@ -17,6 +17,7 @@
 #include "utils/parser.hpp"
 
 #include "dnnl_common.hpp"
+#include "utils/cold_cache.hpp"
 
 namespace parser {
 
@@ -459,6 +460,20 @@ static bool parse_canonical(
             canonical, false, str2bool, str, option_name, help);
 }
 
+static bool parse_cold_cache(
+        const char *str, const std::string &option_name = "cold-cache") {
+    static const std::string help
+            = "MODE    (Default: `none`)\n    Instructs the driver to measure "
+              "performance with the execution arguments evicted from the CPU "
+              "caches, in addition to the default measurement.\n    `MODE` "
+              "values are `none`, `wei` for weights and bias, `all` for all "
+              "arguments, or `custom` for the arguments listed in the source "
+              "code.\n    More details at "
+            + doc_url + "knobs_common.md\n";
+    return parse_single_value_option(cold_cache_mode, cold_cache_mode_t::none,
+            str2cold_cache_mode, str, option_name, help);
+}
+
 static bool parse_cpu_isa_hints(
         const char *str, const std::string &option_name = "cpu-isa-hints") {
     static const std::string help
@@ -682,7 +697,8 @@ bool parse_bench_settings(const char *str) {
 
     bool parsed = parse_allow_enum_tags_only(str)
             || parse_attr_same_pd_check(str) || parse_canonical(str)
-            || parse_cpu_isa_hints(str) || parse_engine(str)
+            || parse_cold_cache(str) || parse_cpu_isa_hints(str)
+            || parse_engine(str)
             || parse_fast_ref_gpu(str) || parse_fix_times_per_prb(str)
             || parse_max_ms_per_prb(str) || parse_mem_check(str)
             || parse_memory_kind(str) || parse_mode(str) || parse_skip_impl(str)
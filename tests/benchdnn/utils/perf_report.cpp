@@ -122,6 +122,11 @@ void base_perf_report_t::handle_option(std::ostream &s, const char *&option,
     HANDLE("obytes", s << res->obytes / unit);
     HANDLE("iobytes", s << (res->ibytes + res->obytes) / unit);
     HANDLE("idx", s << benchdnn_stat.tests);
+    // Timer values measured with `--cold-cache`.
+    const auto &cold_t = res->timer_map.get_timer(timer::timer_t::cold_timer);
+    HANDLE("cbw", s << get_bw(cold_t));
+    HANDLE("cflops", s << get_flops(cold_t));
+    HANDLE("ctime", s << cold_t.ms(mode) / unit);
 
 #undef HANDLE
 
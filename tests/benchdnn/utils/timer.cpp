@@ -115,5 +115,6 @@ timer_t &timer_map_t::perf_timer() {
 // Initializing timers with fixed names.
 const std::string timer_t::perf_timer = "perf_timer";
 const std::string timer_t::ref_timer = "compute_ref_timer";
+const std::string timer_t::cold_timer = "cold_cache_timer";
 
 } // namespace timer
@@ -70,6 +70,7 @@ struct timer_t {
     // Section with timer fixed timer names for ease of use
     static const std::string perf_timer;
     static const std::string ref_timer;
+    static const std::string cold_timer;
 };
 
 struct timer_map_t {
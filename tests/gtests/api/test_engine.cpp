@@ -73,6 +73,52 @@ HANDLE_EXCEPTIONS_FOR_TEST_P(engine_test_t, TestMultithreading) {
     exe.join();
 }
 
+HANDLE_EXCEPTIONS_FOR_TEST_P(engine_test_t, TestNumaNode) {
+    engine::kind eng_kind = GetParam();
+    SKIP_IF(engine::get_count(eng_kind) == 0, "Engine is not found.");
+    engine eng {eng_kind, 0};
+    ASSERT_EQ(eng.get_numa_node(), -1);
+
+    const int numa_nodes = (int)engine::get_numa_node_count(eng_kind);
+    if (numa_nodes == 0) {
+        EXPECT_ANY_THROW(engine::create_on_numa_node(eng_kind, 0));
+        return;
+    }
+    EXPECT_ANY_THROW(engine::create_on_numa_node(eng_kind, numa_nodes));
+
+    const int numa_node = numa_nodes - 1;
+    engine numa_eng = engine::create_on_numa_node(eng_kind, numa_node);
+    ASSERT_EQ(numa_eng.get_numa_node(), numa_node);
+
+    memory::desc mem_d({2, 16, 32, 32}, memory::data_type::f32,
+            memory::format_tag::nchw);
+    auto src = test::make_memory(mem_d, numa_eng);
+    auto dst = test::make_memory(mem_d, numa_eng);
+    const size_t nelems = mem_d.get_size() / sizeof(float);
+    {
+        auto *ptr = src.map_data<float>();
+        GTEST_EXPECT_NE(ptr, nullptr);
+        for (size_t i = 0; i < nelems; ++i)
+            ptr[i] = float(i) * (i % 2 == 0 ? 1 : -1);
+        src.unmap_data(ptr);
+    }
+
+    auto eltwise_d = eltwise_forward::desc(
+            prop_kind::forward, algorithm::eltwise_relu, mem_d, 0.0f);
+    eltwise_forward eltwise({eltwise_d, numa_eng});
+    stream s(numa_eng);
+    eltwise.execute(s, {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst}});
+    s.wait();
+
+    {
+        auto *ptr = dst.map_data<float>();
+        GTEST_EXPECT_NE(ptr, nullptr);
+        for (size_t i = 0; i < nelems; ++i)
+            ASSERT_EQ(ptr[i], i % 2 == 0 ? float(i) : 0.f);
+        dst.unmap_data(ptr);
+    }
+}
+
 INSTANTIATE_TEST_SUITE_P(AllEngineKinds, engine_test_t,
         ::testing::Values(engine::kind::cpu, engine::kind::gpu));
 
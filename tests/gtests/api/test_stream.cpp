@@ -137,6 +137,63 @@ TEST(stream_test_c_t, GetStream) {
 }
 #endif
 
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE \
+        && DNNL_CPU_RUNTIME != DNNL_RUNTIME_SYCL \
+        && DNNL_CPU_RUNTIME != DNNL_RUNTIME_THREADPOOL
+TEST(stream_test_cpp_t, ScratchpadArena) {
+    engine eng(engine::kind::cpu, 0);
+    stream s(eng);
+
+    const memory::dim M = 64, K = 256, N = 96;
+    memory::desc a_md({M, K}, memory::data_type::f32, memory::format_tag::ab);
+    memory::desc b_md({K, N}, memory::data_type::f32, memory::format_tag::ba);
+    memory::desc c_md({M, N}, memory::data_type::f32, memory::format_tag::ab);
+
+    primitive_attr attr;
+    attr.set_scratchpad_mode(scratchpad_mode::user);
+    auto pd = matmul::primitive_desc({a_md, b_md, c_md}, attr, eng);
+    const size_t scratchpad_size = pd.scratchpad_desc().get_size();
+    SKIP_IF(scratchpad_size == 0, "The implementation needs no scratchpad.");
+
+    memory a(a_md, eng), b(b_md, eng), c(c_md, eng), c_ref(c_md, eng);
+    {
+        auto *pa = (float *)a.get_data_handle();
+        for (memory::dim i = 0; i < M * K; i++)
+            pa[i] = (float)(i % 7) - 3.f;
+        auto *pb = (float *)b.get_data_handle();
+        for (memory::dim i = 0; i < K * N; i++)
+            pb[i] = (float)(i % 5) - 2.f;
+    }
+
+    ASSERT_EQ(s.get_scratchpad_arena_size(), 0u);
+    ASSERT_EQ(s.get_scratchpad_arena_num_allocations(), 0u);
+
+    matmul p(pd);
+    memory scratchpad(pd.scratchpad_desc(), eng);
+    p.execute(s,
+            {{DNNL_ARG_SRC, a}, {DNNL_ARG_WEIGHTS, b}, {DNNL_ARG_DST, c_ref},
+                    {DNNL_ARG_SCRATCHPAD, scratchpad}});
+    // A user-provided scratchpad is used as is.
+    ASSERT_EQ(s.get_scratchpad_arena_size(), 0u);
+
+    // Without a user-provided scratchpad the arena is used and its memory is
+    // reused by the subsequent executions.
+    for (int i = 0; i < 3; i++)
+        p.execute(s,
+                {{DNNL_ARG_SRC, a}, {DNNL_ARG_WEIGHTS, b},
+                        {DNNL_ARG_DST, c}});
+    s.wait();
+
+    ASSERT_GE(s.get_scratchpad_arena_size(), scratchpad_size);
+    ASSERT_EQ(s.get_scratchpad_arena_num_allocations(), 1u);
+
+    const auto *ref = (const float *)c_ref.get_data_handle();
+    const auto *got = (const float *)c.get_data_handle();
+    for (memory::dim i = 0; i < M * N; i++)
+        ASSERT_EQ(ref[i], got[i]);
+}
+#endif
+
 namespace {
 struct print_to_string_param_name_t {
     template <class ParamType>
@@ -270,4 +270,76 @@ TEST_P(brgemm_test_t, TestsBRGEMM) {}
 INSTANTIATE_TEST_SUITE_P(TestBRGEMMSimple, brgemm_test_t,
         ::testing::ValuesIn(params_creator_t().create_simple_brgemm_params()));
 
+// Kernels created for identical descriptors share the generated code.
+TEST(brgemm_kernel_cache_test, TestSharing) {
+    using namespace impl::cpu::x64;
+
+    SKIP_IF(engine::get_count(engine::kind::cpu) == 0, "Brgemm requires cpu.");
+    SKIP_IF(!dnnl::mayiuse(cpu_isa::avx2), "Brgemm requires avx2.");
+
+    const int M = 8, N = 16, K = 16;
+    memory::desc dst_md({M, N}, memory::data_type::f32, memory::format_tag::ab);
+
+    auto create = [&](cpu_isa_t isa, const dnnl_primitive_attr_t attr) {
+        brgemm_t desc;
+        brgemm_kernel_t *kernel = nullptr;
+        EXPECT_EQ(brgemm_desc_init(&desc, isa, brgemm_addr, dnnl_f32,
+                          dnnl_f32, false, false, brgemm_row_major, 1.f, 0.f,
+                          K, N, N, M, N, K),
+                dnnl_success);
+        if (attr) {
+            EXPECT_EQ(
+                    brgemm_desc_set_postops(&desc, attr, &dst_md.data, N),
+                    dnnl_success);
+        }
+        brgemm_attr_t brgattr;
+        brgattr.max_bs = 1;
+        EXPECT_EQ(brgemm_desc_set_attr(&desc, brgattr), dnnl_success);
+        EXPECT_EQ(brgemm_kernel_create(&kernel, desc), dnnl_success);
+        return std::unique_ptr<brgemm_kernel_t, void (*)(brgemm_kernel_t *)>(
+                kernel, brgemm_kernel_destroy);
+    };
+
+    auto k0 = create(isa_any, nullptr);
+    auto k1 = create(isa_any, nullptr);
+    ASSERT_TRUE(k0 && k1);
+    ASSERT_EQ(k0->get_jit_generator(), k1->get_jit_generator());
+
+    // A different code path of the kernel is not shared.
+    if (dnnl::mayiuse(cpu_isa::avx512_core)) {
+        auto k_ymm = create(avx2, nullptr);
+        ASSERT_TRUE(k_ymm);
+        ASSERT_NE(k_ymm->get_jit_generator(), k0->get_jit_generator());
+    }
+
+    // Neither is a kernel with post-ops.
+    post_ops ops;
+    ops.append_eltwise(1.f, algorithm::eltwise_relu, 0.f, 0.f);
+    primitive_attr attr;
+    attr.set_post_ops(ops);
+    auto k_po = create(isa_any, attr.get());
+    ASSERT_TRUE(k_po);
+    ASSERT_NE(k_po->get_jit_generator(), k0->get_jit_generator());
+
+    // The shared kernel outlives the kernel it was shared with.
+    k0.reset();
+    std::vector<float> A(M * K), B(K * N), C(M * N, 0.f);
+    for (int i = 0; i < M * K; i++)
+        A[i] = (float)(i % 7) - 3.f;
+    for (int i = 0; i < K * N; i++)
+        B[i] = (float)(i % 5) - 2.f;
+    brgemm_batch_element_t batch;
+    batch.ptr.A = A.data();
+    batch.ptr.B = B.data();
+    brgemm_kernel_execute(k1.get(), 1, &batch, C.data());
+
+    for_(int m = 0; m < M; m++)
+    for (int n = 0; n < N; n++) {
+        float ref = 0.f;
+        for (int k = 0; k < K; k++)
+            ref += A[m * K + k] * B[k * N + n];
+        ASSERT_EQ(C[m * N + n], ref) << "m " << m << " n " << n;
+    }
+}
+
 } // namespace dnnl
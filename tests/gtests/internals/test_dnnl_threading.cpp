@@ -14,6 +14,8 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <atomic>
+#include <tuple>
 #include <vector>
 
 #include "dnnl_test_common.hpp"
@@ -29,6 +31,21 @@ TEST(test_parallel, Test) {
     });
 }
 
+TEST(test_max_threads_guard, Test) {
+    const int max_threads = dnnl_get_max_threads();
+    {
+        impl::max_threads_guard_t guard(1);
+        ASSERT_EQ(dnnl_get_max_threads(), 1);
+        impl::parallel(0, [&](int ithr, int nthr) { ASSERT_EQ(nthr, 1); });
+        {
+            // Nested guards can't relax the limit.
+            impl::max_threads_guard_t nested_guard(2);
+            ASSERT_EQ(dnnl_get_max_threads(), 1);
+        }
+    }
+    ASSERT_EQ(dnnl_get_max_threads(), max_threads);
+}
+
 using data_t = ptrdiff_t;
 
 struct nd_params_t {
@@ -151,6 +168,12 @@ TEST_P(test_parallel_nd_t, Test) {
     CheckID();
 }
 
+TEST_P(test_parallel_nd_t, TestDynamic) {
+    impl::dynamic_scheduling_guard_t guard(true);
+    emit_parallel_nd();
+    CheckID();
+}
+
 CPU_INSTANTIATE_TEST_SUITE_P(Case, test_parallel_nd_t,
         ::testing::Values(np_t {{0}}, np_t {{1}}, np_t {{100}}, np_t {{0, 0}},
                 np_t {{1, 2}}, np_t {{10, 10}}, np_t {{0, 1, 0}},
@@ -160,4 +183,53 @@ CPU_INSTANTIATE_TEST_SUITE_P(Case, test_parallel_nd_t,
                 np_t {{4, 1, 4, 5, 2}}, np_t {{4, 3, 0, 3, 0, 1}},
                 np_t {{2, 1, 3, 1, 2, 1}}, np_t {{4, 1, 4, 3, 2, 2}}));
 
+class test_work_scheduler_t
+    : public ::testing::TestWithParam<std::tuple<ptrdiff_t, bool>> {};
+
+TEST_P(test_work_scheduler_t, Test) {
+    const ptrdiff_t work_amount = std::get<0>(GetParam());
+    const bool dynamic = std::get<1>(GetParam());
+    std::vector<std::atomic<int>> counts((size_t)work_amount);
+    for (auto &c : counts)
+        c = 0;
+
+    const int nthr = dnnl_get_max_threads();
+    impl::work_scheduler_t scheduler(work_amount, nthr, dynamic);
+    impl::parallel(nthr, [&](int ithr, int nthr) {
+        impl::dim_t start {0}, end {0};
+        while (scheduler.next(ithr, start, end)) {
+            ASSERT_TRUE(0 <= start && start < end && end <= work_amount);
+            for (impl::dim_t i = start; i < end; i++)
+                counts[(size_t)i]++;
+        }
+    });
+    // Each item is processed exactly once.
+    for (auto &c : counts)
+        ASSERT_EQ(c, 1);
+}
+
+TEST_P(test_work_scheduler_t, TestSequential) {
+    const ptrdiff_t work_amount = std::get<0>(GetParam());
+    const bool dynamic = std::get<1>(GetParam());
+    std::vector<int> counts((size_t)work_amount, 0);
+
+    // The threads take the work one after another.
+    const int nthr = 5;
+    impl::work_scheduler_t scheduler(work_amount, nthr, dynamic);
+    for (int ithr = 0; ithr < nthr; ithr++) {
+        impl::dim_t start {0}, end {0};
+        while (scheduler.next(ithr, start, end)) {
+            ASSERT_TRUE(0 <= start && start < end && end <= work_amount);
+            for (impl::dim_t i = start; i < end; i++)
+                counts[(size_t)i]++;
+        }
+    }
+    for (auto c : counts)
+        ASSERT_EQ(c, 1);
+}
+
+CPU_INSTANTIATE_TEST_SUITE_P(Case, test_work_scheduler_t,
+        ::testing::Combine(::testing::Values(0, 1, 7, 1000, 12345),
+                ::testing::Bool()));
+
 } // namespace dnnl
@@ -0,0 +1,90 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include "stdlib.h"
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "oneapi/dnnl/dnnl.hpp"
+
+namespace {
+
+void custom_setenv(const char *name, const char *value, int overwrite) {
+#ifdef _WIN32
+    auto status = SetEnvironmentVariable(name, value);
+    EXPECT_NE(status, 0);
+#else
+    auto status = ::setenv(name, value, overwrite);
+    EXPECT_EQ(status, 0);
+#endif
+}
+
+} // namespace
+
+namespace dnnl {
+
+TEST(onednn_primitive_cache_shards_env_var_test, TestEnvVars) {
+    custom_setenv("ONEDNN_PRIMITIVE_CACHE_CAPACITY", "11", 1);
+    custom_setenv("ONEDNN_PRIMITIVE_CACHE_SHARDS", "4", 1);
+    // The capacity is split between the shards, the total one is expected to
+    // be preserved.
+    auto got = get_primitive_cache_capacity();
+#ifndef DNNL_DISABLE_PRIMITIVE_CACHE
+    EXPECT_EQ(got, 11);
+
+    set_primitive_cache_capacity(8);
+    EXPECT_EQ(get_primitive_cache_capacity(), 8);
+
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE
+    engine eng(engine::kind::cpu, 0);
+    auto create_primitives = [&](int n) {
+        for (int np = 1; np <= n; np++) {
+            auto relu_d = eltwise_forward::desc(prop_kind::forward_inference,
+                    algorithm::eltwise_relu,
+                    {{np, 1, 1, 1}, memory::data_type::f32,
+                            memory::format_tag::nchw},
+                    0.f, 0.f);
+            auto relu = eltwise_forward({relu_d, eng});
+        }
+    };
+
+    // The capacity lower than the number of shards is not split into empty
+    // shards: every primitive has to find a slot.
+    set_primitive_cache_capacity(2);
+    EXPECT_EQ(get_primitive_cache_capacity(), 2);
+    create_primitives(2);
+    EXPECT_EQ(get_primitive_cache_size(), 2);
+
+    set_primitive_cache_capacity(1);
+    create_primitives(1);
+    EXPECT_EQ(get_primitive_cache_size(), 1);
+
+    set_primitive_cache_capacity(1024);
+    const int n_primitives = 16;
+    create_primitives(n_primitives);
+    EXPECT_EQ(get_primitive_cache_size(), n_primitives);
+#endif
+#else
+    EXPECT_EQ(got, 0);
+#endif
+}
+
+} // namespace dnnl
@@ -0,0 +1,316 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "oneapi/dnnl/dnnl.hpp"
+
+namespace dnnl {
+
+namespace {
+
+// The maximal ISA can be set only before the first primitive is created, so
+// the whole binary runs with AVX2 (and AVX-VNNI if the CPU has it). Returns
+// the ISA the primitives are created for.
+cpu_isa get_test_isa() {
+    static const cpu_isa isa = []() {
+        set_max_cpu_isa(cpu_isa::avx2_vnni);
+        return get_effective_cpu_isa();
+    }();
+    return isa;
+}
+
+bool is_avx2_f32_supported() {
+    return get_test_engine_kind() == engine::kind::cpu
+            && (get_test_isa() == cpu_isa::avx2
+                    || get_test_isa() == cpu_isa::avx2_vnni);
+}
+
+bool is_avx2_int8_supported() {
+    return get_test_engine_kind() == engine::kind::cpu
+            && get_test_isa() == cpu_isa::avx2_vnni;
+}
+
+// All the values and intermediate results are exact in f32.
+float src_val(memory::dim i) {
+    return (float)(i % 7 - 3);
+}
+float wei_val(memory::dim i) {
+    return (float)(i % 5 - 2);
+}
+float bia_val(memory::dim i) {
+    return (float)(i % 4 - 2);
+}
+float po_val(memory::dim i) {
+    return (float)(i % 3 - 1);
+}
+// The values of an unsigned source.
+float abs_src_val(memory::dim i) {
+    return std::fabs(src_val(i));
+}
+
+template <typename T>
+void fill(const memory &mem, float (*val)(memory::dim)) {
+    const memory::dim nelems = (memory::dim)(
+            mem.get_desc().get_size() / memory::data_type_size(
+                    mem.get_desc().data_type()));
+    auto *ptr = mem.map_data<T>();
+    for (memory::dim i = 0; i < nelems; i++)
+        ptr[i] = (T)val(i);
+    mem.unmap_data(ptr);
+}
+
+// Returns the memory in the layout chosen by the primitive.
+memory reorder_to(memory &mem, const memory::desc &md, stream &s) {
+    if (mem.get_desc() == md) return mem;
+    auto res = test::make_memory(md, mem.get_engine());
+    reorder(mem, res).execute(s, mem, res);
+    s.wait();
+    return res;
+}
+
+// Converts the value to an integer type the way the library does: rounds to
+// the nearest even and saturates.
+template <typename T>
+float saturate(float f) {
+    const float lo = (float)std::numeric_limits<T>::lowest();
+    const float hi = (float)std::numeric_limits<T>::max();
+    return std::min(std::max(std::nearbyint(f), lo), hi);
+}
+
+} // namespace
+
+class brgemm_avx2_test_t : public ::testing::Test {};
+
+// The shapes have tails along M, N and K, and one of them is batched.
+HANDLE_EXCEPTIONS_FOR_TEST(brgemm_avx2_test_t, TestMatmulF32) {
+    SKIP_IF(!is_avx2_f32_supported(), "AVX2 CPU engine is required.");
+
+    engine eng = get_test_engine();
+    stream s(eng);
+    const auto f32 = memory::data_type::f32;
+    const auto tag = memory::format_tag::abc;
+    const auto any = memory::format_tag::any;
+
+    struct shape_t {
+        memory::dim B, M, K, N;
+    };
+    for (const auto &p : std::vector<shape_t> {
+                 {1, 13, 37, 23}, {1, 64, 16, 48}, {3, 7, 19, 9}}) {
+        memory::desc src_md({p.B, p.M, p.K}, f32, tag);
+        memory::desc wei_md({p.B, p.K, p.N}, f32, tag);
+        memory::desc bia_md({1, 1, p.N}, f32, tag);
+        memory::desc dst_md({p.B, p.M, p.N}, f32, tag);
+        memory::desc po_md({1, 1, p.N}, f32, tag);
+
+        dnnl::post_ops ops;
+        ops.append_eltwise(1.f, algorithm::eltwise_relu, 0.f, 0.f);
+        ops.append_binary(algorithm::binary_add, po_md);
+        dnnl::primitive_attr attr;
+        attr.set_post_ops(ops);
+
+        auto pd = matmul::primitive_desc(
+                matmul::desc(src_md, {{p.B, p.K, p.N}, f32, any}, bia_md,
+                        dst_md),
+                attr, eng);
+        ASSERT_EQ(std::string(pd.impl_info_str()), "brg:avx2");
+
+        auto src = test::make_memory(src_md, eng);
+        auto wei = test::make_memory(wei_md, eng);
+        auto bia = test::make_memory(bia_md, eng);
+        auto po = test::make_memory(po_md, eng);
+        auto dst = test::make_memory(dst_md, eng);
+        fill<float>(src, src_val);
+        fill<float>(wei, wei_val);
+        fill<float>(bia, bia_val);
+        fill<float>(po, po_val);
+
+        matmul(pd).execute(s,
+                {{DNNL_ARG_SRC, src},
+                        {DNNL_ARG_WEIGHTS,
+                                reorder_to(wei, pd.weights_desc(), s)},
+                        {DNNL_ARG_BIAS, bia}, {DNNL_ARG_DST, dst},
+                        {DNNL_ARG_ATTR_MULTIPLE_POST_OP(1) | DNNL_ARG_SRC_1,
+                                po}});
+        s.wait();
+
+        auto *dst_ptr = dst.map_data<float>();
+        for_(memory::dim b = 0; b < p.B; b++)
+        for_(memory::dim m = 0; m < p.M; m++)
+        for (memory::dim n = 0; n < p.N; n++) {
+            float ref = 0.f;
+            for (memory::dim k = 0; k < p.K; k++)
+                ref += src_val((b * p.M + m) * p.K + k)
+                        * wei_val((b * p.K + k) * p.N + n);
+            ref = std::max(ref + bia_val(n), 0.f) + po_val(n);
+            ASSERT_EQ(ref, dst_ptr[(b * p.M + m) * p.N + n])
+                    << "b " << b << " m " << m << " n " << n;
+        }
+        dst.unmap_data(dst_ptr);
+    }
+}
+
+// Both signed and unsigned sources are covered, the former needs the weights
+// compensation. The post-op makes the results exceed the range of int8.
+HANDLE_EXCEPTIONS_FOR_TEST(brgemm_avx2_test_t, TestMatmulInt8) {
+    SKIP_IF(!is_avx2_int8_supported(), "AVX2 VNNI CPU engine is required.");
+
+    engine eng = get_test_engine();
+    stream s(eng);
+    using dt = memory::data_type;
+    const auto tag = memory::format_tag::ab;
+    const memory::dim M = 13, K = 37, N = 23;
+
+    for_(dt src_dt : {dt::u8, dt::s8})
+    for (dt dst_dt : {dt::s8, dt::u8, dt::f32}) {
+        memory::desc src_md({M, K}, src_dt, tag);
+        memory::desc wei_md({K, N}, dt::s8, tag);
+        memory::desc bia_md({1, N}, dt::f32, tag);
+        memory::desc dst_md({M, N}, dst_dt, tag);
+
+        dnnl::post_ops ops;
+        ops.append_eltwise(1.f, algorithm::eltwise_linear, 8.f, -4.f);
+        dnnl::primitive_attr attr;
+        attr.set_post_ops(ops);
+
+        auto pd = matmul::primitive_desc(
+                matmul::desc(src_md, {{K, N}, dt::s8, memory::format_tag::any},
+                        bia_md, dst_md),
+                attr, eng);
+        ASSERT_EQ(std::string(pd.impl_info_str()), "brg:avx2_vnni");
+
+        auto src_val_x8 = src_dt == dt::u8 ? abs_src_val : src_val;
+        auto src = test::make_memory(src_md, eng);
+        if (src_dt == dt::u8)
+            fill<uint8_t>(src, src_val_x8);
+        else
+            fill<int8_t>(src, src_val_x8);
+        auto wei = test::make_memory(wei_md, eng);
+        fill<int8_t>(wei, wei_val);
+        auto bia = test::make_memory(bia_md, eng);
+        fill<float>(bia, bia_val);
+        auto dst = test::make_memory(dst_md, eng);
+
+        matmul(pd).execute(s,
+                {{DNNL_ARG_SRC, src},
+                        {DNNL_ARG_WEIGHTS,
+                                reorder_to(wei, pd.weights_desc(), s)},
+                        {DNNL_ARG_BIAS, bia}, {DNNL_ARG_DST, dst}});
+        s.wait();
+
+        auto dst_f32 = test::make_memory({{M, N}, dt::f32, tag}, eng);
+        reorder(dst, dst_f32).execute(s, dst, dst_f32);
+        s.wait();
+
+        auto *dst_ptr = dst_f32.map_data<float>();
+        for_(memory::dim m = 0; m < M; m++)
+        for (memory::dim n = 0; n < N; n++) {
+            float ref = 0.f;
+            for (memory::dim k = 0; k < K; k++)
+                ref += src_val_x8(m * K + k) * wei_val(k * N + n);
+            ref = 8.f * (ref + bia_val(n)) - 4.f;
+            if (dst_dt == dt::s8) ref = saturate<int8_t>(ref);
+            if (dst_dt == dt::u8) ref = saturate<uint8_t>(ref);
+            ASSERT_EQ(ref, dst_ptr[m * N + n]) << "m " << m << " n " << n;
+        }
+        dst_f32.unmap_data(dst_ptr);
+    }
+}
+
+HANDLE_EXCEPTIONS_FOR_TEST(brgemm_avx2_test_t, TestInnerProduct) {
+    SKIP_IF(!is_avx2_f32_supported(), "AVX2 CPU engine is required.");
+
+    engine eng = get_test_engine();
+    stream s(eng);
+    using dt = memory::data_type;
+    const auto tag = memory::format_tag::ab;
+    const memory::dim MB = 7, IC = 35, OC = 19;
+
+    std::vector<dt> dst_dts = {dt::f32};
+    if (is_avx2_int8_supported())
+        dst_dts.insert(dst_dts.end(), {dt::s8, dt::u8});
+
+    for (dt dst_dt : dst_dts) {
+        const bool is_int8 = dst_dt != dt::f32;
+        const dt src_dt = is_int8 ? dt::u8 : dt::f32;
+        const dt wei_dt = is_int8 ? dt::s8 : dt::f32;
+        memory::desc src_md({MB, IC}, src_dt, tag);
+        memory::desc wei_md({OC, IC}, wei_dt, tag);
+        memory::desc bia_md({OC}, dt::f32, memory::format_tag::a);
+        memory::desc dst_md({MB, OC}, dst_dt, tag);
+
+        dnnl::post_ops ops;
+        ops.append_eltwise(1.f, algorithm::eltwise_linear, 4.f, 0.f);
+        ops.append_eltwise(1.f, algorithm::eltwise_relu, 0.f, 0.f);
+        dnnl::primitive_attr attr;
+        attr.set_post_ops(ops);
+
+        auto pd = inner_product_forward::primitive_desc(
+                inner_product_forward::desc(prop_kind::forward_inference,
+                        src_md, {{OC, IC}, wei_dt, memory::format_tag::any},
+                        bia_md, dst_md),
+                attr, eng);
+        ASSERT_EQ(std::string(pd.impl_info_str()),
+                is_int8 ? "brgemm:avx2_vnni" : "brgemm:avx2");
+
+        auto src_val_x = is_int8 ? abs_src_val : src_val;
+        auto src = test::make_memory(src_md, eng);
+        auto wei = test::make_memory(wei_md, eng);
+        if (is_int8) {
+            fill<uint8_t>(src, src_val_x);
+            fill<int8_t>(wei, wei_val);
+        } else {
+            fill<float>(src, src_val_x);
+            fill<float>(wei, wei_val);
+        }
+        auto bia = test::make_memory(bia_md, eng);
+        fill<float>(bia, bia_val);
+        auto dst = test::make_memory(dst_md, eng);
+
+        inner_product_forward(pd).execute(s,
+                {{DNNL_ARG_SRC, src},
+                        {DNNL_ARG_WEIGHTS,
+                                reorder_to(wei, pd.weights_desc(), s)},
+                        {DNNL_ARG_BIAS, bia}, {DNNL_ARG_DST, dst}});
+        s.wait();
+
+        auto dst_f32 = test::make_memory({{MB, OC}, dt::f32, tag}, eng);
+        reorder(dst, dst_f32).execute(s, dst, dst_f32);
+        s.wait();
+
+        auto *dst_ptr = dst_f32.map_data<float>();
+        for_(memory::dim mb = 0; mb < MB; mb++)
+        for (memory::dim oc = 0; oc < OC; oc++) {
+            float ref = 0.f;
+            for (memory::dim ic = 0; ic < IC; ic++)
+                ref += src_val_x(mb * IC + ic) * wei_val(oc * IC + ic);
+            ref = std::max(4.f * (ref + bia_val(oc)), 0.f);
+            if (dst_dt == dt::s8) ref = saturate<int8_t>(ref);
+            if (dst_dt == dt::u8) ref = saturate<uint8_t>(ref);
+            ASSERT_EQ(ref, dst_ptr[mb * OC + oc])
+                    << "mb " << mb << " oc " << oc;
+        }
+        dst_f32.unmap_data(dst_ptr);
+    }
+}
+
+} // namespace dnnl
@@ -18,6 +18,7 @@
 #include "gtest/gtest.h"
 
 #include "oneapi/dnnl/dnnl.hpp"
+#include "tests/test_isa_common.hpp"
 
 namespace dnnl {
 
@@ -426,4 +427,85 @@ GPU_INSTANTIATE_TEST_SUITE_P(TestConcat, concat_test_float, cases_concat_gpu());
 GPU_INSTANTIATE_TEST_SUITE_P(
         TestConcat, concat_test_float16, cases_concat_gpu());
 
+class concat_scales_test_t
+    : public ::testing::TestWithParam<memory::format_tag> {};
+
+// The inputs of different layouts are scaled, converted to s8 and written at
+// the offsets not aligned with the blocks of the destination.
+TEST_P(concat_scales_test_t, TestInputScales) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "Input scales are supported only on CPU.");
+
+    auto eng = get_test_engine();
+    auto strm = make_stream(eng);
+
+    const memory::dim N = 2, H = 3, W = 5;
+    const std::vector<memory::dim> Cs = {13, 24, 5};
+    const std::vector<memory::format_tag> tags
+            = {fmt::nChw16c, fmt::nhwc, fmt::nChw8c};
+    const std::vector<float> scales = {0.5f, 2.f, -1.f};
+    const memory::dim C = 13 + 24 + 5;
+
+    primitive_attr attr;
+    std::vector<memory::desc> srcs_md;
+    for (size_t i = 0; i < Cs.size(); i++) {
+        srcs_md.emplace_back(memory::dims {N, Cs[i], H, W},
+                memory::data_type::f32, tags[i]);
+        attr.set_scales(DNNL_ARG_MULTIPLE_SRC + (int)i, 0, {scales[i]});
+    }
+    memory::desc dst_md({N, C, H, W}, memory::data_type::s8, GetParam());
+
+    auto concat_pd = concat::primitive_desc(dst_md, 1, srcs_md, eng, attr);
+#if DNNL_X64
+    if (dnnl::mayiuse(cpu_isa::avx512_core)) {
+        const std::string impl_name = concat_pd.impl_info_str();
+        ASSERT_EQ(impl_name.compare(0, 4, "jit:"), 0);
+    }
+#endif
+
+    // The integer values saturate and round half to even when scaled.
+    auto src_val = [](memory::dim i) { return (float)(i % 301 - 150); };
+    std::vector<memory> srcs;
+    for (size_t i = 0; i < Cs.size(); i++) {
+        srcs.push_back(test::make_memory(srcs_md[i], eng));
+        auto ptr = map_memory<float>(srcs[i]);
+        const dnnl::impl::memory_desc_wrapper mdw(srcs_md[i].data);
+        for_(memory::dim n = 0; n < N; n++)
+        for_(memory::dim c = 0; c < Cs[i]; c++)
+        for_(memory::dim h = 0; h < H; h++)
+        for (memory::dim w = 0; w < W; w++)
+            ptr[mdw.off(n, c, h, w)] = src_val(((n * C + c) * H + h) * W + w);
+    }
+
+    auto dst = test::make_memory(concat_pd.dst_desc(), eng);
+    fill_data<int8_t>(dst.get_desc().get_size(), dst);
+
+    std::unordered_map<int, memory> args = {{DNNL_ARG_DST, dst}};
+    for (size_t i = 0; i < srcs.size(); i++)
+        args.insert({DNNL_ARG_MULTIPLE_SRC + (int)i, srcs[i]});
+    concat(concat_pd).execute(strm, args);
+    strm.wait();
+
+    auto dst_data = map_memory<const int8_t>(dst);
+    const dnnl::impl::memory_desc_wrapper dst_mdw(concat_pd.dst_desc().data);
+    memory::dim c_off = 0;
+    for (size_t i = 0; i < Cs.size(); i++) {
+        for_(memory::dim n = 0; n < N; n++)
+        for_(memory::dim c = 0; c < Cs[i]; c++)
+        for_(memory::dim h = 0; h < H; h++)
+        for (memory::dim w = 0; w < W; w++) {
+            float ref = scales[i]
+                    * src_val(((n * C + c) * H + h) * W + w);
+            ref = std::nearbyint(std::min(std::max(ref, -128.f), 127.f));
+            ASSERT_EQ((int8_t)ref,
+                    dst_data[dst_mdw.off(n, c_off + c, h, w)]);
+        }
+        c_off += Cs[i];
+    }
+    check_zero_tail<int8_t>(0, dst);
+}
+
+CPU_INSTANTIATE_TEST_SUITE_P(TestConcatScales, concat_scales_test_t,
+        ::testing::Values(fmt::nChw16c, fmt::nhwc, fmt::nchw));
+
 } // namespace dnnl
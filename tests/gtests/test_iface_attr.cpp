@@ -87,6 +87,70 @@ TEST_F(attr_test_t, TestScratchpadModeEx) {
     }
 }
 
+TEST_F(attr_test_t, TestMaxThreads) {
+    dnnl::primitive_attr attr;
+    ASSERT_EQ(attr.get_max_threads(), 0);
+    for (int max_threads : {1, 4, 0}) {
+        attr.set_max_threads(max_threads);
+        ASSERT_EQ(max_threads, attr.get_max_threads());
+    }
+    EXPECT_ANY_THROW(attr.set_max_threads(-1));
+}
+
+HANDLE_EXCEPTIONS_FOR_TEST_F(attr_test_t, TestMaxThreadsEx) {
+    engine eng = get_test_engine();
+
+    memory::desc data_md(
+            {16, 64, 32}, memory::data_type::f32, memory::format_tag::ncw);
+    auto softmax_d
+            = softmax_forward::desc(prop_kind::forward_inference, data_md, 1);
+
+    auto src = test::make_memory(data_md, eng);
+    fill_data<float>(data_md.get_size() / sizeof(float), src);
+
+    stream s(eng);
+    std::vector<memory> dst;
+    for (int max_threads : {0, 1, 2}) {
+        dnnl::primitive_attr attr;
+        attr.set_max_threads(max_threads);
+        auto softmax_pd = softmax_forward::primitive_desc(softmax_d, attr, eng);
+        dst.push_back(test::make_memory(data_md, eng));
+        softmax_forward(softmax_pd)
+                .execute(s, {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst.back()}});
+    }
+    s.wait();
+
+    const size_t nelems = data_md.get_size() / sizeof(float);
+    auto *ref = dst[0].map_data<float>();
+    for (size_t i = 1; i < dst.size(); i++) {
+        auto *got = dst[i].map_data<float>();
+        for (size_t j = 0; j < nelems; j++)
+            ASSERT_EQ(ref[j], got[j]);
+        dst[i].unmap_data(got);
+    }
+    dst[0].unmap_data(ref);
+}
+
+TEST_F(attr_test_t, TestWeightsGroupSize) {
+    dnnl::primitive_attr attr;
+    ASSERT_EQ(attr.get_weights_group_size(), 1);
+    for (memory::dim group_size : {32, 128, 1}) {
+        attr.set_weights_group_size(group_size);
+        ASSERT_EQ(group_size, attr.get_weights_group_size());
+    }
+    EXPECT_ANY_THROW(attr.set_weights_group_size(0));
+    EXPECT_ANY_THROW(attr.set_weights_group_size(-1));
+}
+
+TEST_F(attr_test_t, TestSrcDynamicQuantization) {
+    dnnl::primitive_attr attr;
+    ASSERT_FALSE(attr.get_src_dynamic_quantization());
+    attr.set_src_dynamic_quantization(true);
+    ASSERT_TRUE(attr.get_src_dynamic_quantization());
+    attr.set_src_dynamic_quantization(false);
+    ASSERT_FALSE(attr.get_src_dynamic_quantization());
+}
+
 HANDLE_EXCEPTIONS_FOR_TEST_F(attr_test_t, TestScratchpadArg) {
     engine eng = get_test_engine();
 
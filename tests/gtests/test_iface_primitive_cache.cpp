@@ -109,6 +109,41 @@ TEST(primitive_cache_test, TestCacheHit) {
 #endif
     ASSERT_EQ(get_primitive_cache_size(), 2);
 }
+
+TEST(primitive_cache_test, TestFootprint) {
+    ASSERT_EQ(get_primitive_cache_footprint_limit(), 0u);
+
+    set_primitive_cache_capacity(0);
+    ASSERT_EQ(get_primitive_cache_footprint(), 0u);
+
+    set_primitive_cache_capacity(1024);
+    fill_primitive_cache(8);
+    const size_t footprint = get_primitive_cache_footprint();
+    ASSERT_GT(footprint, 0u);
+
+    // Lowering the limit evicts the entries that don't fit.
+    set_primitive_cache_footprint_limit(footprint / 2);
+    ASSERT_EQ(get_primitive_cache_footprint_limit(), footprint / 2);
+    ASSERT_LT(get_primitive_cache_size(), 8);
+    ASSERT_LE(get_primitive_cache_footprint(), footprint / 2);
+
+    // New entries evict the least recently used ones to fit the limit.
+    fill_primitive_cache(16);
+    ASSERT_LE(get_primitive_cache_footprint(), footprint / 2);
+
+    // A primitive exceeding the limit on its own is not cached.
+    set_primitive_cache_footprint_limit(1);
+    fill_primitive_cache(1);
+    ASSERT_EQ(get_primitive_cache_size(), 0);
+    ASSERT_EQ(get_primitive_cache_footprint(), 0u);
+
+    set_primitive_cache_footprint_limit(0);
+    fill_primitive_cache(16);
+    ASSERT_EQ(get_primitive_cache_size(), 16);
+
+    set_primitive_cache_capacity(0);
+    ASSERT_EQ(get_primitive_cache_footprint(), 0u);
+}
 #endif
 
 } // namespace dnnl
@@ -21,6 +21,7 @@
 #include "gtest/gtest.h"
 
 #include "oneapi/dnnl/dnnl.hpp"
+#include "tests/test_isa_common.hpp"
 
 #define CPU_INST_TEST_CASE(str, ...) \
     CPU_INSTANTIATE_TEST_SUITE_P( \
@@ -694,5 +695,194 @@ private:
 
 TEST_P(lnorm_test_t, TestsLnormF32) {}
 
+// The normalized values are scaled, passed through the post-ops and written
+// to an int8 destination. The number of channels is not a multiple of the
+// vector length to cover the tails.
+TEST(lnorm_int8_test_t, TestsLnormInt8Dst) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "Int8 destination is supported only on CPU.");
+#if DNNL_X64
+    SKIP_IF(!dnnl::mayiuse(cpu_isa::avx2),
+            "Int8 destination is supported by the JIT kernel only.");
+#else
+    SKIP_IF(true, "Int8 destination is supported by the JIT kernel only.");
+#endif
+
+    using dt = memory::data_type;
+    using tag = memory::format_tag;
+
+    auto eng = get_test_engine();
+    auto strm = make_stream(eng);
+
+    const memory::dim N = 2, T = 3, C = 37;
+    const float eps = 1e-5f, oscale = 2.f;
+
+    for_(auto src_dt : {dt::f32, dt::u8})
+    for (auto dst_dt : {dt::s8, dt::u8}) {
+        memory::desc src_md({N, T, C}, src_dt, tag::abc);
+        memory::desc dst_md({N, T, C}, dst_dt, tag::abc);
+        memory::desc stat_md({N, T}, dt::f32, tag::ab);
+        memory::desc bin_md({N, T, C}, dt::f32, tag::abc);
+
+        primitive_attr attr;
+        attr.set_output_scales(0, {oscale});
+        post_ops ops;
+        ops.append_eltwise(1.f, algorithm::eltwise_relu, 0.f, 0.f);
+        ops.append_binary(algorithm::binary_add, bin_md);
+        attr.set_post_ops(ops);
+
+        const auto flags = normalization_flags::use_scale
+                | normalization_flags::use_shift;
+        auto pd = layer_normalization_forward::primitive_desc(
+                {prop_kind::forward_inference, src_md, dst_md, stat_md, eps,
+                        flags},
+                attr, eng);
+        ASSERT_EQ(pd.dst_desc(), dst_md);
+
+        auto src = test::make_memory(src_md, eng);
+        auto dst = test::make_memory(dst_md, eng);
+        auto scale = test::make_memory(pd.weights_desc(), eng);
+        auto shift = test::make_memory(pd.weights_desc(), eng);
+        auto bin = test::make_memory(bin_md, eng);
+
+        const memory::dim nelems = N * T * C;
+        auto src_val = [](memory::dim i) { return (float)((i * 7) % 61); };
+        auto bin_val = [](memory::dim i) { return (float)(i % 13) - 6.f; };
+        {
+            auto s = map_memory<float>(scale);
+            auto b = map_memory<float>(shift);
+            for (memory::dim c = 0; c < C; c++) {
+                s[c] = 10.f + (float)(c % 5);
+                b[c] = (float)(c % 7) - 3.f;
+            }
+            auto bi = map_memory<float>(bin);
+            for (memory::dim i = 0; i < nelems; i++)
+                bi[i] = bin_val(i);
+            if (src_dt == dt::f32) {
+                auto si = map_memory<float>(src);
+                for (memory::dim i = 0; i < nelems; i++)
+                    si[i] = src_val(i);
+            } else {
+                auto si = map_memory<uint8_t>(src);
+                for (memory::dim i = 0; i < nelems; i++)
+                    si[i] = (uint8_t)src_val(i);
+            }
+        }
+
+        layer_normalization_forward(pd).execute(strm,
+                {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst},
+                        {DNNL_ARG_SCALE, scale}, {DNNL_ARG_SHIFT, shift},
+                        {DNNL_ARG_ATTR_MULTIPLE_POST_OP(1) | DNNL_ARG_SRC_1,
+                                bin}});
+        strm.wait();
+
+        auto s = map_memory<const float>(scale);
+        auto b = map_memory<const float>(shift);
+        auto d = map_memory<const int8_t>(dst);
+        const float lbound = dst_dt == dt::s8 ? -128.f : 0.f;
+        const float ubound = dst_dt == dt::s8 ? 127.f : 255.f;
+        for (memory::dim r = 0; r < N * T; r++) {
+            double mean = 0, var = 0;
+            for (memory::dim c = 0; c < C; c++)
+                mean += src_val(r * C + c);
+            mean /= C;
+            for (memory::dim c = 0; c < C; c++) {
+                const double d = src_val(r * C + c) - mean;
+                var += d * d;
+            }
+            var /= C;
+            const double inv_sqrtvar = 1. / std::sqrt(var + eps);
+
+            for (memory::dim c = 0; c < C; c++) {
+                const memory::dim i = r * C + c;
+                double ref = s[c] * (src_val(i) - mean) * inv_sqrtvar + b[c];
+                ref = std::max(oscale * ref, 0.) + bin_val(i);
+                ref = std::min(std::max(ref, (double)lbound), (double)ubound);
+                const float out = dst_dt == dt::s8 ? (float)d[i]
+                                                   : (float)(uint8_t)d[i];
+                // the rounding of the f32 computations may differ by one
+                ASSERT_NEAR(out, ref, 1.f) << "at " << i;
+            }
+        }
+    }
+}
+
+// The RMS normalization takes no mean and outputs the mean square of the
+// source as the variance.
+TEST(lnorm_rms_test_t, TestsLnormRms) {
+    SKIP_IF_CUDA(true, "Layer normalization not supported by CUDA.");
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "RMS normalization is supported only on CPU.");
+
+    using dt = memory::data_type;
+    using tag = memory::format_tag;
+
+    auto eng = get_test_engine();
+    auto strm = make_stream(eng);
+
+    const memory::dim N = 3, T = 2, C = 45;
+    const float eps = 1e-3f;
+    memory::desc data_md({N, T, C}, dt::f32, tag::abc);
+    memory::desc stat_md({N, T}, dt::f32, tag::ab);
+
+    bool with_relu = false;
+#if DNNL_X64
+    with_relu = dnnl::mayiuse(cpu_isa::avx2);
+#endif
+    primitive_attr attr;
+    if (with_relu) {
+        post_ops ops;
+        ops.append_eltwise(1.f, algorithm::eltwise_relu, 0.f, 0.f);
+        attr.set_post_ops(ops);
+    }
+
+    const auto flags
+            = normalization_flags::rms_norm | normalization_flags::use_scale;
+    auto pd = layer_normalization_forward::primitive_desc(
+            {prop_kind::forward_training, data_md, stat_md, eps, flags}, attr,
+            eng);
+    ASSERT_EQ(pd.mean_desc(), memory::desc());
+    ASSERT_EQ(pd.variance_desc(), stat_md);
+
+    auto src = test::make_memory(data_md, eng);
+    auto dst = test::make_memory(data_md, eng);
+    auto scale = test::make_memory(pd.weights_desc(), eng);
+    auto variance = test::make_memory(stat_md, eng);
+
+    auto src_val = [](memory::dim i) { return (float)(i % 17) / 4.f - 2.f; };
+    {
+        auto s = map_memory<float>(src);
+        for (memory::dim i = 0; i < N * T * C; i++)
+            s[i] = src_val(i);
+        auto g = map_memory<float>(scale);
+        for (memory::dim c = 0; c < C; c++)
+            g[c] = 0.5f + (float)(c % 3);
+    }
+
+    layer_normalization_forward(pd).execute(strm,
+            {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst},
+                    {DNNL_ARG_SCALE, scale}, {DNNL_ARG_VARIANCE, variance}});
+    strm.wait();
+
+    auto d = map_memory<const float>(dst);
+    auto g = map_memory<const float>(scale);
+    auto v = map_memory<const float>(variance);
+    for (memory::dim r = 0; r < N * T; r++) {
+        float ms = 0;
+        for (memory::dim c = 0; c < C; c++)
+            ms += src_val(r * C + c) * src_val(r * C + c);
+        ms /= C;
+        ASSERT_NEAR(v[r], ms, 1e-4f * ms);
+
+        const float inv_rms = 1.f / std::sqrt(ms + eps);
+        for (memory::dim c = 0; c < C; c++) {
+            float ref = g[c] * src_val(r * C + c) * inv_rms;
+            if (with_relu) ref = std::max(ref, 0.f);
+            ASSERT_NEAR(d[r * C + c], ref, 1e-4f * std::max(1.f, ref))
+                    << "at " << r * C + c;
+        }
+    }
+}
+
 #include "layer_normalization.h"
 } // namespace dnnl
@@ -18,7 +18,11 @@
 #include "gtest/gtest.h"
 
 #include "oneapi/dnnl/dnnl.hpp"
+#include "tests/test_isa_common.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <string>
 #include <vector>
 
 namespace dnnl {
@@ -391,6 +395,446 @@ HANDLE_EXCEPTIONS_FOR_TEST_P(
     ASSERT_EQ(impl_info_no_postops, impl_info_with_postops);
 }
 
+HANDLE_EXCEPTIONS_FOR_TEST(matmul_f16_test_t, TestF16Compute) {
+    auto engine_kind = get_test_engine_kind();
+    bool skip_test = !DNNL_X64 || (DNNL_CPU_RUNTIME == DNNL_RUNTIME_NONE)
+            || (engine_kind != engine::kind::cpu);
+#if DNNL_X64 && (DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE)
+    skip_test = skip_test || !dnnl::mayiuse(cpu_isa::avx512_core);
+#endif
+    SKIP_IF(skip_test, "f16 matmul is supported only on avx512_core CPU");
+
+    engine eng = get_test_engine();
+    stream s(eng);
+
+    // The sizes are chosen to have tails in all dimensions.
+    const memory::dim M = 7, K = 70, N = 33;
+    const auto f16 = memory::data_type::f16;
+    memory::desc src_md({M, K}, f16, memory::format_tag::ab);
+    memory::desc wei_md({K, N}, f16, memory::format_tag::ab);
+    memory::desc bia_md({1, N}, f16, memory::format_tag::ab);
+    memory::desc dst_md({M, N}, f16, memory::format_tag::ab);
+
+    dnnl::post_ops ops;
+    ops.append_sum(1.f);
+    dnnl::primitive_attr attr;
+    attr.set_post_ops(ops);
+
+    auto matmul_d = matmul::desc(src_md, wei_md, bia_md, dst_md);
+    auto matmul_pd = matmul::primitive_desc(matmul_d, attr, eng);
+
+    auto src = test::make_memory(src_md, eng);
+    auto wei = test::make_memory(wei_md, eng);
+    auto bia = test::make_memory(bia_md, eng);
+    auto dst = test::make_memory(dst_md, eng);
+
+    // All the values and intermediate results are exact in f16.
+    auto src_val = [](memory::dim i) { return 0.25f * (float)(i % 7 - 3); };
+    auto wei_val = [](memory::dim i) { return 0.5f * (float)(i % 5 - 2); };
+    auto bia_val = [](memory::dim i) { return 0.125f * (float)(i % 4); };
+    auto dst_val = [](memory::dim i) { return (float)(i % 3 - 1); };
+    {
+        auto *src_ptr = src.map_data<float16_t>();
+        auto *wei_ptr = wei.map_data<float16_t>();
+        auto *bia_ptr = bia.map_data<float16_t>();
+        auto *dst_ptr = dst.map_data<float16_t>();
+        for (memory::dim i = 0; i < M * K; i++)
+            src_ptr[i] = src_val(i);
+        for (memory::dim i = 0; i < K * N; i++)
+            wei_ptr[i] = wei_val(i);
+        for (memory::dim i = 0; i < N; i++)
+            bia_ptr[i] = bia_val(i);
+        for (memory::dim i = 0; i < M * N; i++)
+            dst_ptr[i] = dst_val(i);
+        src.unmap_data(src_ptr);
+        wei.unmap_data(wei_ptr);
+        bia.unmap_data(bia_ptr);
+        dst.unmap_data(dst_ptr);
+    }
+
+    matmul(matmul_pd).execute(s,
+            {{DNNL_ARG_SRC, src}, {DNNL_ARG_WEIGHTS, wei},
+                    {DNNL_ARG_BIAS, bia}, {DNNL_ARG_DST, dst}});
+    s.wait();
+
+    auto *dst_ptr = dst.map_data<float16_t>();
+    for_(memory::dim m = 0; m < M; m++)
+    for (memory::dim n = 0; n < N; n++) {
+        float ref = bia_val(n) + dst_val(m * N + n);
+        for (memory::dim k = 0; k < K; k++)
+            ref += src_val(m * K + k) * wei_val(k * N + n);
+        ASSERT_EQ(ref, (float)dst_ptr[m * N + n]);
+    }
+    dst.unmap_data(dst_ptr);
+}
+
+HANDLE_EXCEPTIONS_FOR_TEST(matmul_runtime_dims_test_t, TestRuntimeM) {
+    auto engine_kind = get_test_engine_kind();
+    bool skip_test = !DNNL_X64 || (DNNL_CPU_RUNTIME == DNNL_RUNTIME_NONE)
+            || (engine_kind != engine::kind::cpu);
+#if DNNL_X64 && (DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE)
+    skip_test = skip_test || !dnnl::mayiuse(cpu_isa::avx512_core);
+#endif
+    SKIP_IF(skip_test,
+            "brgemm matmul with runtime M is supported only on avx512_core "
+            "CPU");
+
+    engine eng = get_test_engine();
+    stream s(eng);
+
+    const memory::dim K = 70, N = 33;
+    const auto f32 = memory::data_type::f32;
+    memory::desc src_md({DNNL_RUNTIME_DIM_VAL, K}, f32, memory::format_tag::ab);
+    memory::desc wei_md({K, N}, f32, memory::format_tag::ab);
+    memory::desc bia_md({1, N}, f32, memory::format_tag::ab);
+    memory::desc dst_md({DNNL_RUNTIME_DIM_VAL, N}, f32, memory::format_tag::ab);
+
+    dnnl::post_ops ops;
+    ops.append_eltwise(1.f, algorithm::eltwise_relu, 0.f, 0.f);
+    dnnl::primitive_attr attr;
+    attr.set_post_ops(ops);
+
+    auto matmul_d = matmul::desc(src_md, wei_md, bia_md, dst_md);
+    auto matmul_pd = matmul::primitive_desc(matmul_d, attr, eng);
+    const std::string impl_name = matmul_pd.impl_info_str();
+    ASSERT_EQ(impl_name.compare(0, 4, "brg:"), 0);
+    auto prim = matmul(matmul_pd);
+
+    // All the values and intermediate results are exact in f32.
+    auto src_val = [](memory::dim i) { return (float)(i % 7 - 3); };
+    auto wei_val = [](memory::dim i) { return (float)(i % 5 - 2); };
+    auto bia_val = [](memory::dim i) { return (float)(i % 4 - 2); };
+
+    auto wei = test::make_memory(wei_md, eng);
+    auto bia = test::make_memory(bia_md, eng);
+    {
+        auto *wei_ptr = wei.map_data<float>();
+        auto *bia_ptr = bia.map_data<float>();
+        for (memory::dim i = 0; i < K * N; i++)
+            wei_ptr[i] = wei_val(i);
+        for (memory::dim i = 0; i < N; i++)
+            bia_ptr[i] = bia_val(i);
+        wei.unmap_data(wei_ptr);
+        bia.unmap_data(bia_ptr);
+    }
+
+    // A single primitive serves the problems with different M tails, the
+    // repeated M reuses the kernels generated by the first execution.
+    for (memory::dim M : {1, 5, 64, 67, 300, 5}) {
+        auto src = test::make_memory(
+                {{M, K}, f32, memory::format_tag::ab}, eng);
+        auto dst = test::make_memory(
+                {{M, N}, f32, memory::format_tag::ab}, eng);
+        {
+            auto *src_ptr = src.map_data<float>();
+            for (memory::dim i = 0; i < M * K; i++)
+                src_ptr[i] = src_val(i);
+            src.unmap_data(src_ptr);
+        }
+
+        prim.execute(s,
+                {{DNNL_ARG_SRC, src}, {DNNL_ARG_WEIGHTS, wei},
+                        {DNNL_ARG_BIAS, bia}, {DNNL_ARG_DST, dst}});
+        s.wait();
+
+        auto *dst_ptr = dst.map_data<float>();
+        for_(memory::dim m = 0; m < M; m++)
+        for (memory::dim n = 0; n < N; n++) {
+            float ref = bia_val(n);
+            for (memory::dim k = 0; k < K; k++)
+                ref += src_val(m * K + k) * wei_val(k * N + n);
+            ASSERT_EQ(std::max(ref, 0.f), dst_ptr[m * N + n]);
+        }
+        dst.unmap_data(dst_ptr);
+    }
+}
+
+HANDLE_EXCEPTIONS_FOR_TEST(matmul_small_batched_test_t, TestSmallBatched) {
+    auto engine_kind = get_test_engine_kind();
+    bool skip_test = !DNNL_X64 || (DNNL_CPU_RUNTIME == DNNL_RUNTIME_NONE)
+            || (engine_kind != engine::kind::cpu);
+#if DNNL_X64 && (DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE)
+    skip_test = skip_test || !dnnl::mayiuse(cpu_isa::avx2);
+#endif
+    SKIP_IF(skip_test, "small batched matmul is supported only on avx2 CPU");
+
+    engine eng = get_test_engine();
+    stream s(eng);
+
+    // The batch is large enough for any reasonable number of threads, the
+    // weights are shared by the second batch dimension.
+    const memory::dim B0 = 128, B1 = 8, M = 7, K = 20, N = 33;
+    const auto f32 = memory::data_type::f32;
+    memory::desc src_md({B0, B1, M, K}, f32, memory::format_tag::abcd);
+    memory::desc wei_md({B0, 1, K, N}, f32, memory::format_tag::abcd);
+    memory::desc bia_md({1, 1, 1, N}, f32, memory::format_tag::abcd);
+    memory::desc dst_md({B0, B1, M, N}, f32, memory::format_tag::abcd);
+
+    dnnl::post_ops ops;
+    ops.append_eltwise(1.f, algorithm::eltwise_relu, 0.f, 0.f);
+    dnnl::primitive_attr attr;
+    attr.set_output_scales(0, {2.f});
+    attr.set_post_ops(ops);
+
+    auto matmul_d = matmul::desc(src_md, wei_md, bia_md, dst_md);
+    auto matmul_pd = matmul::primitive_desc(matmul_d, attr, eng);
+    const std::string impl_name = matmul_pd.impl_info_str();
+    ASSERT_EQ(impl_name.compare(0, 16, "brg_small_batch:"), 0);
+
+    // The broadcast source is not supported.
+    memory::desc bcast_src_md({1, B1, M, K}, f32, memory::format_tag::abcd);
+    auto bcast_pd = matmul::primitive_desc(
+            matmul::desc(bcast_src_md, wei_md, bia_md, dst_md), attr, eng);
+    const std::string bcast_impl_name = bcast_pd.impl_info_str();
+    ASSERT_NE(bcast_impl_name.compare(0, 16, "brg_small_batch:"), 0);
+
+    auto src = test::make_memory(src_md, eng);
+    auto wei = test::make_memory(wei_md, eng);
+    auto bia = test::make_memory(bia_md, eng);
+    auto dst = test::make_memory(dst_md, eng);
+
+    // All the values and intermediate results are exact in f32.
+    auto src_val = [](memory::dim i) { return (float)(i % 7 - 3); };
+    auto wei_val = [](memory::dim i) { return (float)(i % 5 - 2); };
+    auto bia_val = [](memory::dim i) { return (float)(i % 4 - 2); };
+    {
+        auto *src_ptr = src.map_data<float>();
+        auto *wei_ptr = wei.map_data<float>();
+        auto *bia_ptr = bia.map_data<float>();
+        for (memory::dim i = 0; i < B0 * B1 * M * K; i++)
+            src_ptr[i] = src_val(i);
+        for (memory::dim i = 0; i < B0 * K * N; i++)
+            wei_ptr[i] = wei_val(i);
+        for (memory::dim i = 0; i < N; i++)
+            bia_ptr[i] = bia_val(i);
+        src.unmap_data(src_ptr);
+        wei.unmap_data(wei_ptr);
+        bia.unmap_data(bia_ptr);
+    }
+
+    matmul(matmul_pd).execute(s,
+            {{DNNL_ARG_SRC, src}, {DNNL_ARG_WEIGHTS, wei},
+                    {DNNL_ARG_BIAS, bia}, {DNNL_ARG_DST, dst}});
+    s.wait();
+
+    auto *dst_ptr = dst.map_data<float>();
+    for_(memory::dim b = 0; b < B0 * B1; b++)
+    for_(memory::dim m = 0; m < M; m++)
+    for (memory::dim n = 0; n < N; n++) {
+        const memory::dim src_off = b * M * K, wei_off = (b / B1) * K * N;
+        float ref = 0.f;
+        for (memory::dim k = 0; k < K; k++)
+            ref += src_val(src_off + m * K + k)
+                    * wei_val(wei_off + k * N + n);
+        ref = std::max(2.f * (ref + bia_val(n)), 0.f);
+        ASSERT_EQ(ref, dst_ptr[b * M * N + m * N + n]);
+    }
+    dst.unmap_data(dst_ptr);
+}
+
+// Weights decompression: the s8 / u8 weights are converted to the source data
+// type as (wei - zero_point) * scale, with the scales and zero points shared by
+// groups of `group` rows along K (all K if 0) and defined per N. With the
+// source dynamic quantization, the int8 implementations quantize each source
+// row to s8 instead.
+struct matmul_wei_decomp_test_params_t {
+    memory::dims src_dims, wei_dims;
+    memory::data_type src_dt, wei_dt;
+    memory::dim group;
+    bool with_zero_points;
+    bool src_dynamic_quantization;
+};
+
+class matmul_wei_decomp_test_t
+    : public ::testing::TestWithParam<matmul_wei_decomp_test_params_t> {
+protected:
+    void SetUp() override {
+        matmul_wei_decomp_test_params_t p
+                = ::testing::TestWithParam<decltype(p)>::GetParam();
+
+        SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+                "Weights decompression is only supported on CPU engine");
+        SKIP_IF(unsupported_data_type(p.src_dt),
+                "Engine does not support this data type.");
+
+        Test();
+    }
+
+    template <typename T, typename F>
+    static void fill(const memory &m, const F &val) {
+        const memory::dim nelems
+                = (memory::dim)(m.get_desc().get_size() / sizeof(T));
+        auto ptr = map_memory<T>(m);
+        for (memory::dim i = 0; i < nelems; i++)
+            ptr[i] = (T)val(i);
+    }
+
+    // Fills the memory with `val(i)` converted to its data type.
+    template <typename F>
+    static void fill(const memory &m, const F &val) {
+        switch (m.get_desc().data_type()) {
+            case memory::data_type::f32: fill<float>(m, val); break;
+            case memory::data_type::bf16: fill<bfloat16_t>(m, val); break;
+            case memory::data_type::s32: fill<int32_t>(m, val); break;
+            case memory::data_type::s8: fill<int8_t>(m, val); break;
+            case memory::data_type::u8: fill<uint8_t>(m, val); break;
+            default: ASSERT_TRUE(!"unexpected data type");
+        }
+    }
+
+    void Test() {
+        matmul_wei_decomp_test_params_t p
+                = ::testing::TestWithParam<decltype(p)>::GetParam();
+
+        auto eng = get_test_engine();
+        auto strm = make_stream(eng);
+
+        const int ndims = (int)p.src_dims.size();
+        const memory::dim B = ndims == 3 ? p.src_dims[0] : 1;
+        const memory::dim wei_B = ndims == 3 ? p.wei_dims[0] : 1;
+        const memory::dim M = p.src_dims[ndims - 2];
+        const memory::dim K = p.src_dims[ndims - 1];
+        const memory::dim N = p.wei_dims[ndims - 1];
+        const memory::dim G = p.group ? p.group : K;
+        const tag t = ndims == 3 ? tag::abc : tag::ab;
+
+        memory::dims dst_dims(p.src_dims), bia_dims(ndims, 1);
+        dst_dims[ndims - 1] = N;
+        bia_dims[ndims - 1] = N;
+        memory::desc src_md(p.src_dims, p.src_dt, t);
+        memory::desc wei_md(p.wei_dims, p.wei_dt, t);
+        memory::desc bia_md(bia_dims, memory::data_type::f32, t);
+        memory::desc dst_md(dst_dims, memory::data_type::f32, t);
+        memory::desc scales_md({K / G * N}, memory::data_type::f32, tag::a);
+        memory::desc zp_md({K / G * N}, memory::data_type::s32, tag::a);
+
+        const int mask = (p.group ? 1 << (ndims - 2) : 0) | 1 << (ndims - 1);
+        primitive_attr attr;
+        attr.set_scales(DNNL_ARG_WEIGHTS, mask, {DNNL_RUNTIME_F32_VAL});
+        if (p.with_zero_points)
+            attr.set_zero_points(
+                    DNNL_ARG_WEIGHTS, mask, {DNNL_RUNTIME_S32_VAL});
+        if (p.group) attr.set_weights_group_size(p.group);
+        attr.set_src_dynamic_quantization(p.src_dynamic_quantization);
+
+        auto matmul_pd = matmul::primitive_desc(
+                matmul::desc(src_md, wei_md, bia_md, dst_md), attr, eng);
+
+        // The source quantized at runtime is computed by the int8
+        // implementations, the others decompress the weights. The int8 ones
+        // support neither groups nor zero points.
+        bool is_int8 = false;
+#if DNNL_X64 && (DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE)
+        is_int8 = p.src_dynamic_quantization && p.group == 0
+                && !p.with_zero_points
+                && dnnl::mayiuse(cpu_isa::avx512_core_vnni);
+#endif
+        if (is_int8) {
+            const std::string impl_name = matmul_pd.impl_info_str();
+            ASSERT_TRUE(impl_name == "brg:avx512_core_vnni"
+                    || impl_name == "brg:avx512_core_amx_int8")
+                    << impl_name;
+        }
+
+        // The decompressed weights and their products with the source are
+        // exact in f32 and bf16.
+        const bool is_bf16 = p.src_dt == memory::data_type::bf16;
+        auto src_val = [&](memory::dim i) {
+            const float v = p.src_dynamic_quantization
+                    ? 0.37f * (float)(i % 13) - 2.1f
+                    : (float)(i % 7 - 3);
+            return is_bf16 ? (float)bfloat16_t(v) : v;
+        };
+        auto wei_val = [&](memory::dim i) {
+            return p.wei_dt == memory::data_type::u8 ? (float)(i % 13)
+                                             : (float)(i % 11 - 5);
+        };
+        auto bia_val = [](memory::dim i) { return 0.5f * (float)(i % 4); };
+        auto scale_val = [](memory::dim i) { return 0.25f * (i % 3 + 1); };
+        auto zp_val = [&](memory::dim i) {
+            return p.with_zero_points ? (float)(i % 5 - 2) : 0.f;
+        };
+
+        auto src = test::make_memory(src_md, eng);
+        auto wei = test::make_memory(wei_md, eng);
+        auto bia = test::make_memory(bia_md, eng);
+        auto dst = test::make_memory(dst_md, eng);
+        auto scales = test::make_memory(scales_md, eng);
+        auto zp = test::make_memory(zp_md, eng);
+        fill(src, src_val);
+        fill(wei, wei_val);
+        fill(bia, bia_val);
+        fill(scales, scale_val);
+        fill(zp, zp_val);
+
+        matmul(matmul_pd)
+                .execute(strm,
+                        {{DNNL_ARG_SRC, src}, {DNNL_ARG_WEIGHTS, wei},
+                                {DNNL_ARG_BIAS, bia}, {DNNL_ARG_DST, dst},
+                                {DNNL_ARG_ATTR_INPUT_SCALES | DNNL_ARG_WEIGHTS,
+                                        scales},
+                                {DNNL_ARG_ATTR_ZERO_POINTS | DNNL_ARG_WEIGHTS,
+                                        zp}});
+        strm.wait();
+
+        auto dst_ptr = map_memory<float>(dst);
+        for_(memory::dim b = 0; b < B; b++)
+        for (memory::dim m = 0; m < M; m++) {
+            const memory::dim src_off = (b * M + m) * K;
+            const memory::dim wei_off = (wei_B == 1 ? 0 : b) * K * N;
+            // The quantization factor maps the maximum absolute value of the
+            // row to 127.
+            float amax = 0.f;
+            for (memory::dim k = 0; k < K; k++)
+                amax = std::max(amax, std::abs(src_val(src_off + k)));
+            const float factor = amax > 0.f ? 127.f / amax : 1.f;
+
+            for (memory::dim n = 0; n < N; n++) {
+                const float dst_val = dst_ptr[(b * M + m) * N + n];
+                if (is_int8) {
+                    // The result is computed in the same order as by the
+                    // library, so it is expected to match exactly.
+                    int32_t acc = 0;
+                    for (memory::dim k = 0; k < K; k++) {
+                        const float q = std::nearbyint(
+                                src_val(src_off + k) * factor);
+                        acc += (int32_t)std::min(std::max(q, -128.f), 127.f)
+                                * (int32_t)wei_val(wei_off + k * N + n);
+                    }
+                    float ref = acc * (1.f / factor);
+                    ref *= scale_val(n);
+                    ref += bia_val(n);
+                    ASSERT_EQ(ref, dst_val) << "b " << b << " m " << m
+                                            << " n " << n;
+                    continue;
+                }
+
+                // The source quantized at runtime by implementations this
+                // test doesn't know about may differ by half of the step.
+                float ref = bia_val(n), err = 0.f;
+                for (memory::dim k = 0; k < K; k++) {
+                    const memory::dim g_off = (k / G) * N + n;
+                    const float w = (wei_val(wei_off + k * N + n)
+                                            - zp_val(g_off))
+                            * scale_val(g_off);
+                    ref += src_val(src_off + k) * w;
+                    err += 0.5f * amax / 127.f * std::abs(w);
+                }
+                if (p.src_dynamic_quantization) {
+                    ASSERT_NEAR(ref, dst_val,
+                            err + 1e-4f * std::max(1.f, std::abs(ref)))
+                            << "b " << b << " m " << m << " n " << n;
+                } else {
+                    ASSERT_EQ(ref, dst_val)
+                            << "b " << b << " m " << m << " n " << n;
+                }
+            }
+        }
+    }
+};
+
+TEST_P(matmul_wei_decomp_test_t, TestsMatMul) {}
+
 /********************************* TEST CASES *********************************/
 
 using iface = matmul_iface_test_t;
@@ -659,4 +1103,37 @@ INSTANTIATE_TEST_SUITE_P(TensorDims, attr_test_t,
                         memory::dims {2, 10, 10, 10}, tag::abcd,
                         memory::data_type::bf16, 4)));
 
+static auto cases_wei_decomp = []() {
+    std::vector<matmul_wei_decomp_test_params_t> cases;
+    const auto f32 = data_type::f32, bf16 = data_type::bf16;
+    const auto s8 = data_type::s8, u8 = data_type::u8;
+
+    for_(auto src_dt : {f32, bf16})
+    for (auto wei_dt : {s8, u8}) {
+        // groups along K with zero points
+        cases.push_back({{3, 64}, {64, 40}, src_dt, wei_dt, 16, true, false});
+        // per N only, K and N tails
+        cases.push_back({{5, 37}, {37, 23}, src_dt, wei_dt, 0, false, false});
+        // batched, groups along K
+        cases.push_back(
+                {{2, 4, 100}, {2, 100, 24}, src_dt, wei_dt, 20, true, false});
+    }
+
+    for (auto src_dt : {f32, bf16}) {
+        // per N scales, K tail
+        cases.push_back({{5, 100}, {100, 40}, src_dt, s8, 0, false, true});
+        // batched with broadcast weights, N tail
+        cases.push_back(
+                {{3, 7, 70}, {1, 70, 33}, src_dt, s8, 0, false, true});
+        // large K
+        cases.push_back({{2, 4096}, {4096, 32}, src_dt, s8, 0, false, true});
+        // groups along K fall back to the weights decompression
+        cases.push_back({{3, 64}, {64, 40}, src_dt, s8, 16, false, true});
+    }
+
+    return ::testing::ValuesIn(cases);
+};
+INSTANTIATE_TEST_SUITE_P(
+        WeightsDecompression, matmul_wei_decomp_test_t, cases_wei_decomp());
+
 } // namespace dnnl
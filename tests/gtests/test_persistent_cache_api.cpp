@@ -44,9 +44,13 @@ HANDLE_EXCEPTIONS_FOR_TEST(
     ASSERT_NO_THROW(cache_blob_id = pd.get_cache_blob_id());
     ASSERT_EQ(cache_blob_id, pd.get_cache_blob_id());
 
-    if (get_test_engine_kind() != engine::kind::gpu
-            || (get_test_engine_kind() == engine::kind::gpu
-                    && DNNL_GPU_RUNTIME != DNNL_RUNTIME_OCL)) {
+    if (get_test_engine_kind() == engine::kind::cpu) {
+        // Only a subset of CPU implementations can be stored in a cache blob.
+        ASSERT_EQ(cache_blob_id.empty(), DNNL_CPU_RUNTIME == DNNL_RUNTIME_SYCL);
+        EXPECT_ANY_THROW(cache_blob = p.get_cache_blob());
+        ASSERT_EQ(cache_blob.empty(), true);
+        EXPECT_ANY_THROW(convolution_forward(pd, cache_blob));
+    } else if (DNNL_GPU_RUNTIME != DNNL_RUNTIME_OCL) {
         ASSERT_EQ(cache_blob_id.empty(), true);
         EXPECT_ANY_THROW(cache_blob = p.get_cache_blob());
         ASSERT_EQ(cache_blob.empty(), true);
@@ -60,4 +64,56 @@ HANDLE_EXCEPTIONS_FOR_TEST(
     }
 }
 
+HANDLE_EXCEPTIONS_FOR_TEST(
+        persistent_cache_api_test_t, TestPersistentCacheAPICPUJit) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu, "CPU-specific test.");
+    SKIP_IF(DNNL_CPU_RUNTIME == DNNL_RUNTIME_SYCL,
+            "Cache blob is not supported for SYCL CPU runtime.");
+
+    engine e = get_test_engine();
+    const memory::desc md(
+            {2, 64, 8, 8}, memory::data_type::f32, memory::format_tag::nchw);
+    auto pd = eltwise_forward::primitive_desc {
+            {prop_kind::forward_inference, algorithm::eltwise_gelu_tanh, md,
+                    0.f, 0.f},
+            e};
+    const std::string impl_info = pd.impl_info_str();
+    SKIP_IF(impl_info.find("jit") == std::string::npos,
+            "Only JIT eltwise implementation supports cache blob.");
+
+    auto p = eltwise_forward(pd);
+
+    std::vector<uint8_t> cache_blob;
+    ASSERT_NO_THROW(cache_blob = p.get_cache_blob());
+    ASSERT_EQ(cache_blob.empty(), false);
+
+    // The primitive cache would return the original primitive instead of
+    // creating a new one from the blob.
+    const int capacity = get_primitive_cache_capacity();
+    set_primitive_cache_capacity(0);
+    eltwise_forward p_from_blob;
+    ASSERT_NO_THROW(p_from_blob = eltwise_forward(pd, cache_blob));
+    set_primitive_cache_capacity(capacity);
+    ASSERT_EQ(cache_blob, p_from_blob.get_cache_blob());
+
+    // Results of the primitive restored from the blob must match the ones of
+    // the original primitive.
+    memory src(md, e), dst(md, e), dst_from_blob(md, e);
+    {
+        auto *ptr = (float *)src.get_data_handle();
+        for (size_t i = 0; i < md.get_size() / sizeof(float); i++)
+            ptr[i] = (float)((int)(i % 17) - 8) / 4.f;
+    }
+    stream s(e);
+    p.execute(s, {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst}});
+    p_from_blob.execute(
+            s, {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst_from_blob}});
+    s.wait();
+
+    const auto *ref = (const float *)dst.get_data_handle();
+    const auto *got = (const float *)dst_from_blob.get_data_handle();
+    for (size_t i = 0; i < md.get_size() / sizeof(float); i++)
+        ASSERT_EQ(ref[i], got[i]);
+}
+
 } // namespace dnnl
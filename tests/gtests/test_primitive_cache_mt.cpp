@@ -102,4 +102,76 @@ TEST(primitive_cache_mt_test, TestMTCacheHit) {
     ASSERT_EQ(get_primitive_cache_size(), n_primitives);
 }
 
+TEST(primitive_cache_mt_test, TestCreatePrimitives) {
+    using tag = memory::format_tag;
+    using dt = memory::data_type;
+
+    engine eng(get_test_engine_kind(), 0);
+
+    // Flush the cache
+    dnnl::set_primitive_cache_capacity(0);
+    dnnl::set_primitive_cache_capacity(1024);
+
+    int n_primitives = 12;
+    int n_unique_primitives = 4;
+
+    std::vector<primitive_desc_base> pds;
+    for (int i = 0; i < n_primitives; i++) {
+        auto relu_d = eltwise_forward::desc(prop_kind::forward_inference,
+                algorithm::eltwise_relu,
+                {{i % n_unique_primitives + 1, 1, 1, 1}, dt::f32, tag::nchw},
+                0.f, 0.f);
+        pds.push_back(eltwise_forward::primitive_desc(relu_d, eng));
+    }
+
+    auto primitives = create_primitives(pds);
+    ASSERT_EQ((int)primitives.size(), n_primitives);
+    for (int i = 0; i < n_primitives; i++) {
+        ASSERT_TRUE(bool(primitives[i]));
+        ASSERT_EQ(primitives[i].get_kind(), primitive::kind::eltwise);
+    }
+
+    ASSERT_EQ(get_primitive_cache_size(), n_unique_primitives);
+
+    // The primitives are created even if the cache can't hold all of them.
+    dnnl::set_primitive_cache_capacity(0);
+    dnnl::set_primitive_cache_capacity(3);
+    ASSERT_EQ((int)create_primitives(pds).size(), n_primitives);
+
+    dnnl::set_primitive_cache_capacity(0);
+    ASSERT_EQ((int)create_primitives(pds).size(), n_primitives);
+    dnnl::set_primitive_cache_capacity(1024);
+}
+
+TEST(primitive_cache_mt_test, TestCreatePrimitivesDuplicates) {
+    using tag = memory::format_tag;
+    using dt = memory::data_type;
+
+    engine eng(get_test_engine_kind(), 0);
+
+    // Flush the cache
+    dnnl::set_primitive_cache_capacity(0);
+    dnnl::set_primitive_cache_capacity(1024);
+
+    // The same primitive descriptor repeated many times along with an
+    // identical one created separately.
+    auto relu_d = eltwise_forward::desc(prop_kind::forward_inference,
+            algorithm::eltwise_relu, {{2, 16, 3, 3}, dt::f32, tag::nchw},
+            0.f, 0.f);
+    auto relu_pd = eltwise_forward::primitive_desc(relu_d, eng);
+    std::vector<primitive_desc_base> pds(31, relu_pd);
+    pds.push_back(eltwise_forward::primitive_desc(relu_d, eng));
+
+    auto primitives = create_primitives(pds);
+    ASSERT_EQ(primitives.size(), pds.size());
+    for (const auto &p : primitives)
+        ASSERT_TRUE(bool(p));
+    ASSERT_EQ(get_primitive_cache_size(), 1);
+
+    // The primitives created from the batch are taken from the cache by the
+    // regular creation.
+    auto relu = eltwise_forward(relu_pd);
+    ASSERT_EQ(get_primitive_cache_size(), 1);
+}
+
 } // namespace dnnl
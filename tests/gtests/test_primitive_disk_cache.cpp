@@ -0,0 +1,144 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "oneapi/dnnl/dnnl.hpp"
+
+namespace dnnl {
+
+class primitive_disk_cache_test_t : public ::testing::Test {};
+
+namespace {
+
+// A temporary directory removed with its content on destruction.
+struct temp_dir_t {
+    temp_dir_t() {
+        char dir_template[] = "/tmp/onednn_pcache_XXXXXX";
+        if (mkdtemp(dir_template)) path_ = dir_template;
+    }
+
+    ~temp_dir_t() {
+        if (path_.empty()) return;
+        for (const auto &name : list())
+            unlink((path_ + "/" + name).c_str());
+        rmdir(path_.c_str());
+    }
+
+    const std::string &path() const { return path_; }
+
+    std::vector<std::string> list() const {
+        std::vector<std::string> names;
+        DIR *d = opendir(path_.c_str());
+        if (!d) return names;
+        while (struct dirent *e = readdir(d)) {
+            const std::string name = e->d_name;
+            if (name != "." && name != "..") names.push_back(name);
+        }
+        closedir(d);
+        return names;
+    }
+
+private:
+    std::string path_;
+};
+
+std::vector<std::string> get_entries(const temp_dir_t &dir) {
+    std::vector<std::string> entries;
+    const std::string ext = ".onednn";
+    for (const auto &name : dir.list()) {
+        if (name.size() > ext.size()
+                && name.compare(name.size() - ext.size(), ext.size(), ext)
+                        == 0)
+            entries.push_back(dir.path() + "/" + name);
+    }
+    return entries;
+}
+
+ino_t get_inode(const std::string &path) {
+    struct stat st;
+    return stat(path.c_str(), &st) == 0 ? st.st_ino : 0;
+}
+
+} // namespace
+
+HANDLE_EXCEPTIONS_FOR_TEST(primitive_disk_cache_test_t, TestEltwise) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu, "CPU-specific test.");
+    SKIP_IF(DNNL_CPU_RUNTIME == DNNL_RUNTIME_SYCL,
+            "Cache blob is not supported for SYCL CPU runtime.");
+
+    // The directory has to be set before the first primitive is created.
+    temp_dir_t dir;
+    ASSERT_FALSE(dir.path().empty());
+    ASSERT_EQ(setenv("ONEDNN_PRIMITIVE_CACHE_DIR", dir.path().c_str(), 1), 0);
+
+    engine e = get_test_engine();
+    const memory::desc md(
+            {2, 64, 8, 8}, memory::data_type::f32, memory::format_tag::nchw);
+    auto pd = eltwise_forward::primitive_desc {
+            {prop_kind::forward_inference, algorithm::eltwise_gelu_tanh, md,
+                    0.f, 0.f},
+            e};
+    const std::string impl_info = pd.impl_info_str();
+    SKIP_IF(impl_info.find("jit") == std::string::npos,
+            "Only JIT eltwise implementation supports cache blob.");
+
+    auto p = eltwise_forward(pd);
+    const auto entries = get_entries(dir);
+    ASSERT_EQ(entries.size(), 1u);
+    const ino_t inode = get_inode(entries[0]);
+    ASSERT_NE(inode, 0u);
+
+    // Drop the in-memory entry to make the next creation use the disk.
+    const int capacity = get_primitive_cache_capacity();
+    set_primitive_cache_capacity(0);
+    set_primitive_cache_capacity(capacity);
+
+    // A miss stores the entry again, replacing the file with a new one. The
+    // same file proves the primitive was created from the disk entry.
+    auto p_from_disk = eltwise_forward(pd);
+    ASSERT_EQ(get_entries(dir), entries);
+    ASSERT_EQ(get_inode(entries[0]), inode);
+    ASSERT_EQ(p.get_cache_blob(), p_from_disk.get_cache_blob());
+
+    memory src(md, e), dst(md, e), dst_from_disk(md, e);
+    {
+        auto *ptr = (float *)src.get_data_handle();
+        for (size_t i = 0; i < md.get_size() / sizeof(float); i++)
+            ptr[i] = (float)((int)(i % 17) - 8) / 4.f;
+    }
+    stream s(e);
+    p.execute(s, {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst}});
+    p_from_disk.execute(
+            s, {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst_from_disk}});
+    s.wait();
+
+    const auto *ref = (const float *)dst.get_data_handle();
+    const auto *got = (const float *)dst_from_disk.get_data_handle();
+    for (size_t i = 0; i < md.get_size() / sizeof(float); i++)
+        ASSERT_EQ(ref[i], got[i]);
+}
+
+} // namespace dnnl
@@ -817,4 +817,237 @@ CPU_INSTANTIATE_TEST_SUITE_P(TestAUGRUlbr, lbr_augru_forward_test_f32,
                                 fmt::undef},
                         test_rnn_sizes_t {1, 1, 5, 1, 4, 4, 4, 4}}));
 
+// Computes the batch of sequences of different lengths at once and compares
+// it against every sequence computed alone.
+TEST(rnn_seq_lengths_test_t, TestsLstmSeqLengths) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "Sequence lengths are supported only on CPU.");
+
+    using dt = memory::data_type;
+    using tag = memory::format_tag;
+
+    auto eng = get_test_engine();
+    auto strm = make_stream(eng);
+
+    const memory::dim L = 2, D = 2, T = 5, MB = 4, C = 8, G = 4;
+    // sorted by the length in the decreasing order
+    const std::vector<int32_t> lengths = {5, 3, 1, 0};
+
+    auto val = [](memory::dim i, int salt) {
+        return (float)((i * 7 + salt) % 13) / 13.f - 0.5f;
+    };
+    auto init = [&](memory::dim n, int salt) {
+        std::vector<float> v(n);
+        for (memory::dim i = 0; i < n; i++)
+            v[i] = val(i, salt);
+        return v;
+    };
+    const auto src_layer = init(T * MB * C, 1);
+    const auto src_iter = init(L * D * MB * C, 2);
+    const auto src_iter_c = init(L * D * MB * C, 3);
+    const auto wei_layer = init(L * D * C * G * C, 4);
+    const auto wei_iter = init(L * D * C * G * C, 5);
+    const auto bias = init(L * D * G * C, 6);
+
+    struct result_t {
+        std::vector<float> dst_layer, dst_iter, dst_iter_c;
+    };
+
+    auto run = [&](memory::dim t, memory::dim mb,
+                       const std::vector<float> &src_layer_v,
+                       const std::vector<float> &src_iter_v,
+                       const std::vector<float> &src_iter_c_v,
+                       const int32_t *seq_lengths) {
+        memory::desc src_layer_md({t, mb, C}, dt::f32, tag::tnc);
+        memory::desc iter_md({L, D, mb, C}, dt::f32, tag::ldnc);
+        memory::desc wei_md({L, D, C, G, C}, dt::f32, tag::ldigo);
+        memory::desc wei_any_md({L, D, C, G, C}, dt::f32, tag::any);
+        memory::desc bias_md({L, D, G, C}, dt::f32, tag::ldgo);
+        memory::desc dst_layer_md({t, mb, D * C}, dt::f32, tag::tnc);
+        memory::desc seq_lengths_md({mb}, dt::s32, tag::a);
+
+        lstm_forward::desc lstm_d(prop_kind::forward_inference,
+                rnn_direction::bidirectional_concat, src_layer_md, iter_md,
+                iter_md, wei_any_md, wei_any_md, bias_md, dst_layer_md,
+                iter_md, iter_md,
+                seq_lengths ? rnn_flags::seq_lengths : rnn_flags::undef);
+        lstm_forward::primitive_desc pd(lstm_d, eng);
+        if (seq_lengths)
+            EXPECT_EQ(pd.query_md(query::exec_arg_md, DNNL_ARG_SEQ_LENGTHS),
+                    seq_lengths_md);
+
+        auto make = [&](const memory::desc &md, const float *data) {
+            auto m = test::make_memory(md, eng);
+            {
+                auto p = map_memory<float>(m);
+                for (size_t i = 0; i < md.get_size() / sizeof(float); i++)
+                    p[i] = data[i];
+            }
+            return m;
+        };
+        auto make_weights = [&](const std::vector<float> &data,
+                                    const memory::desc &md) {
+            auto user = make(wei_md, data.data());
+            auto m = test::make_memory(md, eng);
+            reorder(user, m).execute(strm, user, m);
+            return m;
+        };
+
+        std::unordered_map<int, memory> args = {
+                {DNNL_ARG_SRC_LAYER, make(src_layer_md, src_layer_v.data())},
+                {DNNL_ARG_SRC_ITER, make(iter_md, src_iter_v.data())},
+                {DNNL_ARG_SRC_ITER_C, make(iter_md, src_iter_c_v.data())},
+                {DNNL_ARG_WEIGHTS_LAYER,
+                        make_weights(wei_layer, pd.weights_layer_desc())},
+                {DNNL_ARG_WEIGHTS_ITER,
+                        make_weights(wei_iter, pd.weights_iter_desc())},
+                {DNNL_ARG_BIAS, make(bias_md, bias.data())},
+                {DNNL_ARG_DST_LAYER, test::make_memory(dst_layer_md, eng)},
+                {DNNL_ARG_DST_ITER, test::make_memory(iter_md, eng)},
+                {DNNL_ARG_DST_ITER_C, test::make_memory(iter_md, eng)}};
+        if (seq_lengths) {
+            auto m = test::make_memory(seq_lengths_md, eng);
+            {
+                auto p = map_memory<int32_t>(m);
+                for (memory::dim b = 0; b < mb; b++)
+                    p[b] = seq_lengths[b];
+            }
+            args.insert({DNNL_ARG_SEQ_LENGTHS, m});
+        }
+        lstm_forward(pd).execute(strm, args);
+        strm.wait();
+
+        auto get = [&](int arg) {
+            const auto &m = args.at(arg);
+            const size_t n = m.get_desc().get_size() / sizeof(float);
+            auto p = map_memory<const float>(m);
+            return std::vector<float>(&p[0], &p[0] + n);
+        };
+        return result_t {get(DNNL_ARG_DST_LAYER), get(DNNL_ARG_DST_ITER),
+                get(DNNL_ARG_DST_ITER_C)};
+    };
+
+    const auto tgt = run(T, MB, src_layer, src_iter, src_iter_c,
+            lengths.data());
+
+    for (memory::dim b = 0; b < MB; b++) {
+        const memory::dim len = lengths[b];
+
+        // the states of the sequence alone
+        std::vector<float> src_layer_b(len * C), src_iter_b(L * D * C),
+                src_iter_c_b(L * D * C);
+        for_(memory::dim t = 0; t < len; t++)
+        for (memory::dim c = 0; c < C; c++)
+            src_layer_b[t * C + c] = src_layer[(t * MB + b) * C + c];
+        for_(memory::dim ld = 0; ld < L * D; ld++)
+        for (memory::dim c = 0; c < C; c++) {
+            src_iter_b[ld * C + c] = src_iter[(ld * MB + b) * C + c];
+            src_iter_c_b[ld * C + c] = src_iter_c[(ld * MB + b) * C + c];
+        }
+
+        // an empty sequence passes the initial states through
+        const auto ref = len > 0
+                ? run(len, 1, src_layer_b, src_iter_b, src_iter_c_b, nullptr)
+                : result_t {{}, src_iter_b, src_iter_c_b};
+
+        for_(memory::dim t = 0; t < T; t++)
+        for (memory::dim c = 0; c < D * C; c++) {
+            const float d = tgt.dst_layer[(t * MB + b) * D * C + c];
+            if (t < len)
+                ASSERT_NEAR(d, ref.dst_layer[t * D * C + c], 1e-5f)
+                        << "b " << b << " t " << t << " c " << c;
+            else
+                ASSERT_EQ(d, 0.f) << "b " << b << " t " << t << " c " << c;
+        }
+        for_(memory::dim ld = 0; ld < L * D; ld++)
+        for (memory::dim c = 0; c < C; c++) {
+            ASSERT_NEAR(tgt.dst_iter[(ld * MB + b) * C + c],
+                    ref.dst_iter[ld * C + c], 1e-5f);
+            ASSERT_NEAR(tgt.dst_iter_c[(ld * MB + b) * C + c],
+                    ref.dst_iter_c[ld * C + c], 1e-5f);
+        }
+    }
+}
+
+TEST(rnn_weights_packing_test_t, TestsLstmPlainWeights) {
+    using dt = memory::data_type;
+    using tag = memory::format_tag;
+
+    auto eng = get_test_engine();
+    auto strm = make_stream(eng);
+
+    const memory::dim L = 1, D = 1, T = 3, C = 40, G = 4;
+
+    auto make = [&](const memory::desc &md, int salt) {
+        auto m = test::make_memory(md, eng);
+        auto p = map_memory<float>(m);
+        for (size_t i = 0; i < md.get_size() / sizeof(float); i++)
+            p[i] = (float)((i * 7 + salt) % 13) / 13.f - 0.5f;
+        return m;
+    };
+
+    // The same weights in the plain layout serve all the batch sizes.
+    memory::desc wei_md({L, D, C, G, C}, dt::f32, tag::ldigo);
+    memory::desc wei_any_md({L, D, C, G, C}, dt::f32, tag::any);
+    memory::desc bias_md({L, D, G, C}, dt::f32, tag::ldgo);
+    auto wei_layer = make(wei_md, 1);
+    auto wei_iter = make(wei_md, 2);
+    auto bias = make(bias_md, 3);
+
+    for (memory::dim mb : {1, 5, 16}) {
+        memory::desc src_layer_md({T, mb, C}, dt::f32, tag::tnc);
+        memory::desc iter_md({L, D, mb, C}, dt::f32, tag::ldnc);
+        auto src_layer = make(src_layer_md, 4);
+        auto src_iter = make(iter_md, 5);
+        auto src_iter_c = make(iter_md, 6);
+
+        auto run = [&](const memory::desc &w_md) {
+            lstm_forward::desc lstm_d(prop_kind::forward_inference,
+                    rnn_direction::unidirectional_left2right, src_layer_md,
+                    iter_md, iter_md, w_md, w_md, bias_md, src_layer_md,
+                    iter_md, iter_md);
+            lstm_forward::primitive_desc pd(lstm_d, eng);
+
+            auto prepare = [&](memory user, const memory::desc &md) {
+                if (md == user.get_desc()) return user;
+                auto m = test::make_memory(md, eng);
+                reorder(user, m).execute(strm, user, m);
+                return m;
+            };
+            auto dst_layer = test::make_memory(src_layer_md, eng);
+            lstm_forward(pd).execute(strm,
+                    {{DNNL_ARG_SRC_LAYER, src_layer},
+                            {DNNL_ARG_SRC_ITER, src_iter},
+                            {DNNL_ARG_SRC_ITER_C, src_iter_c},
+                            {DNNL_ARG_WEIGHTS_LAYER,
+                                    prepare(wei_layer,
+                                            pd.weights_layer_desc())},
+                            {DNNL_ARG_WEIGHTS_ITER,
+                                    prepare(wei_iter, pd.weights_iter_desc())},
+                            {DNNL_ARG_BIAS, bias},
+                            {DNNL_ARG_DST_LAYER, dst_layer},
+                            {DNNL_ARG_DST_ITER,
+                                    test::make_memory(iter_md, eng)},
+                            {DNNL_ARG_DST_ITER_C,
+                                    test::make_memory(iter_md, eng)}});
+            strm.wait();
+
+            const size_t n = src_layer_md.get_size() / sizeof(float);
+            auto p = map_memory<const float>(dst_layer);
+            return std::make_pair(std::string(pd.impl_info_str()),
+                    std::vector<float>(&p[0], &p[0] + n));
+        };
+
+        const auto ref = run(wei_any_md);
+        const auto tgt = run(wei_md);
+
+        // The brgemm implementation packs the plain weights by itself.
+        if (ref.first.find("brgemm") != std::string::npos)
+            ASSERT_EQ(tgt.first, ref.first);
+        for (size_t i = 0; i < ref.second.size(); i++)
+            ASSERT_NEAR(tgt.second[i], ref.second[i], 1e-5f)
+                    << "mb " << mb << " i " << i;
+    }
+}
+
 } // namespace dnnl
@@ -0,0 +1,123 @@
+/*******************************************************************************
+* Copyright 2022 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "oneapi/dnnl/dnnl.hpp"
+
+namespace dnnl {
+
+class rnn_weights_cache_test_t : public ::testing::Test {};
+
+HANDLE_EXCEPTIONS_FOR_TEST(rnn_weights_cache_test_t, TestLstmBatchSizes) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu, "CPU-specific test.");
+
+    // The capacity has to be set before the first primitive is created.
+#ifdef _WIN32
+    SetEnvironmentVariable("ONEDNN_RNN_WEIGHTS_CACHE_CAPACITY", "4");
+#else
+    ::setenv("ONEDNN_RNN_WEIGHTS_CACHE_CAPACITY", "4", 1);
+#endif
+
+    using dt = memory::data_type;
+    using tag = memory::format_tag;
+
+    auto eng = get_test_engine();
+    auto strm = make_stream(eng);
+
+    const memory::dim L = 1, D = 1, T = 2, C = 32, G = 4;
+
+    auto fill = [&](const memory &m, int salt) {
+        auto p = map_memory<float>(m);
+        for (size_t i = 0; i < m.get_desc().get_size() / sizeof(float); i++)
+            p[i] = (float)((i * 7 + salt) % 13) / 13.f - 0.5f;
+    };
+
+    memory::desc wei_md({L, D, C, G, C}, dt::f32, tag::ldigo);
+    memory::desc bias_md({L, D, G, C}, dt::f32, tag::ldgo);
+    auto wei_layer = test::make_memory(wei_md, eng);
+    auto wei_iter = test::make_memory(wei_md, eng);
+    auto bias = test::make_memory(bias_md, eng);
+    fill(wei_layer, 1);
+    fill(wei_iter, 2);
+    fill(bias, 3);
+
+    // Runs a batch of mb sequences and returns the last dst_layer of the
+    // first one, which does not depend on mb.
+    auto run = [&](memory::dim mb, std::string &impl) {
+        memory::desc src_layer_md({T, mb, C}, dt::f32, tag::tnc);
+        memory::desc iter_md({L, D, mb, C}, dt::f32, tag::ldnc);
+        lstm_forward::desc lstm_d(prop_kind::forward_inference,
+                rnn_direction::unidirectional_left2right, src_layer_md,
+                iter_md, iter_md, wei_md, wei_md, bias_md, src_layer_md,
+                iter_md, iter_md);
+        lstm_forward::primitive_desc pd(lstm_d, eng);
+        impl = pd.impl_info_str();
+
+        auto src_layer = test::make_memory(src_layer_md, eng);
+        {
+            auto p = map_memory<float>(src_layer);
+            for_(memory::dim t = 0; t < T; t++)
+            for_(memory::dim b = 0; b < mb; b++)
+            for (memory::dim c = 0; c < C; c++)
+                p[(t * mb + b) * C + c] = (float)((t * C + c) % 5) / 5.f;
+        }
+        auto src_iter = test::make_memory(iter_md, eng);
+        auto src_iter_c = test::make_memory(iter_md, eng);
+        fill(src_iter, 0);
+        fill(src_iter_c, 0);
+        auto dst_layer = test::make_memory(src_layer_md, eng);
+        lstm_forward(pd).execute(strm,
+                {{DNNL_ARG_SRC_LAYER, src_layer}, {DNNL_ARG_SRC_ITER, src_iter},
+                        {DNNL_ARG_SRC_ITER_C, src_iter_c},
+                        {DNNL_ARG_WEIGHTS_LAYER, wei_layer},
+                        {DNNL_ARG_WEIGHTS_ITER, wei_iter},
+                        {DNNL_ARG_BIAS, bias}, {DNNL_ARG_DST_LAYER, dst_layer},
+                        {DNNL_ARG_DST_ITER, test::make_memory(iter_md, eng)},
+                        {DNNL_ARG_DST_ITER_C,
+                                test::make_memory(iter_md, eng)}});
+        strm.wait();
+
+        std::vector<float> res(C);
+        auto p = map_memory<const float>(dst_layer);
+        for (memory::dim c = 0; c < C; c++)
+            res[c] = p[((T - 1) * mb) * C + c];
+        return res;
+    };
+
+    std::string impl;
+    const auto ref = run(2, impl);
+    SKIP_IF(impl.find("brgemm") == std::string::npos,
+            "The weights are packed by the brgemm implementation only.");
+
+    // The cache can not see the weights modified in place: the primitive for
+    // the other batch size still uses the copy packed by the first one.
+    fill(wei_layer, 4);
+    const auto tgt = run(7, impl);
+    for (memory::dim c = 0; c < C; c++)
+        ASSERT_NEAR(tgt[c], ref[c], 1e-6f) << "c " << c;
+}
+
+} // namespace dnnl
@@ -18,6 +18,7 @@
 #include "gtest/gtest.h"
 
 #include "oneapi/dnnl/dnnl.hpp"
+#include "tests/test_isa_common.hpp"
 
 namespace dnnl {
 
@@ -61,6 +62,61 @@ TEST_F(iface_sum_test_t, SumTestDstDataTypeCompliance) {
     }
 }
 
+// More inputs than the other implementations handle at once, with the
+// conversion and saturation of the accumulated values.
+TEST_F(iface_sum_test_t, SumTestJitManyInputs) {
+    using dt = memory::data_type;
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "The test targets the CPU implementations.");
+
+    const int n = 12;
+    const memory::dims shape = {3, 37, 5, 7};
+    const memory::dim nelems = 3 * 37 * 5 * 7;
+    auto src_md = memory::desc(shape, dt::u8, tag::abcd);
+    auto dst_md = memory::desc(shape, dt::s8, tag::abcd);
+
+    // The scales and values are such that the sums are exact in f32.
+    std::vector<float> scales;
+    std::vector<memory::desc> srcs_md;
+    for (int i = 0; i < n; i++) {
+        scales.push_back(i % 3 == 0 ? -1.f : 0.5f * (i % 4));
+        srcs_md.push_back(src_md);
+    }
+    auto sum_pd = sum::primitive_desc(dst_md, scales, srcs_md, eng);
+#if DNNL_X64
+    if (dnnl::mayiuse(cpu_isa::avx2)) {
+        const std::string impl_name = sum_pd.impl_info_str();
+        ASSERT_EQ(impl_name.compare(0, 4, "jit:"), 0);
+    }
+#endif
+
+    auto src_val = [](int i, memory::dim j) {
+        return (uint8_t)((j * (i + 1)) % 47);
+    };
+    std::unordered_map<int, memory> args;
+    for (int i = 0; i < n; i++) {
+        auto src = test::make_memory(src_md, eng);
+        auto ptr = map_memory<uint8_t>(src);
+        for (memory::dim j = 0; j < nelems; j++)
+            ptr[j] = src_val(i, j);
+        args.insert({DNNL_ARG_MULTIPLE_SRC + i, src});
+    }
+    auto dst = test::make_memory(dst_md, eng);
+    args.insert({DNNL_ARG_DST, dst});
+
+    sum(sum_pd).execute(strm, args);
+    strm.wait();
+
+    auto dst_data = map_memory<const int8_t>(dst);
+    for (memory::dim j = 0; j < nelems; j++) {
+        float ref = 0.f;
+        for (int i = 0; i < n; i++)
+            ref += scales[i] * src_val(i, j);
+        ref = std::nearbyint(std::min(std::max(ref, -128.f), 127.f));
+        ASSERT_EQ((int8_t)ref, dst_data[j]);
+    }
+}
+
 /* correctness tests */
 
 struct sum_test_params {